@@ -0,0 +1,229 @@
+#pragma once
+
+#include "telemetry_common/redis_client.h"
+
+#include <string>
+#include <optional>
+#include <vector>
+#include <future>
+#include <functional>
+#include <memory>
+
+/**
+ * @file async_redis_client.h
+ * @brief Non-blocking Redis client with futures and callbacks
+ * @author TelemetryHub Team
+ * @date 2026-01-12
+ * @version 0.3.0
+ *
+ * @details
+ * RedisClient blocks the calling thread for one round trip per command, and
+ * BRPOP pins a pooled connection for the whole timeout. AsyncRedisClient
+ * sends commands from a background event loop instead:
+ * - **Multiplexing**: Many in-flight commands share a handful of connections
+ * - **Futures**: std::future for call sites that want a value later
+ * - **Callbacks**: Continuation style for publishers/workers that never wait
+ * - **Blocking Pops Isolated**: BRPOP runs on a separate small pool so it can
+ *   never stall the commands queued behind it
+ *
+ * **Why redis++ AsyncRedis?**
+ * - Same library (and ConnectionOptions) as RedisClient
+ * - Owns its libuv event loop thread - no extra runtime to manage
+ * - Commands are written to the connection without waiting for the reply,
+ *   so throughput is bounded by bandwidth instead of RTT
+ *
+ * @note Only available when built with TELEMETRY_COMMON_ENABLE_ASYNC=ON
+ *       (off by default; defines TELEMETRY_COMMON_HAS_ASYNC)
+ * @see RedisClient for the synchronous API
+ */
+
+// Forward declarations to avoid exposing redis++ in header
+namespace sw {
+namespace redis {
+    class AsyncRedis;
+    class EventLoop;
+}
+}
+
+namespace telemetry_common {
+
+/**
+ * @class AsyncRedisClient
+ * @brief Future/callback based Redis client on a local event loop
+ *
+ * @details
+ * Every command comes in two flavors:
+ * - `std::future<T> cmd(args...)` - resolves when the reply arrives
+ * - `void cmd(args..., Callback<T>)` - invokes the callback on the event loop thread
+ *
+ * Error handling mirrors RedisClient: a failed command resolves to the same
+ * fallback value the synchronous client returns (nullopt, 0, false, empty),
+ * so futures never carry exceptions.
+ *
+ * **Interview Talking Points**:
+ * 1. **Little's Law**: in-flight requests = throughput x latency; async lets
+ *    one connection hold hundreds of them
+ * 2. **Head-of-line blocking**: why blocking commands need their own connections
+ * 3. **Continuations**: chaining BRPOP -> RPOP count without a waiting thread
+ *
+ * **Thread Safety**:
+ * - ✅ All methods may be called concurrently from any thread
+ * - ⚠️ Callbacks run on the event loop thread: keep them short, never block
+ *   and never call future.get() on this client inside a callback
+ *
+ * **Usage Example**:
+ * @code
+ * AsyncRedisClient client(opts);
+ *
+ * // Publisher: fire many pushes, wait once
+ * std::vector<std::future<long long>> acks;
+ * for (const auto& task : tasks) {
+ *     acks.push_back(client.lpush("telemetry:tasks", task));
+ * }
+ * for (auto& ack : acks) ack.get();
+ *
+ * // Worker: continuation style, no thread parked on BRPOP
+ * client.brpop_batch("telemetry:tasks", 100, 5, [&](std::vector<std::string> batch) {
+ *     local_queue.push(std::move(batch));
+ * });
+ * @endcode
+ */
+class AsyncRedisClient {
+public:
+    template <typename T>
+    using Callback = std::function<void(T)>;
+
+    /**
+     * @brief Async client options
+     */
+    struct Options {
+        RedisClient::ConnectionOptions connection;  ///< Host, auth, pool_size for regular commands
+        int blocking_pool_size = 2;                 ///< Dedicated connections for BRPOP
+    };
+
+    /**
+     * @brief Construct async client with default options (localhost:6379)
+     * @throws std::runtime_error if the client cannot be created
+     */
+    AsyncRedisClient();
+
+    /**
+     * @brief Construct async client
+     * @param options Connection and pool configuration
+     * @throws std::runtime_error if the client cannot be created
+     */
+    explicit AsyncRedisClient(const Options& options);
+
+    /**
+     * @brief Destructor - stops the event loop; pending callbacks are dropped
+     */
+    ~AsyncRedisClient();
+
+    // Disable copy (owns event loop and connections)
+    AsyncRedisClient(const AsyncRedisClient&) = delete;
+    AsyncRedisClient& operator=(const AsyncRedisClient&) = delete;
+
+    // Enable move
+    AsyncRedisClient(AsyncRedisClient&&) noexcept;
+    AsyncRedisClient& operator=(AsyncRedisClient&&) noexcept;
+
+    // ========== Connection Management ==========
+
+    /**
+     * @brief PING the server
+     * @return Future resolving to true if the server answered PONG
+     */
+    std::future<bool> ping();
+
+    // ========== String Operations ==========
+
+    std::future<bool> set(const std::string& key, const std::string& value, int ttl_seconds = 0);
+    void set(const std::string& key, const std::string& value, int ttl_seconds, Callback<bool> callback);
+
+    std::future<std::optional<std::string>> get(const std::string& key);
+    void get(const std::string& key, Callback<std::optional<std::string>> callback);
+
+    std::future<long long> del(const std::string& key);
+    void del(const std::string& key, Callback<long long> callback);
+
+    std::future<bool> expire(const std::string& key, int seconds);
+    void expire(const std::string& key, int seconds, Callback<bool> callback);
+
+    // ========== List Operations (Task Queue) ==========
+
+    std::future<long long> lpush(const std::string& key, const std::string& value);
+    void lpush(const std::string& key, const std::string& value, Callback<long long> callback);
+
+    std::future<long long> lpush_many(const std::string& key, const std::vector<std::string>& values);
+    void lpush_many(const std::string& key, const std::vector<std::string>& values,
+                    Callback<long long> callback);
+
+    std::future<std::optional<std::string>> rpop(const std::string& key);
+    void rpop(const std::string& key, Callback<std::optional<std::string>> callback);
+
+    /**
+     * @brief Pop up to count elements from tail of list (Redis 6.2+)
+     */
+    std::future<std::vector<std::string>> rpop_count(const std::string& key, long long count);
+    void rpop_count(const std::string& key, long long count,
+                    Callback<std::vector<std::string>> callback);
+
+    /**
+     * @brief Blocking right pop on the dedicated blocking pool
+     * @param timeout_seconds Timeout in seconds (0 = block indefinitely)
+     *
+     * Interview note: the waiting happens inside Redis, not in a thread of ours -
+     * the caller's thread is free the moment this returns
+     */
+    std::future<std::optional<std::string>> brpop(const std::string& key, int timeout_seconds = 0);
+    void brpop(const std::string& key, int timeout_seconds,
+               Callback<std::optional<std::string>> callback);
+
+    /**
+     * @brief BRPOP, then drain up to max_count - 1 more with RPOP count
+     * @return Between 1 and max_count elements in FIFO order, empty on timeout
+     *
+     * @see RedisClient::brpop_batch for the synchronous equivalent
+     */
+    std::future<std::vector<std::string>> brpop_batch(const std::string& key, long long max_count,
+                                                      int timeout_seconds = 0);
+    void brpop_batch(const std::string& key, long long max_count, int timeout_seconds,
+                     Callback<std::vector<std::string>> callback);
+
+    std::future<long long> llen(const std::string& key);
+    void llen(const std::string& key, Callback<long long> callback);
+
+    // ========== Set Operations (Task Deduplication) ==========
+
+    std::future<long long> sadd(const std::string& key, const std::string& member);
+    void sadd(const std::string& key, const std::string& member, Callback<long long> callback);
+
+    std::future<bool> sismember(const std::string& key, const std::string& member);
+    void sismember(const std::string& key, const std::string& member, Callback<bool> callback);
+
+    // ========== Sorted Set Operations ==========
+
+    std::future<long long> zadd(const std::string& key, const std::string& member, double score);
+    void zadd(const std::string& key, const std::string& member, double score,
+              Callback<long long> callback);
+
+    // ========== Atomic Operations ==========
+
+    std::future<long long> incr(const std::string& key);
+    void incr(const std::string& key, Callback<long long> callback);
+
+    // ========== Statistics & Debugging ==========
+
+    /**
+     * @brief Get options used
+     */
+    const Options& get_options() const { return options_; }
+
+private:
+    Options options_;
+    std::shared_ptr<sw::redis::EventLoop> loop_;       ///< Declared first: stopped and joined last
+    std::shared_ptr<sw::redis::AsyncRedis> redis_;     ///< Multiplexed command connections
+    std::shared_ptr<sw::redis::AsyncRedis> blocking_;  ///< Connections reserved for BRPOP
+};
+
+} // namespace telemetry_common
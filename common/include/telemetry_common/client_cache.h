@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file client_cache.h
+ * @brief Bounded LRU + TTL cache for values read with RedisClient::get
+ * @author TelemetryHub Team
+ * @date 2026-10-18
+ * @version 0.3.0
+ *
+ * @details
+ * Configuration-like keys (device metadata, thresholds) are read on every
+ * task but change rarely; caching them in the process removes most of
+ * those round trips. Two ways an entry goes away:
+ * - **Invalidation**: RedisClient runs CLIENT TRACKING (BCAST on the cached
+ *   prefixes) and calls invalidate() for every key the server reports as
+ *   changed, so entries are dropped within a round trip of the write
+ * - **TTL**: every entry also expires after `ttl`. Without tracking (older
+ *   server, tracking connection down) this alone bounds staleness
+ *
+ * Missing keys are cached too (as nullopt): unknown devices would otherwise
+ * miss on every task.
+ */
+
+namespace telemetry_common {
+
+/**
+ * @brief Cache counters; hit/miss/fill counters are cumulative
+ */
+struct ClientCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t fills = 0;
+    uint64_t dropped_fills = 0;        ///< Raced an invalidation, not stored
+    uint64_t evictions = 0;            ///< LRU, at capacity
+    uint64_t expirations = 0;          ///< TTL
+    uint64_t invalidations = 0;        ///< Entries removed by invalidate()
+    uint64_t flushes = 0;              ///< clear() calls
+    size_t entries = 0;
+    size_t capacity = 0;
+    bool tracking = false;             ///< Server-side invalidation currently active
+
+    double hit_rate() const;
+
+    /**
+     * @brief Export as a JSON object (same style as the gateway's /metrics)
+     */
+    std::string to_json() const;
+};
+
+/**
+ * @class ClientCache
+ * @brief Sharded LRU cache with per-entry TTL and invalidation-safe fills
+ *
+ * @details
+ * A read is lookup() → GET on a miss → fill(). If the key is invalidated
+ * between the two (someone wrote it while the GET was in flight), the
+ * fill would store the old value, so lookup() hands out a token - the
+ * shard's invalidation epoch - and fill() drops the value if the epoch
+ * moved. The next read simply misses again.
+ *
+ * Capacity is split across 16 shards, each with its own lock and LRU
+ * list, so eviction order is LRU per shard.
+ *
+ * Thread-safe.
+ *
+ * Interview note: the "invalidate, don't update" rule of client-side
+ * caching (as in Redis 6 client tracking): a cache that only drops
+ * entries can never resurrect an old value
+ */
+class ClientCache {
+public:
+    struct Options {
+        size_t max_entries = 10000;
+        std::chrono::milliseconds ttl{5000};
+        std::vector<std::string> prefixes;     ///< Keys cached (empty = every key)
+    };
+
+    struct Lookup {
+        bool hit = false;
+        std::optional<std::string> value;      ///< Cached value (nullopt = key known missing)
+        uint64_t fill_token = 0;               ///< Pass to fill() after a miss
+    };
+
+    /**
+     * @throws std::invalid_argument on zero capacity or TTL
+     */
+    explicit ClientCache(Options options);
+
+    ClientCache(const ClientCache&) = delete;
+    ClientCache& operator=(const ClientCache&) = delete;
+
+    /// Whether key matches one of the configured prefixes
+    bool cacheable(const std::string& key) const;
+
+    Lookup lookup(const std::string& key);
+
+    /**
+     * @brief Store a value fetched after a missed lookup()
+     * @return false if the key was invalidated meanwhile (not stored)
+     */
+    bool fill(const std::string& key, std::optional<std::string> value, uint64_t token);
+
+    void invalidate(const std::string& key);
+
+    void invalidate(const std::vector<std::string>& keys);
+
+    /// Drop everything (server FLUSHALL, tracking connection lost)
+    void clear();
+
+    /// Reported in stats(); set by whoever runs the invalidation feed
+    void set_tracking(bool active) { tracking_ = active; }
+
+    ClientCacheStats stats() const;
+
+    const Options& options() const { return options_; }
+
+private:
+    static constexpr size_t kShards = 16;
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string key;
+        std::optional<std::string> value;
+        Clock::time_point expires;
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> lru;                  // Most recent first
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        uint64_t epoch = 0;                    // Bumped by every invalidation
+        ClientCacheStats stats;
+    };
+
+    Shard& shard_for(const std::string& key);
+
+    Options options_;
+    size_t shard_capacity_;
+    std::array<Shard, kShards> shards_;
+    std::atomic<bool> tracking_{false};
+};
+
+} // namespace telemetry_common
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file connection_pool.h
+ * @brief Instrumented, optionally self-sizing pool of client connections
+ * @author TelemetryHub Team
+ * @date 2026-10-18
+ * @version 0.3.0
+ *
+ * @details
+ * redis++ pools connections internally but says nothing about them: when a
+ * worker stalls there is no way to tell a slow Redis from callers queueing
+ * for a connection. This pool owns the connections itself and measures
+ * every borrow:
+ * - **Wait histogram**: time from borrow() to getting a connection
+ * - **Gauges**: size, open, in use, idle, peak in use
+ * - **Counters**: borrows, borrows that waited, timeouts, grow/shrink steps
+ *
+ * **Adaptive sizing** (optional): every adapt_interval the pool looks at
+ * the borrows of the last window. If any timed out, or more than 1% waited
+ * longer than target_wait (the p99 is over target), it grows by half its
+ * size. If the peak in use stayed at least two below the size for
+ * shrink_after, it shrinks by one. Both stay within [min_size, max_size];
+ * growing fast and shrinking slowly keeps it from flapping.
+ */
+
+namespace telemetry_common {
+
+/**
+ * @brief Thrown by ConnectionPool::borrow() when no connection frees up in time
+ */
+class PoolTimeout : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Pool sizing and adaptation
+ */
+struct PoolOptions {
+    size_t initial_size = 5;
+    size_t min_size = 1;                               ///< Adaptive lower bound
+    size_t max_size = 32;                              ///< Adaptive upper bound
+    bool adaptive = false;                             ///< false: stays at initial_size
+    std::chrono::milliseconds borrow_timeout{0};       ///< Longest wait for a connection (0 = forever)
+    std::chrono::microseconds target_wait{1000};       ///< Adaptive: p99 borrow wait to stay under
+    std::chrono::milliseconds adapt_interval{1000};    ///< Adaptive: evaluation window
+    std::chrono::milliseconds shrink_after{30000};     ///< Adaptive: spare capacity this long = shrink
+};
+
+/**
+ * @brief Snapshot of pool metrics
+ *
+ * Counters and the histogram are cumulative since the pool was created.
+ */
+struct PoolStats {
+    /// Upper bounds (µs) of the wait histogram buckets; one more bucket catches the rest
+    static constexpr std::array<int64_t, 12> kWaitBucketsUs{
+        {0, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 50000, 100000, 1000000}};
+
+    // Gauges
+    size_t size = 0;                   ///< Connections allowed right now
+    size_t open = 0;                   ///< Connections created (lazily, up to size)
+    size_t in_use = 0;
+    size_t idle = 0;
+    size_t peak_in_use = 0;
+    size_t min_size = 0;
+    size_t max_size = 0;
+
+    // Counters
+    uint64_t borrows = 0;
+    uint64_t waits = 0;                ///< Borrows that found no free connection
+    uint64_t timeouts = 0;
+    uint64_t grown = 0;                ///< Adaptive grow steps
+    uint64_t shrunk = 0;               ///< Adaptive shrink steps
+    uint64_t wait_us_total = 0;
+    std::array<uint64_t, kWaitBucketsUs.size() + 1> wait_histogram{};
+
+    /// Count one borrow wait (timeouts included) in the histogram
+    void record_wait(std::chrono::microseconds wait);
+
+    double mean_wait_ms() const;
+
+    /**
+     * @brief Upper bound of the bucket holding quantile q (0..1), in ms
+     * @return 0 with no borrows; -1 if the quantile is past the last bound
+     */
+    double wait_quantile_ms(double q) const;
+
+    /**
+     * @brief Export as a JSON object (same style as the gateway's /metrics)
+     */
+    std::string to_json() const;
+};
+
+/**
+ * @class ConnectionPool
+ * @brief Blocking, instrumented pool of Conn handed out as RAII leases
+ *
+ * @details
+ * Connections are created lazily by the factory (outside the lock), up to
+ * the current size, and returned to a LIFO idle stack so the warmest
+ * connection is reused first. Lowering the size closes idle connections
+ * at once and busy ones when they come back.
+ *
+ * @code
+ * ConnectionPool<Conn> pool([] { return std::make_unique<Conn>(); }, opts);
+ * {
+ *     auto conn = pool.borrow();   // May wait; throws PoolTimeout
+ *     conn->send(...);
+ * }                                // Returned here
+ * @endcode
+ *
+ * Thread-safe. The pool must outlive its leases.
+ *
+ * Interview note: same shape as HikariCP - LIFO reuse, a bounded wait,
+ * and wait-time metrics as the signal for pool starvation
+ */
+template <typename Conn>
+class ConnectionPool {
+public:
+    using Factory = std::function<std::unique_ptr<Conn>()>;
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @class Lease
+     * @brief A borrowed connection; given back when destroyed
+     */
+    class Lease {
+    public:
+        Lease() = default;
+        ~Lease() { release(); }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Lease(Lease&& other) noexcept
+            : pool_(std::exchange(other.pool_, nullptr)), conn_(std::move(other.conn_)) {}
+
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                release();
+                pool_ = std::exchange(other.pool_, nullptr);
+                conn_ = std::move(other.conn_);
+            }
+            return *this;
+        }
+
+        Conn* operator->() const { return conn_.get(); }
+        Conn& operator*() const { return *conn_; }
+        explicit operator bool() const { return conn_ != nullptr; }
+
+    private:
+        friend class ConnectionPool;
+        Lease(ConnectionPool* pool, std::unique_ptr<Conn> conn)
+            : pool_(pool), conn_(std::move(conn)) {}
+
+        void release() {
+            if (pool_ && conn_) {
+                pool_->give_back(std::move(conn_));
+            }
+            pool_ = nullptr;
+        }
+
+        ConnectionPool* pool_ = nullptr;
+        std::unique_ptr<Conn> conn_;
+    };
+
+    /**
+     * @param factory Creates one connection (may throw; the slot is freed again)
+     * @param options Sizing; min/max only matter when adaptive
+     * @throws std::invalid_argument on a null factory or inconsistent sizes
+     */
+    ConnectionPool(Factory factory, PoolOptions options)
+        : factory_(std::move(factory)), options_(options), size_(options.initial_size),
+          window_start_(Clock::now()), calm_since_(window_start_) {
+        if (!options_.adaptive) {
+            options_.min_size = options_.max_size = options_.initial_size;
+        }
+        if (!factory_ || options_.min_size == 0 || options_.min_size > options_.initial_size ||
+            options_.initial_size > options_.max_size || options_.adapt_interval.count() <= 0) {
+            throw std::invalid_argument("ConnectionPool: need a factory and 0 < min <= initial <= max");
+        }
+    }
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    /**
+     * @brief Take a connection, waiting up to borrow_timeout for one to free up
+     * @throws PoolTimeout if none did; whatever the factory throws
+     */
+    Lease borrow() {
+        std::vector<std::unique_ptr<Conn>> retired;   // Closed after the lock is released
+        const auto start = Clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        maybe_adapt(start, false, retired);
+
+        bool waited = false;
+        const bool bounded = options_.borrow_timeout.count() > 0;
+        const auto deadline = start + options_.borrow_timeout;
+        while (idle_.empty() && open_ >= size_) {
+            waited = true;
+            if (!bounded && !options_.adaptive) {
+                available_.wait(lock);
+                continue;
+            }
+            // Adaptive: wake at the window's end too, in case every caller is stuck waiting
+            auto wake = options_.adaptive ? window_start_ + options_.adapt_interval : deadline;
+            if (bounded) {
+                wake = std::min(wake, deadline);
+            }
+            available_.wait_until(lock, wake);
+            const auto now = Clock::now();
+            maybe_adapt(now, now - start > options_.target_wait, retired);
+            if (bounded && now >= deadline && idle_.empty() && open_ >= size_) {
+                ++stats_.timeouts;
+                ++window_timeouts_;
+                record(now - start, true);
+                throw PoolTimeout("connection pool exhausted: " + std::to_string(size_) +
+                                  " connections in use");
+            }
+        }
+        record(waited ? Clock::now() - start : Clock::duration::zero(), waited);
+        ++in_use_;
+        window_peak_ = std::max(window_peak_, in_use_);
+        stats_.peak_in_use = std::max(stats_.peak_in_use, in_use_);
+
+        if (!idle_.empty()) {
+            std::unique_ptr<Conn> conn = std::move(idle_.back());
+            idle_.pop_back();
+            return Lease(this, std::move(conn));
+        }
+
+        // Reserve the slot, connect outside the lock
+        ++open_;
+        lock.unlock();
+        try {
+            return Lease(this, factory_());
+        }
+        catch (...) {
+            lock.lock();
+            --open_;
+            --in_use_;
+            available_.notify_one();
+            throw;
+        }
+    }
+
+    PoolStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PoolStats s = stats_;
+        s.size = size_;
+        s.open = open_;
+        s.in_use = in_use_;
+        s.idle = idle_.size();
+        s.min_size = options_.min_size;
+        s.max_size = options_.max_size;
+        return s;
+    }
+
+    const PoolOptions& options() const { return options_; }
+
+private:
+    void give_back(std::unique_ptr<Conn> conn) {
+        std::unique_ptr<Conn> retired;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --in_use_;
+            if (open_ > size_) {
+                --open_;              // The pool shrank while this one was out
+                retired = std::move(conn);
+            } else {
+                idle_.push_back(std::move(conn));
+            }
+        }
+        available_.notify_one();
+    }
+
+    // Caller holds mutex_
+    void record(Clock::duration wait, bool waited) {
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(wait);
+        ++stats_.borrows;
+        ++window_borrows_;
+        if (waited) {
+            ++stats_.waits;
+        }
+        if (us > options_.target_wait) {
+            ++window_slow_;
+        }
+        stats_.record_wait(us);
+    }
+
+    // Close the window if it is over; caller holds mutex_. `stalled`: the
+    // caller is itself still waiting, longer than target_wait.
+    void maybe_adapt(Clock::time_point now, bool stalled, std::vector<std::unique_ptr<Conn>>& retired) {
+        if (!options_.adaptive || now - window_start_ < options_.adapt_interval) {
+            return;
+        }
+        const bool starved = stalled || window_timeouts_ > 0 || window_slow_ * 100 > window_borrows_;
+        if (starved) {
+            calm_since_ = now;
+            if (size_ < options_.max_size) {
+                size_ = std::min(options_.max_size, size_ + std::max<size_t>(1, size_ / 2));
+                ++stats_.grown;
+                available_.notify_all();
+            }
+        } else if (window_peak_ + 2 > size_) {
+            calm_since_ = now;        // Busy but keeping up: leave it
+        } else if (now - calm_since_ >= options_.shrink_after && size_ > options_.min_size) {
+            --size_;
+            ++stats_.shrunk;
+            calm_since_ = now;
+            if (open_ > size_ && !idle_.empty()) {
+                --open_;
+                retired.push_back(std::move(idle_.back()));
+                idle_.pop_back();
+            }
+        }
+        window_start_ = now;
+        window_borrows_ = window_slow_ = window_timeouts_ = 0;
+        window_peak_ = in_use_;
+    }
+
+    Factory factory_;
+    PoolOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::vector<std::unique_ptr<Conn>> idle_;     // LIFO
+    size_t size_;
+    size_t open_ = 0;                             // idle + in use + being created
+    size_t in_use_ = 0;
+    PoolStats stats_;
+
+    // Current adaptation window
+    Clock::time_point window_start_;
+    Clock::time_point calm_since_;                // Since when peak use stayed 2+ below size
+    uint64_t window_borrows_ = 0;
+    uint64_t window_slow_ = 0;                    // Waited longer than target_wait
+    uint64_t window_timeouts_ = 0;
+    size_t window_peak_ = 0;
+};
+
+} // namespace telemetry_common
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @file hash_ring.h
+ * @brief Consistent hashing with virtual nodes
+ * @author TelemetryHub Team
+ * @date 2026-10-18
+ * @version 0.3.0
+ */
+
+namespace telemetry_common {
+
+/**
+ * @class HashRing
+ * @brief Maps keys to nodes so that adding a node moves only ~1/N of the keys
+ *
+ * @details
+ * Each node is placed on a 64-bit ring at `virtual_nodes` points
+ * (hash of "name#i"); a key belongs to the first point at or after its own
+ * hash. Many points per node even out the arcs: with 160 points per node
+ * the load per node stays within a few percent of 1/N. Placement depends
+ * only on node names, never on their order, so every process that lists
+ * the same endpoints routes the same way.
+ *
+ * **Hash tags**: as in Redis Cluster, only the part of a key between the
+ * first '{' and the next '}' is hashed when that part is non-empty, so
+ * "{device:7}:meta" and "{device:7}:alerts" always share a node.
+ *
+ * Immutable after construction, so thread-safe.
+ *
+ * Interview note: Karger et al. consistent hashing, virtual nodes as in
+ * Dynamo/Cassandra; modulo hashing would remap almost every key on resize
+ */
+class HashRing {
+public:
+    /**
+     * @param nodes Node names (e.g. "10.0.0.5:6379"), unique
+     * @param virtual_nodes Ring points per node
+     * @throws std::invalid_argument on no nodes, duplicates or zero virtual_nodes
+     */
+    HashRing(std::vector<std::string> nodes, size_t virtual_nodes);
+
+    /**
+     * @brief Index (into nodes()) of the node owning key
+     */
+    size_t node_for(std::string_view key) const;
+
+    const std::vector<std::string>& nodes() const { return nodes_; }
+
+    /**
+     * @brief The part of key that is hashed (hash tag content, or the whole key)
+     */
+    static std::string_view routing_key(std::string_view key);
+
+    /// FNV-1a, finalized with splitmix64 so nearby names spread over the ring
+    static uint64_t hash(std::string_view data);
+
+private:
+    std::vector<std::string> nodes_;
+    std::vector<std::pair<uint64_t, uint32_t>> points_;   // (ring position, node), sorted
+};
+
+} // namespace telemetry_common
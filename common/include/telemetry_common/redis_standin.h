@@ -0,0 +1,136 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstdint>
+
+/**
+ * @file redis_standin.h
+ * @brief In-process Redis-compatible server for benchmarks and tests
+ * @author TelemetryHub Team
+ * @date 2026-01-16
+ * @version 0.3.0
+ *
+ * @details
+ * A small RESP2 server that RedisClient, AsyncRedisClient, redis-cli and the
+ * gateway publisher can talk to on a machine without a Redis install:
+ * - **Transport**: TCP (ephemeral or fixed port) or a unix domain socket
+ * - **Data Types**: strings, lists, sets, sorted sets, hashes, streams
+ * - **Blocking Commands**: BLPOP/BRPOP/BLMOVE/BRPOPLPUSH/XREADGROUP BLOCK
+ *   park the client until data arrives or the timeout expires - no polling
+ * - **Transactions**: MULTI/EXEC/DISCARD (pipelines work naturally)
+ * - **Consumer Groups**: XGROUP CREATE, XREADGROUP, XACK, XAUTOCLAIM, XPENDING
+ *
+ * **Architecture** (same as Redis itself):
+ * - One event loop thread multiplexes all clients with poll()
+ * - Commands execute one at a time, so every command is atomic
+ * - Blocked clients wait in FIFO order per key and are served as soon as
+ *   a write makes their key non-empty
+ *
+ * **Not Supported**: persistence, replication, pub/sub, Lua, RESP3, auth
+ * (AUTH is accepted and ignored), multiple databases (SELECT is a no-op).
+ *
+ * @note POSIX only (Linux, macOS)
+ */
+
+namespace telemetry_common {
+
+/**
+ * @class RedisStandin
+ * @brief Embeddable Redis stand-in server
+ *
+ * **Usage Example**:
+ * @code
+ * RedisStandin server;              // 127.0.0.1, ephemeral port
+ * if (!server.start()) return 1;
+ *
+ * RedisClient::ConnectionOptions opts;
+ * opts.port = server.port();
+ * RedisClient client(opts);         // Real redis++ client, real sockets
+ *
+ * client.lpush("queue", "task");
+ * auto task = client.brpop("queue", 1);
+ * @endcode
+ *
+ * **Interview Talking Points**:
+ * 1. **Event loop**: poll() over non-blocking sockets, one thread, no locks
+ * 2. **RESP**: length-prefixed framing, why parsing is cheap
+ * 3. **Blocking pops**: parking a client instead of a thread
+ */
+class RedisStandin {
+public:
+    /**
+     * @brief Listen configuration
+     */
+    struct Options {
+        std::string host = "127.0.0.1";  ///< TCP bind address
+        int port = 0;                    ///< TCP port (0 = pick a free one, see port())
+        std::string unix_path;           ///< If set, listen on this unix socket instead of TCP
+    };
+
+    /**
+     * @brief Server statistics
+     */
+    struct Stats {
+        uint64_t connections_accepted = 0;
+        uint64_t commands_processed = 0;
+        uint64_t keys = 0;
+    };
+
+    /**
+     * @brief Construct stand-in with default options (127.0.0.1, ephemeral port)
+     */
+    RedisStandin();
+
+    /**
+     * @brief Construct stand-in
+     * @param options Listen configuration
+     */
+    explicit RedisStandin(const Options& options);
+
+    /**
+     * @brief Destructor - stops the server and closes all connections
+     */
+    ~RedisStandin();
+
+    // Disable copy and move (event loop thread refers to this object)
+    RedisStandin(const RedisStandin&) = delete;
+    RedisStandin& operator=(const RedisStandin&) = delete;
+
+    /**
+     * @brief Bind, listen and start the event loop thread
+     * @return true if the server is accepting connections
+     */
+    bool start();
+
+    /**
+     * @brief Stop the event loop and close all connections (idempotent)
+     */
+    void stop();
+
+    /**
+     * @brief Check if the event loop is running
+     */
+    bool is_running() const;
+
+    /**
+     * @brief Actual TCP port (resolved after start() when Options::port == 0)
+     */
+    int port() const;
+
+    /**
+     * @brief Unix socket path (empty when listening on TCP)
+     */
+    const std::string& unix_path() const;
+
+    /**
+     * @brief Get server statistics (thread-safe snapshot)
+     */
+    Stats get_stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace telemetry_common
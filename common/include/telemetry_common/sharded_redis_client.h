@@ -0,0 +1,208 @@
+#pragma once
+
+#include "telemetry_common/hash_ring.h"
+#include "telemetry_common/redis_client.h"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @file sharded_redis_client.h
+ * @brief Keys spread over several Redis instances by consistent hashing
+ * @author TelemetryHub Team
+ * @date 2026-10-18
+ * @version 0.3.0
+ *
+ * @details
+ * Redis executes commands on one core, so a single instance caps the whole
+ * queue. ShardedRedisClient routes every key to one of N instances:
+ * - **Routing**: HashRing over the endpoint names ("host:port" or the unix
+ *   socket path), so adding an instance moves only ~1/N of the keys
+ * - **Co-location**: hash tags ("{device:7}:meta") keep related keys together
+ * - **Pinning**: Options::pinned puts chosen keys (a queue whose FIFO order
+ *   matters) on a named endpoint, regardless of the ring
+ * - **Per-shard resources**: one RedisClient per shard, each with its own
+ *   connection pool (and pool metrics); pipelines split per shard
+ *
+ * Commands touching several keys only work when all keys live on one shard
+ * (use a hash tag); nothing here fans a single command out.
+ */
+
+namespace telemetry_common {
+
+/**
+ * @class ShardedRedisClient
+ * @brief One RedisClient per Redis instance behind a consistent-hash router
+ *
+ * **Usage Example**:
+ * @code
+ * ShardedRedisClient::Options opts;
+ * for (int port : {6379, 6380, 6381}) {
+ *     RedisClient::ConnectionOptions shard;
+ *     shard.port = port;
+ *     opts.shards.push_back(shard);
+ * }
+ * opts.pinned["telemetry:tasks:pending"] = "localhost:6379";  // One FIFO queue, one shard
+ * ShardedRedisClient redis(opts);
+ *
+ * redis.set("{device:7}:meta", json);           // Routed by "device:7"
+ * redis.for_key("telemetry:tasks:pending").lpush_many("telemetry:tasks:pending", batch);
+ * @endcode
+ *
+ * Thread-safe to the same degree as RedisClient (routing is immutable).
+ *
+ * Interview note: client-side sharding as in Twemproxy/Jedis
+ * ShardedJedis - no proxy hop, but no cross-shard transactions either
+ */
+class ShardedRedisClient {
+public:
+    struct Options {
+        std::vector<RedisClient::ConnectionOptions> shards;   ///< One per Redis instance
+        size_t virtual_nodes = 160;                           ///< Ring points per shard
+        std::unordered_map<std::string, std::string> pinned;  ///< Key -> endpoint_name() of a shard, overrides the ring
+    };
+
+    /**
+     * @brief Connect to every shard
+     * @throws std::invalid_argument on no shards, duplicate endpoints or a pin to an unknown endpoint
+     * @throws std::runtime_error if a shard cannot be reached
+     */
+    explicit ShardedRedisClient(Options options);
+
+    ~ShardedRedisClient();
+
+    ShardedRedisClient(const ShardedRedisClient&) = delete;
+    ShardedRedisClient& operator=(const ShardedRedisClient&) = delete;
+
+    // ========== Routing ==========
+
+    size_t shard_count() const { return shards_.size(); }
+
+    /**
+     * @brief Shard owning key: its pin if any, else the ring (hash tag aware)
+     */
+    size_t shard_index(const std::string& key) const;
+
+    /**
+     * @brief Client of the shard owning key, for any RedisClient operation
+     */
+    RedisClient& for_key(const std::string& key) { return *shards_[shard_index(key)]; }
+
+    RedisClient& shard(size_t index) { return *shards_.at(index); }
+
+    /**
+     * @brief Ring node name of an endpoint: "host:port", or the unix socket path
+     */
+    static std::string endpoint_name(const RedisClient::ConnectionOptions& options);
+
+    // ========== Single-key Operations (routed) ==========
+
+    bool set(const std::string& key, const std::string& value, int ttl_seconds = 0);
+    std::optional<std::string> get(const std::string& key);
+    int del(const std::string& key);
+    long long incr(const std::string& key);
+    long long lpush(const std::string& key, const std::string& value);
+    long long lpush_many(const std::string& key, const std::vector<std::string>& values);
+    std::optional<std::string> rpop(const std::string& key);
+    std::vector<std::string> rpop_count(const std::string& key, long long count);
+    std::vector<std::string> brpop_batch(const std::string& key, long long max_count,
+                                         int timeout_seconds = 0);
+    long long llen(const std::string& key);
+
+    // ========== Batch Operations (Pipelining) ==========
+
+    /**
+     * @class Pipeline
+     * @brief Queues commands into one RedisClient::Pipeline per shard touched
+     *
+     * @details
+     * exec() sends the per-shard batches concurrently (one round trip per
+     * shard, overlapped) and returns the replies in the order the commands
+     * were queued. If one shard's batch fails, its commands get nil
+     * (std::monostate) replies and the other shards' replies are kept.
+     *
+     * Holds one pooled connection per shard touched until destroyed; a
+     * builder method throws std::runtime_error if that shard has none.
+     *
+     * @warning Not thread-safe - build and exec from one thread
+     */
+    class Pipeline {
+    public:
+        ~Pipeline();
+
+        Pipeline(const Pipeline&) = delete;
+        Pipeline& operator=(const Pipeline&) = delete;
+        Pipeline(Pipeline&&) noexcept;
+        Pipeline& operator=(Pipeline&&) = delete;
+
+        Pipeline& set(const std::string& key, const std::string& value, int ttl_seconds = 0);
+        Pipeline& get(const std::string& key);
+        Pipeline& del(const std::string& key);
+        Pipeline& expire(const std::string& key, int seconds);
+        Pipeline& lpush(const std::string& key, const std::string& value);
+        Pipeline& lpush_many(const std::string& key, const std::vector<std::string>& values);
+        Pipeline& rpop(const std::string& key);
+        Pipeline& rpop_count(const std::string& key, long long count);
+        Pipeline& llen(const std::string& key);
+        Pipeline& sadd(const std::string& key, const std::string& member);
+        Pipeline& srem(const std::string& key, const std::string& member);
+        Pipeline& zadd(const std::string& key, const std::string& member, double score);
+        Pipeline& incr(const std::string& key);
+        Pipeline& decr(const std::string& key);
+
+        /**
+         * @brief Queue an arbitrary command, routed by its first argument after the name
+         */
+        Pipeline& command(const std::vector<std::string>& args);
+
+        /**
+         * @brief Commands queued since the last exec()
+         */
+        size_t size() const { return order_.size(); }
+
+        /**
+         * @brief Send every shard's batch and collect replies in queue order
+         */
+        std::vector<RedisClient::Reply> exec();
+
+    private:
+        friend class ShardedRedisClient;
+        explicit Pipeline(ShardedRedisClient& client);
+
+        // Route key, queue through fn(RedisClient::Pipeline&), remember the slot
+        template <typename Fn>
+        Pipeline& queue(const std::string& key, Fn&& fn);
+
+        ShardedRedisClient& client_;
+        std::vector<std::optional<RedisClient::Pipeline>> pipes_;   // Per shard, created on first use
+        std::vector<size_t> queued_;                                // Commands per shard since exec()
+        std::vector<std::pair<size_t, size_t>> order_;              // (shard, position in its batch)
+    };
+
+    /**
+     * @brief Create a sharded pipeline (per-shard batches, replies in queue order)
+     */
+    Pipeline pipeline();
+
+    // ========== Statistics & Debugging ==========
+
+    /**
+     * @brief Per-shard endpoint, pool and cache metrics as one JSON object
+     */
+    std::string metrics() const;
+
+    const Options& options() const { return options_; }
+
+private:
+    Options options_;
+    std::vector<std::unique_ptr<RedisClient>> shards_;   // Same order as options_.shards
+    HashRing ring_;                                      // Nodes in the same order too
+    std::unordered_map<std::string, size_t> pinned_;     // Options::pinned resolved to shard indexes
+};
+
+} // namespace telemetry_common
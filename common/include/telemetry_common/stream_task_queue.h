@@ -0,0 +1,175 @@
+#pragma once
+
+#include "telemetry_common/redis_client.h"
+#include "telemetry_common/types.h"
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+/**
+ * @file stream_task_queue.h
+ * @brief Redis Streams task transport with consumer groups
+ * @author TelemetryHub Team
+ * @date 2026-01-14
+ * @version 0.3.0
+ *
+ * @details
+ * Alternative to the LPUSH/BRPOP list queue:
+ * - **Batching**: XREADGROUP COUNT hands a worker hundreds of tasks per round trip
+ * - **Acknowledgement**: Delivered tasks stay pending until XACK
+ * - **Recovery**: XAUTOCLAIM lets live workers take over a crashed worker's tasks
+ * - **Replay**: The stream keeps history (capped with MAXLEN ~)
+ * - **Horizontal Scaling**: Each entry goes to exactly one consumer in the group
+ *
+ * **Stream Layout**:
+ *   XADD telemetry:tasks:stream MAXLEN ~ 1000000 * task <serialized task>
+ */
+
+namespace telemetry_common {
+
+/**
+ * @class StreamTaskQueue
+ * @brief One worker's (or publisher's) view of a Redis stream task queue
+ *
+ * @details
+ * **Delivery Semantics**: at-least-once. A task read with read_batch() and
+ * not acknowledged within claim_min_idle is handed to another consumer, so
+ * handlers must be idempotent.
+ *
+ * **Thread Safety**:
+ * - ❌ One StreamTaskQueue per worker thread (it tracks the claim cursor)
+ * - ✅ Many StreamTaskQueue instances may share one RedisClient
+ *
+ * **Usage Example**:
+ * @code
+ * RedisClient client(opts);
+ * StreamTaskQueue::Options qopts;
+ * qopts.consumer = "worker-" + hostname;
+ * StreamTaskQueue queue(client, qopts);
+ * queue.ensure_group();
+ *
+ * while (running) {
+ *     auto batch = queue.read_batch();
+ *     std::vector<std::string> done;
+ *     for (auto& msg : batch) {
+ *         if (handle(msg.payload)) done.push_back(msg.id);
+ *     }
+ *     queue.ack(done);  // One XACK per batch
+ * }
+ * @endcode
+ */
+class StreamTaskQueue {
+public:
+    /**
+     * @brief Stream and consumer group configuration
+     */
+    struct Options {
+        std::string stream_key = "telemetry:tasks:stream";
+        std::string group = "telemetry-workers";
+        std::string consumer;                             ///< Unique per worker (default: random UUID)
+        long long maxlen = 1000000;                       ///< Approximate stream cap (0 = unbounded)
+        long long batch_size = 256;                       ///< XREADGROUP / XAUTOCLAIM COUNT
+        int block_ms = 500;                               ///< XREADGROUP BLOCK (keep < socket_timeout)
+        std::chrono::milliseconds claim_min_idle{30000};  ///< Pending longer than this = stuck
+        std::chrono::milliseconds claim_interval{5000};   ///< How often read_batch() looks for stuck tasks
+    };
+
+    /**
+     * @brief Task delivered to this consumer
+     */
+    struct Message {
+        std::string id;            ///< Stream entry ID (pass to ack())
+        std::string payload;       ///< Serialized task
+        bool redelivered = false;  ///< Claimed from another (stuck) consumer
+    };
+
+    /**
+     * @brief Transport statistics
+     */
+    struct Stats {
+        size_t published = 0;
+        size_t delivered = 0;
+        size_t claimed = 0;
+        size_t acked = 0;
+        size_t dropped = 0;  ///< Entries without a task field, acked instead of delivered
+    };
+
+    /**
+     * @brief Construct queue view
+     * @param client Connected Redis client (must outlive this object)
+     * @param options Stream configuration
+     */
+    StreamTaskQueue(RedisClient& client, Options options);
+
+    /**
+     * @brief Create the consumer group (and stream) if missing
+     * @return true if the group is usable
+     */
+    bool ensure_group();
+
+    // ========== Producer Side ==========
+
+    /**
+     * @brief Publish one task
+     * @return Entry ID, empty on error
+     */
+    std::string publish(const std::string& payload);
+
+    /**
+     * @brief Publish many tasks in one pipelined round trip
+     * @return Number of tasks published
+     */
+    size_t publish_batch(const std::vector<std::string>& payloads);
+
+    // ========== Consumer Side ==========
+
+    /**
+     * @brief Fetch up to batch_size tasks
+     *
+     * @details
+     * Every claim_interval, first takes over tasks stuck with dead consumers
+     * (XAUTOCLAIM), then fills the rest of the batch with new tasks
+     * (XREADGROUP, blocking up to block_ms when there are none).
+     *
+     * Entries with no task field (trimmed while pending, or written by
+     * someone else) are acknowledged and counted in Stats::dropped rather
+     * than returned.
+     *
+     * @return Tasks in delivery order, empty on timeout
+     */
+    std::vector<Message> read_batch();
+
+    /**
+     * @brief Take over tasks idle longer than claim_min_idle (one XAUTOCLAIM page)
+     */
+    std::vector<Message> claim_stuck();
+
+    /**
+     * @brief Acknowledge processed tasks (one XACK for the whole batch)
+     * @return Number of tasks acknowledged
+     */
+    size_t ack(const std::vector<std::string>& ids);
+
+    /**
+     * @brief Get stream length (includes acknowledged entries until trimmed)
+     */
+    long long length();
+
+    const Options& get_options() const { return options_; }
+    Stats get_stats() const { return stats_; }
+
+    /// Field name holding the serialized task in each stream entry
+    static constexpr const char* kPayloadField = "task";
+
+private:
+    std::vector<Message> to_messages(std::vector<StreamEntry>&& entries, bool redelivered);
+
+    RedisClient& client_;
+    Options options_;
+    Stats stats_;
+    std::string claim_cursor_ = "0-0";
+    std::chrono::steady_clock::time_point last_claim_{};
+};
+
+} // namespace telemetry_common
@@ -3,6 +3,8 @@
 #include <string>
 #include <chrono>
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace telemetry_common {
 
@@ -15,6 +17,19 @@ using timestamp_t = std::chrono::system_clock::time_point;
 using device_id_t = std::string;
 using task_id_t = std::string;
 
+/**
+ * @brief Field/value pairs of a Redis stream entry
+ */
+using StreamFields = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief Single Redis stream entry (XADD / XREADGROUP / XAUTOCLAIM)
+ */
+struct StreamEntry {
+    std::string id;        // Entry ID assigned by Redis ("<ms>-<seq>")
+    StreamFields fields;   // Field/value pairs (empty if entry was trimmed)
+};
+
 /**
  * @brief Get current timestamp
  */
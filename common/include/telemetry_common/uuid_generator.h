@@ -1,13 +1,86 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace telemetry_common {
 
+/**
+ * @brief 128-bit UUID held as 16 bytes (RFC 9562 byte order)
+ *
+ * Hot paths (dedup sets, in-flight maps) can key on Uuid directly: 16 bytes
+ * inline, trivially copyable, no heap, O(1) hash - versus a 36-char
+ * std::string that allocates on every copy. Convert with to_string() only
+ * at the edges (logs, JSON, Redis keys).
+ *
+ * Generation draws 128 bits per call from a per-thread xoshiro256** PRNG
+ * (seeded once per thread from std::random_device): no locks, no shared
+ * state, no per-digit distribution calls.
+ *
+ * Interview note: v4 is fully random - great for sharding, bad for B-tree
+ * indexes (inserts land on random pages). v7 puts a millisecond timestamp
+ * first, so IDs sort by creation time and inserts append to the index.
+ */
+struct Uuid {
+    std::array<uint8_t, 16> bytes{};  ///< Big-endian, as in the text form
+
+    /// Random UUID (version 4)
+    static Uuid v4();
+
+    /**
+     * @brief Time-ordered UUID (version 7): 48-bit Unix ms + 74 random bits
+     *
+     * IDs from one thread are strictly increasing, even within the same
+     * millisecond (12-bit counter in rand_a, RFC 9562 method 1). Across
+     * threads they are ordered to the millisecond.
+     */
+    static Uuid v7();
+
+    /// Parse the 36-char hyphenated form (either case); nullopt if malformed
+    static std::optional<Uuid> parse(std::string_view text);
+
+    /// Version nibble (4, 7, ...); 0 for the nil UUID
+    int version() const { return bytes[6] >> 4; }
+
+    bool is_nil() const;
+
+    /// Write the 36-char lowercase form to out (no terminator)
+    void format(char* out) const;
+
+    /// Lowercase xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
+    std::string to_string() const;
+
+    friend bool operator==(const Uuid& a, const Uuid& b) { return a.bytes == b.bytes; }
+    friend bool operator!=(const Uuid& a, const Uuid& b) { return a.bytes != b.bytes; }
+    friend bool operator<(const Uuid& a, const Uuid& b) { return a.bytes < b.bytes; }
+
+    static constexpr size_t kStringLength = 36;
+};
+
 /**
  * @brief Generate UUID v4 (random)
  * @return UUID string in format: xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx
  */
 std::string generate_uuid();
 
+/**
+ * @brief Generate a time-ordered UUID v7 string (sorts by creation time)
+ * @return UUID string in format: xxxxxxxx-xxxx-7xxx-yxxx-xxxxxxxxxxxx
+ */
+std::string generate_uuid_v7();
+
 } // namespace telemetry_common
+
+namespace std {
+
+template <>
+struct hash<telemetry_common::Uuid> {
+    size_t operator()(const telemetry_common::Uuid& id) const noexcept;
+};
+
+} // namespace std
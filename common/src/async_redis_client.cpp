@@ -0,0 +1,364 @@
+#include "telemetry_common/async_redis_client.h"
+#include <sw/redis++/async_redis++.h>
+#include <stdexcept>
+#include <sstream>
+
+namespace telemetry_common {
+
+namespace {
+
+template <typename T>
+using Callback = AsyncRedisClient::Callback<T>;
+
+/**
+ * Deliver a redis++ reply to a callback, mapping errors to the same
+ * fallback values RedisClient returns (nullopt, 0, false, empty).
+ *
+ * @param send Issues the command, given the redis++ completion handler
+ * @param convert Maps the redis++ result type to the public result type
+ */
+template <typename T, typename Raw, typename Send, typename Convert>
+void dispatch(sw::redis::AsyncRedis* redis, const Callback<T>& callback, T fallback,
+              Send&& send, Convert convert) {
+    if (!redis) {
+        callback(std::move(fallback));
+        return;
+    }
+    auto on_reply = [callback, fallback, convert](sw::redis::Future<Raw>&& fut) {
+        T value = fallback;
+        try {
+            value = convert(fut.get());
+        }
+        catch (const sw::redis::Error&) {
+            // Keep fallback
+        }
+        callback(std::move(value));
+    };
+    try {
+        send(*redis, std::move(on_reply));
+    }
+    catch (const sw::redis::Error&) {
+        callback(std::move(fallback));
+    }
+}
+
+// Bridge a callback-style call into a std::future
+template <typename T, typename Issue>
+std::future<T> make_future(Issue&& issue) {
+    auto promise = std::make_shared<std::promise<T>>();
+    auto future = promise->get_future();
+    issue([promise](T value) { promise->set_value(std::move(value)); });
+    return future;
+}
+
+const auto same = [](auto value) { return value; };
+
+void rpop_count_on(sw::redis::AsyncRedis* redis, const std::string& key, long long count,
+                   const Callback<std::vector<std::string>>& callback) {
+    if (count <= 0) {
+        callback({});
+        return;
+    }
+    using Raw = std::optional<std::vector<std::string>>;
+    dispatch<std::vector<std::string>, Raw>(redis, callback, {},
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) {
+            // RPOP key count replies nil (not an empty array) when the list is empty
+            r.command<Raw>("RPOP", key, std::to_string(count), std::move(on_reply));
+        },
+        [](Raw value) { return value ? std::move(*value) : std::vector<std::string>{}; });
+}
+
+} // namespace
+
+// ========== Constructor & Destructor ==========
+
+AsyncRedisClient::AsyncRedisClient()
+    : AsyncRedisClient(Options{})
+{
+}
+
+AsyncRedisClient::AsyncRedisClient(const Options& options)
+    : options_(options)
+{
+    try {
+        const auto& conn = options_.connection;
+
+        // Same mapping as RedisClient: a unix socket replaces host/port
+        sw::redis::ConnectionOptions conn_opts;
+        if (conn.unix_socket.empty()) {
+            conn_opts.host = conn.host;
+            conn_opts.port = conn.port;
+        } else {
+            conn_opts.type = sw::redis::ConnectionType::UNIX;
+            conn_opts.path = conn.unix_socket;
+        }
+        conn_opts.keep_alive = conn.tcp_keepalive;
+        conn_opts.keep_alive_s = conn.keepalive_interval;
+        conn_opts.password = conn.password;
+        conn_opts.db = conn.db;
+        conn_opts.connect_timeout = conn.connect_timeout;
+        conn_opts.socket_timeout = conn.socket_timeout;
+
+        sw::redis::ConnectionPoolOptions pool_opts;
+        pool_opts.size = conn.pool_size;
+
+        // One event loop thread drives both pools
+        loop_ = std::make_shared<sw::redis::EventLoop>();
+        redis_ = std::make_shared<sw::redis::AsyncRedis>(conn_opts, pool_opts, loop_);
+
+        // BRPOP replies only when data arrives or the server-side timeout
+        // expires, so these connections must not have a socket timeout
+        sw::redis::ConnectionOptions blocking_opts = conn_opts;
+        blocking_opts.socket_timeout = std::chrono::milliseconds(0);
+
+        sw::redis::ConnectionPoolOptions blocking_pool_opts;
+        blocking_pool_opts.size = options_.blocking_pool_size > 0 ? options_.blocking_pool_size : 1;
+
+        blocking_ = std::make_shared<sw::redis::AsyncRedis>(blocking_opts, blocking_pool_opts, loop_);
+    }
+    catch (const sw::redis::Error& e) {
+        std::ostringstream oss;
+        oss << "Async Redis client error: " << e.what();
+        throw std::runtime_error(oss.str());
+    }
+}
+
+AsyncRedisClient::~AsyncRedisClient() = default;
+
+// Move constructor and assignment
+AsyncRedisClient::AsyncRedisClient(AsyncRedisClient&&) noexcept = default;
+AsyncRedisClient& AsyncRedisClient::operator=(AsyncRedisClient&&) noexcept = default;
+
+// ========== Connection Management ==========
+
+std::future<bool> AsyncRedisClient::ping() {
+    return make_future<bool>([&](Callback<bool> cb) {
+        dispatch<bool, std::string>(redis_.get(), cb, false,
+            [](sw::redis::AsyncRedis& r, auto&& on_reply) { r.ping(std::move(on_reply)); },
+            [](const std::string& reply) { return reply == "PONG"; });
+    });
+}
+
+// ========== String Operations ==========
+
+void AsyncRedisClient::set(const std::string& key, const std::string& value, int ttl_seconds,
+                           Callback<bool> callback) {
+    dispatch<bool, bool>(redis_.get(), callback, false,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) {
+            auto ttl = std::chrono::milliseconds(ttl_seconds > 0 ? ttl_seconds * 1000LL : 0);
+            r.set(key, value, ttl, sw::redis::UpdateType::ALWAYS, std::move(on_reply));
+        },
+        same);
+}
+
+std::future<bool> AsyncRedisClient::set(const std::string& key, const std::string& value,
+                                        int ttl_seconds) {
+    return make_future<bool>([&](Callback<bool> cb) { set(key, value, ttl_seconds, std::move(cb)); });
+}
+
+void AsyncRedisClient::get(const std::string& key, Callback<std::optional<std::string>> callback) {
+    dispatch<std::optional<std::string>, sw::redis::OptionalString>(redis_.get(), callback, std::nullopt,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) { r.get(key, std::move(on_reply)); },
+        same);
+}
+
+std::future<std::optional<std::string>> AsyncRedisClient::get(const std::string& key) {
+    return make_future<std::optional<std::string>>(
+        [&](Callback<std::optional<std::string>> cb) { get(key, std::move(cb)); });
+}
+
+void AsyncRedisClient::del(const std::string& key, Callback<long long> callback) {
+    dispatch<long long, long long>(redis_.get(), callback, 0,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) { r.del(key, std::move(on_reply)); },
+        same);
+}
+
+std::future<long long> AsyncRedisClient::del(const std::string& key) {
+    return make_future<long long>([&](Callback<long long> cb) { del(key, std::move(cb)); });
+}
+
+void AsyncRedisClient::expire(const std::string& key, int seconds, Callback<bool> callback) {
+    dispatch<bool, bool>(redis_.get(), callback, false,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) {
+            r.expire(key, std::chrono::seconds(seconds), std::move(on_reply));
+        },
+        same);
+}
+
+std::future<bool> AsyncRedisClient::expire(const std::string& key, int seconds) {
+    return make_future<bool>([&](Callback<bool> cb) { expire(key, seconds, std::move(cb)); });
+}
+
+// ========== List Operations ==========
+
+void AsyncRedisClient::lpush(const std::string& key, const std::string& value,
+                             Callback<long long> callback) {
+    dispatch<long long, long long>(redis_.get(), callback, 0,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) { r.lpush(key, value, std::move(on_reply)); },
+        same);
+}
+
+std::future<long long> AsyncRedisClient::lpush(const std::string& key, const std::string& value) {
+    return make_future<long long>([&](Callback<long long> cb) { lpush(key, value, std::move(cb)); });
+}
+
+void AsyncRedisClient::lpush_many(const std::string& key, const std::vector<std::string>& values,
+                                  Callback<long long> callback) {
+    if (values.empty()) {
+        callback(0);
+        return;
+    }
+    dispatch<long long, long long>(redis_.get(), callback, 0,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) {
+            r.lpush(key, values.begin(), values.end(), std::move(on_reply));
+        },
+        same);
+}
+
+std::future<long long> AsyncRedisClient::lpush_many(const std::string& key,
+                                                    const std::vector<std::string>& values) {
+    return make_future<long long>([&](Callback<long long> cb) { lpush_many(key, values, std::move(cb)); });
+}
+
+void AsyncRedisClient::rpop(const std::string& key, Callback<std::optional<std::string>> callback) {
+    dispatch<std::optional<std::string>, sw::redis::OptionalString>(redis_.get(), callback, std::nullopt,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) { r.rpop(key, std::move(on_reply)); },
+        same);
+}
+
+std::future<std::optional<std::string>> AsyncRedisClient::rpop(const std::string& key) {
+    return make_future<std::optional<std::string>>(
+        [&](Callback<std::optional<std::string>> cb) { rpop(key, std::move(cb)); });
+}
+
+void AsyncRedisClient::rpop_count(const std::string& key, long long count,
+                                  Callback<std::vector<std::string>> callback) {
+    rpop_count_on(redis_.get(), key, count, callback);
+}
+
+std::future<std::vector<std::string>> AsyncRedisClient::rpop_count(const std::string& key,
+                                                                   long long count) {
+    return make_future<std::vector<std::string>>(
+        [&](Callback<std::vector<std::string>> cb) { rpop_count(key, count, std::move(cb)); });
+}
+
+void AsyncRedisClient::brpop(const std::string& key, int timeout_seconds,
+                             Callback<std::optional<std::string>> callback) {
+    dispatch<std::optional<std::string>, sw::redis::OptionalStringPair>(blocking_.get(), callback, std::nullopt,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) {
+            auto timeout = std::chrono::seconds(timeout_seconds > 0 ? timeout_seconds : 0);
+            r.brpop(key, timeout, std::move(on_reply));
+        },
+        [](sw::redis::OptionalStringPair reply) -> std::optional<std::string> {
+            if (reply) {
+                return std::move(reply->second);  // Return value, not key
+            }
+            return std::nullopt;
+        });
+}
+
+std::future<std::optional<std::string>> AsyncRedisClient::brpop(const std::string& key,
+                                                                int timeout_seconds) {
+    return make_future<std::optional<std::string>>(
+        [&](Callback<std::optional<std::string>> cb) { brpop(key, timeout_seconds, std::move(cb)); });
+}
+
+void AsyncRedisClient::brpop_batch(const std::string& key, long long max_count, int timeout_seconds,
+                                   Callback<std::vector<std::string>> callback) {
+    if (max_count <= 0) {
+        callback({});
+        return;
+    }
+    // Continuation runs on the event loop after this call returns, when the
+    // client may have been moved or destroyed: hold the pool weakly, not `this`
+    std::weak_ptr<sw::redis::AsyncRedis> pool = redis_;
+    brpop(key, timeout_seconds, [pool, key, max_count, callback](std::optional<std::string> first) {
+        if (!first) {
+            callback({});
+            return;
+        }
+        auto redis = pool.lock();
+        if (max_count == 1 || !redis) {
+            callback({std::move(*first)});  // Client gone: still hand over what was popped
+            return;
+        }
+        // Drain on the multiplexed pool; the blocking connection is already free again
+        rpop_count_on(redis.get(), key, max_count - 1,
+            [head = std::move(*first), callback](std::vector<std::string> rest) {
+                rest.insert(rest.begin(), head);
+                callback(std::move(rest));
+            });
+    });
+}
+
+std::future<std::vector<std::string>> AsyncRedisClient::brpop_batch(const std::string& key,
+                                                                    long long max_count,
+                                                                    int timeout_seconds) {
+    return make_future<std::vector<std::string>>([&](Callback<std::vector<std::string>> cb) {
+        brpop_batch(key, max_count, timeout_seconds, std::move(cb));
+    });
+}
+
+void AsyncRedisClient::llen(const std::string& key, Callback<long long> callback) {
+    dispatch<long long, long long>(redis_.get(), callback, 0,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) { r.llen(key, std::move(on_reply)); },
+        same);
+}
+
+std::future<long long> AsyncRedisClient::llen(const std::string& key) {
+    return make_future<long long>([&](Callback<long long> cb) { llen(key, std::move(cb)); });
+}
+
+// ========== Set Operations ==========
+
+void AsyncRedisClient::sadd(const std::string& key, const std::string& member,
+                            Callback<long long> callback) {
+    dispatch<long long, long long>(redis_.get(), callback, 0,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) { r.sadd(key, member, std::move(on_reply)); },
+        same);
+}
+
+std::future<long long> AsyncRedisClient::sadd(const std::string& key, const std::string& member) {
+    return make_future<long long>([&](Callback<long long> cb) { sadd(key, member, std::move(cb)); });
+}
+
+void AsyncRedisClient::sismember(const std::string& key, const std::string& member,
+                                 Callback<bool> callback) {
+    dispatch<bool, bool>(redis_.get(), callback, false,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) { r.sismember(key, member, std::move(on_reply)); },
+        same);
+}
+
+std::future<bool> AsyncRedisClient::sismember(const std::string& key, const std::string& member) {
+    return make_future<bool>([&](Callback<bool> cb) { sismember(key, member, std::move(cb)); });
+}
+
+// ========== Sorted Set Operations ==========
+
+void AsyncRedisClient::zadd(const std::string& key, const std::string& member, double score,
+                            Callback<long long> callback) {
+    dispatch<long long, long long>(redis_.get(), callback, 0,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) {
+            r.zadd(key, member, score, sw::redis::UpdateType::ALWAYS, false, std::move(on_reply));
+        },
+        same);
+}
+
+std::future<long long> AsyncRedisClient::zadd(const std::string& key, const std::string& member,
+                                              double score) {
+    return make_future<long long>([&](Callback<long long> cb) { zadd(key, member, score, std::move(cb)); });
+}
+
+// ========== Atomic Operations ==========
+
+void AsyncRedisClient::incr(const std::string& key, Callback<long long> callback) {
+    dispatch<long long, long long>(redis_.get(), callback, 0,
+        [&](sw::redis::AsyncRedis& r, auto&& on_reply) { r.incr(key, std::move(on_reply)); },
+        same);
+}
+
+std::future<long long> AsyncRedisClient::incr(const std::string& key) {
+    return make_future<long long>([&](Callback<long long> cb) { incr(key, std::move(cb)); });
+}
+
+} // namespace telemetry_common
@@ -0,0 +1,155 @@
+#include "telemetry_common/client_cache.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace telemetry_common {
+
+// ========== Stats ==========
+
+double ClientCacheStats::hit_rate() const {
+    const uint64_t lookups = hits + misses;
+    return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+}
+
+std::string ClientCacheStats::to_json() const {
+    nlohmann::json j{
+        {"hits", hits},
+        {"misses", misses},
+        {"hit_rate", hit_rate()},
+        {"fills", fills},
+        {"dropped_fills", dropped_fills},
+        {"evictions", evictions},
+        {"expirations", expirations},
+        {"invalidations", invalidations},
+        {"flushes", flushes},
+        {"entries", entries},
+        {"capacity", capacity},
+        {"tracking", tracking},
+    };
+    return j.dump();
+}
+
+// ========== Cache ==========
+
+ClientCache::ClientCache(Options options)
+    : options_(std::move(options)),
+      shard_capacity_((options_.max_entries + kShards - 1) / kShards) {
+    if (options_.max_entries == 0 || options_.ttl.count() <= 0) {
+        throw std::invalid_argument("ClientCache: max_entries and ttl must be positive");
+    }
+}
+
+ClientCache::Shard& ClientCache::shard_for(const std::string& key) {
+    return shards_[std::hash<std::string>{}(key) % kShards];
+}
+
+bool ClientCache::cacheable(const std::string& key) const {
+    if (options_.prefixes.empty()) {
+        return true;
+    }
+    return std::any_of(options_.prefixes.begin(), options_.prefixes.end(),
+                       [&key](const std::string& prefix) { return key.compare(0, prefix.size(), prefix) == 0; });
+}
+
+ClientCache::Lookup ClientCache::lookup(const std::string& key) {
+    Shard& shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Lookup result;
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        if (it->second->expires > Clock::now()) {
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            ++shard.stats.hits;
+            result.hit = true;
+            result.value = it->second->value;
+            return result;
+        }
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+        ++shard.stats.expirations;
+    }
+    ++shard.stats.misses;
+    result.fill_token = shard.epoch;
+    return result;
+}
+
+bool ClientCache::fill(const std::string& key, std::optional<std::string> value, uint64_t token) {
+    Shard& shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.epoch != token) {
+        ++shard.stats.dropped_fills;
+        return false;
+    }
+    const auto expires = Clock::now() + options_.ttl;
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        // Another reader filled it first; same epoch, so same value
+        it->second->value = std::move(value);
+        it->second->expires = expires;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    } else {
+        if (shard.index.size() >= shard_capacity_) {
+            shard.index.erase(shard.lru.back().key);
+            shard.lru.pop_back();
+            ++shard.stats.evictions;
+        }
+        shard.lru.push_front(Entry{key, std::move(value), expires});
+        shard.index.emplace(key, shard.lru.begin());
+    }
+    ++shard.stats.fills;
+    return true;
+}
+
+void ClientCache::invalidate(const std::string& key) {
+    Shard& shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    ++shard.epoch;  // Also when absent: a GET for it may be in flight
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+        ++shard.stats.invalidations;
+    }
+}
+
+void ClientCache::invalidate(const std::vector<std::string>& keys) {
+    for (const auto& key : keys) {
+        invalidate(key);
+    }
+}
+
+void ClientCache::clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        ++shard.epoch;
+        shard.lru.clear();
+        shard.index.clear();
+    }
+    std::lock_guard<std::mutex> lock(shards_[0].mutex);
+    ++shards_[0].stats.flushes;
+}
+
+ClientCacheStats ClientCache::stats() const {
+    ClientCacheStats total;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const ClientCacheStats& s = shard.stats;
+        total.hits += s.hits;
+        total.misses += s.misses;
+        total.fills += s.fills;
+        total.dropped_fills += s.dropped_fills;
+        total.evictions += s.evictions;
+        total.expirations += s.expirations;
+        total.invalidations += s.invalidations;
+        total.flushes += s.flushes;
+        total.entries += shard.index.size();
+    }
+    total.capacity = shard_capacity_ * kShards;
+    total.tracking = tracking_;
+    return total;
+}
+
+} // namespace telemetry_common
@@ -0,0 +1,71 @@
+#include "telemetry_common/connection_pool.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace telemetry_common {
+
+constexpr std::array<int64_t, 12> PoolStats::kWaitBucketsUs;
+
+void PoolStats::record_wait(std::chrono::microseconds wait) {
+    const auto it = std::lower_bound(kWaitBucketsUs.begin(), kWaitBucketsUs.end(), wait.count());
+    ++wait_histogram[static_cast<size_t>(it - kWaitBucketsUs.begin())];
+    wait_us_total += static_cast<uint64_t>(std::max<int64_t>(0, wait.count()));
+}
+
+double PoolStats::mean_wait_ms() const {
+    return borrows == 0 ? 0.0 : static_cast<double>(wait_us_total) / static_cast<double>(borrows) / 1000.0;
+}
+
+double PoolStats::wait_quantile_ms(double q) const {
+    uint64_t total = 0;
+    for (uint64_t n : wait_histogram) {
+        total += n;
+    }
+    if (total == 0) {
+        return 0.0;
+    }
+    // Rank of the q-quantile, 1-based: the bucket where the running count reaches it
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kWaitBucketsUs.size(); ++i) {
+        seen += wait_histogram[i];
+        if (seen >= rank) {
+            return static_cast<double>(kWaitBucketsUs[i]) / 1000.0;
+        }
+    }
+    return -1.0;
+}
+
+std::string PoolStats::to_json() const {
+    // Cumulative buckets keyed by upper bound, as in a Prometheus histogram
+    nlohmann::json buckets = nlohmann::json::object();
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < wait_histogram.size(); ++i) {
+        cumulative += wait_histogram[i];
+        const std::string le = i < kWaitBucketsUs.size() ? std::to_string(kWaitBucketsUs[i]) : "+Inf";
+        buckets[le] = cumulative;
+    }
+    nlohmann::json j{
+        {"size", size},
+        {"open", open},
+        {"in_use", in_use},
+        {"idle", idle},
+        {"peak_in_use", peak_in_use},
+        {"min_size", min_size},
+        {"max_size", max_size},
+        {"borrows", borrows},
+        {"waits", waits},
+        {"timeouts", timeouts},
+        {"grown", grown},
+        {"shrunk", shrunk},
+        {"wait_mean_ms", mean_wait_ms()},
+        {"wait_p50_ms", wait_quantile_ms(0.50)},
+        {"wait_p99_ms", wait_quantile_ms(0.99)},
+        {"wait_us_sum", wait_us_total},
+        {"wait_us_buckets", buckets},
+    };
+    return j.dump();
+}
+
+} // namespace telemetry_common
@@ -0,0 +1,66 @@
+#include "telemetry_common/hash_ring.h"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace telemetry_common {
+
+HashRing::HashRing(std::vector<std::string> nodes, size_t virtual_nodes)
+    : nodes_(std::move(nodes)) {
+    if (nodes_.empty() || virtual_nodes == 0) {
+        throw std::invalid_argument("HashRing: need at least one node and one virtual node");
+    }
+    std::unordered_set<std::string> unique(nodes_.begin(), nodes_.end());
+    if (unique.size() != nodes_.size()) {
+        throw std::invalid_argument("HashRing: duplicate node names");
+    }
+
+    points_.reserve(nodes_.size() * virtual_nodes);
+    for (uint32_t node = 0; node < nodes_.size(); ++node) {
+        for (size_t i = 0; i < virtual_nodes; ++i) {
+            points_.emplace_back(hash(nodes_[node] + "#" + std::to_string(i)), node);
+        }
+    }
+    // Ties (astronomically rare) go to the smaller name, not to list order
+    std::sort(points_.begin(), points_.end(), [this](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first < b.first : nodes_[a.second] < nodes_[b.second];
+    });
+}
+
+size_t HashRing::node_for(std::string_view key) const {
+    const uint64_t h = hash(routing_key(key));
+    auto it = std::lower_bound(points_.begin(), points_.end(), h,
+                               [](const auto& point, uint64_t value) { return point.first < value; });
+    if (it == points_.end()) {
+        it = points_.begin();  // Wrap around
+    }
+    return it->second;
+}
+
+std::string_view HashRing::routing_key(std::string_view key) {
+    const size_t open = key.find('{');
+    if (open == std::string_view::npos) {
+        return key;
+    }
+    const size_t close = key.find('}', open + 1);
+    if (close == std::string_view::npos || close == open + 1) {
+        return key;  // No closing brace, or "{}": hash the whole key
+    }
+    return key.substr(open + 1, close - open - 1);
+}
+
+uint64_t HashRing::hash(std::string_view data) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : data) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+} // namespace telemetry_common
@@ -1,36 +1,349 @@
 #include "telemetry_common/redis_client.h"
 #include <sw/redis++/redis++.h>
+#include <hiredis/hiredis.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <stdexcept>
 #include <sstream>
+#include <iterator>
+#include <thread>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <poll.h>
+#include <sys/socket.h>
+#endif
 
 namespace telemetry_common {
 
+namespace {
+
+// Convert a raw hiredis reply into the wrapper's Reply variant
+RedisClient::Reply to_reply(const redisReply& reply) {
+    switch (reply.type) {
+        case REDIS_REPLY_INTEGER:
+            return static_cast<long long>(reply.integer);
+        case REDIS_REPLY_STRING:
+        case REDIS_REPLY_STATUS:
+            return std::string(reply.str, reply.len);
+        case REDIS_REPLY_ARRAY: {
+            std::vector<std::optional<std::string>> items;
+            items.reserve(reply.elements);
+            for (size_t i = 0; i < reply.elements; ++i) {
+                const redisReply* element = reply.element[i];
+                if (element && element->type == REDIS_REPLY_INTEGER) {
+                    items.emplace_back(std::to_string(element->integer));
+                } else if (element && element->str) {
+                    items.emplace_back(std::string(element->str, element->len));
+                } else {
+                    items.emplace_back();  // Keep the slot: MGET a missing b -> [a, nil, b]
+                }
+            }
+            return items;
+        }
+        default:
+            return std::monostate{};  // NIL or ERROR
+    }
+}
+
+// Parse an array of [id, [field, value, ...]] stream entries
+std::vector<StreamEntry> to_stream_entries(const redisReply& reply) {
+    std::vector<StreamEntry> entries;
+    if (reply.type != REDIS_REPLY_ARRAY) {
+        return entries;
+    }
+    entries.reserve(reply.elements);
+    for (size_t i = 0; i < reply.elements; ++i) {
+        const redisReply* item = reply.element[i];
+        if (!item || item->type != REDIS_REPLY_ARRAY || item->elements == 0 || !item->element[0]->str) {
+            continue;
+        }
+        StreamEntry entry;
+        entry.id.assign(item->element[0]->str, item->element[0]->len);
+
+        // Field list is nil for entries trimmed while still pending
+        const redisReply* fields = item->elements > 1 ? item->element[1] : nullptr;
+        if (fields && fields->type == REDIS_REPLY_ARRAY) {
+            entry.fields.reserve(fields->elements / 2);
+            for (size_t f = 0; f + 1 < fields->elements; f += 2) {
+                const redisReply* name = fields->element[f];
+                const redisReply* value = fields->element[f + 1];
+                if (name->str && value->str) {
+                    entry.fields.emplace_back(std::string(name->str, name->len),
+                                              std::string(value->str, value->len));
+                }
+            }
+        }
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+// XADD key [MAXLEN ~ n] * field value ...
+std::vector<std::string> xadd_args(const std::string& key, const StreamFields& fields, long long maxlen) {
+    std::vector<std::string> args;
+    args.reserve(6 + fields.size() * 2);
+    args.emplace_back("XADD");
+    args.push_back(key);
+    if (maxlen > 0) {
+        args.emplace_back("MAXLEN");
+        args.emplace_back("~");
+        args.push_back(std::to_string(maxlen));
+    }
+    args.emplace_back("*");
+    for (const auto& field : fields) {
+        args.push_back(field.first);
+        args.push_back(field.second);
+    }
+    return args;
+}
+
+// SO_KEEPALIVE on the invalidation feed socket this wrapper opens itself
+// (the pooled connections get it through sw::redis::ConnectionOptions)
+void enable_keepalive(int fd, const RedisClient::ConnectionOptions& options) {
+    if (!options.unix_socket.empty() || !options.tcp_keepalive) {
+        return;
+    }
+    int on = 1;
+    // const char* for winsock, const void* elsewhere
+    ::setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, reinterpret_cast<const char*>(&on), sizeof(on));
+}
+
+// Drops a key from the client-side cache once a write through this client is done
+// (or failed: the key's state is then unknown either way)
+class WriteInvalidation {
+public:
+    WriteInvalidation(ClientCache* cache, const std::string& key) : cache_(cache), key_(key) {}
+    ~WriteInvalidation() {
+        if (cache_ && cache_->cacheable(key_)) {
+            cache_->invalidate(key_);
+        }
+    }
+
+    WriteInvalidation(const WriteInvalidation&) = delete;
+    WriteInvalidation& operator=(const WriteInvalidation&) = delete;
+
+private:
+    ClientCache* cache_;
+    const std::string& key_;
+};
+
+} // namespace
+
+// ========== Client-side Cache Invalidation ==========
+
+/**
+ * Feeds server-side invalidations into the cache over one dedicated hiredis
+ * connection. redis++ does not expose a subscriber's client ID, which RESP2
+ * tracking needs, so this connection does it all itself:
+ *
+ *   CLIENT ID -> n
+ *   CLIENT TRACKING ON REDIRECT n BCAST PREFIX p ...   (writes to cached prefixes)
+ *   SUBSCRIBE __redis__:invalidate                     -> [message, channel, [key ...]]
+ *
+ * BCAST needs no per-key bookkeeping on the server and survives pooled
+ * connections reconnecting, since the tracking state lives here. If the
+ * connection drops, invalidations may have been missed: the cache is
+ * cleared and the feed reconnected. A server that rejects CLIENT TRACKING
+ * (Redis < 6, the stand-in) leaves the cache on TTL only.
+ */
+struct RedisClient::CacheTracker {
+    CacheTracker(const ConnectionOptions& opts, ClientCache& c)
+        : options(opts), cache(c), thread([this] { run(); }) {}
+
+    ~CacheTracker() {
+        stop = true;
+        thread.join();
+    }
+
+    enum class Setup { Ok, Retry, Unsupported };
+
+    static redisReply* call(redisContext* ctx, const std::vector<std::string>& args) {
+        std::vector<const char*> argv;
+        std::vector<size_t> lens;
+        for (const auto& arg : args) {
+            argv.push_back(arg.data());
+            lens.push_back(arg.size());
+        }
+        return static_cast<redisReply*>(
+            redisCommandArgv(ctx, static_cast<int>(args.size()), argv.data(), lens.data()));
+    }
+
+    Setup subscribe(redisContext* ctx) {
+        if (!options.password.empty()) {
+            redisReply* auth = call(ctx, {"AUTH", options.password});
+            const bool ok = auth && auth->type != REDIS_REPLY_ERROR;
+            freeReplyObject(auth);
+            if (!ok) return Setup::Retry;
+        }
+        redisReply* id = call(ctx, {"CLIENT", "ID"});
+        if (!id || id->type != REDIS_REPLY_INTEGER) {
+            freeReplyObject(id);
+            return Setup::Retry;
+        }
+        std::vector<std::string> tracking{"CLIENT", "TRACKING", "ON", "REDIRECT",
+                                          std::to_string(id->integer), "BCAST"};
+        freeReplyObject(id);
+        for (const auto& prefix : cache.options().prefixes) {
+            tracking.push_back("PREFIX");
+            tracking.push_back(prefix);
+        }
+        redisReply* on = call(ctx, tracking);
+        if (!on) return Setup::Retry;
+        const bool rejected = on->type == REDIS_REPLY_ERROR;
+        freeReplyObject(on);
+        if (rejected) return Setup::Unsupported;
+
+        redisReply* sub = call(ctx, {"SUBSCRIBE", "__redis__:invalidate"});
+        const bool subscribed = sub && sub->type == REDIS_REPLY_ARRAY;
+        freeReplyObject(sub);
+        return subscribed ? Setup::Ok : Setup::Retry;
+    }
+
+    // [message, __redis__:invalidate, [key ...] | nil]; nil means FLUSHALL
+    void apply(const redisReply& reply) {
+        if (reply.type != REDIS_REPLY_ARRAY || reply.elements < 3 || !reply.element[0]->str ||
+            std::string(reply.element[0]->str, reply.element[0]->len) != "message") {
+            return;
+        }
+        const redisReply* keys = reply.element[2];
+        if (keys->type != REDIS_REPLY_ARRAY) {
+            cache.clear();
+            return;
+        }
+        for (size_t i = 0; i < keys->elements; ++i) {
+            if (keys->element[i]->str) {
+                cache.invalidate(std::string(keys->element[i]->str, keys->element[i]->len));
+            }
+        }
+    }
+
+    // Wait up to 100 ms for the socket, so stop is noticed promptly
+    static int wait_readable(redisContext* ctx) {
+#ifdef _WIN32
+        WSAPOLLFD pfd{static_cast<SOCKET>(ctx->fd), POLLIN, 0};
+        return WSAPoll(&pfd, 1, 100);
+#else
+        pollfd pfd{ctx->fd, POLLIN, 0};
+        return ::poll(&pfd, 1, 100);
+#endif
+    }
+
+    void listen(redisContext* ctx) {
+        while (!stop) {
+            const int ready = wait_readable(ctx);
+            if (ready < 0 && errno != EINTR) return;
+            if (ready <= 0) continue;
+            if (redisBufferRead(ctx) != REDIS_OK) return;   // Connection lost
+            void* reply = nullptr;
+            while (redisReaderGetReply(ctx->reader, &reply) == REDIS_OK && reply) {
+                apply(*static_cast<redisReply*>(reply));
+                freeReplyObject(reply);
+                reply = nullptr;
+            }
+        }
+    }
+
+    void run() {
+        auto backoff = std::chrono::milliseconds(100);
+        while (!stop) {
+            timeval timeout{};
+            timeout.tv_sec = static_cast<long>(options.connect_timeout.count() / 1000);
+            timeout.tv_usec = static_cast<long>(options.connect_timeout.count() % 1000 * 1000);
+            redisContext* ctx = options.unix_socket.empty()
+                ? redisConnectWithTimeout(options.host.c_str(), options.port, timeout)
+                : redisConnectUnixWithTimeout(options.unix_socket.c_str(), timeout);
+            if (ctx && !ctx->err) {
+                enable_keepalive(ctx->fd, options);
+            }
+            const Setup setup = ctx && !ctx->err ? subscribe(ctx) : Setup::Retry;
+            if (setup == Setup::Ok) {
+                cache.clear();       // Writes during the gap were not reported
+                cache.set_tracking(true);
+                backoff = std::chrono::milliseconds(100);
+                listen(ctx);
+                cache.set_tracking(false);
+                cache.clear();
+            }
+            if (ctx) redisFree(ctx);
+            if (setup == Setup::Unsupported) return;   // TTL only from here on
+
+            const auto resume = std::chrono::steady_clock::now() + backoff;
+            while (!stop && std::chrono::steady_clock::now() < resume) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+            backoff = std::min(backoff * 2, std::chrono::milliseconds(5000));
+        }
+    }
+
+    ConnectionOptions options;
+    ClientCache& cache;
+    std::atomic<bool> stop{false};
+    std::thread thread;          // Last: started once everything above exists
+};
+
 // ========== Constructor & Destructor ==========
 
+RedisClient::RedisClient()
+    : RedisClient(ConnectionOptions{})
+{
+}
+
 RedisClient::RedisClient(const ConnectionOptions& options)
     : options_(options)
 {
     try {
         // Build connection string
         sw::redis::ConnectionOptions conn_opts;
-        conn_opts.host = options_.host;
-        conn_opts.port = options_.port;
+        if (options_.unix_socket.empty()) {
+            conn_opts.host = options_.host;
+            conn_opts.port = options_.port;
+        } else {
+            conn_opts.type = sw::redis::ConnectionType::UNIX;
+            conn_opts.path = options_.unix_socket;
+        }
+        conn_opts.keep_alive = options_.tcp_keepalive;
+        conn_opts.keep_alive_s = options_.keepalive_interval;
         conn_opts.password = options_.password;
         conn_opts.db = options_.db;
         conn_opts.connect_timeout = options_.connect_timeout;
         conn_opts.socket_timeout = options_.socket_timeout;
 
-        // Connection pool options
-        sw::redis::ConnectionPoolOptions pool_opts;
-        pool_opts.size = options_.pool_size;
+        // Our own pool of single-connection clients, so every borrow can be measured
+        PoolOptions pool_opts;
+        pool_opts.initial_size = static_cast<size_t>(std::max(options_.pool_size, 1));
+        pool_opts.adaptive = options_.adaptive_pool;
+        pool_opts.min_size = static_cast<size_t>(std::max(options_.min_pool_size, 1));
+        pool_opts.max_size = static_cast<size_t>(std::max(options_.max_pool_size, 1));
+        pool_opts.borrow_timeout = options_.pool_wait_timeout;
+        pool_opts.target_wait = options_.pool_target_wait;
 
-        // Create Redis client with connection pooling
-        redis_ = std::make_unique<sw::redis::Redis>(conn_opts, pool_opts);
+        pool_ = std::make_unique<ConnectionPool<sw::redis::Redis>>(
+            [conn_opts] {
+                sw::redis::ConnectionPoolOptions single;
+                single.size = 1;
+                return std::make_unique<sw::redis::Redis>(conn_opts, single);
+            },
+            pool_opts);
 
         // Test connection
         if (!ping()) {
             throw std::runtime_error("Failed to connect to Redis server");
         }
+
+        if (options_.client_cache) {
+            ClientCache::Options cache_opts;
+            cache_opts.max_entries = options_.cache_max_entries;
+            cache_opts.ttl = options_.cache_ttl;
+            cache_opts.prefixes = options_.cache_prefixes;
+            cache_ = std::make_unique<ClientCache>(std::move(cache_opts));
+            if (options_.cache_tracking) {
+                tracker_ = std::make_unique<CacheTracker>(options_, *cache_);
+            }
+        }
     }
     catch (const sw::redis::Error& e) {
         std::ostringstream oss;
@@ -45,12 +358,22 @@ RedisClient::~RedisClient() = default;
 RedisClient::RedisClient(RedisClient&&) noexcept = default;
 RedisClient& RedisClient::operator=(RedisClient&&) noexcept = default;
 
+// Pool timeouts surface as redis++ timeouts, so every operation's error path covers them
+ConnectionPool<sw::redis::Redis>::Lease RedisClient::borrow() {
+    try {
+        return pool_->borrow();
+    }
+    catch (const PoolTimeout& e) {
+        throw sw::redis::TimeoutError(e.what());
+    }
+}
+
 // ========== Connection Management ==========
 
 bool RedisClient::ping() {
-    if (!redis_) return false;
+    if (!pool_) return false;
     try {
-        std::string response = redis_->ping();
+        std::string response = borrow()->ping();
         return response == "PONG";
     }
     catch (const sw::redis::Error&) {
@@ -59,19 +382,20 @@ bool RedisClient::ping() {
 }
 
 bool RedisClient::is_connected() const {
-    return redis_ != nullptr;
+    return pool_ != nullptr;
 }
 
 // ========== String Operations ==========
 
 bool RedisClient::set(const std::string& key, const std::string& value, int ttl_seconds) {
-    if (!redis_) return false;
+    if (!pool_) return false;
+    WriteInvalidation written(cache_.get(), key);
     try {
         if (ttl_seconds > 0) {
             auto ttl = std::chrono::seconds(ttl_seconds);
-            return redis_->set(key, value, ttl);
+            return borrow()->set(key, value, ttl);
         } else {
-            return redis_->set(key, value);
+            return borrow()->set(key, value);
         }
     }
     catch (const sw::redis::Error&) {
@@ -80,13 +404,25 @@ bool RedisClient::set(const std::string& key, const std::string& value, int ttl_
 }
 
 std::optional<std::string> RedisClient::get(const std::string& key) {
-    if (!redis_) return std::nullopt;
+    if (!pool_) return std::nullopt;
+    const bool cached = cache_ && cache_->cacheable(key);
+    ClientCache::Lookup lookup;
+    if (cached) {
+        lookup = cache_->lookup(key);
+        if (lookup.hit) {
+            return lookup.value;
+        }
+    }
     try {
-        auto val = redis_->get(key);
+        auto val = borrow()->get(key);
+        std::optional<std::string> result;
         if (val) {
-            return *val;
+            result = *val;
         }
-        return std::nullopt;
+        if (cached) {
+            cache_->fill(key, result, lookup.fill_token);
+        }
+        return result;
     }
     catch (const sw::redis::Error&) {
         return std::nullopt;
@@ -94,9 +430,10 @@ std::optional<std::string> RedisClient::get(const std::string& key) {
 }
 
 int RedisClient::del(const std::string& key) {
-    if (!redis_) return 0;
+    if (!pool_) return 0;
+    WriteInvalidation written(cache_.get(), key);
     try {
-        return static_cast<int>(redis_->del(key));
+        return static_cast<int>(borrow()->del(key));
     }
     catch (const sw::redis::Error&) {
         return 0;
@@ -104,9 +441,9 @@ int RedisClient::del(const std::string& key) {
 }
 
 bool RedisClient::exists(const std::string& key) {
-    if (!redis_) return false;
+    if (!pool_) return false;
     try {
-        return redis_->exists(key) > 0;
+        return borrow()->exists(key) > 0;
     }
     catch (const sw::redis::Error&) {
         return false;
@@ -114,9 +451,10 @@ bool RedisClient::exists(const std::string& key) {
 }
 
 bool RedisClient::expire(const std::string& key, int seconds) {
-    if (!redis_) return false;
+    if (!pool_) return false;
+    WriteInvalidation written(cache_.get(), key);
     try {
-        return redis_->expire(key, std::chrono::seconds(seconds));
+        return borrow()->expire(key, std::chrono::seconds(seconds));
     }
     catch (const sw::redis::Error&) {
         return false;
@@ -124,10 +462,10 @@ bool RedisClient::expire(const std::string& key, int seconds) {
 }
 
 int RedisClient::ttl(const std::string& key) {
-    if (!redis_) return -2;
+    if (!pool_) return -2;
     try {
         // redis++: ttl() returns long long (seconds)
-        long long ttl_seconds = redis_->ttl(key);
+        long long ttl_seconds = borrow()->ttl(key);
         return static_cast<int>(ttl_seconds);
     }
     catch (const sw::redis::Error&) {
@@ -138,9 +476,9 @@ int RedisClient::ttl(const std::string& key) {
 // ========== List Operations ==========
 
 long long RedisClient::lpush(const std::string& key, const std::string& value) {
-    if (!redis_) return 0;
+    if (!pool_) return 0;
     try {
-        return redis_->lpush(key, value);
+        return borrow()->lpush(key, value);
     }
     catch (const sw::redis::Error&) {
         return 0;
@@ -148,9 +486,9 @@ long long RedisClient::lpush(const std::string& key, const std::string& value) {
 }
 
 std::optional<std::string> RedisClient::rpop(const std::string& key) {
-    if (!redis_) return std::nullopt;
+    if (!pool_) return std::nullopt;
     try {
-        auto val = redis_->rpop(key);
+        auto val = borrow()->rpop(key);
         if (val) {
             return *val;
         }
@@ -162,18 +500,18 @@ std::optional<std::string> RedisClient::rpop(const std::string& key) {
 }
 
 std::optional<std::string> RedisClient::brpop(const std::string& key, int timeout_seconds) {
-    if (!redis_) return std::nullopt;
+    if (!pool_) return std::nullopt;
     try {
         std::pair<std::string, std::string> result;
         if (timeout_seconds > 0) {
             auto timeout = std::chrono::seconds(timeout_seconds);
-            auto val = redis_->brpop(key, timeout);
+            auto val = borrow()->brpop(key, timeout);
             if (val) {
                 return val->second;  // Return value, not key
             }
         } else {
             // Block indefinitely
-            auto val = redis_->brpop(key, std::chrono::seconds(0));
+            auto val = borrow()->brpop(key, std::chrono::seconds(0));
             if (val) {
                 return val->second;
             }
@@ -185,10 +523,63 @@ std::optional<std::string> RedisClient::brpop(const std::string& key, int timeou
     }
 }
 
+long long RedisClient::lpush_many(const std::string& key, const std::vector<std::string>& values) {
+    if (!pool_ || values.empty()) return 0;
+    try {
+        return borrow()->lpush(key, values.begin(), values.end());
+    }
+    catch (const sw::redis::Error&) {
+        return 0;
+    }
+}
+
+std::vector<std::string> RedisClient::rpop_count(const std::string& key, long long count) {
+    if (!pool_ || count <= 0) return {};
+    try {
+        // RPOP key count replies nil (not an empty array) when the list is empty
+        auto val = borrow()->command<std::optional<std::vector<std::string>>>(
+            "RPOP", key, std::to_string(count));
+        if (val) {
+            return std::move(*val);
+        }
+        return {};
+    }
+    catch (const sw::redis::Error&) {
+        return {};
+    }
+}
+
+std::vector<std::string> RedisClient::brpop_batch(const std::string& key, long long max_count,
+                                                  int timeout_seconds) {
+    if (!pool_ || max_count <= 0) return {};
+
+    std::vector<std::string> result;
+    try {
+        auto timeout = std::chrono::seconds(timeout_seconds > 0 ? timeout_seconds : 0);
+        auto val = borrow()->brpop(key, timeout);
+        if (!val) {
+            return {};
+        }
+        result.push_back(std::move(val->second));
+    }
+    catch (const sw::redis::Error&) {
+        return {};
+    }
+
+    // Drain whatever else is already queued; keep the blocking pop on failure
+    if (max_count > 1) {
+        auto rest = rpop_count(key, max_count - 1);
+        result.insert(result.end(),
+                      std::make_move_iterator(rest.begin()),
+                      std::make_move_iterator(rest.end()));
+    }
+    return result;
+}
+
 long long RedisClient::llen(const std::string& key) {
-    if (!redis_) return 0;
+    if (!pool_) return 0;
     try {
-        return redis_->llen(key);
+        return borrow()->llen(key);
     }
     catch (const sw::redis::Error&) {
         return 0;
@@ -196,10 +587,10 @@ long long RedisClient::llen(const std::string& key) {
 }
 
 std::vector<std::string> RedisClient::lrange(const std::string& key, long long start, long long stop) {
-    if (!redis_) return {};
+    if (!pool_) return {};
     try {
         std::vector<std::string> result;
-        redis_->lrange(key, start, stop, std::back_inserter(result));
+        borrow()->lrange(key, start, stop, std::back_inserter(result));
         return result;
     }
     catch (const sw::redis::Error&) {
@@ -210,9 +601,9 @@ std::vector<std::string> RedisClient::lrange(const std::string& key, long long s
 // ========== Set Operations ==========
 
 long long RedisClient::sadd(const std::string& key, const std::string& member) {
-    if (!redis_) return 0;
+    if (!pool_) return 0;
     try {
-        return redis_->sadd(key, member);
+        return borrow()->sadd(key, member);
     }
     catch (const sw::redis::Error&) {
         return 0;
@@ -220,9 +611,9 @@ long long RedisClient::sadd(const std::string& key, const std::string& member) {
 }
 
 bool RedisClient::sismember(const std::string& key, const std::string& member) {
-    if (!redis_) return false;
+    if (!pool_) return false;
     try {
-        return redis_->sismember(key, member);
+        return borrow()->sismember(key, member);
     }
     catch (const sw::redis::Error&) {
         return false;
@@ -230,9 +621,9 @@ bool RedisClient::sismember(const std::string& key, const std::string& member) {
 }
 
 long long RedisClient::srem(const std::string& key, const std::string& member) {
-    if (!redis_) return 0;
+    if (!pool_) return 0;
     try {
-        return redis_->srem(key, member);
+        return borrow()->srem(key, member);
     }
     catch (const sw::redis::Error&) {
         return 0;
@@ -242,9 +633,9 @@ long long RedisClient::srem(const std::string& key, const std::string& member) {
 // ========== Sorted Set Operations ==========
 
 long long RedisClient::zadd(const std::string& key, const std::string& member, double score) {
-    if (!redis_) return 0;
+    if (!pool_) return 0;
     try {
-        return redis_->zadd(key, member, score);
+        return borrow()->zadd(key, member, score);
     }
     catch (const sw::redis::Error&) {
         return 0;
@@ -252,10 +643,10 @@ long long RedisClient::zadd(const std::string& key, const std::string& member, d
 }
 
 std::optional<std::string> RedisClient::zpopmax(const std::string& key) {
-    if (!redis_) return std::nullopt;
+    if (!pool_) return std::nullopt;
     try {
         std::pair<std::string, double> result;
-        auto val = redis_->zpopmax(key);
+        auto val = borrow()->zpopmax(key);
         if (val) {
             return val->first;  // Return member, not score
         }
@@ -267,9 +658,143 @@ std::optional<std::string> RedisClient::zpopmax(const std::string& key) {
 }
 
 long long RedisClient::zcard(const std::string& key) {
-    if (!redis_) return 0;
+    if (!pool_) return 0;
+    try {
+        return borrow()->zcard(key);
+    }
+    catch (const sw::redis::Error&) {
+        return 0;
+    }
+}
+
+// ========== Stream Operations ==========
+
+std::string RedisClient::xadd(const std::string& key, const StreamFields& fields, long long maxlen) {
+    if (!pool_ || fields.empty()) return "";
+    try {
+        if (maxlen > 0) {
+            return borrow()->xadd(key, "*", fields.begin(), fields.end(), maxlen, true);
+        }
+        return borrow()->xadd(key, "*", fields.begin(), fields.end());
+    }
+    catch (const sw::redis::Error&) {
+        return "";
+    }
+}
+
+std::vector<std::string> RedisClient::xadd_many(const std::string& key,
+                                                const std::vector<StreamFields>& entries,
+                                                long long maxlen) {
+    if (!pool_ || entries.empty()) return {};
+    try {
+        auto pipe = pipeline();
+        for (const auto& fields : entries) {
+            pipe.command(xadd_args(key, fields, maxlen));
+        }
+        std::vector<std::string> ids;
+        ids.reserve(entries.size());
+        for (auto& reply : pipe.exec()) {
+            if (auto* id = std::get_if<std::string>(&reply)) {
+                ids.push_back(std::move(*id));
+            }
+        }
+        return ids;
+    }
+    catch (const std::runtime_error&) {
+        return {};
+    }
+}
+
+bool RedisClient::xgroup_create(const std::string& key, const std::string& group,
+                                const std::string& start_id) {
+    if (!pool_) return false;
+    try {
+        borrow()->xgroup_create(key, group, start_id, true);
+        return true;
+    }
+    catch (const sw::redis::ReplyError& e) {
+        // BUSYGROUP: group already exists, which is what the caller wants
+        return std::string(e.what()).find("BUSYGROUP") != std::string::npos;
+    }
+    catch (const sw::redis::Error&) {
+        return false;
+    }
+}
+
+std::vector<StreamEntry> RedisClient::xreadgroup(const std::string& key, const std::string& group,
+                                                 const std::string& consumer, long long count,
+                                                 int block_ms) {
+    if (!pool_ || count <= 0) return {};
+    try {
+        std::vector<std::string> args = {
+            "XREADGROUP", "GROUP", group, consumer, "COUNT", std::to_string(count)
+        };
+        if (block_ms > 0) {
+            args.emplace_back("BLOCK");
+            args.push_back(std::to_string(block_ms));
+        }
+        args.emplace_back("STREAMS");
+        args.push_back(key);
+        args.emplace_back(">");  // Only entries never delivered to this group
+
+        // Reply: [[key, [entry, ...]]], or nil on timeout
+        auto reply = borrow()->command(args.begin(), args.end());
+        if (!reply || reply->type != REDIS_REPLY_ARRAY || reply->elements == 0) {
+            return {};
+        }
+        const redisReply* stream = reply->element[0];
+        if (stream->type != REDIS_REPLY_ARRAY || stream->elements < 2) {
+            return {};
+        }
+        return to_stream_entries(*stream->element[1]);
+    }
+    catch (const sw::redis::Error&) {
+        return {};
+    }
+}
+
+long long RedisClient::xack(const std::string& key, const std::string& group,
+                            const std::vector<std::string>& ids) {
+    if (!pool_ || ids.empty()) return 0;
     try {
-        return redis_->zcard(key);
+        return borrow()->xack(key, group, ids.begin(), ids.end());
+    }
+    catch (const sw::redis::Error&) {
+        return 0;
+    }
+}
+
+std::vector<StreamEntry> RedisClient::xautoclaim(const std::string& key, const std::string& group,
+                                                 const std::string& consumer, long long min_idle_ms,
+                                                 long long count, std::string& cursor) {
+    if (!pool_ || count <= 0) return {};
+    try {
+        const std::string start = cursor.empty() ? "0-0" : cursor;
+        std::vector<std::string> args = {
+            "XAUTOCLAIM", key, group, consumer, std::to_string(min_idle_ms), start,
+            "COUNT", std::to_string(count)
+        };
+
+        // Reply: [next-cursor, [entry, ...], (Redis 7+) [deleted-id, ...]]
+        auto reply = borrow()->command(args.begin(), args.end());
+        if (!reply || reply->type != REDIS_REPLY_ARRAY || reply->elements < 2) {
+            return {};
+        }
+        const redisReply* next = reply->element[0];
+        if (next->str) {
+            cursor.assign(next->str, next->len);
+        }
+        return to_stream_entries(*reply->element[1]);
+    }
+    catch (const sw::redis::Error&) {
+        return {};
+    }
+}
+
+long long RedisClient::xlen(const std::string& key) {
+    if (!pool_) return 0;
+    try {
+        return borrow()->xlen(key);
     }
     catch (const sw::redis::Error&) {
         return 0;
@@ -279,9 +804,10 @@ long long RedisClient::zcard(const std::string& key) {
 // ========== Atomic Operations ==========
 
 long long RedisClient::incr(const std::string& key) {
-    if (!redis_) return 0;
+    if (!pool_) return 0;
+    WriteInvalidation written(cache_.get(), key);
     try {
-        return redis_->incr(key);
+        return borrow()->incr(key);
     }
     catch (const sw::redis::Error&) {
         return 0;
@@ -289,25 +815,267 @@ long long RedisClient::incr(const std::string& key) {
 }
 
 long long RedisClient::decr(const std::string& key) {
-    if (!redis_) return 0;
+    if (!pool_) return 0;
+    WriteInvalidation written(cache_.get(), key);
     try {
-        return redis_->decr(key);
+        return borrow()->decr(key);
     }
     catch (const sw::redis::Error&) {
         return 0;
     }
 }
 
+// ========== Batch Operations (Pipelining) ==========
+
+struct RedisClient::Pipeline::Impl {
+    // Declared first: given back to the pool only after pipe/tx are gone
+    ConnectionPool<sw::redis::Redis>::Lease conn;
+    // Exactly one of these is engaged
+    std::optional<sw::redis::Pipeline> pipe;
+    std::optional<sw::redis::Transaction> tx;
+    size_t queued = 0;
+    bool failed = false;  // A queueing error poisons the batch until exec()/discard()
+    ClientCache* cache = nullptr;
+    std::vector<std::string> written;  // Cached keys to invalidate once the batch is sent
+
+    void wrote(const std::string& key) {
+        if (cache && cache->cacheable(key)) {
+            written.push_back(key);
+        }
+    }
+
+    void invalidate_written() {
+        if (cache) {
+            cache->invalidate(written);
+        }
+        written.clear();
+    }
+
+    template <typename Fn>
+    void queue(Fn&& fn) {
+        if (failed) return;
+        try {
+            if (tx) {
+                fn(*tx);
+            } else {
+                fn(*pipe);
+            }
+            ++queued;
+        }
+        catch (const sw::redis::Error&) {
+            failed = true;
+        }
+    }
+};
+
+RedisClient::Pipeline::Pipeline(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl))
+{
+}
+
+RedisClient::Pipeline::~Pipeline() = default;
+RedisClient::Pipeline::Pipeline(Pipeline&&) noexcept = default;
+RedisClient::Pipeline& RedisClient::Pipeline::operator=(Pipeline&&) noexcept = default;
+
+RedisClient::Pipeline& RedisClient::Pipeline::set(const std::string& key, const std::string& value,
+                                                  int ttl_seconds) {
+    impl_->queue([&](auto& q) {
+        if (ttl_seconds > 0) {
+            q.set(key, value, std::chrono::seconds(ttl_seconds));
+        } else {
+            q.set(key, value);
+        }
+    });
+    impl_->wrote(key);
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::get(const std::string& key) {
+    impl_->queue([&](auto& q) { q.get(key); });
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::del(const std::string& key) {
+    impl_->queue([&](auto& q) { q.del(key); });
+    impl_->wrote(key);
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::expire(const std::string& key, int seconds) {
+    impl_->queue([&](auto& q) { q.expire(key, std::chrono::seconds(seconds)); });
+    impl_->wrote(key);
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::lpush(const std::string& key, const std::string& value) {
+    impl_->queue([&](auto& q) { q.lpush(key, value); });
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::lpush_many(const std::string& key,
+                                                         const std::vector<std::string>& values) {
+    if (values.empty()) return *this;
+    impl_->queue([&](auto& q) { q.lpush(key, values.begin(), values.end()); });
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::rpop(const std::string& key) {
+    impl_->queue([&](auto& q) { q.rpop(key); });
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::rpop_count(const std::string& key, long long count) {
+    impl_->queue([&](auto& q) { q.command("RPOP", key, std::to_string(count)); });
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::llen(const std::string& key) {
+    impl_->queue([&](auto& q) { q.llen(key); });
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::sadd(const std::string& key, const std::string& member) {
+    impl_->queue([&](auto& q) { q.sadd(key, member); });
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::srem(const std::string& key, const std::string& member) {
+    impl_->queue([&](auto& q) { q.srem(key, member); });
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::zadd(const std::string& key, const std::string& member,
+                                                   double score) {
+    impl_->queue([&](auto& q) { q.zadd(key, member, score); });
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::incr(const std::string& key) {
+    impl_->queue([&](auto& q) { q.incr(key); });
+    impl_->wrote(key);
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::decr(const std::string& key) {
+    impl_->queue([&](auto& q) { q.decr(key); });
+    impl_->wrote(key);
+    return *this;
+}
+
+RedisClient::Pipeline& RedisClient::Pipeline::command(const std::vector<std::string>& args) {
+    if (args.empty()) return *this;
+    impl_->queue([&](auto& q) { q.command(args.begin(), args.end()); });
+    return *this;
+}
+
+size_t RedisClient::Pipeline::size() const {
+    return impl_ ? impl_->queued : 0;
+}
+
+std::vector<RedisClient::Reply> RedisClient::Pipeline::exec() {
+    if (!impl_) return {};
+    if (impl_->failed) {
+        discard();
+        return {};
+    }
+
+    std::vector<Reply> result;
+    try {
+        auto replies = impl_->tx ? impl_->tx->exec() : impl_->pipe->exec();
+        result.reserve(replies.size());
+        for (size_t i = 0; i < replies.size(); ++i) {
+            result.push_back(to_reply(replies.get(i)));
+        }
+    }
+    catch (const sw::redis::Error&) {
+        result.clear();
+    }
+    impl_->queued = 0;
+    impl_->invalidate_written();
+    return result;
+}
+
+void RedisClient::Pipeline::discard() {
+    if (!impl_) return;
+    try {
+        if (impl_->tx) {
+            impl_->tx->discard();
+        } else {
+            impl_->pipe->discard();
+        }
+    }
+    catch (const sw::redis::Error&) {
+        // Nothing was sent, nothing to undo
+    }
+    impl_->queued = 0;
+    impl_->failed = false;
+    impl_->written.clear();
+}
+
+RedisClient::Pipeline RedisClient::pipeline() {
+    if (!pool_) {
+        throw std::runtime_error("Redis client is not connected");
+    }
+    try {
+        auto impl = std::make_unique<Pipeline::Impl>();
+        // Borrow a pooled connection instead of opening a new one per batch
+        impl->conn = borrow();
+        impl->cache = cache_.get();
+        impl->pipe.emplace(impl->conn->pipeline(false));
+        return Pipeline(std::move(impl));
+    }
+    catch (const sw::redis::Error& e) {
+        std::ostringstream oss;
+        oss << "Redis pipeline error: " << e.what();
+        throw std::runtime_error(oss.str());
+    }
+}
+
+RedisClient::Pipeline RedisClient::transaction() {
+    if (!pool_) {
+        throw std::runtime_error("Redis client is not connected");
+    }
+    try {
+        auto impl = std::make_unique<Pipeline::Impl>();
+        impl->conn = borrow();
+        impl->cache = cache_.get();
+        // piped = true: MULTI, commands and EXEC go out in a single round trip
+        impl->tx.emplace(impl->conn->transaction(true, false));
+        return Pipeline(std::move(impl));
+    }
+    catch (const sw::redis::Error& e) {
+        std::ostringstream oss;
+        oss << "Redis transaction error: " << e.what();
+        throw std::runtime_error(oss.str());
+    }
+}
+
 // ========== Statistics & Debugging ==========
 
 std::string RedisClient::info() {
-    if (!redis_) return "";
+    if (!pool_) return "";
     try {
-        return redis_->info();
+        return borrow()->info();
     }
     catch (const sw::redis::Error&) {
         return "";
     }
 }
 
+PoolStats RedisClient::pool_stats() const {
+    return pool_ ? pool_->stats() : PoolStats{};
+}
+
+std::string RedisClient::pool_metrics() const {
+    return pool_stats().to_json();
+}
+
+ClientCacheStats RedisClient::cache_stats() const {
+    return cache_ ? cache_->stats() : ClientCacheStats{};
+}
+
+std::string RedisClient::cache_metrics() const {
+    return cache_stats().to_json();
+}
+
 } // namespace telemetry_common
@@ -0,0 +1,2866 @@
+#include "telemetry_common/redis_standin.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <map>
+#include <optional>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+namespace telemetry_common {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Args = std::vector<std::string>;
+
+constexpr size_t kReadChunk = 16 * 1024;
+constexpr long long kMaxBulkLength = 512LL * 1024 * 1024;
+constexpr long long kMaxMultibulkLength = 1024 * 1024;
+
+// ========== RESP Encoding ==========
+
+void reply_status(std::string& out, const char* status) {
+    out += '+';
+    out += status;
+    out += "\r\n";
+}
+
+void reply_error(std::string& out, const std::string& message) {
+    out += '-';
+    out += message;
+    out += "\r\n";
+}
+
+void reply_int(std::string& out, long long value) {
+    out += ':';
+    out += std::to_string(value);
+    out += "\r\n";
+}
+
+void reply_bulk(std::string& out, const std::string& value) {
+    out += '$';
+    out += std::to_string(value.size());
+    out += "\r\n";
+    out += value;
+    out += "\r\n";
+}
+
+void reply_array(std::string& out, size_t size) {
+    out += '*';
+    out += std::to_string(size);
+    out += "\r\n";
+}
+
+constexpr const char* kNilBulk = "$-1\r\n";
+constexpr const char* kNilArray = "*-1\r\n";
+
+// ========== Argument Parsing ==========
+
+std::string to_upper(std::string s) {
+    for (auto& ch : s) {
+        ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+    }
+    return s;
+}
+
+std::string to_lower(std::string s) {
+    for (auto& ch : s) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    return s;
+}
+
+bool iequals(const std::string& a, const char* b) {
+    return ::strcasecmp(a.c_str(), b) == 0;
+}
+
+bool parse_ll(const std::string& s, long long& value) {
+    if (s.empty() || s.size() > 20) {
+        return false;
+    }
+    errno = 0;
+    char* end = nullptr;
+    value = std::strtoll(s.c_str(), &end, 10);
+    return errno == 0 && end == s.c_str() + s.size();
+}
+
+bool parse_double(const std::string& s, double& value) {
+    if (iequals(s, "+inf") || iequals(s, "inf")) {
+        value = std::numeric_limits<double>::infinity();
+        return true;
+    }
+    if (iequals(s, "-inf")) {
+        value = -std::numeric_limits<double>::infinity();
+        return true;
+    }
+    if (s.empty()) {
+        return false;
+    }
+    errno = 0;
+    char* end = nullptr;
+    value = std::strtod(s.c_str(), &end);
+    return errno == 0 && end == s.c_str() + s.size() && !std::isnan(value);
+}
+
+std::string format_double(double value) {
+    if (std::isinf(value)) {
+        return value > 0 ? "inf" : "-inf";
+    }
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%.17g", value);
+    return buf;
+}
+
+// Score range endpoint: "1.5", "(1.5" (exclusive), "-inf", "+inf"
+struct ScoreBound {
+    double value = 0;
+    bool exclusive = false;
+};
+
+bool parse_bound(const std::string& s, ScoreBound& bound) {
+    if (!s.empty() && s[0] == '(') {
+        bound.exclusive = true;
+        return parse_double(s.substr(1), bound.value);
+    }
+    bound.exclusive = false;
+    return parse_double(s, bound.value);
+}
+
+bool above_min(double score, const ScoreBound& min) {
+    return min.exclusive ? score > min.value : score >= min.value;
+}
+
+bool below_max(double score, const ScoreBound& max) {
+    return max.exclusive ? score < max.value : score <= max.value;
+}
+
+// Clamp Redis-style (possibly negative) inclusive indices; false if the range is empty
+bool normalize_range(long long start, long long stop, long long size, long long& from, long long& to) {
+    if (start < 0) start += size;
+    if (stop < 0) stop += size;
+    if (start < 0) start = 0;
+    if (start > stop || start >= size) {
+        return false;
+    }
+    if (stop >= size) stop = size - 1;
+    from = start;
+    to = stop;
+    return true;
+}
+
+// ========== Data Types ==========
+
+using List = std::deque<std::string>;
+using Set = std::unordered_set<std::string>;
+using Hash = std::unordered_map<std::string, std::string>;
+
+struct ZSet {
+    std::set<std::pair<double, std::string>> ordered;  ///< Score order (ties by member)
+    std::unordered_map<std::string, double> scores;    ///< O(1) ZSCORE
+
+    bool empty() const { return scores.empty(); }
+
+    /// @return true if the member is new
+    bool insert(const std::string& member, double score) {
+        auto it = scores.find(member);
+        if (it != scores.end()) {
+            ordered.erase({it->second, member});
+            it->second = score;
+            ordered.emplace(score, member);
+            return false;
+        }
+        scores.emplace(member, score);
+        ordered.emplace(score, member);
+        return true;
+    }
+
+    bool erase(const std::string& member) {
+        auto it = scores.find(member);
+        if (it == scores.end()) {
+            return false;
+        }
+        ordered.erase({it->second, member});
+        scores.erase(it);
+        return true;
+    }
+};
+
+struct StreamId {
+    uint64_t ms = 0;
+    uint64_t seq = 0;
+
+    bool operator<(const StreamId& other) const {
+        return ms != other.ms ? ms < other.ms : seq < other.seq;
+    }
+    bool operator==(const StreamId& other) const { return ms == other.ms && seq == other.seq; }
+    bool operator<=(const StreamId& other) const { return !(other < *this); }
+
+    std::string str() const { return std::to_string(ms) + "-" + std::to_string(seq); }
+};
+
+constexpr StreamId kMaxStreamId{std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::max()};
+
+// "ms-seq", "ms" (seq = missing_seq), "-" (minimum), "+" (maximum)
+bool parse_stream_id(const std::string& s, StreamId& id, uint64_t missing_seq = 0) {
+    if (s == "-") {
+        id = StreamId{};
+        return true;
+    }
+    if (s == "+") {
+        id = kMaxStreamId;
+        return true;
+    }
+    auto dash = s.find('-');
+    std::string ms_part = s.substr(0, dash);
+    if (ms_part.empty() || ms_part.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    errno = 0;
+    id.ms = std::strtoull(ms_part.c_str(), nullptr, 10);
+    if (errno != 0) {
+        return false;
+    }
+    if (dash == std::string::npos) {
+        id.seq = missing_seq;
+        return true;
+    }
+    std::string seq_part = s.substr(dash + 1);
+    if (seq_part.empty() || seq_part.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    id.seq = std::strtoull(seq_part.c_str(), nullptr, 10);
+    return errno == 0;
+}
+
+using Fields = std::vector<std::string>;  ///< Flat field, value, field, value...
+
+struct PendingEntry {
+    std::string consumer;
+    Clock::time_point delivered;
+    uint64_t deliveries = 1;
+};
+
+struct ConsumerGroup {
+    StreamId last_delivered;
+    std::map<StreamId, PendingEntry> pending;  ///< Pending entries list (PEL)
+    std::set<std::string> consumers;
+};
+
+struct Stream {
+    std::map<StreamId, Fields> entries;
+    StreamId last_id;
+    std::map<std::string, ConsumerGroup> groups;
+
+    StreamId next_id() const {
+        auto now_ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        if (now_ms > last_id.ms) {
+            return StreamId{now_ms, 0};
+        }
+        return StreamId{last_id.ms, last_id.seq + 1};
+    }
+
+    size_t trim(size_t maxlen) {
+        size_t removed = 0;
+        while (entries.size() > maxlen) {
+            entries.erase(entries.begin());
+            ++removed;
+        }
+        return removed;
+    }
+};
+
+using Value = std::variant<std::string, List, Set, ZSet, Hash, Stream>;
+
+const char* type_name(const Value& value) {
+    static const char* names[] = {"string", "list", "set", "zset", "hash", "stream"};
+    return names[value.index()];
+}
+
+struct Entry {
+    Value value;
+    std::optional<Clock::time_point> expires;
+};
+
+void reply_stream_entry(std::string& out, const StreamId& id, const Fields* fields) {
+    reply_array(out, 2);
+    reply_bulk(out, id.str());
+    if (!fields) {
+        out += kNilArray;  // Entry was deleted/trimmed while pending
+        return;
+    }
+    reply_array(out, fields->size());
+    for (const auto& field : *fields) {
+        reply_bulk(out, field);
+    }
+}
+
+// ========== Connections ==========
+
+enum class Outcome { Replied, Blocked };
+enum class MoveResult { Moved, Empty, Error };
+
+struct Client {
+    int fd = -1;
+    long long id = 0;
+    std::string name;
+
+    std::string in;
+    size_t in_pos = 0;
+    std::string out;
+    size_t out_pos = 0;
+
+    bool closing = false;  ///< Close once output is flushed (QUIT, protocol error)
+    bool dead = false;     ///< Peer gone, close now
+
+    // MULTI/EXEC
+    bool in_multi = false;
+    bool multi_error = false;
+    bool exec_mode = false;  ///< Executing EXEC: blocking commands must not block
+    std::vector<Args> queued;
+
+    // Blocking commands
+    bool blocked = false;
+    Args blocked_args;
+    std::vector<std::string> blocked_keys;
+    std::optional<Clock::time_point> block_deadline;
+    const char* timeout_reply = kNilArray;
+
+    bool has_output() const { return out_pos < out.size(); }
+};
+
+bool set_nonblocking(int fd) {
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;  // SO_NOSIGPIPE set per socket instead (macOS)
+#endif
+
+void suppress_sigpipe(int fd) {
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#else
+    (void)fd;
+#endif
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+struct RedisStandin::Impl {
+    using Handler = Outcome (Impl::*)(Client&, const Args&, std::string&);
+
+    struct Command {
+        Handler handler;
+        int arity;  ///< > 0: exact argc, < 0: minimum argc (Redis convention)
+    };
+
+    explicit Impl(const Options& opts) : options(opts) { register_commands(); }
+
+    Options options;
+    int listen_fd = -1;
+    int wake_fds[2] = {-1, -1};
+    int bound_port = 0;
+    std::thread loop_thread;
+    std::atomic<bool> running{false};
+
+    std::atomic<uint64_t> connections_accepted{0};
+    std::atomic<uint64_t> commands_processed{0};
+    std::atomic<uint64_t> key_count{0};
+
+    // Everything below is touched only by the event loop thread
+    std::unordered_map<std::string, Command> commands;
+    std::unordered_map<int, std::unique_ptr<Client>> clients;
+    std::unordered_map<std::string, Entry> db;
+    std::list<int> blocked;                      ///< Blocked client fds, FIFO
+    std::unordered_set<std::string> ready_keys;  ///< Written keys someone may be blocked on
+    std::deque<int> resume;                      ///< Unblocked clients with input left to process
+    long long next_client_id = 1;
+
+    // ========== Lifecycle ==========
+
+    bool open_listener();
+    void close_listener();
+    void run_loop();
+
+    // ========== Event Loop ==========
+
+    void accept_clients();
+    void read_client(Client& c);
+    void flush_client(Client& c);
+    void close_client(int fd);
+    int next_timeout_ms() const;
+    void expire_blocked();
+    void resume_unblocked();
+
+    // ========== Command Processing ==========
+
+    int parse_command(Client& c, Args& args);
+    void process_input(Client& c);
+    void execute(Client& c, const Args& args);
+    Outcome run(Client& c, const Args& args, std::string& out);
+    Outcome block_on(Client& c, const Args& args, std::vector<std::string> keys,
+                     double timeout_seconds, const char* timeout_reply, std::string& out);
+    void unblock(Client& c);
+    void serve_blocked();
+    void signal_ready(const std::string& key) {
+        if (!blocked.empty()) {
+            ready_keys.insert(key);
+        }
+    }
+
+    // ========== Keyspace ==========
+
+    Entry* find(const std::string& key) {
+        auto it = db.find(key);
+        if (it == db.end()) {
+            return nullptr;
+        }
+        if (it->second.expires && *it->second.expires <= Clock::now()) {
+            db.erase(it);
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    template <typename T>
+    T* lookup(const std::string& key, bool& wrong_type) {
+        wrong_type = false;
+        Entry* entry = find(key);
+        if (!entry) {
+            return nullptr;
+        }
+        T* value = std::get_if<T>(&entry->value);
+        wrong_type = value == nullptr;
+        return value;
+    }
+
+    template <typename T>
+    T* lookup_or_create(const std::string& key, bool& wrong_type) {
+        T* value = lookup<T>(key, wrong_type);
+        if (value || wrong_type) {
+            return value;
+        }
+        Entry& entry = db[key];
+        entry.value = T{};
+        entry.expires.reset();
+        return &std::get<T>(entry.value);
+    }
+
+    // Redis deletes aggregate keys as soon as they become empty
+    template <typename T>
+    void drop_if_empty(const std::string& key, const T& value) {
+        if (value.empty()) {
+            db.erase(key);
+        }
+    }
+
+    void purge_expired() {
+        auto now = Clock::now();
+        for (auto it = db.begin(); it != db.end();) {
+            if (it->second.expires && *it->second.expires <= now) {
+                it = db.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    static Outcome wrong_type(std::string& out) {
+        reply_error(out, "WRONGTYPE Operation against a key holding the wrong kind of value");
+        return Outcome::Replied;
+    }
+
+    static Outcome error(std::string& out, const std::string& message) {
+        reply_error(out, message);
+        return Outcome::Replied;
+    }
+
+    static Outcome not_integer(std::string& out) {
+        return error(out, "ERR value is not an integer or out of range");
+    }
+
+    static Outcome syntax_error(std::string& out) {
+        return error(out, "ERR syntax error");
+    }
+
+    void register_commands();
+
+    // ========== Connection / Server Commands ==========
+    Outcome cmd_ping(Client&, const Args& args, std::string& out);
+    Outcome cmd_echo(Client&, const Args& args, std::string& out);
+    Outcome cmd_ok(Client&, const Args& args, std::string& out);
+    Outcome cmd_quit(Client& c, const Args& args, std::string& out);
+    Outcome cmd_client(Client& c, const Args& args, std::string& out);
+    Outcome cmd_command(Client&, const Args& args, std::string& out);
+    Outcome cmd_info(Client&, const Args& args, std::string& out);
+    Outcome cmd_dbsize(Client&, const Args& args, std::string& out);
+    Outcome cmd_flushall(Client&, const Args& args, std::string& out);
+    Outcome cmd_multi(Client& c, const Args& args, std::string& out);
+    Outcome cmd_exec(Client& c, const Args& args, std::string& out);
+    Outcome cmd_discard(Client& c, const Args& args, std::string& out);
+
+    // ========== Key Commands ==========
+    Outcome cmd_del(Client&, const Args& args, std::string& out);
+    Outcome cmd_exists(Client&, const Args& args, std::string& out);
+    Outcome cmd_expire(Client&, const Args& args, std::string& out);
+    Outcome cmd_ttl(Client&, const Args& args, std::string& out);
+    Outcome cmd_persist(Client&, const Args& args, std::string& out);
+    Outcome cmd_type(Client&, const Args& args, std::string& out);
+    Outcome cmd_keys(Client&, const Args& args, std::string& out);
+
+    // ========== String Commands ==========
+    Outcome cmd_set(Client&, const Args& args, std::string& out);
+    Outcome cmd_setex(Client&, const Args& args, std::string& out);
+    Outcome cmd_get(Client&, const Args& args, std::string& out);
+    Outcome cmd_mget(Client&, const Args& args, std::string& out);
+    Outcome cmd_incrby(Client&, const Args& args, std::string& out);
+
+    // ========== List Commands ==========
+    Outcome cmd_push(Client&, const Args& args, std::string& out);
+    Outcome cmd_pop(Client&, const Args& args, std::string& out);
+    Outcome cmd_llen(Client&, const Args& args, std::string& out);
+    Outcome cmd_lrange(Client&, const Args& args, std::string& out);
+    Outcome cmd_lindex(Client&, const Args& args, std::string& out);
+    Outcome cmd_lrem(Client&, const Args& args, std::string& out);
+    Outcome cmd_lmove(Client& c, const Args& args, std::string& out);
+    Outcome cmd_bpop(Client& c, const Args& args, std::string& out);
+    MoveResult move_element(const std::string& src, const std::string& dst, bool from_left, bool to_left,
+                            std::string& out);
+
+    // ========== Set Commands ==========
+    Outcome cmd_sadd(Client&, const Args& args, std::string& out);
+    Outcome cmd_srem(Client&, const Args& args, std::string& out);
+    Outcome cmd_sismember(Client&, const Args& args, std::string& out);
+    Outcome cmd_scard(Client&, const Args& args, std::string& out);
+    Outcome cmd_smembers(Client&, const Args& args, std::string& out);
+
+    // ========== Sorted Set Commands ==========
+    Outcome cmd_zadd(Client&, const Args& args, std::string& out);
+    Outcome cmd_zincrby(Client&, const Args& args, std::string& out);
+    Outcome cmd_zrem(Client&, const Args& args, std::string& out);
+    Outcome cmd_zcard(Client&, const Args& args, std::string& out);
+    Outcome cmd_zscore(Client&, const Args& args, std::string& out);
+    Outcome cmd_zrange(Client&, const Args& args, std::string& out);
+    Outcome cmd_zrangebyscore(Client&, const Args& args, std::string& out);
+    Outcome cmd_zcount(Client&, const Args& args, std::string& out);
+    Outcome cmd_zremrangebyscore(Client&, const Args& args, std::string& out);
+    Outcome cmd_zpop(Client&, const Args& args, std::string& out);
+
+    // ========== Hash Commands ==========
+    Outcome cmd_hset(Client&, const Args& args, std::string& out);
+    Outcome cmd_hget(Client&, const Args& args, std::string& out);
+    Outcome cmd_hdel(Client&, const Args& args, std::string& out);
+    Outcome cmd_hgetall(Client&, const Args& args, std::string& out);
+    Outcome cmd_hlen(Client&, const Args& args, std::string& out);
+    Outcome cmd_hincrby(Client&, const Args& args, std::string& out);
+
+    // ========== Stream Commands ==========
+    Outcome cmd_xadd(Client&, const Args& args, std::string& out);
+    Outcome cmd_xlen(Client&, const Args& args, std::string& out);
+    Outcome cmd_xrange(Client&, const Args& args, std::string& out);
+    Outcome cmd_xdel(Client&, const Args& args, std::string& out);
+    Outcome cmd_xtrim(Client&, const Args& args, std::string& out);
+    Outcome cmd_xgroup(Client&, const Args& args, std::string& out);
+    Outcome cmd_xreadgroup(Client& c, const Args& args, std::string& out);
+    Outcome cmd_xack(Client&, const Args& args, std::string& out);
+    Outcome cmd_xpending(Client&, const Args& args, std::string& out);
+    Outcome cmd_xautoclaim(Client&, const Args& args, std::string& out);
+};
+
+void RedisStandin::Impl::register_commands() {
+    commands = {
+        // Connection / server
+        {"PING", {&Impl::cmd_ping, -1}},
+        {"ECHO", {&Impl::cmd_echo, 2}},
+        {"AUTH", {&Impl::cmd_ok, -2}},
+        {"SELECT", {&Impl::cmd_ok, 2}},
+        {"QUIT", {&Impl::cmd_quit, -1}},
+        {"CLIENT", {&Impl::cmd_client, -2}},
+        {"COMMAND", {&Impl::cmd_command, -1}},
+        {"INFO", {&Impl::cmd_info, -1}},
+        {"DBSIZE", {&Impl::cmd_dbsize, 1}},
+        {"FLUSHALL", {&Impl::cmd_flushall, -1}},
+        {"FLUSHDB", {&Impl::cmd_flushall, -1}},
+        {"MULTI", {&Impl::cmd_multi, 1}},
+        {"EXEC", {&Impl::cmd_exec, 1}},
+        {"DISCARD", {&Impl::cmd_discard, 1}},
+        // Keys
+        {"DEL", {&Impl::cmd_del, -2}},
+        {"UNLINK", {&Impl::cmd_del, -2}},
+        {"EXISTS", {&Impl::cmd_exists, -2}},
+        {"EXPIRE", {&Impl::cmd_expire, 3}},
+        {"PEXPIRE", {&Impl::cmd_expire, 3}},
+        {"TTL", {&Impl::cmd_ttl, 2}},
+        {"PTTL", {&Impl::cmd_ttl, 2}},
+        {"PERSIST", {&Impl::cmd_persist, 2}},
+        {"TYPE", {&Impl::cmd_type, 2}},
+        {"KEYS", {&Impl::cmd_keys, 2}},
+        // Strings
+        {"SET", {&Impl::cmd_set, -3}},
+        {"SETEX", {&Impl::cmd_setex, 4}},
+        {"GET", {&Impl::cmd_get, 2}},
+        {"MGET", {&Impl::cmd_mget, -2}},
+        {"INCR", {&Impl::cmd_incrby, 2}},
+        {"DECR", {&Impl::cmd_incrby, 2}},
+        {"INCRBY", {&Impl::cmd_incrby, 3}},
+        {"DECRBY", {&Impl::cmd_incrby, 3}},
+        // Lists
+        {"LPUSH", {&Impl::cmd_push, -3}},
+        {"RPUSH", {&Impl::cmd_push, -3}},
+        {"LPOP", {&Impl::cmd_pop, -2}},
+        {"RPOP", {&Impl::cmd_pop, -2}},
+        {"LLEN", {&Impl::cmd_llen, 2}},
+        {"LRANGE", {&Impl::cmd_lrange, 4}},
+        {"LINDEX", {&Impl::cmd_lindex, 3}},
+        {"LREM", {&Impl::cmd_lrem, 4}},
+        {"LMOVE", {&Impl::cmd_lmove, 5}},
+        {"RPOPLPUSH", {&Impl::cmd_lmove, 3}},
+        {"BLPOP", {&Impl::cmd_bpop, -3}},
+        {"BRPOP", {&Impl::cmd_bpop, -3}},
+        {"BLMOVE", {&Impl::cmd_lmove, 6}},
+        {"BRPOPLPUSH", {&Impl::cmd_lmove, 4}},
+        // Sets
+        {"SADD", {&Impl::cmd_sadd, -3}},
+        {"SREM", {&Impl::cmd_srem, -3}},
+        {"SISMEMBER", {&Impl::cmd_sismember, 3}},
+        {"SCARD", {&Impl::cmd_scard, 2}},
+        {"SMEMBERS", {&Impl::cmd_smembers, 2}},
+        // Sorted sets
+        {"ZADD", {&Impl::cmd_zadd, -4}},
+        {"ZINCRBY", {&Impl::cmd_zincrby, 4}},
+        {"ZREM", {&Impl::cmd_zrem, -3}},
+        {"ZCARD", {&Impl::cmd_zcard, 2}},
+        {"ZSCORE", {&Impl::cmd_zscore, 3}},
+        {"ZRANGE", {&Impl::cmd_zrange, -4}},
+        {"ZRANGEBYSCORE", {&Impl::cmd_zrangebyscore, -4}},
+        {"ZCOUNT", {&Impl::cmd_zcount, 4}},
+        {"ZREMRANGEBYSCORE", {&Impl::cmd_zremrangebyscore, 4}},
+        {"ZPOPMIN", {&Impl::cmd_zpop, -2}},
+        {"ZPOPMAX", {&Impl::cmd_zpop, -2}},
+        // Hashes
+        {"HSET", {&Impl::cmd_hset, -4}},
+        {"HGET", {&Impl::cmd_hget, 3}},
+        {"HDEL", {&Impl::cmd_hdel, -3}},
+        {"HGETALL", {&Impl::cmd_hgetall, 2}},
+        {"HLEN", {&Impl::cmd_hlen, 2}},
+        {"HINCRBY", {&Impl::cmd_hincrby, 4}},
+        // Streams
+        {"XADD", {&Impl::cmd_xadd, -5}},
+        {"XLEN", {&Impl::cmd_xlen, 2}},
+        {"XRANGE", {&Impl::cmd_xrange, -4}},
+        {"XDEL", {&Impl::cmd_xdel, -3}},
+        {"XTRIM", {&Impl::cmd_xtrim, -4}},
+        {"XGROUP", {&Impl::cmd_xgroup, -2}},
+        {"XREADGROUP", {&Impl::cmd_xreadgroup, -7}},
+        {"XACK", {&Impl::cmd_xack, -4}},
+        {"XPENDING", {&Impl::cmd_xpending, -3}},
+        {"XAUTOCLAIM", {&Impl::cmd_xautoclaim, -6}},
+    };
+}
+
+// ========== Lifecycle ==========
+
+bool RedisStandin::Impl::open_listener() {
+    if (!options.unix_path.empty()) {
+        sockaddr_un addr{};
+        if (options.unix_path.size() >= sizeof(addr.sun_path)) {
+            std::cerr << "[RedisStandin] unix socket path too long: " << options.unix_path << std::endl;
+            return false;
+        }
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0) {
+            return false;
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, options.unix_path.c_str(), options.unix_path.size() + 1);
+        ::unlink(options.unix_path.c_str());  // Stale socket from a previous run
+        if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cerr << "[RedisStandin] bind " << options.unix_path << ": " << std::strerror(errno) << std::endl;
+            close_listener();
+            return false;
+        }
+    } else {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+        addrinfo* results = nullptr;
+        std::string port = std::to_string(options.port);
+        if (::getaddrinfo(options.host.c_str(), port.c_str(), &hints, &results) != 0) {
+            std::cerr << "[RedisStandin] cannot resolve " << options.host << std::endl;
+            return false;
+        }
+        for (addrinfo* ai = results; ai; ai = ai->ai_next) {
+            listen_fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (listen_fd < 0) {
+                continue;
+            }
+            int one = 1;
+            ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            if (::bind(listen_fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+                break;
+            }
+            close_listener();
+        }
+        ::freeaddrinfo(results);
+        if (listen_fd < 0) {
+            std::cerr << "[RedisStandin] bind " << options.host << ":" << options.port
+                      << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        sockaddr_storage bound{};
+        socklen_t len = sizeof(bound);
+        if (::getsockname(listen_fd, reinterpret_cast<sockaddr*>(&bound), &len) == 0) {
+            bound_port = bound.ss_family == AF_INET6
+                ? ntohs(reinterpret_cast<sockaddr_in6*>(&bound)->sin6_port)
+                : ntohs(reinterpret_cast<sockaddr_in*>(&bound)->sin_port);
+        }
+    }
+
+    if (::listen(listen_fd, 511) != 0 || !set_nonblocking(listen_fd)) {
+        close_listener();
+        return false;
+    }
+    return true;
+}
+
+void RedisStandin::Impl::close_listener() {
+    if (listen_fd >= 0) {
+        ::close(listen_fd);
+        listen_fd = -1;
+    }
+}
+
+void RedisStandin::Impl::run_loop() {
+    std::vector<pollfd> fds;
+    std::vector<int> to_close;
+
+    while (running.load(std::memory_order_acquire)) {
+        fds.clear();
+        fds.push_back({wake_fds[0], POLLIN, 0});
+        fds.push_back({listen_fd, POLLIN, 0});
+        for (const auto& [fd, client] : clients) {
+            short events = POLLIN;
+            if (client->has_output()) {
+                events |= POLLOUT;
+            }
+            fds.push_back({fd, events, 0});
+        }
+
+        int ready = ::poll(fds.data(), static_cast<nfds_t>(fds.size()), next_timeout_ms());
+        if (ready < 0 && errno != EINTR) {
+            std::cerr << "[RedisStandin] poll: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (!running.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        if (ready > 0) {
+            if (fds[1].revents & POLLIN) {
+                accept_clients();
+            }
+            for (size_t i = 2; i < fds.size(); ++i) {
+                if (fds[i].revents == 0) {
+                    continue;
+                }
+                auto it = clients.find(fds[i].fd);
+                if (it == clients.end()) {
+                    continue;
+                }
+                Client& c = *it->second;
+                if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    read_client(c);
+                }
+                if (!c.dead && (fds[i].revents & POLLOUT)) {
+                    flush_client(c);
+                }
+            }
+        }
+
+        expire_blocked();
+        resume_unblocked();
+
+        // Write replies now instead of waiting a poll() round for POLLOUT
+        to_close.clear();
+        for (auto& [fd, client] : clients) {
+            if (!client->dead && client->has_output()) {
+                flush_client(*client);
+            }
+            if (client->dead || (client->closing && !client->has_output())) {
+                to_close.push_back(fd);
+            }
+        }
+        for (int fd : to_close) {
+            close_client(fd);
+        }
+        key_count.store(db.size(), std::memory_order_relaxed);
+    }
+
+    for (auto& [fd, client] : clients) {
+        ::close(fd);
+    }
+    clients.clear();
+    blocked.clear();
+    resume.clear();
+    running.store(false, std::memory_order_release);
+}
+
+// ========== Event Loop ==========
+
+void RedisStandin::Impl::accept_clients() {
+    while (true) {
+        int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            return;  // EAGAIN: backlog drained (other errors: retry next round)
+        }
+        set_nonblocking(fd);
+        suppress_sigpipe(fd);
+        if (options.unix_path.empty()) {
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        auto client = std::make_unique<Client>();
+        client->fd = fd;
+        client->id = next_client_id++;
+        clients.emplace(fd, std::move(client));
+        connections_accepted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void RedisStandin::Impl::read_client(Client& c) {
+    char buf[kReadChunk];
+    while (true) {
+        ssize_t n = ::recv(c.fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            c.in.append(buf, static_cast<size_t>(n));
+            continue;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            c.dead = true;
+        }
+        break;
+    }
+    if (!c.dead) {
+        process_input(c);
+    }
+}
+
+void RedisStandin::Impl::flush_client(Client& c) {
+    while (c.has_output()) {
+        ssize_t n = ::send(c.fd, c.out.data() + c.out_pos, c.out.size() - c.out_pos, kSendFlags);
+        if (n > 0) {
+            c.out_pos += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return;  // Socket buffer full: wait for POLLOUT
+        }
+        c.dead = true;
+        return;
+    }
+    c.out.clear();
+    c.out_pos = 0;
+}
+
+void RedisStandin::Impl::close_client(int fd) {
+    auto it = clients.find(fd);
+    if (it == clients.end()) {
+        return;
+    }
+    if (it->second->blocked) {
+        blocked.remove(fd);
+    }
+    ::close(fd);
+    clients.erase(it);
+}
+
+int RedisStandin::Impl::next_timeout_ms() const {
+    std::optional<Clock::time_point> nearest;
+    for (int fd : blocked) {
+        const Client& c = *clients.at(fd);
+        if (c.block_deadline && (!nearest || *c.block_deadline < *nearest)) {
+            nearest = c.block_deadline;
+        }
+    }
+    if (!nearest) {
+        return -1;  // Nothing to time out: sleep until I/O
+    }
+    auto wait = std::chrono::ceil<std::chrono::milliseconds>(*nearest - Clock::now()).count();
+    return static_cast<int>(std::max<long long>(0, std::min<long long>(wait, 60000)));
+}
+
+void RedisStandin::Impl::expire_blocked() {
+    auto now = Clock::now();
+    for (auto it = blocked.begin(); it != blocked.end();) {
+        Client& c = *clients.at(*it);
+        if (c.block_deadline && *c.block_deadline <= now) {
+            c.out += c.timeout_reply;
+            unblock(c);
+            resume.push_back(c.fd);
+            it = blocked.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void RedisStandin::Impl::resume_unblocked() {
+    while (!resume.empty()) {
+        int fd = resume.front();
+        resume.pop_front();
+        auto it = clients.find(fd);
+        if (it != clients.end() && !it->second->dead) {
+            process_input(*it->second);
+        }
+    }
+}
+
+// ========== Command Processing ==========
+
+// @return 1 = complete command in args, 0 = need more bytes, -1 = protocol error
+int RedisStandin::Impl::parse_command(Client& c, Args& args) {
+    const std::string& buf = c.in;
+    size_t pos = c.in_pos;
+    if (pos >= buf.size()) {
+        return 0;
+    }
+    args.clear();
+
+    if (buf[pos] != '*') {
+        // Inline command (telnet / nc): space separated, newline terminated
+        size_t eol = buf.find('\n', pos);
+        if (eol == std::string::npos) {
+            return buf.size() - pos > 64 * 1024 ? -1 : 0;
+        }
+        size_t end = (eol > pos && buf[eol - 1] == '\r') ? eol - 1 : eol;
+        size_t i = pos;
+        while (i < end) {
+            while (i < end && (buf[i] == ' ' || buf[i] == '\t')) ++i;
+            size_t start = i;
+            while (i < end && buf[i] != ' ' && buf[i] != '\t') ++i;
+            if (i > start) {
+                args.emplace_back(buf, start, i - start);
+            }
+        }
+        c.in_pos = eol + 1;
+        return 1;
+    }
+
+    size_t eol = buf.find("\r\n", pos);
+    if (eol == std::string::npos) {
+        return 0;
+    }
+    long long count = 0;
+    if (!parse_ll(buf.substr(pos + 1, eol - pos - 1), count) || count > kMaxMultibulkLength) {
+        return -1;
+    }
+    pos = eol + 2;
+    args.reserve(count > 0 ? static_cast<size_t>(count) : 0);
+
+    for (long long i = 0; i < count; ++i) {
+        if (pos >= buf.size()) {
+            return 0;
+        }
+        if (buf[pos] != '$') {
+            return -1;
+        }
+        eol = buf.find("\r\n", pos);
+        if (eol == std::string::npos) {
+            return 0;
+        }
+        long long len = 0;
+        if (!parse_ll(buf.substr(pos + 1, eol - pos - 1), len) || len < 0 || len > kMaxBulkLength) {
+            return -1;
+        }
+        pos = eol + 2;
+        if (buf.size() < pos + static_cast<size_t>(len) + 2) {
+            return 0;
+        }
+        args.emplace_back(buf, pos, static_cast<size_t>(len));
+        pos += static_cast<size_t>(len) + 2;
+    }
+    c.in_pos = pos;
+    return 1;
+}
+
+void RedisStandin::Impl::process_input(Client& c) {
+    Args args;
+    // A blocked client keeps its pipelined commands buffered until it is served
+    while (!c.blocked && !c.closing && !c.dead) {
+        int parsed = parse_command(c, args);
+        if (parsed == 0) {
+            break;
+        }
+        if (parsed < 0) {
+            reply_error(c.out, "ERR Protocol error");
+            c.closing = true;
+            break;
+        }
+        if (!args.empty()) {
+            execute(c, args);
+        }
+    }
+
+    if (c.in_pos == c.in.size()) {
+        c.in.clear();
+        c.in_pos = 0;
+    } else if (c.in_pos > kReadChunk) {
+        c.in.erase(0, c.in_pos);
+        c.in_pos = 0;
+    }
+}
+
+void RedisStandin::Impl::execute(Client& c, const Args& args) {
+    commands_processed.fetch_add(1, std::memory_order_relaxed);
+
+    if (c.in_multi) {
+        std::string name = to_upper(args[0]);
+        if (name != "EXEC" && name != "DISCARD" && name != "MULTI") {
+            auto it = commands.find(name);
+            int argc = static_cast<int>(args.size());
+            if (it == commands.end()) {
+                reply_error(c.out, "ERR unknown command '" + args[0] + "'");
+                c.multi_error = true;
+            } else if ((it->second.arity > 0 && argc != it->second.arity) ||
+                       (it->second.arity < 0 && argc < -it->second.arity)) {
+                reply_error(c.out, "ERR wrong number of arguments for '" + to_lower(args[0]) + "' command");
+                c.multi_error = true;
+            } else {
+                c.queued.push_back(args);
+                reply_status(c.out, "QUEUED");
+            }
+            return;
+        }
+    }
+
+    run(c, args, c.out);
+    serve_blocked();
+}
+
+Outcome RedisStandin::Impl::run(Client& c, const Args& args, std::string& out) {
+    auto it = commands.find(to_upper(args[0]));
+    if (it == commands.end()) {
+        return error(out, "ERR unknown command '" + args[0] + "'");
+    }
+    int argc = static_cast<int>(args.size());
+    const Command& cmd = it->second;
+    if ((cmd.arity > 0 && argc != cmd.arity) || (cmd.arity < 0 && argc < -cmd.arity)) {
+        return error(out, "ERR wrong number of arguments for '" + to_lower(args[0]) + "' command");
+    }
+    return (this->*cmd.handler)(c, args, out);
+}
+
+Outcome RedisStandin::Impl::block_on(Client& c, const Args& args,
+                                                         std::vector<std::string> keys,
+                                                         double timeout_seconds,
+                                                         const char* timeout_reply,
+                                                         std::string& out) {
+    if (c.exec_mode) {
+        out += timeout_reply;  // Inside MULTI/EXEC blocking commands never block
+        return Outcome::Replied;
+    }
+    if (!c.blocked) {
+        c.blocked = true;
+        c.blocked_args = args;
+        c.blocked_keys = std::move(keys);
+        c.timeout_reply = timeout_reply;
+        c.block_deadline.reset();
+        if (timeout_seconds > 0) {
+            c.block_deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(timeout_seconds));
+        }
+        blocked.push_back(c.fd);
+    }
+    return Outcome::Blocked;
+}
+
+void RedisStandin::Impl::unblock(Client& c) {
+    c.blocked = false;
+    c.blocked_args.clear();
+    c.blocked_keys.clear();
+    c.block_deadline.reset();
+}
+
+void RedisStandin::Impl::serve_blocked() {
+    // Re-run each waiting command (FIFO) whose key was written; serving one may
+    // write another key (BLMOVE), so repeat until nothing new became ready
+    while (!ready_keys.empty()) {
+        std::unordered_set<std::string> keys;
+        keys.swap(ready_keys);
+
+        for (auto it = blocked.begin(); it != blocked.end();) {
+            Client& c = *clients.at(*it);
+            bool hit = std::any_of(c.blocked_keys.begin(), c.blocked_keys.end(),
+                                   [&](const std::string& key) { return keys.count(key) > 0; });
+            if (!hit) {
+                ++it;
+                continue;
+            }
+            Args args = c.blocked_args;
+            if (run(c, args, c.out) == Outcome::Replied) {
+                unblock(c);
+                resume.push_back(c.fd);
+                it = blocked.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+// ========== Connection / Server Commands ==========
+
+Outcome RedisStandin::Impl::cmd_ping(Client&, const Args& args, std::string& out) {
+    if (args.size() > 2) {
+        return error(out, "ERR wrong number of arguments for 'ping' command");
+    }
+    if (args.size() == 2) {
+        reply_bulk(out, args[1]);
+    } else {
+        reply_status(out, "PONG");
+    }
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_echo(Client&, const Args& args, std::string& out) {
+    reply_bulk(out, args[1]);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_ok(Client&, const Args&, std::string& out) {
+    reply_status(out, "OK");  // AUTH / SELECT: single unauthenticated database
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_quit(Client& c, const Args&, std::string& out) {
+    reply_status(out, "OK");
+    c.closing = true;
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_client(Client& c, const Args& args, std::string& out) {
+    if (iequals(args[1], "SETNAME") && args.size() == 3) {
+        c.name = args[2];
+        reply_status(out, "OK");
+    } else if (iequals(args[1], "GETNAME")) {
+        if (c.name.empty()) {
+            out += kNilBulk;
+        } else {
+            reply_bulk(out, c.name);
+        }
+    } else if (iequals(args[1], "ID")) {
+        reply_int(out, c.id);
+    } else if (iequals(args[1], "SETINFO")) {
+        reply_status(out, "OK");
+    } else {
+        return error(out, "ERR unknown subcommand '" + args[1] + "'");
+    }
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_command(Client&, const Args&, std::string& out) {
+    reply_array(out, 0);  // No command docs (redis-cli tolerates an empty table)
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_info(Client&, const Args&, std::string& out) {
+    purge_expired();
+    std::string info;
+    info += "# Server\r\n";
+    info += "redis_version:7.2.0\r\n";
+    info += "redis_mode:standalone\r\n";
+    info += "server_name:telemetry-redis-standin\r\n";
+    info += "\r\n# Clients\r\n";
+    info += "connected_clients:" + std::to_string(clients.size()) + "\r\n";
+    info += "blocked_clients:" + std::to_string(blocked.size()) + "\r\n";
+    info += "\r\n# Stats\r\n";
+    info += "total_connections_received:" + std::to_string(connections_accepted.load()) + "\r\n";
+    info += "total_commands_processed:" + std::to_string(commands_processed.load()) + "\r\n";
+    info += "\r\n# Keyspace\r\n";
+    if (!db.empty()) {
+        info += "db0:keys=" + std::to_string(db.size()) + "\r\n";
+    }
+    reply_bulk(out, info);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_dbsize(Client&, const Args&, std::string& out) {
+    purge_expired();
+    reply_int(out, static_cast<long long>(db.size()));
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_flushall(Client&, const Args&, std::string& out) {
+    db.clear();
+    reply_status(out, "OK");
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_multi(Client& c, const Args&, std::string& out) {
+    if (c.in_multi) {
+        return error(out, "ERR MULTI calls can not be nested");
+    }
+    c.in_multi = true;
+    c.multi_error = false;
+    c.queued.clear();
+    reply_status(out, "OK");
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_exec(Client& c, const Args&, std::string& out) {
+    if (!c.in_multi) {
+        return error(out, "ERR EXEC without MULTI");
+    }
+    c.in_multi = false;
+    std::vector<Args> queued;
+    queued.swap(c.queued);
+    if (c.multi_error) {
+        c.multi_error = false;
+        return error(out, "EXECABORT Transaction discarded because of previous errors.");
+    }
+
+    // Single-threaded loop: nothing can interleave, so the block is atomic
+    c.exec_mode = true;
+    reply_array(out, queued.size());
+    for (const auto& args : queued) {
+        run(c, args, out);
+    }
+    c.exec_mode = false;
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_discard(Client& c, const Args&, std::string& out) {
+    if (!c.in_multi) {
+        return error(out, "ERR DISCARD without MULTI");
+    }
+    c.in_multi = false;
+    c.multi_error = false;
+    c.queued.clear();
+    reply_status(out, "OK");
+    return Outcome::Replied;
+}
+
+// ========== Key Commands ==========
+
+Outcome RedisStandin::Impl::cmd_del(Client&, const Args& args, std::string& out) {
+    long long removed = 0;
+    for (size_t i = 1; i < args.size(); ++i) {
+        if (find(args[i])) {
+            db.erase(args[i]);
+            ++removed;
+        }
+    }
+    reply_int(out, removed);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_exists(Client&, const Args& args, std::string& out) {
+    long long count = 0;
+    for (size_t i = 1; i < args.size(); ++i) {
+        if (find(args[i])) {
+            ++count;
+        }
+    }
+    reply_int(out, count);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_expire(Client&, const Args& args, std::string& out) {
+    long long amount = 0;
+    if (!parse_ll(args[2], amount)) {
+        return not_integer(out);
+    }
+    Entry* entry = find(args[1]);
+    if (!entry) {
+        reply_int(out, 0);
+        return Outcome::Replied;
+    }
+    std::chrono::milliseconds ttl = iequals(args[0], "PEXPIRE")
+        ? std::chrono::milliseconds(amount)
+        : std::chrono::milliseconds(amount * 1000);
+    if (ttl.count() <= 0) {
+        db.erase(args[1]);
+    } else {
+        entry->expires = Clock::now() + ttl;
+    }
+    reply_int(out, 1);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_ttl(Client&, const Args& args, std::string& out) {
+    Entry* entry = find(args[1]);
+    if (!entry) {
+        reply_int(out, -2);
+    } else if (!entry->expires) {
+        reply_int(out, -1);
+    } else {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(*entry->expires - Clock::now()).count();
+        reply_int(out, iequals(args[0], "PTTL") ? ms : (ms + 500) / 1000);
+    }
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_persist(Client&, const Args& args, std::string& out) {
+    Entry* entry = find(args[1]);
+    bool had_ttl = entry && entry->expires;
+    if (had_ttl) {
+        entry->expires.reset();
+    }
+    reply_int(out, had_ttl ? 1 : 0);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_type(Client&, const Args& args, std::string& out) {
+    Entry* entry = find(args[1]);
+    reply_status(out, entry ? type_name(entry->value) : "none");
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_keys(Client&, const Args& args, std::string& out) {
+    purge_expired();
+    std::vector<const std::string*> matches;
+    for (const auto& [key, entry] : db) {
+        if (::fnmatch(args[1].c_str(), key.c_str(), 0) == 0) {
+            matches.push_back(&key);
+        }
+    }
+    reply_array(out, matches.size());
+    for (const auto* key : matches) {
+        reply_bulk(out, *key);
+    }
+    return Outcome::Replied;
+}
+
+// ========== String Commands ==========
+
+Outcome RedisStandin::Impl::cmd_set(Client&, const Args& args, std::string& out) {
+    bool nx = false;
+    bool xx = false;
+    bool keep_ttl = false;
+    std::optional<std::chrono::milliseconds> ttl;
+
+    for (size_t i = 3; i < args.size(); ++i) {
+        if (iequals(args[i], "NX")) {
+            nx = true;
+        } else if (iequals(args[i], "XX")) {
+            xx = true;
+        } else if (iequals(args[i], "KEEPTTL")) {
+            keep_ttl = true;
+        } else if ((iequals(args[i], "EX") || iequals(args[i], "PX")) && i + 1 < args.size()) {
+            long long amount = 0;
+            if (!parse_ll(args[i + 1], amount) || amount <= 0) {
+                return error(out, "ERR invalid expire time in 'set' command");
+            }
+            ttl = iequals(args[i], "EX") ? std::chrono::milliseconds(amount * 1000)
+                                         : std::chrono::milliseconds(amount);
+            ++i;
+        } else {
+            return syntax_error(out);
+        }
+    }
+    if (nx && xx) {
+        return syntax_error(out);
+    }
+
+    Entry* existing = find(args[1]);
+    if ((nx && existing) || (xx && !existing)) {
+        out += kNilBulk;
+        return Outcome::Replied;
+    }
+
+    std::optional<Clock::time_point> expires;
+    if (ttl) {
+        expires = Clock::now() + *ttl;
+    } else if (keep_ttl && existing) {
+        expires = existing->expires;
+    }
+    Entry& entry = db[args[1]];
+    entry.value = args[2];
+    entry.expires = expires;
+    reply_status(out, "OK");
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_setex(Client&, const Args& args, std::string& out) {
+    long long seconds = 0;
+    if (!parse_ll(args[2], seconds) || seconds <= 0) {
+        return error(out, "ERR invalid expire time in 'setex' command");
+    }
+    Entry& entry = db[args[1]];
+    entry.value = args[3];
+    entry.expires = Clock::now() + std::chrono::seconds(seconds);
+    reply_status(out, "OK");
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_get(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    const std::string* value = lookup<std::string>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    if (value) {
+        reply_bulk(out, *value);
+    } else {
+        out += kNilBulk;
+    }
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_mget(Client&, const Args& args, std::string& out) {
+    reply_array(out, args.size() - 1);
+    for (size_t i = 1; i < args.size(); ++i) {
+        bool wrong = false;
+        const std::string* value = lookup<std::string>(args[i], wrong);
+        if (value) {
+            reply_bulk(out, *value);
+        } else {
+            out += kNilBulk;  // Missing or not a string
+        }
+    }
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_incrby(Client&, const Args& args, std::string& out) {
+    std::string name = to_upper(args[0]);
+    long long delta = 1;
+    if (args.size() == 3 && !parse_ll(args[2], delta)) {
+        return not_integer(out);
+    }
+    if (name == "DECR" || name == "DECRBY") {
+        delta = -delta;
+    }
+
+    bool wrong = false;
+    std::string* value = lookup_or_create<std::string>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long current = 0;
+    if (!value->empty() && !parse_ll(*value, current)) {
+        return not_integer(out);
+    }
+    if ((delta > 0 && current > std::numeric_limits<long long>::max() - delta) ||
+        (delta < 0 && current < std::numeric_limits<long long>::min() - delta)) {
+        return error(out, "ERR increment or decrement would overflow");
+    }
+    current += delta;
+    *value = std::to_string(current);
+    reply_int(out, current);
+    return Outcome::Replied;
+}
+
+// ========== List Commands ==========
+
+Outcome RedisStandin::Impl::cmd_push(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    List* list = lookup_or_create<List>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    bool left = iequals(args[0], "LPUSH");
+    for (size_t i = 2; i < args.size(); ++i) {
+        if (left) {
+            list->push_front(args[i]);
+        } else {
+            list->push_back(args[i]);
+        }
+    }
+    reply_int(out, static_cast<long long>(list->size()));
+    signal_ready(args[1]);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_pop(Client&, const Args& args, std::string& out) {
+    if (args.size() > 3) {
+        return syntax_error(out);
+    }
+    bool left = iequals(args[0], "LPOP");
+    std::optional<long long> count;
+    if (args.size() == 3) {
+        long long n = 0;
+        if (!parse_ll(args[2], n) || n < 0) {
+            return error(out, "ERR value is out of range, must be positive");
+        }
+        count = n;
+    }
+
+    bool wrong = false;
+    List* list = lookup<List>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    if (!list) {
+        out += count ? kNilArray : kNilBulk;
+        return Outcome::Replied;
+    }
+
+    if (!count) {
+        if (left) {
+            reply_bulk(out, list->front());
+            list->pop_front();
+        } else {
+            reply_bulk(out, list->back());
+            list->pop_back();
+        }
+    } else {
+        size_t n = std::min(static_cast<size_t>(*count), list->size());
+        reply_array(out, n);
+        for (size_t i = 0; i < n; ++i) {
+            if (left) {
+                reply_bulk(out, list->front());
+                list->pop_front();
+            } else {
+                reply_bulk(out, list->back());
+                list->pop_back();
+            }
+        }
+    }
+    drop_if_empty(args[1], *list);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_llen(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    List* list = lookup<List>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    reply_int(out, list ? static_cast<long long>(list->size()) : 0);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_lrange(Client&, const Args& args, std::string& out) {
+    long long start = 0;
+    long long stop = 0;
+    if (!parse_ll(args[2], start) || !parse_ll(args[3], stop)) {
+        return not_integer(out);
+    }
+    bool wrong = false;
+    List* list = lookup<List>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long from = 0;
+    long long to = 0;
+    if (!list || !normalize_range(start, stop, static_cast<long long>(list->size()), from, to)) {
+        reply_array(out, 0);
+        return Outcome::Replied;
+    }
+    reply_array(out, static_cast<size_t>(to - from + 1));
+    for (long long i = from; i <= to; ++i) {
+        reply_bulk(out, (*list)[static_cast<size_t>(i)]);
+    }
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_lindex(Client&, const Args& args, std::string& out) {
+    long long index = 0;
+    if (!parse_ll(args[2], index)) {
+        return not_integer(out);
+    }
+    bool wrong = false;
+    List* list = lookup<List>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long size = list ? static_cast<long long>(list->size()) : 0;
+    if (index < 0) {
+        index += size;
+    }
+    if (index < 0 || index >= size) {
+        out += kNilBulk;
+    } else {
+        reply_bulk(out, (*list)[static_cast<size_t>(index)]);
+    }
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_lrem(Client&, const Args& args, std::string& out) {
+    long long count = 0;
+    if (!parse_ll(args[2], count)) {
+        return not_integer(out);
+    }
+    bool wrong = false;
+    List* list = lookup<List>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    if (!list) {
+        reply_int(out, 0);
+        return Outcome::Replied;
+    }
+
+    const std::string& value = args[3];
+    long long limit = count == 0 ? std::numeric_limits<long long>::max() : std::llabs(count);
+    long long removed = 0;
+    if (count >= 0) {
+        for (auto it = list->begin(); it != list->end() && removed < limit;) {
+            if (*it == value) {
+                it = list->erase(it);
+                ++removed;
+            } else {
+                ++it;
+            }
+        }
+    } else {
+        // Negative count: remove from tail towards head
+        for (size_t i = list->size(); i > 0 && removed < limit; --i) {
+            if ((*list)[i - 1] == value) {
+                list->erase(list->begin() + static_cast<std::ptrdiff_t>(i - 1));
+                ++removed;
+            }
+        }
+    }
+    reply_int(out, removed);
+    drop_if_empty(args[1], *list);
+    return Outcome::Replied;
+}
+
+MoveResult RedisStandin::Impl::move_element(const std::string& src, const std::string& dst,
+                                                bool from_left, bool to_left, std::string& out) {
+    bool wrong = false;
+    List* source = lookup<List>(src, wrong);
+    if (!wrong && source) {
+        lookup<List>(dst, wrong);  // Type check before touching the source
+    }
+    if (wrong) {
+        wrong_type(out);
+        return MoveResult::Error;
+    }
+    if (!source) {
+        return MoveResult::Empty;
+    }
+
+    std::string value = from_left ? std::move(source->front()) : std::move(source->back());
+    if (from_left) {
+        source->pop_front();
+    } else {
+        source->pop_back();
+    }
+    // src may equal dst: push before dropping an empty source
+    List* dest = lookup_or_create<List>(dst, wrong);
+    if (to_left) {
+        dest->push_front(value);
+    } else {
+        dest->push_back(value);
+    }
+    drop_if_empty(src, *source);
+    signal_ready(dst);
+    reply_bulk(out, value);
+    return MoveResult::Moved;
+}
+
+// LMOVE src dst from to | RPOPLPUSH src dst | BLMOVE src dst from to timeout | BRPOPLPUSH src dst timeout
+Outcome RedisStandin::Impl::cmd_lmove(Client& c, const Args& args, std::string& out) {
+    std::string name = to_upper(args[0]);
+    bool from_left = false;
+    bool to_left = true;
+    if (name == "LMOVE" || name == "BLMOVE") {
+        auto side = [](const std::string& s, bool& left) {
+            if (iequals(s, "LEFT")) { left = true; return true; }
+            if (iequals(s, "RIGHT")) { left = false; return true; }
+            return false;
+        };
+        if (!side(args[3], from_left) || !side(args[4], to_left)) {
+            return syntax_error(out);
+        }
+    }
+
+    bool blocking = name == "BLMOVE" || name == "BRPOPLPUSH";
+    double timeout = 0;
+    if (blocking && (!parse_double(args.back(), timeout) || timeout < 0)) {
+        return error(out, "ERR timeout is not a float or out of range");
+    }
+
+    if (move_element(args[1], args[2], from_left, to_left, out) != MoveResult::Empty) {
+        return Outcome::Replied;
+    }
+    if (!blocking) {
+        out += kNilBulk;
+        return Outcome::Replied;
+    }
+    return block_on(c, args, {args[1]}, timeout, kNilBulk, out);
+}
+
+// BLPOP key [key ...] timeout | BRPOP key [key ...] timeout
+Outcome RedisStandin::Impl::cmd_bpop(Client& c, const Args& args, std::string& out) {
+    double timeout = 0;
+    if (!parse_double(args.back(), timeout) || timeout < 0) {
+        return error(out, "ERR timeout is not a float or out of range");
+    }
+    bool left = iequals(args[0], "BLPOP");
+    std::vector<std::string> keys(args.begin() + 1, args.end() - 1);
+
+    for (const auto& key : keys) {
+        bool wrong = false;
+        List* list = lookup<List>(key, wrong);
+        if (wrong) {
+            return wrong_type(out);
+        }
+        if (!list) {
+            continue;
+        }
+        reply_array(out, 2);
+        reply_bulk(out, key);
+        if (left) {
+            reply_bulk(out, list->front());
+            list->pop_front();
+        } else {
+            reply_bulk(out, list->back());
+            list->pop_back();
+        }
+        drop_if_empty(key, *list);
+        return Outcome::Replied;
+    }
+    return block_on(c, args, std::move(keys), timeout, kNilArray, out);
+}
+
+// ========== Set Commands ==========
+
+Outcome RedisStandin::Impl::cmd_sadd(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Set* set = lookup_or_create<Set>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long added = 0;
+    for (size_t i = 2; i < args.size(); ++i) {
+        added += set->insert(args[i]).second ? 1 : 0;
+    }
+    reply_int(out, added);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_srem(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Set* set = lookup<Set>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long removed = 0;
+    if (set) {
+        for (size_t i = 2; i < args.size(); ++i) {
+            removed += static_cast<long long>(set->erase(args[i]));
+        }
+        drop_if_empty(args[1], *set);
+    }
+    reply_int(out, removed);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_sismember(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Set* set = lookup<Set>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    reply_int(out, set && set->count(args[2]) ? 1 : 0);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_scard(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Set* set = lookup<Set>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    reply_int(out, set ? static_cast<long long>(set->size()) : 0);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_smembers(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Set* set = lookup<Set>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    reply_array(out, set ? set->size() : 0);
+    if (set) {
+        for (const auto& member : *set) {
+            reply_bulk(out, member);
+        }
+    }
+    return Outcome::Replied;
+}
+
+// ========== Sorted Set Commands ==========
+
+// ZADD key [NX|XX] [GT|LT] [CH] [INCR] score member [score member ...]
+Outcome RedisStandin::Impl::cmd_zadd(Client&, const Args& args, std::string& out) {
+    bool nx = false, xx = false, gt = false, lt = false, ch = false, incr = false;
+    size_t i = 2;
+    for (; i < args.size(); ++i) {
+        if (iequals(args[i], "NX")) nx = true;
+        else if (iequals(args[i], "XX")) xx = true;
+        else if (iequals(args[i], "GT")) gt = true;
+        else if (iequals(args[i], "LT")) lt = true;
+        else if (iequals(args[i], "CH")) ch = true;
+        else if (iequals(args[i], "INCR")) incr = true;
+        else break;
+    }
+    size_t pairs = args.size() - i;
+    if (pairs == 0 || pairs % 2 != 0 || (nx && xx) || (gt && lt) || (nx && (gt || lt))) {
+        return syntax_error(out);
+    }
+    if (incr && pairs != 2) {
+        return error(out, "ERR INCR option supports a single increment-element pair");
+    }
+    std::vector<double> scores;
+    for (size_t p = i; p < args.size(); p += 2) {
+        double score = 0;
+        if (!parse_double(args[p], score)) {
+            return error(out, "ERR value is not a valid float");
+        }
+        scores.push_back(score);
+    }
+
+    bool wrong = false;
+    ZSet* zset = lookup_or_create<ZSet>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+
+    long long added = 0;
+    long long changed = 0;
+    std::optional<double> incr_result;
+    for (size_t p = 0; p < scores.size(); ++p) {
+        const std::string& member = args[i + 2 * p + 1];
+        auto existing = zset->scores.find(member);
+        bool exists = existing != zset->scores.end();
+        if ((nx && exists) || (xx && !exists)) {
+            continue;
+        }
+        double score = incr && exists ? existing->second + scores[p] : scores[p];
+        if (exists && ((gt && score <= existing->second) || (lt && score >= existing->second))) {
+            continue;
+        }
+        if (!exists) {
+            ++added;
+        } else if (existing->second != score) {
+            ++changed;
+        }
+        zset->insert(member, score);
+        incr_result = score;
+    }
+    drop_if_empty(args[1], *zset);  // NX/XX may have skipped everything
+
+    if (incr) {
+        if (incr_result) {
+            reply_bulk(out, format_double(*incr_result));
+        } else {
+            out += kNilBulk;
+        }
+    } else {
+        reply_int(out, ch ? added + changed : added);
+    }
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_zincrby(Client&, const Args& args, std::string& out) {
+    double delta = 0;
+    if (!parse_double(args[2], delta)) {
+        return error(out, "ERR value is not a valid float");
+    }
+    bool wrong = false;
+    ZSet* zset = lookup_or_create<ZSet>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    auto it = zset->scores.find(args[3]);
+    double score = (it != zset->scores.end() ? it->second : 0.0) + delta;
+    zset->insert(args[3], score);
+    reply_bulk(out, format_double(score));
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_zrem(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    ZSet* zset = lookup<ZSet>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long removed = 0;
+    if (zset) {
+        for (size_t i = 2; i < args.size(); ++i) {
+            removed += zset->erase(args[i]) ? 1 : 0;
+        }
+        drop_if_empty(args[1], *zset);
+    }
+    reply_int(out, removed);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_zcard(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    ZSet* zset = lookup<ZSet>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    reply_int(out, zset ? static_cast<long long>(zset->scores.size()) : 0);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_zscore(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    ZSet* zset = lookup<ZSet>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    auto it = zset ? zset->scores.find(args[2]) : decltype(zset->scores.end()){};
+    if (!zset || it == zset->scores.end()) {
+        out += kNilBulk;
+    } else {
+        reply_bulk(out, format_double(it->second));
+    }
+    return Outcome::Replied;
+}
+
+// ZRANGE key start stop [WITHSCORES] (index ranges only)
+Outcome RedisStandin::Impl::cmd_zrange(Client&, const Args& args, std::string& out) {
+    bool with_scores = false;
+    for (size_t i = 4; i < args.size(); ++i) {
+        if (!iequals(args[i], "WITHSCORES")) {
+            return syntax_error(out);
+        }
+        with_scores = true;
+    }
+    long long start = 0;
+    long long stop = 0;
+    if (!parse_ll(args[2], start) || !parse_ll(args[3], stop)) {
+        return not_integer(out);
+    }
+    bool wrong = false;
+    ZSet* zset = lookup<ZSet>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long from = 0;
+    long long to = 0;
+    if (!zset || !normalize_range(start, stop, static_cast<long long>(zset->ordered.size()), from, to)) {
+        reply_array(out, 0);
+        return Outcome::Replied;
+    }
+    size_t n = static_cast<size_t>(to - from + 1);
+    reply_array(out, with_scores ? n * 2 : n);
+    auto it = std::next(zset->ordered.begin(), from);
+    for (size_t i = 0; i < n; ++i, ++it) {
+        reply_bulk(out, it->second);
+        if (with_scores) {
+            reply_bulk(out, format_double(it->first));
+        }
+    }
+    return Outcome::Replied;
+}
+
+// ZRANGEBYSCORE key min max [WITHSCORES] [LIMIT offset count]
+Outcome RedisStandin::Impl::cmd_zrangebyscore(Client&, const Args& args, std::string& out) {
+    ScoreBound min;
+    ScoreBound max;
+    if (!parse_bound(args[2], min) || !parse_bound(args[3], max)) {
+        return error(out, "ERR min or max is not a float");
+    }
+    bool with_scores = false;
+    long long offset = 0;
+    long long limit = -1;
+    for (size_t i = 4; i < args.size(); ++i) {
+        if (iequals(args[i], "WITHSCORES")) {
+            with_scores = true;
+        } else if (iequals(args[i], "LIMIT") && i + 2 < args.size()) {
+            if (!parse_ll(args[i + 1], offset) || !parse_ll(args[i + 2], limit)) {
+                return not_integer(out);
+            }
+            i += 2;
+        } else {
+            return syntax_error(out);
+        }
+    }
+
+    bool wrong = false;
+    ZSet* zset = lookup<ZSet>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+
+    std::vector<const std::pair<double, std::string>*> hits;
+    if (zset && offset >= 0) {
+        auto it = zset->ordered.lower_bound({min.value, std::string()});
+        for (; it != zset->ordered.end() && below_max(it->first, max); ++it) {
+            if (!above_min(it->first, min)) {
+                continue;  // Exclusive lower bound
+            }
+            if (offset > 0) {
+                --offset;
+                continue;
+            }
+            if (limit >= 0 && static_cast<long long>(hits.size()) >= limit) {
+                break;
+            }
+            hits.push_back(&*it);
+        }
+    }
+
+    reply_array(out, with_scores ? hits.size() * 2 : hits.size());
+    for (const auto* hit : hits) {
+        reply_bulk(out, hit->second);
+        if (with_scores) {
+            reply_bulk(out, format_double(hit->first));
+        }
+    }
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_zcount(Client&, const Args& args, std::string& out) {
+    ScoreBound min;
+    ScoreBound max;
+    if (!parse_bound(args[2], min) || !parse_bound(args[3], max)) {
+        return error(out, "ERR min or max is not a float");
+    }
+    bool wrong = false;
+    ZSet* zset = lookup<ZSet>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long count = 0;
+    if (zset) {
+        for (auto it = zset->ordered.lower_bound({min.value, std::string()});
+             it != zset->ordered.end() && below_max(it->first, max); ++it) {
+            count += above_min(it->first, min) ? 1 : 0;
+        }
+    }
+    reply_int(out, count);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_zremrangebyscore(Client&, const Args& args, std::string& out) {
+    ScoreBound min;
+    ScoreBound max;
+    if (!parse_bound(args[2], min) || !parse_bound(args[3], max)) {
+        return error(out, "ERR min or max is not a float");
+    }
+    bool wrong = false;
+    ZSet* zset = lookup<ZSet>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long removed = 0;
+    if (zset) {
+        auto it = zset->ordered.lower_bound({min.value, std::string()});
+        while (it != zset->ordered.end() && below_max(it->first, max)) {
+            if (!above_min(it->first, min)) {
+                ++it;
+                continue;
+            }
+            zset->scores.erase(it->second);
+            it = zset->ordered.erase(it);
+            ++removed;
+        }
+        drop_if_empty(args[1], *zset);
+    }
+    reply_int(out, removed);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_zpop(Client&, const Args& args, std::string& out) {
+    if (args.size() > 3) {
+        return syntax_error(out);
+    }
+    long long count = 1;
+    if (args.size() == 3 && (!parse_ll(args[2], count) || count < 0)) {
+        return error(out, "ERR value is out of range, must be positive");
+    }
+    bool wrong = false;
+    ZSet* zset = lookup<ZSet>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    bool max = iequals(args[0], "ZPOPMAX");
+    size_t n = zset ? std::min(static_cast<size_t>(count), zset->ordered.size()) : 0;
+    reply_array(out, n * 2);
+    for (size_t i = 0; i < n; ++i) {
+        auto it = max ? std::prev(zset->ordered.end()) : zset->ordered.begin();
+        reply_bulk(out, it->second);
+        reply_bulk(out, format_double(it->first));
+        zset->scores.erase(it->second);
+        zset->ordered.erase(it);
+    }
+    if (zset) {
+        drop_if_empty(args[1], *zset);
+    }
+    return Outcome::Replied;
+}
+
+// ========== Hash Commands ==========
+
+Outcome RedisStandin::Impl::cmd_hset(Client&, const Args& args, std::string& out) {
+    if (args.size() % 2 != 0) {
+        return error(out, "ERR wrong number of arguments for 'hset' command");
+    }
+    bool wrong = false;
+    Hash* hash = lookup_or_create<Hash>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long added = 0;
+    for (size_t i = 2; i + 1 < args.size(); i += 2) {
+        added += hash->insert_or_assign(args[i], args[i + 1]).second ? 1 : 0;
+    }
+    reply_int(out, added);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_hget(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Hash* hash = lookup<Hash>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    auto it = hash ? hash->find(args[2]) : Hash::iterator{};
+    if (!hash || it == hash->end()) {
+        out += kNilBulk;
+    } else {
+        reply_bulk(out, it->second);
+    }
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_hdel(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Hash* hash = lookup<Hash>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long removed = 0;
+    if (hash) {
+        for (size_t i = 2; i < args.size(); ++i) {
+            removed += static_cast<long long>(hash->erase(args[i]));
+        }
+        drop_if_empty(args[1], *hash);
+    }
+    reply_int(out, removed);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_hgetall(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Hash* hash = lookup<Hash>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    reply_array(out, hash ? hash->size() * 2 : 0);
+    if (hash) {
+        for (const auto& [field, value] : *hash) {
+            reply_bulk(out, field);
+            reply_bulk(out, value);
+        }
+    }
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_hlen(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Hash* hash = lookup<Hash>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    reply_int(out, hash ? static_cast<long long>(hash->size()) : 0);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_hincrby(Client&, const Args& args, std::string& out) {
+    long long delta = 0;
+    if (!parse_ll(args[3], delta)) {
+        return not_integer(out);
+    }
+    bool wrong = false;
+    Hash* hash = lookup_or_create<Hash>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    std::string& field = (*hash)[args[2]];
+    long long current = 0;
+    if (!field.empty() && !parse_ll(field, current)) {
+        return error(out, "ERR hash value is not an integer");
+    }
+    current += delta;
+    field = std::to_string(current);
+    reply_int(out, current);
+    return Outcome::Replied;
+}
+
+// ========== Stream Commands ==========
+
+// XADD key [NOMKSTREAM] [MAXLEN [=|~] n [LIMIT count]] *|id field value [field value ...]
+Outcome RedisStandin::Impl::cmd_xadd(Client&, const Args& args, std::string& out) {
+    bool no_mkstream = false;
+    std::optional<long long> maxlen;
+    size_t i = 2;
+    for (; i < args.size(); ++i) {
+        if (iequals(args[i], "NOMKSTREAM")) {
+            no_mkstream = true;
+        } else if (iequals(args[i], "MAXLEN") && i + 1 < args.size()) {
+            ++i;
+            if ((args[i] == "~" || args[i] == "=") && i + 1 < args.size()) {
+                ++i;  // Approximate trimming is exact here
+            }
+            long long n = 0;
+            if (!parse_ll(args[i], n) || n < 0) {
+                return error(out, "ERR The MAXLEN argument must be >= 0.");
+            }
+            maxlen = n;
+        } else if (iequals(args[i], "LIMIT") && i + 1 < args.size()) {
+            ++i;
+        } else {
+            break;
+        }
+    }
+    if (i >= args.size()) {
+        return syntax_error(out);
+    }
+    size_t field_args = args.size() - i - 1;
+    if (field_args == 0 || field_args % 2 != 0) {
+        return error(out, "ERR wrong number of arguments for 'xadd' command");
+    }
+
+    bool wrong = false;
+    Stream* stream = lookup<Stream>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    if (!stream && no_mkstream) {
+        out += kNilBulk;
+        return Outcome::Replied;
+    }
+    Stream probe;
+    const Stream& current = stream ? *stream : probe;
+
+    StreamId id;
+    if (args[i] == "*") {
+        id = current.next_id();
+    } else {
+        if (!parse_stream_id(args[i], id)) {
+            return error(out, "ERR Invalid stream ID specified as stream command argument");
+        }
+        if (id == StreamId{}) {
+            return error(out, "ERR The ID specified in XADD must be greater than 0-0");
+        }
+        if (id <= current.last_id) {
+            return error(out, "ERR The ID specified in XADD is equal or smaller than the target stream top item");
+        }
+    }
+
+    if (!stream) {
+        stream = lookup_or_create<Stream>(args[1], wrong);
+    }
+    stream->entries.emplace(id, Fields(args.begin() + static_cast<std::ptrdiff_t>(i) + 1, args.end()));
+    stream->last_id = id;
+    if (maxlen) {
+        stream->trim(static_cast<size_t>(*maxlen));
+    }
+    reply_bulk(out, id.str());
+    signal_ready(args[1]);
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_xlen(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Stream* stream = lookup<Stream>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    reply_int(out, stream ? static_cast<long long>(stream->entries.size()) : 0);
+    return Outcome::Replied;
+}
+
+// XRANGE key start end [COUNT n]
+Outcome RedisStandin::Impl::cmd_xrange(Client&, const Args& args, std::string& out) {
+    StreamId start;
+    StreamId end;
+    if (!parse_stream_id(args[2], start, 0) ||
+        !parse_stream_id(args[3], end, std::numeric_limits<uint64_t>::max())) {
+        return error(out, "ERR Invalid stream ID specified as stream command argument");
+    }
+    long long count = -1;
+    if (args.size() == 6 && iequals(args[4], "COUNT")) {
+        if (!parse_ll(args[5], count)) {
+            return not_integer(out);
+        }
+    } else if (args.size() != 4) {
+        return syntax_error(out);
+    }
+
+    bool wrong = false;
+    Stream* stream = lookup<Stream>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    std::string body;
+    size_t n = 0;
+    if (stream) {
+        for (auto it = stream->entries.lower_bound(start);
+             it != stream->entries.end() && it->first <= end; ++it) {
+            if (count >= 0 && static_cast<long long>(n) >= count) {
+                break;
+            }
+            reply_stream_entry(body, it->first, &it->second);
+            ++n;
+        }
+    }
+    reply_array(out, n);
+    out += body;
+    return Outcome::Replied;
+}
+
+Outcome RedisStandin::Impl::cmd_xdel(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Stream* stream = lookup<Stream>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    long long removed = 0;
+    for (size_t i = 2; i < args.size(); ++i) {
+        StreamId id;
+        if (!parse_stream_id(args[i], id)) {
+            return error(out, "ERR Invalid stream ID specified as stream command argument");
+        }
+        if (stream) {
+            removed += static_cast<long long>(stream->entries.erase(id));
+        }
+    }
+    reply_int(out, removed);
+    return Outcome::Replied;
+}
+
+// XTRIM key MAXLEN [=|~] n
+Outcome RedisStandin::Impl::cmd_xtrim(Client&, const Args& args, std::string& out) {
+    if (!iequals(args[2], "MAXLEN")) {
+        return syntax_error(out);
+    }
+    size_t i = 3;
+    if ((args[i] == "~" || args[i] == "=") && i + 1 < args.size()) {
+        ++i;
+    }
+    long long maxlen = 0;
+    if (!parse_ll(args[i], maxlen) || maxlen < 0) {
+        return error(out, "ERR The MAXLEN argument must be >= 0.");
+    }
+    bool wrong = false;
+    Stream* stream = lookup<Stream>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    reply_int(out, stream ? static_cast<long long>(stream->trim(static_cast<size_t>(maxlen))) : 0);
+    return Outcome::Replied;
+}
+
+// XGROUP CREATE key group id|$ [MKSTREAM] | DESTROY key group |
+//        CREATECONSUMER key group consumer | DELCONSUMER key group consumer
+Outcome RedisStandin::Impl::cmd_xgroup(Client&, const Args& args, std::string& out) {
+    if (args.size() < 4) {
+        return error(out, "ERR wrong number of arguments for 'xgroup' command");
+    }
+    bool wrong = false;
+    Stream* stream = lookup<Stream>(args[2], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+
+    if (iequals(args[1], "CREATE") && args.size() >= 5) {
+        bool mkstream = false;
+        for (size_t i = 5; i < args.size(); ++i) {
+            if (iequals(args[i], "MKSTREAM")) {
+                mkstream = true;
+            } else if (iequals(args[i], "ENTRIESREAD") && i + 1 < args.size()) {
+                ++i;
+            } else {
+                return syntax_error(out);
+            }
+        }
+        if (!stream && !mkstream) {
+            return error(out, "ERR The XGROUP subcommand requires the key to exist. Note that for CREATE "
+                              "you may want to use the MKSTREAM option to create an empty stream automatically.");
+        }
+        StreamId start;
+        if (args[4] != "$" && !parse_stream_id(args[4], start)) {
+            return error(out, "ERR Invalid stream ID specified as stream command argument");
+        }
+        if (!stream) {
+            stream = lookup_or_create<Stream>(args[2], wrong);
+        }
+        if (args[4] == "$") {
+            start = stream->last_id;
+        }
+        if (stream->groups.count(args[3])) {
+            return error(out, "BUSYGROUP Consumer Group name already exists");
+        }
+        stream->groups[args[3]].last_delivered = start;
+        reply_status(out, "OK");
+        return Outcome::Replied;
+    }
+
+    auto group = stream ? stream->groups.find(args[3]) : decltype(stream->groups.end()){};
+    bool has_group = stream && group != stream->groups.end();
+
+    if (iequals(args[1], "DESTROY") && args.size() == 4) {
+        if (has_group) {
+            stream->groups.erase(group);
+        }
+        reply_int(out, has_group ? 1 : 0);
+        return Outcome::Replied;
+    }
+    if ((iequals(args[1], "CREATECONSUMER") || iequals(args[1], "DELCONSUMER")) && args.size() == 5) {
+        if (!has_group) {
+            return error(out, "NOGROUP No such consumer group '" + args[3] + "' for key name '" + args[2] + "'");
+        }
+        ConsumerGroup& cg = group->second;
+        if (iequals(args[1], "CREATECONSUMER")) {
+            reply_int(out, cg.consumers.insert(args[4]).second ? 1 : 0);
+            return Outcome::Replied;
+        }
+        long long dropped = 0;
+        for (auto it = cg.pending.begin(); it != cg.pending.end();) {
+            if (it->second.consumer == args[4]) {
+                it = cg.pending.erase(it);
+                ++dropped;
+            } else {
+                ++it;
+            }
+        }
+        cg.consumers.erase(args[4]);
+        reply_int(out, dropped);
+        return Outcome::Replied;
+    }
+    return error(out, "ERR unknown subcommand '" + args[1] + "'");
+}
+
+// XREADGROUP GROUP group consumer [COUNT n] [BLOCK ms] [NOACK] STREAMS key [key ...] id [id ...]
+Outcome RedisStandin::Impl::cmd_xreadgroup(Client& c, const Args& args, std::string& out) {
+    if (!iequals(args[1], "GROUP")) {
+        return syntax_error(out);
+    }
+    const std::string& group_name = args[2];
+    const std::string& consumer = args[3];
+
+    long long count = 0;
+    long long block_ms = -1;
+    bool noack = false;
+    bool has_streams = false;
+    size_t i = 4;
+    for (; i < args.size(); ++i) {
+        if (iequals(args[i], "COUNT") && i + 1 < args.size()) {
+            if (!parse_ll(args[++i], count)) {
+                return not_integer(out);
+            }
+        } else if (iequals(args[i], "BLOCK") && i + 1 < args.size()) {
+            if (!parse_ll(args[++i], block_ms) || block_ms < 0) {
+                return error(out, "ERR timeout is not an integer or out of range");
+            }
+        } else if (iequals(args[i], "NOACK")) {
+            noack = true;
+        } else if (iequals(args[i], "STREAMS")) {
+            has_streams = true;
+            ++i;
+            break;
+        } else {
+            return syntax_error(out);
+        }
+    }
+    size_t remaining = args.size() - i;
+    if (!has_streams || remaining == 0 || remaining % 2 != 0) {
+        return error(out, "ERR Unbalanced 'xreadgroup' list of streams: for each stream key an ID or '>' "
+                          "must be specified.");
+    }
+    size_t n = remaining / 2;
+
+    struct Read {
+        const std::string* key;
+        Stream* stream;
+        ConsumerGroup* group;
+        bool fresh;      ///< ">": never-delivered entries
+        StreamId after;  ///< History read: this consumer's pending entries after this ID
+    };
+    std::vector<Read> reads;
+    reads.reserve(n);
+    bool all_fresh = true;
+    for (size_t k = 0; k < n; ++k) {
+        const std::string& key = args[i + k];
+        const std::string& id = args[i + n + k];
+        bool wrong = false;
+        Stream* stream = lookup<Stream>(key, wrong);
+        if (wrong) {
+            return wrong_type(out);
+        }
+        auto group = stream ? stream->groups.find(group_name) : decltype(stream->groups.end()){};
+        if (!stream || group == stream->groups.end()) {
+            return error(out, "NOGROUP No such key '" + key + "' or consumer group '" + group_name +
+                              "' in XREADGROUP with GROUP option");
+        }
+        Read read{&key, stream, &group->second, id == ">", StreamId{}};
+        if (!read.fresh && !parse_stream_id(id, read.after)) {
+            return error(out, "ERR Invalid stream ID specified as stream command argument");
+        }
+        all_fresh = all_fresh && read.fresh;
+        group->second.consumers.insert(consumer);
+        reads.push_back(read);
+    }
+
+    auto now = Clock::now();
+    std::string body;
+    size_t streams_in_reply = 0;
+    for (auto& read : reads) {
+        std::string entries;
+        size_t delivered = 0;
+        auto limit_reached = [&] { return count > 0 && static_cast<long long>(delivered) >= count; };
+
+        if (read.fresh) {
+            for (auto it = read.stream->entries.upper_bound(read.group->last_delivered);
+                 it != read.stream->entries.end() && !limit_reached(); ++it) {
+                read.group->last_delivered = it->first;
+                if (!noack) {
+                    read.group->pending[it->first] = PendingEntry{consumer, now, 1};
+                }
+                reply_stream_entry(entries, it->first, &it->second);
+                ++delivered;
+            }
+            if (delivered == 0) {
+                continue;  // Fresh reads only list streams that had something
+            }
+        } else {
+            for (auto it = read.group->pending.upper_bound(read.after);
+                 it != read.group->pending.end() && !limit_reached(); ++it) {
+                if (it->second.consumer != consumer) {
+                    continue;
+                }
+                it->second.delivered = now;
+                ++it->second.deliveries;
+                auto entry = read.stream->entries.find(it->first);
+                reply_stream_entry(entries, it->first,
+                                   entry != read.stream->entries.end() ? &entry->second : nullptr);
+                ++delivered;
+            }
+        }
+        reply_array(body, 2);
+        reply_bulk(body, *read.key);
+        reply_array(body, delivered);
+        body += entries;
+        ++streams_in_reply;
+    }
+
+    if (streams_in_reply > 0) {
+        reply_array(out, streams_in_reply);
+        out += body;
+        return Outcome::Replied;
+    }
+    if (block_ms < 0 || !all_fresh) {
+        out += kNilArray;
+        return Outcome::Replied;
+    }
+    std::vector<std::string> keys;
+    for (const auto& read : reads) {
+        keys.push_back(*read.key);
+    }
+    return block_on(c, args, std::move(keys), static_cast<double>(block_ms) / 1000.0, kNilArray, out);
+}
+
+Outcome RedisStandin::Impl::cmd_xack(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Stream* stream = lookup<Stream>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    auto group = stream ? stream->groups.find(args[2]) : decltype(stream->groups.end()){};
+    long long acked = 0;
+    for (size_t i = 3; i < args.size(); ++i) {
+        StreamId id;
+        if (!parse_stream_id(args[i], id)) {
+            return error(out, "ERR Invalid stream ID specified as stream command argument");
+        }
+        if (stream && group != stream->groups.end()) {
+            acked += static_cast<long long>(group->second.pending.erase(id));
+        }
+    }
+    reply_int(out, acked);
+    return Outcome::Replied;
+}
+
+// XPENDING key group  (summary)
+// XPENDING key group [IDLE min-idle] start end count [consumer]  (extended)
+Outcome RedisStandin::Impl::cmd_xpending(Client&, const Args& args, std::string& out) {
+    bool wrong = false;
+    Stream* stream = lookup<Stream>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    auto group = stream ? stream->groups.find(args[2]) : decltype(stream->groups.end()){};
+    if (!stream || group == stream->groups.end()) {
+        return error(out, "NOGROUP No such key '" + args[1] + "' or consumer group '" + args[2] + "'");
+    }
+    const auto& pending = group->second.pending;
+
+    if (args.size() == 3) {
+        if (pending.empty()) {
+            reply_array(out, 4);
+            reply_int(out, 0);
+            out += kNilBulk;
+            out += kNilBulk;
+            out += kNilArray;
+            return Outcome::Replied;
+        }
+        std::map<std::string, long long> per_consumer;
+        for (const auto& [id, entry] : pending) {
+            ++per_consumer[entry.consumer];
+        }
+        reply_array(out, 4);
+        reply_int(out, static_cast<long long>(pending.size()));
+        reply_bulk(out, pending.begin()->first.str());
+        reply_bulk(out, pending.rbegin()->first.str());
+        reply_array(out, per_consumer.size());
+        for (const auto& [consumer, n] : per_consumer) {
+            reply_array(out, 2);
+            reply_bulk(out, consumer);
+            reply_bulk(out, std::to_string(n));
+        }
+        return Outcome::Replied;
+    }
+
+    size_t i = 3;
+    long long min_idle = 0;
+    if (iequals(args[i], "IDLE") && i + 1 < args.size()) {
+        if (!parse_ll(args[i + 1], min_idle)) {
+            return not_integer(out);
+        }
+        i += 2;
+    }
+    if (args.size() - i < 3 || args.size() - i > 4) {
+        return syntax_error(out);
+    }
+    StreamId start;
+    StreamId end;
+    long long count = 0;
+    if (!parse_stream_id(args[i], start, 0) ||
+        !parse_stream_id(args[i + 1], end, std::numeric_limits<uint64_t>::max())) {
+        return error(out, "ERR Invalid stream ID specified as stream command argument");
+    }
+    if (!parse_ll(args[i + 2], count)) {
+        return not_integer(out);
+    }
+    const std::string* consumer = args.size() - i == 4 ? &args[i + 3] : nullptr;
+
+    auto now = Clock::now();
+    std::string body;
+    size_t n = 0;
+    for (auto it = pending.lower_bound(start);
+         it != pending.end() && it->first <= end && static_cast<long long>(n) < count; ++it) {
+        if (consumer && it->second.consumer != *consumer) {
+            continue;
+        }
+        auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second.delivered).count();
+        if (idle < min_idle) {
+            continue;
+        }
+        reply_array(body, 4);
+        reply_bulk(body, it->first.str());
+        reply_bulk(body, it->second.consumer);
+        reply_int(body, idle);
+        reply_int(body, static_cast<long long>(it->second.deliveries));
+        ++n;
+    }
+    reply_array(out, n);
+    out += body;
+    return Outcome::Replied;
+}
+
+// XAUTOCLAIM key group consumer min-idle-time start [COUNT count] [JUSTID]
+Outcome RedisStandin::Impl::cmd_xautoclaim(Client&, const Args& args, std::string& out) {
+    long long min_idle = 0;
+    if (!parse_ll(args[4], min_idle) || min_idle < 0) {
+        return error(out, "ERR Invalid min-idle-time argument for XAUTOCLAIM");
+    }
+    StreamId start;
+    if (!parse_stream_id(args[5], start)) {
+        return error(out, "ERR Invalid stream ID specified as stream command argument");
+    }
+    long long count = 100;
+    bool just_id = false;
+    for (size_t i = 6; i < args.size(); ++i) {
+        if (iequals(args[i], "COUNT") && i + 1 < args.size()) {
+            if (!parse_ll(args[++i], count) || count < 1) {
+                return error(out, "ERR COUNT must be > 0");
+            }
+        } else if (iequals(args[i], "JUSTID")) {
+            just_id = true;
+        } else {
+            return syntax_error(out);
+        }
+    }
+
+    bool wrong = false;
+    Stream* stream = lookup<Stream>(args[1], wrong);
+    if (wrong) {
+        return wrong_type(out);
+    }
+    auto group = stream ? stream->groups.find(args[2]) : decltype(stream->groups.end()){};
+    if (!stream || group == stream->groups.end()) {
+        return error(out, "NOGROUP No such key '" + args[1] + "' or consumer group '" + args[2] + "'");
+    }
+    ConsumerGroup& cg = group->second;
+    cg.consumers.insert(args[3]);
+
+    auto now = Clock::now();
+    std::string claimed;
+    size_t n_claimed = 0;
+    std::vector<StreamId> deleted;
+    long long attempts = count * 10;  // Same scan budget as Redis
+
+    auto it = cg.pending.lower_bound(start);
+    while (it != cg.pending.end() && static_cast<long long>(n_claimed) < count && attempts-- > 0) {
+        auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second.delivered).count();
+        if (idle < min_idle) {
+            ++it;
+            continue;
+        }
+        auto entry = stream->entries.find(it->first);
+        if (entry == stream->entries.end()) {
+            deleted.push_back(it->first);  // Trimmed while pending: drop from the PEL
+            it = cg.pending.erase(it);
+            continue;
+        }
+        it->second.consumer = args[3];
+        it->second.delivered = now;
+        if (!just_id) {
+            ++it->second.deliveries;
+            reply_stream_entry(claimed, it->first, &entry->second);
+        } else {
+            reply_bulk(claimed, it->first.str());
+        }
+        ++n_claimed;
+        ++it;
+    }
+
+    reply_array(out, 3);
+    reply_bulk(out, it == cg.pending.end() ? std::string("0-0") : it->first.str());
+    reply_array(out, n_claimed);
+    out += claimed;
+    reply_array(out, deleted.size());
+    for (const auto& id : deleted) {
+        reply_bulk(out, id.str());
+    }
+    return Outcome::Replied;
+}
+
+// ============================================================================
+// Public Interface
+// ============================================================================
+
+RedisStandin::RedisStandin()
+    : RedisStandin(Options{})
+{
+}
+
+RedisStandin::RedisStandin(const Options& options)
+    : impl_(std::make_unique<Impl>(options))
+{
+}
+
+RedisStandin::~RedisStandin() {
+    stop();
+}
+
+bool RedisStandin::start() {
+    if (impl_->running.load()) {
+        return true;
+    }
+    if (!impl_->open_listener()) {
+        return false;
+    }
+    if (::pipe(impl_->wake_fds) != 0) {
+        impl_->close_listener();
+        return false;
+    }
+    set_nonblocking(impl_->wake_fds[0]);
+    if (!impl_->options.unix_path.empty()) {
+        impl_->bound_port = 0;
+    }
+
+    impl_->running.store(true, std::memory_order_release);
+    impl_->loop_thread = std::thread([impl = impl_.get()] { impl->run_loop(); });
+    return true;
+}
+
+void RedisStandin::stop() {
+    if (!impl_->loop_thread.joinable()) {
+        return;
+    }
+    impl_->running.store(false, std::memory_order_release);
+    char wake = 1;
+    ssize_t written = ::write(impl_->wake_fds[1], &wake, 1);  // Interrupt poll()
+    (void)written;
+    impl_->loop_thread.join();
+
+    ::close(impl_->wake_fds[0]);
+    ::close(impl_->wake_fds[1]);
+    impl_->wake_fds[0] = impl_->wake_fds[1] = -1;
+    impl_->close_listener();
+    if (!impl_->options.unix_path.empty()) {
+        ::unlink(impl_->options.unix_path.c_str());
+    }
+    impl_->db.clear();
+}
+
+bool RedisStandin::is_running() const {
+    return impl_->running.load(std::memory_order_acquire);
+}
+
+int RedisStandin::port() const {
+    return impl_->bound_port;
+}
+
+const std::string& RedisStandin::unix_path() const {
+    return impl_->options.unix_path;
+}
+
+RedisStandin::Stats RedisStandin::get_stats() const {
+    Stats stats;
+    stats.connections_accepted = impl_->connections_accepted.load(std::memory_order_relaxed);
+    stats.commands_processed = impl_->commands_processed.load(std::memory_order_relaxed);
+    stats.keys = impl_->key_count.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace telemetry_common
@@ -0,0 +1,255 @@
+#include "telemetry_common/sharded_redis_client.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+
+namespace telemetry_common {
+
+namespace {
+
+std::vector<std::string> endpoint_names(const ShardedRedisClient::Options& options) {
+    if (options.shards.empty()) {
+        throw std::invalid_argument("ShardedRedisClient: no shards configured");
+    }
+    std::vector<std::string> names;
+    names.reserve(options.shards.size());
+    for (const auto& shard : options.shards) {
+        names.push_back(ShardedRedisClient::endpoint_name(shard));
+    }
+    return names;
+}
+
+} // namespace
+
+// ========== Constructor & Destructor ==========
+
+ShardedRedisClient::ShardedRedisClient(Options options)
+    : options_(std::move(options)),
+      ring_(endpoint_names(options_), options_.virtual_nodes)
+{
+    // Pins name endpoints, not positions: reordering Options::shards must not move a queue
+    const auto& nodes = ring_.nodes();
+    for (const auto& pin : options_.pinned) {
+        auto it = std::find(nodes.begin(), nodes.end(), pin.second);
+        if (it == nodes.end()) {
+            throw std::invalid_argument("ShardedRedisClient: key '" + pin.first +
+                                        "' pinned to unknown endpoint '" + pin.second + "'");
+        }
+        pinned_.emplace(pin.first, static_cast<size_t>(it - nodes.begin()));
+    }
+    shards_.reserve(options_.shards.size());
+    for (const auto& shard : options_.shards) {
+        shards_.push_back(std::make_unique<RedisClient>(shard));  // Throws if unreachable
+    }
+}
+
+ShardedRedisClient::~ShardedRedisClient() = default;
+
+// ========== Routing ==========
+
+size_t ShardedRedisClient::shard_index(const std::string& key) const {
+    if (!pinned_.empty()) {
+        auto it = pinned_.find(key);
+        if (it != pinned_.end()) {
+            return it->second;
+        }
+    }
+    return ring_.node_for(key);
+}
+
+std::string ShardedRedisClient::endpoint_name(const RedisClient::ConnectionOptions& options) {
+    if (!options.unix_socket.empty()) {
+        return options.unix_socket;
+    }
+    return options.host + ":" + std::to_string(options.port);
+}
+
+// ========== Single-key Operations (routed) ==========
+
+bool ShardedRedisClient::set(const std::string& key, const std::string& value, int ttl_seconds) {
+    return for_key(key).set(key, value, ttl_seconds);
+}
+
+std::optional<std::string> ShardedRedisClient::get(const std::string& key) {
+    return for_key(key).get(key);
+}
+
+int ShardedRedisClient::del(const std::string& key) {
+    return for_key(key).del(key);
+}
+
+long long ShardedRedisClient::incr(const std::string& key) {
+    return for_key(key).incr(key);
+}
+
+long long ShardedRedisClient::lpush(const std::string& key, const std::string& value) {
+    return for_key(key).lpush(key, value);
+}
+
+long long ShardedRedisClient::lpush_many(const std::string& key, const std::vector<std::string>& values) {
+    return for_key(key).lpush_many(key, values);
+}
+
+std::optional<std::string> ShardedRedisClient::rpop(const std::string& key) {
+    return for_key(key).rpop(key);
+}
+
+std::vector<std::string> ShardedRedisClient::rpop_count(const std::string& key, long long count) {
+    return for_key(key).rpop_count(key, count);
+}
+
+std::vector<std::string> ShardedRedisClient::brpop_batch(const std::string& key, long long max_count,
+                                                         int timeout_seconds) {
+    return for_key(key).brpop_batch(key, max_count, timeout_seconds);
+}
+
+long long ShardedRedisClient::llen(const std::string& key) {
+    return for_key(key).llen(key);
+}
+
+// ========== Batch Operations (Pipelining) ==========
+
+ShardedRedisClient::Pipeline::Pipeline(ShardedRedisClient& client)
+    : client_(client), pipes_(client.shard_count()), queued_(client.shard_count(), 0)
+{
+}
+
+ShardedRedisClient::Pipeline::~Pipeline() = default;
+ShardedRedisClient::Pipeline::Pipeline(Pipeline&&) noexcept = default;
+
+template <typename Fn>
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::queue(const std::string& key, Fn&& fn) {
+    const size_t shard = client_.shard_index(key);
+    if (!pipes_[shard]) {
+        pipes_[shard].emplace(client_.shard(shard).pipeline());
+    }
+    fn(*pipes_[shard]);
+    order_.emplace_back(shard, queued_[shard]++);
+    return *this;
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::set(const std::string& key, const std::string& value,
+                                                                int ttl_seconds) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.set(key, value, ttl_seconds); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::get(const std::string& key) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.get(key); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::del(const std::string& key) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.del(key); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::expire(const std::string& key, int seconds) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.expire(key, seconds); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::lpush(const std::string& key, const std::string& value) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.lpush(key, value); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::lpush_many(const std::string& key,
+                                                                       const std::vector<std::string>& values) {
+    if (values.empty()) return *this;
+    return queue(key, [&](RedisClient::Pipeline& p) { p.lpush_many(key, values); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::rpop(const std::string& key) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.rpop(key); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::rpop_count(const std::string& key, long long count) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.rpop_count(key, count); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::llen(const std::string& key) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.llen(key); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::sadd(const std::string& key, const std::string& member) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.sadd(key, member); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::srem(const std::string& key, const std::string& member) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.srem(key, member); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::zadd(const std::string& key, const std::string& member,
+                                                                 double score) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.zadd(key, member, score); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::incr(const std::string& key) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.incr(key); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::decr(const std::string& key) {
+    return queue(key, [&](RedisClient::Pipeline& p) { p.decr(key); });
+}
+
+ShardedRedisClient::Pipeline& ShardedRedisClient::Pipeline::command(const std::vector<std::string>& args) {
+    if (args.size() < 2) return *this;  // No key to route by
+    return queue(args[1], [&](RedisClient::Pipeline& p) { p.command(args); });
+}
+
+std::vector<RedisClient::Reply> ShardedRedisClient::Pipeline::exec() {
+    std::vector<size_t> touched;
+    for (size_t shard = 0; shard < pipes_.size(); ++shard) {
+        if (queued_[shard] != 0) {
+            touched.push_back(shard);
+        }
+    }
+
+    // One batch per shard; all but the first go out from their own thread so the round trips overlap
+    std::vector<std::vector<RedisClient::Reply>> replies(pipes_.size());
+    std::vector<std::future<void>> pending;
+    for (size_t i = 1; i < touched.size(); ++i) {
+        const size_t shard = touched[i];
+        pending.push_back(std::async(std::launch::async,
+                                     [this, &replies, shard] { replies[shard] = pipes_[shard]->exec(); }));
+    }
+    if (!touched.empty()) {
+        replies[touched[0]] = pipes_[touched[0]]->exec();
+    }
+    for (auto& f : pending) {
+        f.get();
+    }
+
+    std::vector<RedisClient::Reply> result;
+    result.reserve(order_.size());
+    for (const auto& [shard, position] : order_) {
+        // A failed batch comes back empty: its commands read as nil
+        result.push_back(position < replies[shard].size() ? std::move(replies[shard][position])
+                                                          : RedisClient::Reply{});
+    }
+    order_.clear();
+    std::fill(queued_.begin(), queued_.end(), 0);
+    return result;
+}
+
+ShardedRedisClient::Pipeline ShardedRedisClient::pipeline() {
+    return Pipeline(*this);
+}
+
+// ========== Statistics & Debugging ==========
+
+std::string ShardedRedisClient::metrics() const {
+    nlohmann::json shards = nlohmann::json::array();
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        shards.push_back({
+            {"endpoint", ring_.nodes()[i]},
+            {"pool", nlohmann::json::parse(shards_[i]->pool_metrics())},
+            {"cache", nlohmann::json::parse(shards_[i]->cache_metrics())},
+        });
+    }
+    nlohmann::json j{
+        {"shards", shards},
+        {"virtual_nodes", options_.virtual_nodes},
+        {"pinned_keys", pinned_.size()},
+    };
+    return j.dump();
+}
+
+} // namespace telemetry_common
@@ -0,0 +1,127 @@
+#include "telemetry_common/stream_task_queue.h"
+#include "telemetry_common/uuid_generator.h"
+#include <algorithm>
+#include <iterator>
+
+namespace telemetry_common {
+
+StreamTaskQueue::StreamTaskQueue(RedisClient& client, Options options)
+    : client_(client)
+    , options_(std::move(options))
+{
+    if (options_.consumer.empty()) {
+        options_.consumer = "consumer-" + generate_uuid();
+    }
+}
+
+bool StreamTaskQueue::ensure_group() {
+    // "0": a freshly created group also receives tasks published before it existed
+    return client_.xgroup_create(options_.stream_key, options_.group, "0");
+}
+
+// ========== Producer Side ==========
+
+std::string StreamTaskQueue::publish(const std::string& payload) {
+    auto id = client_.xadd(options_.stream_key, {{kPayloadField, payload}}, options_.maxlen);
+    if (!id.empty()) {
+        ++stats_.published;
+    }
+    return id;
+}
+
+size_t StreamTaskQueue::publish_batch(const std::vector<std::string>& payloads) {
+    if (payloads.empty()) {
+        return 0;
+    }
+    std::vector<StreamFields> entries;
+    entries.reserve(payloads.size());
+    for (const auto& payload : payloads) {
+        entries.push_back({{kPayloadField, payload}});
+    }
+    size_t published = client_.xadd_many(options_.stream_key, entries, options_.maxlen).size();
+    stats_.published += published;
+    return published;
+}
+
+// ========== Consumer Side ==========
+
+std::vector<StreamTaskQueue::Message> StreamTaskQueue::read_batch() {
+    std::vector<Message> batch;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_claim_ >= options_.claim_interval) {
+        last_claim_ = now;
+        batch = claim_stuck();
+    }
+
+    long long remaining = options_.batch_size - static_cast<long long>(batch.size());
+    if (remaining <= 0) {
+        return batch;
+    }
+
+    // Don't block if recovered tasks are already waiting to be processed
+    int block_ms = batch.empty() ? options_.block_ms : 0;
+    auto fresh = to_messages(
+        client_.xreadgroup(options_.stream_key, options_.group, options_.consumer, remaining, block_ms),
+        false);
+    stats_.delivered += fresh.size();
+
+    if (batch.empty()) {
+        return fresh;
+    }
+    batch.insert(batch.end(),
+                 std::make_move_iterator(fresh.begin()),
+                 std::make_move_iterator(fresh.end()));
+    return batch;
+}
+
+std::vector<StreamTaskQueue::Message> StreamTaskQueue::claim_stuck() {
+    auto claimed = to_messages(
+        client_.xautoclaim(options_.stream_key, options_.group, options_.consumer,
+                           options_.claim_min_idle.count(), options_.batch_size, claim_cursor_),
+        true);
+    stats_.claimed += claimed.size();
+    return claimed;
+}
+
+size_t StreamTaskQueue::ack(const std::vector<std::string>& ids) {
+    if (ids.empty()) {
+        return 0;
+    }
+    auto acked = static_cast<size_t>(client_.xack(options_.stream_key, options_.group, ids));
+    stats_.acked += acked;
+    return acked;
+}
+
+long long StreamTaskQueue::length() {
+    return client_.xlen(options_.stream_key);
+}
+
+std::vector<StreamTaskQueue::Message> StreamTaskQueue::to_messages(std::vector<StreamEntry>&& entries,
+                                                                   bool redelivered) {
+    std::vector<Message> messages;
+    std::vector<std::string> unreadable;
+    messages.reserve(entries.size());
+    for (auto& entry : entries) {
+        auto field = std::find_if(entry.fields.begin(), entry.fields.end(),
+                                  [](const auto& f) { return f.first == kPayloadField; });
+        if (field == entry.fields.end()) {
+            // Trimmed while pending (nil field list) or not one of our tasks:
+            // handing it out would only redeliver an empty payload forever
+            unreadable.push_back(std::move(entry.id));
+            continue;
+        }
+        Message msg;
+        msg.id = std::move(entry.id);
+        msg.payload = std::move(field->second);
+        msg.redelivered = redelivered;
+        messages.push_back(std::move(msg));
+    }
+    if (!unreadable.empty()) {
+        client_.xack(options_.stream_key, options_.group, unreadable);
+        stats_.dropped += unreadable.size();
+    }
+    return messages;
+}
+
+} // namespace telemetry_common
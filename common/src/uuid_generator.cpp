@@ -1,31 +1,180 @@
 #include "telemetry_common/uuid_generator.h"
+#include <chrono>
 #include <random>
-#include <sstream>
-#include <iomanip>
+#include <thread>
 
 namespace telemetry_common {
 
+namespace {
+
+/**
+ * xoshiro256** - 4x64-bit state, ~1 ns per 64-bit draw, passes BigCrush.
+ * Not cryptographic: fine for IDs, never for secrets or tokens.
+ */
+class Xoshiro256 {
+public:
+    Xoshiro256() {
+        // Seed through splitmix64 so a weak seed still spreads over all state bits
+        std::random_device rd;
+        uint64_t seed = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+        seed ^= std::hash<std::thread::id>{}(std::this_thread::get_id());
+        for (auto& word : s_) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        const uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s_[4];
+};
+
+Xoshiro256& thread_rng() {
+    thread_local Xoshiro256 rng;  // Per thread: no lock, no false sharing
+    return rng;
+}
+
+void store_be(uint8_t* out, uint64_t value) {
+    for (int i = 7; i >= 0; --i) {
+        out[i] = static_cast<uint8_t>(value);
+        value >>= 8;
+    }
+}
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+// Byte index -> '-' goes before these bytes in the text form
+constexpr bool is_group_start(size_t i) {
+    return i == 4 || i == 6 || i == 8 || i == 10;
+}
+
+} // namespace
+
+Uuid Uuid::v4() {
+    Xoshiro256& rng = thread_rng();
+    Uuid id;
+    store_be(&id.bytes[0], rng.next());
+    store_be(&id.bytes[8], rng.next());
+    id.bytes[6] = static_cast<uint8_t>((id.bytes[6] & 0x0F) | 0x40);  // Version 4
+    id.bytes[8] = static_cast<uint8_t>((id.bytes[8] & 0x3F) | 0x80);  // Variant 10xx
+    return id;
+}
+
+Uuid Uuid::v7() {
+    struct Clock {
+        uint64_t last_ms = 0;
+        uint16_t counter = 0;  // 12-bit rand_a, reseeded every new millisecond
+    };
+    thread_local Clock clock;
+    Xoshiro256& rng = thread_rng();
+
+    uint64_t now_ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    const uint64_t random = rng.next();
+
+    if (now_ms > clock.last_ms) {
+        clock.last_ms = now_ms;
+        clock.counter = static_cast<uint16_t>(random & 0x7FF);  // Top bit clear: room to count
+    } else if (++clock.counter > 0xFFF) {
+        // Counter exhausted (or clock went backwards): borrow the next millisecond
+        ++clock.last_ms;
+        clock.counter = 0;
+    }
+
+    Uuid id;
+    store_be(&id.bytes[0], clock.last_ms << 16);  // 48-bit timestamp, low 2 bytes overwritten
+    id.bytes[6] = static_cast<uint8_t>(0x70 | (clock.counter >> 8));  // Version 7
+    id.bytes[7] = static_cast<uint8_t>(clock.counter);
+    store_be(&id.bytes[8], rng.next());
+    id.bytes[8] = static_cast<uint8_t>((id.bytes[8] & 0x3F) | 0x80);  // Variant 10xx
+    return id;
+}
+
+std::optional<Uuid> Uuid::parse(std::string_view text) {
+    if (text.size() != kStringLength) {
+        return std::nullopt;
+    }
+    Uuid id;
+    size_t pos = 0;
+    for (size_t i = 0; i < id.bytes.size(); ++i) {
+        if (is_group_start(i) && text[pos++] != '-') {
+            return std::nullopt;
+        }
+        const int hi = hex_value(text[pos++]);
+        const int lo = hex_value(text[pos++]);
+        if (hi < 0 || lo < 0) {
+            return std::nullopt;
+        }
+        id.bytes[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return id;
+}
+
+bool Uuid::is_nil() const {
+    for (uint8_t b : bytes) {
+        if (b != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Uuid::format(char* out) const {
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        if (is_group_start(i)) {
+            *out++ = '-';
+        }
+        *out++ = kHexDigits[bytes[i] >> 4];
+        *out++ = kHexDigits[bytes[i] & 0x0F];
+    }
+}
+
+std::string Uuid::to_string() const {
+    std::string text(kStringLength, '\0');  // One allocation, no stream
+    format(text.data());
+    return text;
+}
+
 std::string generate_uuid() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(0, 15);
-    static std::uniform_int_distribution<> dis2(8, 11);
-
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
-    
-    for (int i = 0; i < 8; i++) ss << dis(gen);
-    ss << "-";
-    for (int i = 0; i < 4; i++) ss << dis(gen);
-    ss << "-4";  // Version 4
-    for (int i = 0; i < 3; i++) ss << dis(gen);
-    ss << "-";
-    ss << dis2(gen);  // Variant bits
-    for (int i = 0; i < 3; i++) ss << dis(gen);
-    ss << "-";
-    for (int i = 0; i < 12; i++) ss << dis(gen);
-    
-    return ss.str();
+    return Uuid::v4().to_string();
+}
+
+std::string generate_uuid_v7() {
+    return Uuid::v7().to_string();
 }
 
 } // namespace telemetry_common
+
+size_t std::hash<telemetry_common::Uuid>::operator()(const telemetry_common::Uuid& id) const noexcept {
+    // Random bits are already uniform; fold the two halves (v7: time + random)
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        hi = (hi << 8) | id.bytes[i];
+        lo = (lo << 8) | id.bytes[i + 8];
+    }
+    return static_cast<size_t>(lo ^ (hi * 0x9E3779B97F4A7C15ULL));
+}
@@ -0,0 +1,138 @@
+// Client-side cache unit tests
+//
+// Exercises the cache on its own; RedisClient only adds the GET on a miss
+// and the invalidation feed.
+//
+// Interview Talking Points:
+// - Negative caching: a missing key is a cacheable answer too
+// - Fill race: a value fetched before an invalidation must not be stored after it
+// - TTL as the staleness bound when the server cannot push invalidations
+
+#include "telemetry_common/client_cache.h"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace telemetry_common;
+using namespace std::chrono_literals;
+
+namespace {
+
+ClientCache::Options cache_options(size_t max_entries, std::chrono::milliseconds ttl) {
+    ClientCache::Options options;
+    options.max_entries = max_entries;
+    options.ttl = ttl;
+    return options;
+}
+
+} // namespace
+
+TEST(ClientCacheTest, HitsAfterFillAndCachesMissingKeys) {
+    ClientCache cache(cache_options(100, 10s));
+
+    auto first = cache.lookup("device:meta:1");
+    EXPECT_FALSE(first.hit);
+    EXPECT_TRUE(cache.fill("device:meta:1", std::string("{\"fw\":\"1.2\"}"), first.fill_token));
+    auto absent = cache.lookup("device:meta:404");
+    EXPECT_TRUE(cache.fill("device:meta:404", std::nullopt, absent.fill_token));
+
+    auto hit = cache.lookup("device:meta:1");
+    ASSERT_TRUE(hit.hit);
+    EXPECT_EQ(hit.value, std::optional<std::string>("{\"fw\":\"1.2\"}"));
+    auto negative = cache.lookup("device:meta:404");
+    EXPECT_TRUE(negative.hit);
+    EXPECT_FALSE(negative.value.has_value());
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.fills, 2u);
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_DOUBLE_EQ(stats.hit_rate(), 0.5);
+}
+
+TEST(ClientCacheTest, EntriesExpireAfterTtl) {
+    ClientCache cache(cache_options(100, 30ms));
+    auto miss = cache.lookup("thresholds:temp");
+    cache.fill("thresholds:temp", std::string("85"), miss.fill_token);
+    EXPECT_TRUE(cache.lookup("thresholds:temp").hit);
+
+    std::this_thread::sleep_for(60ms);
+    EXPECT_FALSE(cache.lookup("thresholds:temp").hit);
+    EXPECT_EQ(cache.stats().expirations, 1u);
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+TEST(ClientCacheTest, EvictsLeastRecentlyUsedAtCapacity) {
+    ClientCache cache(cache_options(32, 10s));  // 2 entries per shard
+    auto hot = cache.lookup("hot");
+    cache.fill("hot", std::string("h"), hot.fill_token);
+
+    for (int i = 0; i < 200; ++i) {
+        const std::string key = "key:" + std::to_string(i);
+        auto miss = cache.lookup(key);
+        cache.fill(key, std::string("v"), miss.fill_token);
+        EXPECT_TRUE(cache.lookup("hot").hit) << "after " << key;  // Kept most recent
+    }
+
+    auto stats = cache.stats();
+    EXPECT_LE(stats.entries, 32u);
+    EXPECT_EQ(stats.evictions, 201u - stats.entries);
+}
+
+TEST(ClientCacheTest, InvalidationDuringFetchDropsTheFill) {
+    ClientCache cache(cache_options(100, 10s));
+
+    // Reader misses and goes to Redis; a writer changes the key meanwhile
+    auto miss = cache.lookup("device:meta:7");
+    cache.invalidate("device:meta:7");
+    EXPECT_FALSE(cache.fill("device:meta:7", std::string("old"), miss.fill_token));
+    EXPECT_FALSE(cache.lookup("device:meta:7").hit);
+
+    auto again = cache.lookup("device:meta:7");
+    EXPECT_TRUE(cache.fill("device:meta:7", std::string("new"), again.fill_token));
+    cache.invalidate(std::vector<std::string>{"device:meta:7"});
+    EXPECT_FALSE(cache.lookup("device:meta:7").hit);
+
+    auto before_flush = cache.lookup("device:meta:8");
+    cache.clear();
+    EXPECT_FALSE(cache.fill("device:meta:8", std::string("old"), before_flush.fill_token));
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.dropped_fills, 2u);
+    EXPECT_EQ(stats.invalidations, 1u);  // Only the entry that was actually cached
+    EXPECT_EQ(stats.flushes, 1u);
+}
+
+TEST(ClientCacheTest, OnlyConfiguredPrefixesAreCacheable) {
+    auto options = cache_options(100, 10s);
+    options.prefixes = {"device:meta:", "thresholds:"};
+    ClientCache cache(options);
+
+    EXPECT_TRUE(cache.cacheable("device:meta:42"));
+    EXPECT_TRUE(cache.cacheable("thresholds:temp"));
+    EXPECT_FALSE(cache.cacheable("telemetry:tasks:pending"));
+    EXPECT_FALSE(cache.cacheable("device:"));
+
+    ClientCache everything(cache_options(100, 10s));
+    EXPECT_TRUE(everything.cacheable("telemetry:tasks:pending"));
+    EXPECT_THROW(ClientCache(cache_options(0, 10s)), std::invalid_argument);
+}
+
+TEST(ClientCacheTest, StatsExportAsJson) {
+    ClientCache cache(cache_options(100, 10s));
+    auto miss = cache.lookup("k");
+    cache.fill("k", std::string("v"), miss.fill_token);
+    cache.lookup("k");
+    cache.set_tracking(true);
+
+    auto j = nlohmann::json::parse(cache.stats().to_json());
+    EXPECT_EQ(j["hits"], 1);
+    EXPECT_EQ(j["misses"], 1);
+    EXPECT_EQ(j["entries"], 1);
+    EXPECT_EQ(j["tracking"], true);
+    EXPECT_DOUBLE_EQ(j["hit_rate"].get<double>(), 0.5);
+}
@@ -0,0 +1,198 @@
+// Connection pool unit tests
+//
+// Fake connections instead of redis++, so these run without a server.
+//
+// Interview Talking Points:
+// - Pool starvation shows up as borrow wait, not as command latency
+// - Lazy creation: a pool of 5 used by one thread opens one connection
+// - Grow fast, shrink slowly: hysteresis keeps the size from flapping
+
+#include "telemetry_common/connection_pool.h"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace telemetry_common;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Mock: stands in for a client connection
+struct FakeConnection {
+    int id;
+};
+
+class ConnectionPoolTest : public ::testing::Test {
+protected:
+    std::unique_ptr<ConnectionPool<FakeConnection>> make_pool(PoolOptions options) {
+        return std::make_unique<ConnectionPool<FakeConnection>>(
+            [this] { return std::make_unique<FakeConnection>(FakeConnection{++created_}); }, options);
+    }
+
+    std::atomic<int> created_{0};
+};
+
+} // namespace
+
+TEST_F(ConnectionPoolTest, ReusesIdleConnectionsLazily) {
+    PoolOptions options;
+    options.initial_size = 4;
+    auto pool = make_pool(options);
+
+    for (int i = 0; i < 10; ++i) {
+        auto conn = pool->borrow();
+        EXPECT_EQ(conn->id, 1);  // LIFO: always the same warm connection
+    }
+    {
+        auto a = pool->borrow();
+        auto b = pool->borrow();
+        EXPECT_NE(a->id, b->id);
+        EXPECT_EQ(pool->stats().in_use, 2u);
+    }
+
+    auto stats = pool->stats();
+    EXPECT_EQ(created_, 2);
+    EXPECT_EQ(stats.size, 4u);
+    EXPECT_EQ(stats.open, 2u);
+    EXPECT_EQ(stats.idle, 2u);
+    EXPECT_EQ(stats.in_use, 0u);
+    EXPECT_EQ(stats.peak_in_use, 2u);
+    EXPECT_EQ(stats.borrows, 12u);
+    EXPECT_EQ(stats.waits, 0u);
+    EXPECT_EQ(stats.wait_histogram[0], 12u);  // All in the "no wait" bucket
+    EXPECT_EQ(stats.wait_quantile_ms(0.99), 0.0);
+}
+
+TEST_F(ConnectionPoolTest, WaitsAreMeasuredAndTimeoutsCounted) {
+    PoolOptions options;
+    options.initial_size = 1;
+    options.borrow_timeout = 200ms;
+    auto pool = make_pool(options);
+
+    {
+        auto held = pool->borrow();
+        std::thread releaser([&held] {
+            std::this_thread::sleep_for(30ms);
+            held = ConnectionPool<FakeConnection>::Lease();
+        });
+        auto conn = pool->borrow();  // Waits for the releaser
+        EXPECT_TRUE(conn);
+        releaser.join();
+    }
+
+    auto held = pool->borrow();
+    options.borrow_timeout = 20ms;
+    auto short_pool = make_pool(options);
+    auto other = short_pool->borrow();
+    EXPECT_THROW(short_pool->borrow(), PoolTimeout);
+
+    auto stats = pool->stats();
+    EXPECT_EQ(stats.borrows, 3u);
+    EXPECT_EQ(stats.waits, 1u);
+    EXPECT_EQ(stats.timeouts, 0u);
+    EXPECT_GE(stats.mean_wait_ms(), 5.0);
+    EXPECT_GE(stats.wait_quantile_ms(1.0), 10.0);   // The 30 ms wait, in the 50 ms bucket
+    EXPECT_LE(stats.wait_quantile_ms(1.0), 100.0);
+
+    auto timed_out = short_pool->stats();
+    EXPECT_EQ(timed_out.timeouts, 1u);
+    EXPECT_EQ(timed_out.waits, 1u);
+    EXPECT_EQ(timed_out.in_use, 1u);
+}
+
+TEST_F(ConnectionPoolTest, AdaptiveGrowsUnderStarvationAndShrinksWhenIdle) {
+    PoolOptions options;
+    options.adaptive = true;
+    options.initial_size = 1;
+    options.min_size = 1;
+    options.max_size = 8;
+    options.target_wait = 1ms;
+    options.adapt_interval = 20ms;
+    options.shrink_after = 60ms;
+    auto pool = make_pool(options);
+
+    // Six callers holding a connection 5 ms each starve a pool of one
+    std::atomic<bool> busy{true};
+    std::vector<std::thread> callers;
+    for (int t = 0; t < 6; ++t) {
+        callers.emplace_back([&] {
+            while (busy) {
+                auto conn = pool->borrow();
+                std::this_thread::sleep_for(5ms);
+            }
+        });
+    }
+    std::this_thread::sleep_for(400ms);
+    busy = false;
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    auto grown = pool->stats();
+    EXPECT_GT(grown.grown, 0u);
+    EXPECT_GE(grown.size, 6u);
+    EXPECT_LE(grown.size, 8u);
+
+    // One caller needs one connection: the pool steps back down, keeping one spare
+    const auto until = std::chrono::steady_clock::now() + 1500ms;
+    while (pool->stats().size > 2 && std::chrono::steady_clock::now() < until) {
+        auto conn = pool->borrow();
+        std::this_thread::sleep_for(2ms);
+    }
+    auto shrunk = pool->stats();
+    EXPECT_EQ(shrunk.size, 2u);
+    EXPECT_GE(shrunk.shrunk, grown.size - 2);  // The last busy window may still add one step
+    EXPECT_LE(shrunk.open, 2u);  // Idle connections closed as it shrank
+}
+
+TEST_F(ConnectionPoolTest, FixedPoolIgnoresBounds) {
+    PoolOptions options;
+    options.initial_size = 2;
+    options.min_size = 5;    // Only meaningful when adaptive
+    options.max_size = 1;
+    auto pool = make_pool(options);
+    EXPECT_EQ(pool->stats().min_size, 2u);
+    EXPECT_EQ(pool->stats().max_size, 2u);
+
+    options.adaptive = true;
+    EXPECT_THROW(make_pool(options), std::invalid_argument);
+}
+
+TEST_F(ConnectionPoolTest, FactoryFailureFreesTheSlot) {
+    PoolOptions options;
+    options.initial_size = 1;
+    bool fail = true;
+    ConnectionPool<FakeConnection> pool(
+        [&fail]() -> std::unique_ptr<FakeConnection> {
+            if (fail) throw std::runtime_error("connect refused");
+            return std::make_unique<FakeConnection>(FakeConnection{7});
+        },
+        options);
+
+    EXPECT_THROW(pool.borrow(), std::runtime_error);
+    fail = false;
+    auto conn = pool.borrow();  // Would wait forever if the slot had leaked
+    EXPECT_EQ(conn->id, 7);
+    EXPECT_EQ(pool.stats().open, 1u);
+}
+
+TEST_F(ConnectionPoolTest, StatsExportAsJson) {
+    PoolOptions options;
+    options.initial_size = 3;
+    auto pool = make_pool(options);
+    {
+        auto conn = pool->borrow();
+    }
+
+    auto j = nlohmann::json::parse(pool->stats().to_json());
+    EXPECT_EQ(j["size"], 3);
+    EXPECT_EQ(j["borrows"], 1);
+    EXPECT_EQ(j["timeouts"], 0);
+    EXPECT_EQ(j["wait_us_buckets"]["0"], 1);
+    EXPECT_EQ(j["wait_us_buckets"]["+Inf"], 1);  // Cumulative
+    EXPECT_EQ(j["wait_p99_ms"], 0.0);
+}
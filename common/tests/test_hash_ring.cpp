@@ -0,0 +1,100 @@
+// Consistent hash ring unit tests
+//
+// Pure routing math, no server required.
+//
+// Interview Talking Points:
+// - Virtual nodes: many ring points per node even out the load
+// - Minimal movement: a new node only takes keys, it never reshuffles the rest
+// - Hash tags: co-locate related keys without a shared prefix rule
+
+#include "telemetry_common/hash_ring.h"
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace telemetry_common;
+
+namespace {
+
+std::vector<std::string> endpoints(int count) {
+    std::vector<std::string> nodes;
+    for (int i = 0; i < count; ++i) {
+        nodes.push_back("10.0.0." + std::to_string(i + 1) + ":6379");
+    }
+    return nodes;
+}
+
+std::string task_key(int i) {
+    return "telemetry:task:" + std::to_string(i);
+}
+
+} // namespace
+
+TEST(HashRingTest, SpreadsKeysEvenlyOverNodes) {
+    HashRing ring(endpoints(4), 160);
+    std::vector<int> load(4, 0);
+    const int keys = 40000;
+    for (int i = 0; i < keys; ++i) {
+        ++load[ring.node_for(task_key(i))];
+    }
+    for (int count : load) {
+        EXPECT_NEAR(count, keys / 4, keys / 4 * 0.15);  // Within 15% of a fair share
+    }
+}
+
+TEST(HashRingTest, AddingANodeOnlyMovesKeysToIt) {
+    HashRing before(endpoints(4), 160);
+    HashRing after(endpoints(5), 160);
+
+    const int keys = 20000;
+    int moved = 0;
+    for (int i = 0; i < keys; ++i) {
+        const size_t old_node = before.node_for(task_key(i));
+        const size_t new_node = after.node_for(task_key(i));
+        if (old_node != new_node) {
+            ++moved;
+            EXPECT_EQ(new_node, 4u) << task_key(i);  // Moved keys only go to the new node
+        }
+    }
+    EXPECT_NEAR(moved, keys / 5, keys / 5 * 0.2);  // ~1/N, not ~(N-1)/N as with modulo
+}
+
+TEST(HashRingTest, PlacementIgnoresNodeOrder) {
+    auto nodes = endpoints(3);
+    HashRing forward(nodes, 64);
+    HashRing reversed({nodes[2], nodes[1], nodes[0]}, 64);
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(forward.nodes()[forward.node_for(task_key(i))],
+                  reversed.nodes()[reversed.node_for(task_key(i))]);
+    }
+}
+
+TEST(HashRingTest, HashTagsKeepRelatedKeysTogether) {
+    HashRing ring(endpoints(8), 160);
+    for (int device = 0; device < 200; ++device) {
+        const std::string tag = "{device:" + std::to_string(device) + "}";
+        const size_t node = ring.node_for(tag + ":meta");
+        EXPECT_EQ(ring.node_for(tag + ":alerts"), node);
+        EXPECT_EQ(ring.node_for("queue:" + tag), node);
+    }
+}
+
+TEST(HashRingTest, RoutingKeyFollowsRedisClusterRules) {
+    EXPECT_EQ(HashRing::routing_key("plain:key"), "plain:key");
+    EXPECT_EQ(HashRing::routing_key("{user1000}.following"), "user1000");
+    EXPECT_EQ(HashRing::routing_key("foo{bar}{zap}"), "bar");          // First tag only
+    EXPECT_EQ(HashRing::routing_key("foo{}{bar}"), "foo{}{bar}");      // Empty tag: whole key
+    EXPECT_EQ(HashRing::routing_key("foo{{bar}}zap"), "{bar");
+    EXPECT_EQ(HashRing::routing_key("foo{bar"), "foo{bar");            // Unclosed: whole key
+}
+
+TEST(HashRingTest, RejectsInvalidConfiguration) {
+    EXPECT_THROW(HashRing({}, 160), std::invalid_argument);
+    EXPECT_THROW(HashRing(endpoints(2), 0), std::invalid_argument);
+    EXPECT_THROW(HashRing({"a:6379", "b:6379", "a:6379"}, 16), std::invalid_argument);
+
+    HashRing single({"only:6379"}, 1);
+    EXPECT_EQ(single.node_for("anything"), 0u);
+}
@@ -0,0 +1,89 @@
+// Redis client batch operation tests
+//
+// Real RedisClient against a RedisStandin on an ephemeral port, so variadic
+// LPUSH, RPOP count, BRPOP + drain and pipelines all go over the wire.
+//
+// Interview Talking Points:
+// - Round trips, not commands, dominate queue throughput
+// - FIFO across batches: LPUSH at the head, RPOP count from the tail
+// - Pipelines: independent commands, replies in the order they were queued
+
+#include "telemetry_common/redis_client.h"
+#include "telemetry_common/redis_standin.h"
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace telemetry_common;
+
+namespace {
+
+using Items = std::vector<std::optional<std::string>>;
+using Strings = std::vector<std::string>;
+
+class RedisClientBatchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(server_.start());
+        RedisClient::ConnectionOptions opts;
+        opts.host = "127.0.0.1";
+        opts.port = server_.port();
+        opts.pool_size = 2;
+        client_ = std::make_unique<RedisClient>(opts);
+    }
+
+    RedisStandin server_;
+    std::unique_ptr<RedisClient> client_;
+};
+
+} // namespace
+
+TEST_F(RedisClientBatchTest, RpopCountKeepsFifoOrderAcrossBatches) {
+    EXPECT_EQ(client_->lpush_many("tasks", {"t1", "t2", "t3", "t4", "t5"}), 5);
+    EXPECT_EQ(client_->lpush_many("tasks", {}), 0);  // Nothing sent
+
+    EXPECT_EQ(client_->rpop_count("tasks", 3), (Strings{"t1", "t2", "t3"}));
+    EXPECT_EQ(client_->lpush_many("tasks", {"t6"}), 3);
+    EXPECT_EQ(client_->rpop_count("tasks", 10), (Strings{"t4", "t5", "t6"}));
+    EXPECT_TRUE(client_->rpop_count("tasks", 10).empty());
+}
+
+TEST_F(RedisClientBatchTest, BrpopBatchTakesFirstThenDrains) {
+    ASSERT_EQ(client_->lpush_many("tasks", {"t1", "t2", "t3", "t4", "t5"}), 5);
+
+    EXPECT_EQ(client_->brpop_batch("tasks", 3, 1), (Strings{"t1", "t2", "t3"}));
+    EXPECT_EQ(client_->brpop_batch("tasks", 3, 1), (Strings{"t4", "t5"}));
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(client_->brpop_batch("tasks", 3, 1).empty());  // Server-side timeout
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(900));
+    EXPECT_EQ(client_->llen("tasks"), 0);
+}
+
+TEST_F(RedisClientBatchTest, PipelineRepliesInQueueOrder) {
+    auto pipe = client_->pipeline();
+    pipe.set("device:1", "online")
+        .get("device:1")
+        .get("device:missing")
+        .lpush_many("tasks", {"t1", "t2", "t3"})
+        .rpop_count("tasks", 2)
+        .incr("counter")
+        .llen("tasks");
+    EXPECT_EQ(pipe.size(), 7u);
+
+    auto replies = pipe.exec();
+    ASSERT_EQ(replies.size(), 7u);
+    EXPECT_EQ(std::get<std::string>(replies[0]), "OK");
+    EXPECT_EQ(std::get<std::string>(replies[1]), "online");
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(replies[2]));  // Nil
+    EXPECT_EQ(std::get<long long>(replies[3]), 3);
+    EXPECT_EQ(std::get<Items>(replies[4]), (Items{"t1", "t2"}));
+    EXPECT_EQ(std::get<long long>(replies[5]), 1);
+    EXPECT_EQ(std::get<long long>(replies[6]), 1);
+    EXPECT_EQ(pipe.size(), 0u);  // exec() leaves the pipeline empty for reuse
+}
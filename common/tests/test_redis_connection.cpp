@@ -2,6 +2,9 @@
 // This test verifies basic Redis connectivity
 
 #include "telemetry_common/redis_client.h"
+#ifdef TELEMETRY_COMMON_HAS_ASYNC
+#include "telemetry_common/async_redis_client.h"
+#endif
 #include <iostream>
 #include <exception>
 
@@ -94,6 +97,54 @@ int main() {
         client.del("test:queue");
         std::cout << std::endl;
 
+        // Test 6: Batch operations (variadic LPUSH, RPOP count, pipeline)
+        std::cout << "[TEST 6] Testing batch operations (pipelining)..." << std::endl;
+        client.lpush_many("test:batch", {"task1", "task2", "task3", "task4"});
+        auto batch = client.rpop_count("test:batch", 3);
+        if (batch.size() == 3 && batch[0] == "task1") {
+            std::cout << "✅ RPOP count drained " << batch.size() << " tasks in one round trip" << std::endl;
+        } else {
+            std::cout << "❌ RPOP count failed or wrong order" << std::endl;
+            return 1;
+        }
+
+        auto replies = client.pipeline()
+            .lpush("test:batch", "task5")
+            .llen("test:batch")
+            .del("test:batch")
+            .exec();
+        if (replies.size() == 3 && std::get<long long>(replies[1]) == 2) {
+            std::cout << "✅ Pipeline executed " << replies.size() << " commands in one round trip" << std::endl;
+        } else {
+            std::cout << "❌ Pipeline failed" << std::endl;
+            return 1;
+        }
+        std::cout << std::endl;
+
+#ifdef TELEMETRY_COMMON_HAS_ASYNC
+        // Test 7: Async client (many requests in flight on few connections)
+        std::cout << "[TEST 7] Testing async client..." << std::endl;
+        telemetry_common::AsyncRedisClient::Options async_opts;
+        async_opts.connection = opts;
+        telemetry_common::AsyncRedisClient async_client(async_opts);
+
+        std::vector<std::future<long long>> pushes;
+        for (int i = 0; i < 100; ++i) {
+            pushes.push_back(async_client.lpush("test:async", "task" + std::to_string(i)));
+        }
+        for (auto& push : pushes) {
+            push.get();
+        }
+        auto drained = async_client.brpop_batch("test:async", 100, 1).get();
+        if (drained.size() == 100 && drained[0] == "task0") {
+            std::cout << "✅ 100 async LPUSH in flight, drained with one BRPOP batch" << std::endl;
+        } else {
+            std::cout << "❌ Async batch failed (" << drained.size() << " tasks)" << std::endl;
+            return 1;
+        }
+        std::cout << std::endl;
+#endif
+
         // Success!
         std::cout << "========================================" << std::endl;
         std::cout << "✅ Day 1 Complete: Redis connection working!" << std::endl;
@@ -104,6 +155,7 @@ int main() {
         std::cout << "- Connection pooling: " << opts.pool_size << " connections" << std::endl;
         std::cout << "- Exception-safe operations with std::optional" << std::endl;
         std::cout << "- LPUSH/RPOP creates FIFO queue (O(1) operations)" << std::endl;
+        std::cout << "- Pipelining: N commands per round trip" << std::endl;
         std::cout << std::endl;
 
         return 0;
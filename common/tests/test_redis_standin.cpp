@@ -0,0 +1,360 @@
+// Redis stand-in server tests
+//
+// Talks raw RESP over real sockets (no redis++), so these run anywhere
+// without a Redis install.
+//
+// Interview Talking Points:
+// - RESP framing: type byte + length prefix, CRLF terminated
+// - Blocking pops: the server parks the connection, not a thread
+// - Pipelining: many commands in one write, replies come back in order
+
+#include "telemetry_common/redis_standin.h"
+#include <gtest/gtest.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace telemetry_common;
+
+namespace {
+
+// Minimal RESP2 reply tree
+struct Reply {
+    char type = 0;  // '+', '-', ':', '$', '*'
+    bool nil = false;
+    std::string str;
+    long long integer = 0;
+    std::vector<Reply> elements;
+};
+
+// Blocking RESP client over one socket
+class RespConnection {
+public:
+    explicit RespConnection(int port) {
+        fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        connected_ = ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    }
+
+    explicit RespConnection(const std::string& unix_path) {
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, unix_path.c_str(), sizeof(addr.sun_path) - 1);
+        connected_ = ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    }
+
+    ~RespConnection() { ::close(fd_); }
+
+    bool connected() const { return connected_; }
+
+    static std::string encode(const std::vector<std::string>& args) {
+        std::string out = "*" + std::to_string(args.size()) + "\r\n";
+        for (const auto& arg : args) {
+            out += "$" + std::to_string(arg.size()) + "\r\n" + arg + "\r\n";
+        }
+        return out;
+    }
+
+    void send_raw(const std::string& bytes) {
+        ::send(fd_, bytes.data(), bytes.size(), 0);
+    }
+
+    Reply call(const std::vector<std::string>& args) {
+        send_raw(encode(args));
+        return read_reply();
+    }
+
+    Reply read_reply() {
+        std::string line = read_line();
+        Reply reply;
+        reply.type = line.empty() ? 0 : line[0];
+        std::string body = line.substr(1);
+        switch (reply.type) {
+            case '+':
+            case '-':
+                reply.str = body;
+                break;
+            case ':':
+                reply.integer = std::stoll(body);
+                break;
+            case '$': {
+                long long len = std::stoll(body);
+                if (len < 0) {
+                    reply.nil = true;
+                    break;
+                }
+                reply.str = read_exact(static_cast<size_t>(len) + 2).substr(0, static_cast<size_t>(len));
+                break;
+            }
+            case '*': {
+                long long n = std::stoll(body);
+                if (n < 0) {
+                    reply.nil = true;
+                    break;
+                }
+                for (long long i = 0; i < n; ++i) {
+                    reply.elements.push_back(read_reply());
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        return reply;
+    }
+
+private:
+    bool fill() {
+        char buf[4096];
+        ssize_t n = ::recv(fd_, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            return false;
+        }
+        buffer_.append(buf, static_cast<size_t>(n));
+        return true;
+    }
+
+    std::string read_line() {
+        size_t eol;
+        while ((eol = buffer_.find("\r\n")) == std::string::npos) {
+            if (!fill()) return "";
+        }
+        std::string line = buffer_.substr(0, eol);
+        buffer_.erase(0, eol + 2);
+        return line;
+    }
+
+    std::string read_exact(size_t n) {
+        while (buffer_.size() < n) {
+            if (!fill()) break;
+        }
+        std::string data = buffer_.substr(0, n);
+        buffer_.erase(0, n);
+        return data;
+    }
+
+    int fd_ = -1;
+    bool connected_ = false;
+    std::string buffer_;
+};
+
+} // anonymous namespace
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class RedisStandinTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(server_.start());
+        ASSERT_GT(server_.port(), 0);
+    }
+
+    std::unique_ptr<RespConnection> connect() {
+        auto conn = std::make_unique<RespConnection>(server_.port());
+        EXPECT_TRUE(conn->connected());
+        return conn;
+    }
+
+    RedisStandin server_;
+};
+
+// ============================================================================
+// Test Suite 1: Connection & Strings
+// ============================================================================
+
+TEST_F(RedisStandinTest, PingSetGet) {
+    auto conn = connect();
+    EXPECT_EQ(conn->call({"PING"}).str, "PONG");
+    EXPECT_EQ(conn->call({"SET", "device:1", "online"}).str, "OK");
+    EXPECT_EQ(conn->call({"GET", "device:1"}).str, "online");
+    EXPECT_TRUE(conn->call({"GET", "missing"}).nil);
+    EXPECT_EQ(conn->call({"INCR", "counter"}).integer, 1);
+    EXPECT_EQ(conn->call({"DEL", "device:1", "counter", "missing"}).integer, 2);
+}
+
+TEST_F(RedisStandinTest, WrongTypeIsAnError) {
+    auto conn = connect();
+    conn->call({"LPUSH", "queue", "a"});
+    Reply reply = conn->call({"GET", "queue"});
+    EXPECT_EQ(reply.type, '-');
+    EXPECT_EQ(reply.str.rfind("WRONGTYPE", 0), 0u);
+}
+
+TEST_F(RedisStandinTest, ExpiredKeysDisappear) {
+    auto conn = connect();
+    conn->call({"SET", "session", "x", "PX", "20"});
+    EXPECT_EQ(conn->call({"EXISTS", "session"}).integer, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    EXPECT_EQ(conn->call({"EXISTS", "session"}).integer, 0);
+}
+
+// ============================================================================
+// Test Suite 2: Lists & Blocking Pops
+// ============================================================================
+
+TEST_F(RedisStandinTest, ListFifoAndBatchPop) {
+    auto conn = connect();
+    EXPECT_EQ(conn->call({"LPUSH", "tasks", "t1", "t2", "t3"}).integer, 3);
+    Reply batch = conn->call({"RPOP", "tasks", "2"});
+    ASSERT_EQ(batch.elements.size(), 2u);
+    EXPECT_EQ(batch.elements[0].str, "t1");
+    EXPECT_EQ(batch.elements[1].str, "t2");
+    EXPECT_EQ(conn->call({"LMOVE", "tasks", "processing", "RIGHT", "LEFT"}).str, "t3");
+    EXPECT_EQ(conn->call({"LLEN", "processing"}).integer, 1);
+    EXPECT_EQ(conn->call({"EXISTS", "tasks"}).integer, 0);  // Empty lists are deleted
+}
+
+TEST_F(RedisStandinTest, BrpopWakesOnPush) {
+    auto consumer = connect();
+    auto producer = connect();
+
+    std::thread pusher([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        producer->call({"LPUSH", "tasks", "late-task"});
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    Reply reply = consumer->call({"BRPOP", "tasks", "5"});
+    auto waited = std::chrono::steady_clock::now() - start;
+    pusher.join();
+
+    ASSERT_EQ(reply.elements.size(), 2u);
+    EXPECT_EQ(reply.elements[0].str, "tasks");
+    EXPECT_EQ(reply.elements[1].str, "late-task");
+    EXPECT_LT(waited, std::chrono::seconds(2));
+}
+
+TEST_F(RedisStandinTest, BrpopTimesOut) {
+    auto conn = connect();
+    auto start = std::chrono::steady_clock::now();
+    Reply reply = conn->call({"BRPOP", "empty", "0.1"});
+    auto waited = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(reply.type, '*');
+    EXPECT_TRUE(reply.nil);
+    EXPECT_GE(waited, std::chrono::milliseconds(90));
+    EXPECT_EQ(conn->call({"PING"}).str, "PONG");  // Connection usable afterwards
+}
+
+// ============================================================================
+// Test Suite 3: Pipelining & Transactions
+// ============================================================================
+
+TEST_F(RedisStandinTest, PipelinedRepliesInOrder) {
+    auto conn = connect();
+    std::string batch;
+    for (int i = 0; i < 100; ++i) {
+        batch += RespConnection::encode({"RPUSH", "pipe", std::to_string(i)});
+    }
+    conn->send_raw(batch);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(conn->read_reply().integer, i + 1);
+    }
+}
+
+TEST_F(RedisStandinTest, MultiExec) {
+    auto conn = connect();
+    EXPECT_EQ(conn->call({"MULTI"}).str, "OK");
+    EXPECT_EQ(conn->call({"INCR", "tx"}).str, "QUEUED");
+    EXPECT_EQ(conn->call({"INCR", "tx"}).str, "QUEUED");
+    Reply exec = conn->call({"EXEC"});
+    ASSERT_EQ(exec.elements.size(), 2u);
+    EXPECT_EQ(exec.elements[1].integer, 2);
+}
+
+// ============================================================================
+// Test Suite 4: Sorted Sets
+// ============================================================================
+
+TEST_F(RedisStandinTest, ZrangeByScoreWithLimit) {
+    auto conn = connect();
+    EXPECT_EQ(conn->call({"ZADD", "retry", "30", "c", "10", "a", "20", "b"}).integer, 3);
+    Reply due = conn->call({"ZRANGEBYSCORE", "retry", "-inf", "25", "LIMIT", "0", "10"});
+    ASSERT_EQ(due.elements.size(), 2u);
+    EXPECT_EQ(due.elements[0].str, "a");
+    EXPECT_EQ(due.elements[1].str, "b");
+    EXPECT_EQ(conn->call({"ZRANGEBYSCORE", "retry", "(10", "+inf"}).elements.size(), 2u);
+    EXPECT_EQ(conn->call({"ZREM", "retry", "a"}).integer, 1);
+    EXPECT_EQ(conn->call({"ZSCORE", "retry", "b"}).str, "20");
+}
+
+// ============================================================================
+// Test Suite 5: Streams & Consumer Groups
+// ============================================================================
+
+TEST_F(RedisStandinTest, StreamConsumerGroupLifecycle) {
+    auto conn = connect();
+    EXPECT_EQ(conn->call({"XGROUP", "CREATE", "s", "workers", "0", "MKSTREAM"}).str, "OK");
+    EXPECT_EQ(conn->call({"XGROUP", "CREATE", "s", "workers", "0"}).str.rfind("BUSYGROUP", 0), 0u);
+
+    std::string id1 = conn->call({"XADD", "s", "*", "task", "one"}).str;
+    std::string id2 = conn->call({"XADD", "s", "*", "task", "two"}).str;
+    EXPECT_LT(id1, id2);
+
+    Reply read = conn->call({"XREADGROUP", "GROUP", "workers", "c1", "COUNT", "10", "STREAMS", "s", ">"});
+    ASSERT_EQ(read.elements.size(), 1u);
+    const Reply& entries = read.elements[0].elements[1];
+    ASSERT_EQ(entries.elements.size(), 2u);
+    EXPECT_EQ(entries.elements[0].elements[1].elements[1].str, "one");
+
+    EXPECT_EQ(conn->call({"XACK", "s", "workers", id1}).integer, 1);
+    EXPECT_EQ(conn->call({"XPENDING", "s", "workers"}).elements[0].integer, 1);
+
+    // Consumer c1 "crashed": c2 takes over everything idle >= 0 ms
+    Reply claimed = conn->call({"XAUTOCLAIM", "s", "workers", "c2", "0", "0-0", "COUNT", "10"});
+    ASSERT_EQ(claimed.elements.size(), 3u);
+    EXPECT_EQ(claimed.elements[0].str, "0-0");
+    ASSERT_EQ(claimed.elements[1].elements.size(), 1u);
+    EXPECT_EQ(claimed.elements[1].elements[0].elements[0].str, id2);
+}
+
+TEST_F(RedisStandinTest, XreadgroupBlockWakesOnXadd) {
+    auto consumer = connect();
+    auto producer = connect();
+    producer->call({"XGROUP", "CREATE", "s", "workers", "$", "MKSTREAM"});
+
+    std::thread publisher([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        producer->call({"XADD", "s", "*", "task", "fresh"});
+    });
+    Reply read = consumer->call({"XREADGROUP", "GROUP", "workers", "c1", "BLOCK", "5000", "STREAMS", "s", ">"});
+    publisher.join();
+
+    ASSERT_EQ(read.elements.size(), 1u);
+    EXPECT_EQ(read.elements[0].elements[1].elements.size(), 1u);
+}
+
+// ============================================================================
+// Test Suite 6: Unix Socket Transport
+// ============================================================================
+
+TEST(RedisStandinUnixTest, ServesOverUnixSocket) {
+    RedisStandin::Options opts;
+    opts.unix_path = "/tmp/telemetry_standin_test_" + std::to_string(::getpid()) + ".sock";
+    RedisStandin server(opts);
+    ASSERT_TRUE(server.start());
+
+    RespConnection conn(opts.unix_path);
+    ASSERT_TRUE(conn.connected());
+    EXPECT_EQ(conn.call({"PING"}).str, "PONG");
+    EXPECT_EQ(conn.call({"SADD", "seen", "a", "b", "a"}).integer, 2);
+
+    server.stop();
+    EXPECT_FALSE(server.is_running());
+    EXPECT_NE(::access(opts.unix_path.c_str(), F_OK), 0);  // Socket file removed
+}
@@ -0,0 +1,166 @@
+// Stream task queue tests
+//
+// Real RedisClient against a RedisStandin on an ephemeral port, so every
+// XADD / XREADGROUP / XAUTOCLAIM / XACK goes over the wire.
+//
+// Interview Talking Points:
+// - At-least-once: unacked entries stay pending until XACK
+// - Recovery: a live consumer takes over entries a stuck one never acked
+// - Bounded history: MAXLEN caps the stream, acked or not
+// - Poison entries: anything without a task field is acked, never delivered
+
+#include "telemetry_common/stream_task_queue.h"
+#include "telemetry_common/redis_standin.h"
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace telemetry_common;
+using namespace std::chrono_literals;
+
+namespace {
+
+class StreamTaskQueueTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(server_.start());
+        RedisClient::ConnectionOptions opts;
+        opts.port = server_.port();
+        opts.pool_size = 2;
+        client_ = std::make_unique<RedisClient>(opts);
+    }
+
+    StreamTaskQueue::Options queue_options(const std::string& consumer) const {
+        StreamTaskQueue::Options opts;
+        opts.stream_key = "test:tasks:stream";
+        opts.consumer = consumer;
+        opts.block_ms = 0;  // Never wait on an empty stream
+        return opts;
+    }
+
+    static std::vector<std::string> payloads(int first, int count) {
+        std::vector<std::string> out;
+        for (int i = first; i < first + count; ++i) {
+            out.push_back("task-" + std::to_string(i));
+        }
+        return out;
+    }
+
+    static std::vector<std::string> ids_of(const std::vector<StreamTaskQueue::Message>& batch) {
+        std::vector<std::string> ids;
+        for (const auto& msg : batch) {
+            ids.push_back(msg.id);
+        }
+        return ids;
+    }
+
+    RedisStandin server_;
+    std::unique_ptr<RedisClient> client_;
+};
+
+} // namespace
+
+TEST_F(StreamTaskQueueTest, ReadThenAck) {
+    StreamTaskQueue queue(*client_, queue_options("worker-1"));
+    ASSERT_TRUE(queue.ensure_group());
+    ASSERT_EQ(queue.publish_batch(payloads(0, 10)), 10u);
+    EXPECT_FALSE(queue.publish("task-10").empty());
+
+    auto batch = queue.read_batch();
+    ASSERT_EQ(batch.size(), 11u);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EXPECT_EQ(batch[i].payload, "task-" + std::to_string(i));  // Publish order
+        EXPECT_FALSE(batch[i].redelivered);
+    }
+    EXPECT_TRUE(queue.read_batch().empty());  // Delivered once per group
+
+    EXPECT_EQ(queue.ack(ids_of(batch)), 11u);
+    EXPECT_EQ(queue.ack(ids_of(batch)), 0u);  // Already acknowledged
+    EXPECT_EQ(queue.length(), 11);            // Acked entries stay until trimmed
+
+    auto stats = queue.get_stats();
+    EXPECT_EQ(stats.published, 11u);
+    EXPECT_EQ(stats.delivered, 11u);
+    EXPECT_EQ(stats.claimed, 0u);
+    EXPECT_EQ(stats.acked, 11u);
+}
+
+TEST_F(StreamTaskQueueTest, ClaimsStuckEntriesAfterClaimInterval) {
+    StreamTaskQueue stuck(*client_, queue_options("worker-stuck"));
+    ASSERT_TRUE(stuck.ensure_group());
+    ASSERT_EQ(stuck.publish_batch(payloads(0, 5)), 5u);
+    ASSERT_EQ(stuck.read_batch().size(), 5u);  // Read, never acked
+
+    auto opts = queue_options("worker-live");
+    opts.claim_min_idle = 20ms;
+    opts.claim_interval = 300ms;
+    StreamTaskQueue live(*client_, opts);
+
+    // First read looks for stuck entries, but none has been idle long enough
+    EXPECT_TRUE(live.read_batch().empty());
+
+    // Idle long enough now, but the next claim pass is not due yet
+    std::this_thread::sleep_for(60ms);
+    EXPECT_TRUE(live.read_batch().empty());
+
+    std::this_thread::sleep_for(300ms);
+    auto claimed = live.read_batch();
+    ASSERT_EQ(claimed.size(), 5u);
+    for (size_t i = 0; i < claimed.size(); ++i) {
+        EXPECT_EQ(claimed[i].payload, "task-" + std::to_string(i));
+        EXPECT_TRUE(claimed[i].redelivered);
+    }
+    EXPECT_EQ(live.get_stats().claimed, 5u);
+    EXPECT_EQ(live.ack(ids_of(claimed)), 5u);
+
+    // Nothing left pending for anyone to claim
+    EXPECT_TRUE(live.claim_stuck().empty());
+}
+
+TEST_F(StreamTaskQueueTest, MaxlenTrimsOldestEntries) {
+    auto opts = queue_options("worker-1");
+    opts.maxlen = 5;
+    StreamTaskQueue queue(*client_, opts);
+    ASSERT_TRUE(queue.ensure_group());
+
+    for (const auto& payload : payloads(0, 8)) {
+        EXPECT_FALSE(queue.publish(payload).empty());
+    }
+    EXPECT_EQ(queue.publish_batch(payloads(8, 12)), 12u);
+
+    // MAXLEN ~ is approximate on a real server; the stand-in trims exactly
+    EXPECT_EQ(queue.length(), 5);
+
+    auto batch = queue.read_batch();
+    ASSERT_EQ(batch.size(), 5u);
+    EXPECT_EQ(batch.front().payload, "task-15");  // Oldest entries went first
+    EXPECT_EQ(batch.back().payload, "task-19");
+}
+
+TEST_F(StreamTaskQueueTest, EntriesWithoutTaskFieldAreAckedNotDelivered) {
+    auto opts = queue_options("worker-1");
+    opts.claim_min_idle = 0ms;
+    StreamTaskQueue queue(*client_, opts);
+    ASSERT_TRUE(queue.ensure_group());
+
+    ASSERT_EQ(queue.publish_batch(payloads(0, 2)), 2u);
+    ASSERT_FALSE(client_->xadd(opts.stream_key, {{"note", "not a task"}}, 0).empty());
+    EXPECT_FALSE(queue.publish("task-2").empty());
+
+    auto batch = queue.read_batch();
+    ASSERT_EQ(batch.size(), 3u);
+    EXPECT_EQ(batch[2].payload, "task-2");
+    EXPECT_EQ(queue.get_stats().delivered, 3u);
+    EXPECT_EQ(queue.get_stats().dropped, 1u);
+
+    // The foreign entry was acked on the spot, so only our tasks are pending
+    auto pending = queue.claim_stuck();
+    ASSERT_EQ(pending.size(), 3u);
+    EXPECT_EQ(ids_of(pending), ids_of(batch));
+    EXPECT_EQ(queue.ack(ids_of(batch)), 3u);
+    EXPECT_TRUE(queue.claim_stuck().empty());
+}
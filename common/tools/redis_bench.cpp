@@ -0,0 +1,260 @@
+// RedisClient end-to-end benchmark
+//
+// Drives the real redis++ client over real sockets. Without --port it starts
+// an embedded RedisStandin, so it runs on a machine without a Redis install;
+// with --host/--port it measures a real server instead.
+//
+//   redis_bench                          # embedded stand-in, 100000 ops
+//   redis_bench 500000 --batch 256
+//   redis_bench --host 10.0.0.5 --port 6379
+//   redis_bench --unix /var/run/redis/redis.sock
+//   redis_bench --compare                # TCP loopback vs unix socket, same mix
+//   redis_bench --compare --port 6379 --unix /var/run/redis/redis.sock
+
+#include "telemetry_common/redis_client.h"
+#include "telemetry_common/redis_standin.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+using telemetry_common::RedisClient;
+using telemetry_common::RedisStandin;
+using telemetry_common::StreamFields;
+
+namespace chrono = std::chrono;
+
+struct Stats {
+    double seconds{};
+    std::size_t ops{};
+    double ops_per_sec{};
+};
+
+template <typename Fn>
+Stats measure(std::size_t n, Fn&& fn)
+{
+    auto start = chrono::steady_clock::now();
+    fn();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return Stats{secs, n, n / secs};
+}
+
+void report(const char* name, const Stats& s)
+{
+    std::cout << name << s.ops << " ops in " << s.seconds << " s, "
+              << static_cast<long long>(s.ops_per_sec) << " ops/s\n";
+}
+
+// One round trip per task: LPUSH, then RPOP
+Stats run_single(RedisClient& client, std::size_t n)
+{
+    client.del("bench:single");
+    return measure(n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            client.lpush("bench:single", "task-" + std::to_string(i));
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            client.rpop("bench:single");
+        }
+    });
+}
+
+// Variadic LPUSH + RPOP count: one round trip per batch
+Stats run_batched(RedisClient& client, std::size_t n, std::size_t batch)
+{
+    client.del("bench:batched");
+    std::vector<std::string> values;
+    values.reserve(batch);
+    return measure(n, [&] {
+        for (std::size_t i = 0; i < n; i += batch) {
+            values.clear();
+            for (std::size_t j = i; j < std::min(n, i + batch); ++j) {
+                values.push_back("task-" + std::to_string(j));
+            }
+            client.lpush_many("bench:batched", values);
+        }
+        std::size_t popped = 0;
+        while (popped < n) {
+            auto got = client.rpop_count("bench:batched", static_cast<long long>(batch));
+            if (got.empty()) break;
+            popped += got.size();
+        }
+    });
+}
+
+// Pipelined INCR/SET mix: bounded by bandwidth, not RTT
+Stats run_pipelined(RedisClient& client, std::size_t n, std::size_t batch)
+{
+    return measure(n, [&] {
+        for (std::size_t i = 0; i < n; i += batch) {
+            auto pipe = client.pipeline();
+            for (std::size_t j = i; j < std::min(n, i + batch); ++j) {
+                if (j % 2 == 0) {
+                    pipe.incr("bench:counter");
+                } else {
+                    pipe.set("bench:device:" + std::to_string(j % 1000), "online");
+                }
+            }
+            pipe.exec();
+        }
+    });
+}
+
+// Stream transport: XADD batches, XREADGROUP + XACK per batch
+Stats run_stream(RedisClient& client, std::size_t n, std::size_t batch)
+{
+    client.del("bench:stream");
+    client.xgroup_create("bench:stream", "bench", "0");
+    std::vector<StreamFields> entries;
+    return measure(n, [&] {
+        for (std::size_t i = 0; i < n; i += batch) {
+            entries.clear();
+            for (std::size_t j = i; j < std::min(n, i + batch); ++j) {
+                entries.push_back({{"task", "task-" + std::to_string(j)}});
+            }
+            client.xadd_many("bench:stream", entries);
+        }
+        std::size_t consumed = 0;
+        std::vector<std::string> ids;
+        while (consumed < n) {
+            auto got = client.xreadgroup("bench:stream", "bench", "bench-consumer",
+                                         static_cast<long long>(batch));
+            if (got.empty()) break;
+            ids.clear();
+            for (const auto& entry : got) {
+                ids.push_back(entry.id);
+            }
+            client.xack("bench:stream", "bench", ids);
+            consumed += got.size();
+        }
+    });
+}
+
+using Suite = std::vector<std::pair<std::string, Stats>>;
+
+// The whole command mix against one server
+Suite run_suite(const RedisClient::ConnectionOptions& options, std::size_t n, std::size_t batch)
+{
+    RedisClient client(options);
+    Suite suite;
+    suite.emplace_back("lpush/rpop:        ", run_single(client, n));
+    suite.emplace_back("lpush_many/rpop_n: ", run_batched(client, n, batch));
+    suite.emplace_back("pipeline:          ", run_pipelined(client, n, batch));
+    suite.emplace_back("xadd/xreadgroup:   ", run_stream(client, n, batch));
+    std::cout << "pool: " << client.pool_metrics() << "\n";
+    return suite;
+}
+
+// Same mix over TCP loopback and a unix socket, side by side
+void report_comparison(const Suite& tcp, const Suite& unix_socket)
+{
+    std::cout << "\n                    TCP us/op   unix us/op   unix speedup\n";
+    for (std::size_t i = 0; i < tcp.size(); ++i) {
+        const double tcp_us = 1e6 / tcp[i].second.ops_per_sec;
+        const double unix_us = 1e6 / unix_socket[i].second.ops_per_sec;
+        std::cout << tcp[i].first << std::setw(9) << std::fixed << std::setprecision(2) << tcp_us
+                  << std::setw(13) << unix_us << std::setw(13) << tcp_us / unix_us << "x\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n = 100'000;
+    std::size_t batch = 100;
+    RedisClient::ConnectionOptions options;
+    bool external = false;
+    bool compare = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--host" && i + 1 < argc) {
+            options.host = argv[++i];
+            external = true;
+        } else if (arg == "--port" && i + 1 < argc) {
+            options.port = std::stoi(argv[++i]);
+            external = true;
+        } else if (arg == "--unix" && i + 1 < argc) {
+            options.unix_socket = argv[++i];
+            external = true;
+        } else if (arg == "--compare") {
+            compare = true;
+        } else if (arg == "--batch" && i + 1 < argc) {
+            batch = static_cast<std::size_t>(std::stoull(argv[++i]));
+        } else {
+            try {
+                n = static_cast<std::size_t>(std::stoull(arg));
+            } catch (...) {
+                std::cerr << "Usage: " << argv[0]
+                          << " [N] [--batch B] [--host H] [--port P] [--unix PATH] [--compare]\n";
+                return 1;
+            }
+        }
+    }
+    if (batch == 0) batch = 1;
+    if (compare && external && options.unix_socket.empty()) {
+        std::cerr << "--compare against an external server needs --unix PATH as well\n";
+        return 1;
+    }
+
+    // Embedded stand-ins: one on TCP loopback, one on a unix socket for --compare
+    std::unique_ptr<RedisStandin> tcp_standin;
+    std::unique_ptr<RedisStandin> unix_standin;
+    if (!external) {
+        tcp_standin = std::make_unique<RedisStandin>();
+        if (!tcp_standin->start()) {
+            std::cerr << "Failed to start embedded Redis stand-in\n";
+            return 1;
+        }
+        options.host = "127.0.0.1";
+        options.port = tcp_standin->port();
+        if (compare) {
+            RedisStandin::Options unix_opts;
+            unix_opts.unix_path = "/tmp/redis_bench_" + std::to_string(::getpid()) + ".sock";
+            unix_standin = std::make_unique<RedisStandin>(unix_opts);
+            if (!unix_standin->start()) {
+                std::cerr << "Failed to start embedded Redis stand-in on " << unix_opts.unix_path << "\n";
+                return 1;
+            }
+            options.unix_socket = unix_standin->unix_path();
+        }
+    }
+
+    auto tcp_options = options;
+    tcp_options.unix_socket.clear();
+    const auto& target = compare ? tcp_options : options;
+    std::cout << "Running redis_bench with N=" << n << ", batch=" << batch << " against "
+              << (external ? "" : "stand-in ")
+              << (target.unix_socket.empty() ? target.host + ":" + std::to_string(target.port)
+                                             : target.unix_socket)
+              << "\n";
+
+    try {
+        auto suite = run_suite(target, n, batch);
+        for (const auto& [name, stats] : suite) {
+            report(name.c_str(), stats);
+        }
+        std::cout << "speedup (batched/single): "
+                  << suite[1].second.ops_per_sec / suite[0].second.ops_per_sec << "x\n";
+
+        if (compare) {
+            std::cout << "\nSame mix over unix socket " << options.unix_socket << "\n";
+            auto unix_suite = run_suite(options, n, batch);
+            for (const auto& [name, stats] : unix_suite) {
+                report(name.c_str(), stats);
+            }
+            report_comparison(suite, unix_suite);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
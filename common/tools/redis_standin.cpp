@@ -0,0 +1,70 @@
+// Standalone Redis stand-in server
+//
+// Lets the gateway, processor and redis-cli run against a local RESP server
+// on a machine without a Redis install:
+//
+//   redis_standin                      # 127.0.0.1:6379
+//   redis_standin --port 7000
+//   redis_standin --unix /tmp/telemetry-redis.sock
+
+#include "telemetry_common/redis_standin.h"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using telemetry_common::RedisStandin;
+
+namespace {
+std::atomic<bool> g_stop{false};
+
+void on_signal(int) { g_stop = true; }
+}
+
+int main(int argc, char** argv)
+{
+    RedisStandin::Options options;
+    options.port = 6379;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--port" && i + 1 < argc) {
+            options.port = std::stoi(argv[++i]);
+        } else if (arg == "--host" && i + 1 < argc) {
+            options.host = argv[++i];
+        } else if (arg == "--unix" && i + 1 < argc) {
+            options.unix_path = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--host H] [--port N] [--unix PATH]\n";
+            return 1;
+        }
+    }
+
+    RedisStandin server(options);
+    if (!server.start()) {
+        return 1;
+    }
+
+    if (options.unix_path.empty()) {
+        std::cout << "redis_standin listening on " << options.host << ":" << server.port() << "\n";
+    } else {
+        std::cout << "redis_standin listening on unix:" << server.unix_path() << "\n";
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+    while (!g_stop && server.is_running()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    auto stats = server.get_stats();
+    server.stop();
+    std::cout << "connections: " << stats.connections_accepted
+              << ", commands: " << stats.commands_processed
+              << ", keys: " << stats.keys << "\n";
+    return 0;
+}
@@ -38,9 +38,8 @@ int main() {
             3  // max retries
         );
         
-        // Serialize and push to queue
-        auto task_json = task.to_json();
-        redis.rpush(queue_key, task_json.dump());
+        // Serialize (compact binary frame; Task::deserialize also accepts JSON) and push
+        redis.rpush(queue_key, task.serialize(telemetry_processor::WireFormat::BINARY));
         
         std::cout << "  [" << i << "] Task " << task.id.substr(0, 8) << "... "
                   << "Priority: " << telemetry_processor::priority_to_string(priority) << "\n";
@@ -1,13 +1,18 @@
 #pragma once
 
-#include <queue>
-#include <vector>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
+#include <cstdint>
 #include <optional>
+#include <vector>
 #include <functional>
 #include <nlohmann/json.hpp>
+#include "telemetry_processor/Payload.h"
 
 /**
  * @file task_queue.h
@@ -24,26 +29,34 @@
  * - **Bounded Capacity**: Configurable max size with backpressure
  * - **Blocking Operations**: enqueue() and dequeue() with timeout support
  * - **FIFO Within Priority**: Same-priority tasks processed in order
+ * - **Concurrent Mode**: Optional lock-free lanes for 16+ worker deployments
+ * - **Delayed Tasks**: enqueue_at()/enqueue_after() for retry backoff
  * 
  * **Performance Characteristics**:
- * - enqueue(): O(log n) - binary heap insertion
- * - dequeue(): O(log n) - extract-min from heap
+ * - enqueue(): O(1) - push_back onto the task's priority lane
+ * - dequeue(): O(1) - pop_front from the first non-empty lane
+ * - enqueue_bulk()/dequeue_bulk(): O(k) - one lock round trip per batch
+ * - enqueue_at()/enqueue_after(): O(log d) - min-heap of d delayed tasks
  * - peek(): O(1) - view highest priority task
- * - size()/empty(): O(1) - constant time
+ * - size()/empty()/get_stats(): O(1) - maintained counters
  * 
  * **Interview Talking Points**:
- * 1. **Priority Queue**: Why binary heap over sorted list? (O(log n) vs O(n))
+ * 1. **Multi-Level Queue**: Why one FIFO lane per priority beats a binary heap
+ *    when there are only a few priority levels (O(1) vs O(log n), no payload moves)
  * 2. **Thread Safety**: Producer-consumer pattern with condition variables
  * 3. **Bounded Queue**: Backpressure mechanism (prevent memory exhaustion)
  * 4. **Timeout Handling**: std::chrono for type-safe time management
  * 5. **Modern C++17**: std::optional, lambda comparators, RAII lock guards
+ * 6. **Lock-Free Lanes**: Bounded MPMC rings + eventcount (QueueMode::CONCURRENT)
  * 
- * @see std::priority_queue for underlying data structure
+ * @see std::deque for the per-priority lanes
  * @see std::condition_variable for blocking synchronization
  */
 
 namespace telemetry_processing {
 
+using telemetry_processor::Payload;
+
 /**
  * @enum TaskPriority
  * @brief Priority levels for task scheduling
@@ -57,7 +70,7 @@ namespace telemetry_processing {
  * - MEDIUM: Normal telemetry processing, analytics
  * - LOW: Batch jobs, data cleanup, non-urgent operations
  * 
- * @note Values are ordered for std::priority_queue (smallest = highest priority)
+ * @note Values double as lane indices in TaskQueue (0 = served first)
  */
 enum class TaskPriority : int {
     HIGH = 0,     ///< Highest priority (processed first)
@@ -86,12 +99,13 @@ inline std::string to_string(TaskPriority priority) {
  * @details
  * A task encapsulates:
  * - **Priority**: For scheduling order
- * - **Timestamp**: For FIFO ordering within same priority
- * - **Payload**: Arbitrary JSON data for processing
+ * - **Timestamp**: Creation time (latency tracking)
+ * - **Payload**: JSON data, kept as raw bytes until first accessed
  * - **ID**: Unique identifier for tracking
  * 
  * **Design Decisions**:
  * - JSON payload: Flexible schema-less data (vs rigid structs)
+ * - Lazy payload: routing/requeueing never parses it (see Payload)
  * - Timestamp: std::chrono for precision (microseconds)
  * - ID: String UUID for distributed systems
  * 
@@ -107,7 +121,7 @@ struct Task {
     std::string id;                                           ///< Unique task identifier
     TaskPriority priority = TaskPriority::MEDIUM;             ///< Scheduling priority
     std::chrono::system_clock::time_point created_at;         ///< Creation timestamp
-    nlohmann::json payload;                                   ///< Task data (flexible JSON)
+    Payload payload;                                          ///< Task data (lazy JSON)
     
     /**
      * @brief Default constructor with current timestamp
@@ -128,15 +142,48 @@ struct Task {
      * @brief Full constructor with payload
      * @param task_id Unique task identifier
      * @param prio Task priority level
-     * @param data Task payload (JSON)
+     * @param data Task payload (raw JSON bytes or a DOM)
      */
-    Task(std::string task_id, TaskPriority prio, nlohmann::json data)
+    Task(std::string task_id, TaskPriority prio, Payload data)
         : id(std::move(task_id))
         , priority(prio)
         , created_at(std::chrono::system_clock::now())
         , payload(std::move(data)) {}
 };
 
+/**
+ * @enum QueueMode
+ * @brief Synchronization strategy of a TaskQueue
+ * 
+ * @details
+ * - LOCKED: One mutex + condition variables, strict priority, exact peek().
+ *   Simplest and fastest up to a handful of workers.
+ * - CONCURRENT: One lock-free MPMC ring per priority, weighted round-robin
+ *   between lanes, eventcount for blocking. Producers and consumers only
+ *   share a capacity counter, so throughput keeps scaling with 16+ workers.
+ */
+enum class QueueMode {
+    LOCKED,
+    CONCURRENT
+};
+
+/**
+ * @struct TaskQueueOptions
+ * @brief Construction options for TaskQueue
+ */
+struct TaskQueueOptions {
+    size_t max_capacity = 10000;            ///< Maximum tasks (0 = unbounded in LOCKED mode)
+    QueueMode mode = QueueMode::LOCKED;     ///< Synchronization strategy
+    
+    /**
+     * Dequeue share per lane (HIGH, MEDIUM, LOW) in CONCURRENT mode.
+     * With {8, 4, 1}, out of every 13 dequeues under full load 8 go to HIGH,
+     * 4 to MEDIUM and 1 to LOW, so LOW cannot starve. A lane whose turn comes
+     * up while empty hands its slot to the highest non-empty lane.
+     */
+    std::array<unsigned, 3> lane_weights{{8, 4, 1}};
+};
+
 /**
  * @class TaskQueue
  * @brief Thread-safe bounded priority queue for task scheduling
@@ -152,10 +199,28 @@ struct Task {
  *   - `not_full_`: Producers wait when queue at capacity
  * - Lock guards ensure exception-safe unlocking
  * 
+ * **Concurrent Mode** (TaskQueueOptions::mode = QueueMode::CONCURRENT):
+ * - One bounded Vyukov MPMC ring per priority: enqueue/dequeue are a CAS on
+ *   the lane's position plus a release store, no mutex
+ * - Weighted round-robin between lanes (TaskQueueOptions::lane_weights)
+ *   instead of strict priority, so a HIGH flood cannot starve LOW
+ * - Eventcount for blocking: a sleeper registers, re-checks, then parks;
+ *   producers only touch the mutex when someone is actually parked
+ * - peek() is unsupported (returns nullopt): a lock-free lane cannot hand
+ *   out a copy of its head without racing the consumer that pops it
+ * 
  * **Priority Scheduling**:
- * - Uses std::priority_queue with custom comparator
- * - Higher priority (lower enum value) processed first
- * - FIFO ordering within same priority (timestamp comparison)
+ * - One FIFO lane (std::deque) per TaskPriority
+ * - dequeue() serves the highest non-empty lane (strict priority)
+ * - Exact FIFO within a priority: arrival order, not timestamps
+ * 
+ * **Delayed Tasks**:
+ * - enqueue_at()/enqueue_after() park a task in a min-heap keyed by due time
+ * - Consumers promote due tasks into the priority lanes on their way in;
+ *   no timer thread and no busy re-enqueueing
+ * - At most one idle consumer (the "timekeeper") sleeps until the earliest
+ *   due time; the others sleep on their own timeout as usual
+ * - Scheduled tasks hold capacity but are not counted by size() until due
  * 
  * **Bounded Capacity**:
  * - Prevents unbounded memory growth
@@ -219,6 +284,24 @@ public:
      */
     explicit TaskQueue(size_t max_capacity = 10000);
     
+    /**
+     * @brief Construct a queue with an explicit mode and lane weights
+     * @param options Capacity, QueueMode and lane weights
+     * 
+     * @details
+     * CONCURRENT mode preallocates one ring of max_capacity slots (rounded up
+     * to a power of two) per priority, so every task could land in one lane.
+     * Capacity 0 in CONCURRENT mode means kConcurrentDefaultCapacity.
+     * 
+     * @code
+     * TaskQueueOptions options;
+     * options.max_capacity = 50000;
+     * options.mode = QueueMode::CONCURRENT;
+     * TaskQueue queue(options);
+     * @endcode
+     */
+    explicit TaskQueue(const TaskQueueOptions& options);
+    
     /**
      * @brief Destructor - automatically unblocks waiting threads
      * 
@@ -249,7 +332,7 @@ public:
      * - timeout > 0: Waits up to timeout for space
      * - timeout = max: Waits indefinitely
      * 
-     * **Time Complexity**: O(log n) where n = queue size
+     * **Time Complexity**: O(1)
      * **Thread Safety**: Fully synchronized (safe from multiple threads)
      * 
      * @code
@@ -285,7 +368,7 @@ public:
      * - timeout > 0: Waits up to timeout for task
      * - timeout = max: Waits indefinitely
      * 
-     * **Time Complexity**: O(log n) where n = queue size
+     * **Time Complexity**: O(1) - at most kPriorityLevels lanes checked
      * **Thread Safety**: Fully synchronized
      * 
      * @code
@@ -305,10 +388,110 @@ public:
      * @endcode
      * 
      * @note Returns nullopt if queue is shutting down
+     * @note QueueMode::CONCURRENT serves lanes by weighted round-robin
+     *       (TaskQueueOptions::lane_weights) rather than strict priority
      */
     std::optional<Task> dequeue(
         std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
     
+    /**
+     * @brief Enqueue a batch of tasks in one operation
+     * 
+     * @param tasks Tasks to enqueue; on return holds only those not accepted
+     * @param timeout Maximum wait for space for the whole batch (0 = no wait)
+     * @return Number of tasks enqueued (a prefix of the batch)
+     * 
+     * @details
+     * Takes the lock once (CONCURRENT: one capacity CAS) per chunk that fits,
+     * instead of once per task. Each task goes to its priority lane in batch
+     * order, so FIFO within a priority is preserved. If the queue fills up,
+     * the rest of the batch waits for space until the timeout, then the
+     * leftovers are handed back in `tasks` for the caller to retry or drop.
+     * Wakes at most one blocked consumer per task added.
+     * 
+     * **Time Complexity**: O(k) for k tasks
+     * 
+     * @code
+     * std::vector<Task> batch = decode(redis_reply);
+     * size_t n = queue.enqueue_bulk(std::move(batch), 100ms);
+     * if (!batch.empty()) {
+     *     metrics.dropped += batch.size();  // Backpressure: queue stayed full
+     * }
+     * @endcode
+     * 
+     * @note Returns 0 if queue is shutting down
+     */
+    size_t enqueue_bulk(std::vector<Task>&& tasks,
+                        std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    
+    /**
+     * @brief Dequeue up to max_tasks tasks in one operation
+     * 
+     * @param out Tasks are appended here (highest priority first)
+     * @param max_tasks Upper bound on tasks taken
+     * @param timeout Maximum wait for the first task (0 = no wait)
+     * @return Number of tasks appended to out
+     * 
+     * @details
+     * Waits only until at least one task is available, then takes whatever
+     * is there up to max_tasks - it never holds a worker back to fill a
+     * batch. Order follows dequeue(): strict priority in LOCKED mode,
+     * weighted round-robin in CONCURRENT mode. Wakes at most one blocked
+     * producer per slot freed.
+     * 
+     * **Time Complexity**: O(k) for k tasks
+     * 
+     * @code
+     * std::vector<Task> batch;
+     * while (queue.dequeue_bulk(batch, 64, 1000ms) > 0) {
+     *     process_batch(batch);
+     *     batch.clear();
+     * }
+     * @endcode
+     */
+    size_t dequeue_bulk(std::vector<Task>& out, size_t max_tasks,
+                        std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    
+    /**
+     * @brief Schedule a task to become visible at a given time
+     * 
+     * @param task Task to schedule (moved)
+     * @param due When the task may be dequeued (steady clock: immune to NTP jumps)
+     * @return true if scheduled, false if full or shutting down
+     * 
+     * @details
+     * The task waits in a min-heap and is promoted into its priority lane by
+     * the first dequeue at or after `due`; a blocked consumer wakes for it on
+     * time. It holds a capacity slot from now on (so backoff cannot grow
+     * memory without bound) but does not count towards size() until due.
+     * Never blocks: a retry path should not stall on a full queue.
+     * 
+     * **Time Complexity**: O(log d) for d scheduled tasks
+     * 
+     * @note A due time in the past makes the task eligible immediately
+     */
+    bool enqueue_at(Task task, std::chrono::steady_clock::time_point due);
+    
+    /**
+     * @brief Schedule a task to become visible after a delay
+     * 
+     * @param task Task to schedule (moved)
+     * @param delay How long the task stays invisible to consumers
+     * @return true if scheduled, false if full or shutting down
+     * 
+     * @code
+     * // Exponential backoff: 100ms, 200ms, 400ms, ...
+     * int attempt = task.payload.value("attempt", 0) + 1;
+     * if (attempt <= max_retries) {
+     *     task.payload.mutable_json()["attempt"] = attempt;
+     *     queue.enqueue_after(std::move(task), std::chrono::milliseconds(100 << (attempt - 1)));
+     * }
+     * @endcode
+     * 
+     * @see enqueue_at
+     */
+    bool enqueue_after(Task task, std::chrono::milliseconds delay);
+    
     /**
      * @brief Peek at highest-priority task without removing
      * 
@@ -333,12 +516,13 @@ public:
      * 
      * @warning Task reference may become invalid if queue modified
      * @note Thread-safe but task may be dequeued by another thread
+     * @note Always nullopt in QueueMode::CONCURRENT
      */
     std::optional<Task> peek() const;
     
     /**
      * @brief Get current number of tasks in queue
-     * @return Size of queue
+     * @return Size of queue (ready tasks; scheduled ones count once promoted)
      * 
      * @details
      * **Time Complexity**: O(1) - cached value
@@ -400,10 +584,14 @@ public:
      * 
      * @details
      * Returns:
-     * - current_size: Number of tasks
+     * - current_size: Number of ready tasks
+     * - delayed: Tasks scheduled via enqueue_at()/enqueue_after(), not yet due
      * - capacity: Max capacity
      * - utilization: Percentage full (0-100)
-     * - priority_breakdown: Count per priority level
+     * - priority_breakdown: Tasks currently queued per priority level
+     * - enqueued_total / dequeued_total: Lifetime counts per priority level
+     * 
+     * **Time Complexity**: O(1) - counters, no queue traversal
      * 
      * @code
      * auto stats = queue.get_stats();
@@ -413,42 +601,99 @@ public:
      */
     nlohmann::json get_stats() const;
 
+    /**
+     * @brief Synchronization strategy chosen at construction
+     */
+    QueueMode mode() const;
+
+    /// Number of priority levels (one lane each)
+    static constexpr size_t kPriorityLevels = 3;
+    
+    /// Ring size used by CONCURRENT mode when constructed with capacity 0
+    static constexpr size_t kConcurrentDefaultCapacity = 65536;
+
 private:
+    struct ConcurrentState;  ///< Lock-free lanes + eventcounts (task_queue.cpp)
+    
     /**
-     * @brief Comparator for priority queue ordering
-     * 
-     * @details
-     * Orders tasks by:
-     * 1. Priority (lower enum value = higher priority)
-     * 2. Timestamp (earlier = higher priority for same priority level)
-     * 
-     * This ensures:
-     * - HIGH priority processed before MEDIUM/LOW
-     * - FIFO ordering within same priority
-     * 
-     * @note Used by std::priority_queue internally
+     * @brief Task parked by enqueue_at() until its due time
      */
-    struct TaskComparator {
-        bool operator()(const Task& a, const Task& b) const {
-            if (a.priority != b.priority) {
-                // Lower enum value = higher priority (process first)
-                return static_cast<int>(a.priority) > static_cast<int>(b.priority);
-            }
-            // Same priority: earlier timestamp = higher priority (FIFO)
-            return a.created_at > b.created_at;
+    struct DelayedTask {
+        std::chrono::steady_clock::time_point due;
+        uint64_t sequence;  ///< Tie-break: equal due times keep scheduling order
+        Task task;
+    };
+    
+    /// Heap comparator: earliest due on top (std::*_heap build max-heaps)
+    struct DueLater {
+        bool operator()(const DelayedTask& a, const DelayedTask& b) const {
+            return a.due != b.due ? a.due > b.due : a.sequence > b.sequence;
         }
     };
     
+    bool enqueue_concurrent(Task task, std::chrono::milliseconds timeout);
+    std::optional<Task> dequeue_concurrent(std::chrono::milliseconds timeout);
+    size_t enqueue_bulk_concurrent(std::vector<Task>& tasks, std::chrono::milliseconds timeout);
+    size_t dequeue_bulk_concurrent(std::vector<Task>& out, size_t max_tasks,
+                                   std::chrono::milliseconds timeout);
+    bool enqueue_at_concurrent(Task task, std::chrono::steady_clock::time_point due);
+    size_t promote_due_concurrent();
+    template <typename TryTake>
+    bool wait_ready_concurrent(TryTake&& try_take, std::chrono::milliseconds timeout);
+    
+
+    /**
+     * @brief Lane index for a priority (out-of-range values go to LOW)
+     */
+    static size_t lane_of(TaskPriority priority) {
+        auto index = static_cast<size_t>(priority);
+        return index < kPriorityLevels ? index : kPriorityLevels - 1;
+    }
+    
+    /**
+     * @brief Pop from the highest-priority non-empty lane (caller holds mutex_)
+     */
+    Task pop_front_locked();
+    
+    /**
+     * @brief Notify min(count, waiting) threads on cv (caller holds mutex_)
+     */
+    static void wake(std::condition_variable& cv, size_t count, size_t waiting);
+    
+    /**
+     * @brief Move due delayed tasks into their lanes (caller holds mutex_)
+     * @return Number of tasks promoted
+     */
+    size_t promote_due_locked();
+    
+    /**
+     * @brief Wait until a task is ready, timeout expires or shutdown
+     *        (caller holds mutex_ via lock)
+     * @return true if at least one task is ready
+     */
+    bool wait_ready_locked(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout);
+    
+    /// Ready + scheduled tasks: what counts against capacity (caller holds mutex_)
+    size_t occupied_locked() const { return size_ + delayed_.size(); }
+    
     mutable std::mutex mutex_;                    ///< Protects all shared state
     std::condition_variable not_empty_;           ///< Signals when task available
     std::condition_variable not_full_;            ///< Signals when space available
+    size_t waiting_consumers_ = 0;                ///< Threads blocked on not_empty_
+    size_t waiting_producers_ = 0;                ///< Threads blocked on not_full_
+    
+    std::array<std::deque<Task>, kPriorityLevels> lanes_;       ///< FIFO lane per priority
+    size_t size_ = 0;                                           ///< Tasks across all lanes
+    std::array<uint64_t, kPriorityLevels> enqueued_total_{};    ///< Lifetime enqueues per lane
+    std::array<uint64_t, kPriorityLevels> dequeued_total_{};    ///< Lifetime dequeues per lane
     
-    std::priority_queue<Task, 
-                        std::vector<Task>, 
-                        TaskComparator> queue_;   ///< Underlying priority queue
+    std::vector<DelayedTask> delayed_;            ///< Min-heap by due time (DueLater)
+    uint64_t delayed_sequence_ = 0;               ///< Next DelayedTask::sequence
+    bool timekeeper_ = false;                     ///< A consumer sleeps until delayed_ head
     
     size_t max_capacity_;                         ///< Maximum queue size (0 = unbounded)
-    bool shutdown_ = false;                       ///< Shutdown flag (unblock threads)
+    std::atomic<bool> shutdown_{false};           ///< Shutdown flag (unblock threads)
+    std::unique_ptr<ConcurrentState> concurrent_; ///< Set only in CONCURRENT mode
 };
 
 } // namespace telemetry_processing
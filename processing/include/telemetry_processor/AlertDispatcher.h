@@ -0,0 +1,167 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace telemetry_processor {
+
+/**
+ * @brief One alert, as delivered to the transport
+ */
+struct Alert {
+    std::string device_id;
+    std::string reason;          ///< Dedup key together with device_id
+    std::string message;
+    std::string severity = "warning";
+    std::string timestamp;       ///< Event time of the triggering sample (may be empty)
+    std::string payload;         ///< Raw telemetry JSON of the triggering sample
+    size_t duplicates = 0;       ///< Repeats folded into this alert (coalesced or suppressed)
+};
+
+/**
+ * @brief Delivers alert batches (webhook, email, test double)
+ *
+ * Called only from the AlertDispatcher thread, one batch per flush, so a
+ * slow endpoint delays alerts but never a worker.
+ */
+class AlertTransport {
+public:
+    virtual ~AlertTransport() = default;
+
+    /// @return false if the batch was not delivered (counted as failed)
+    virtual bool send(const std::vector<Alert>& alerts) = 0;
+};
+
+/**
+ * @brief Webhook transport
+ *
+ * Mock: no HTTP client in this tree yet. Logs the JSON body it would POST
+ * (format_body()) when a URL is configured, and reports success.
+ */
+class WebhookAlertTransport : public AlertTransport {
+public:
+    explicit WebhookAlertTransport(std::string url);
+
+    bool send(const std::vector<Alert>& alerts) override;
+
+    /// JSON body of one POST: {"alerts": [{device_id, reason, ...}, ...]}
+    static std::string format_body(const std::vector<Alert>& alerts);
+
+private:
+    std::string url_;
+};
+
+/**
+ * @brief Asynchronous, deduplicating, rate-limited alert delivery
+ *
+ * submit() never blocks and never does I/O: it files the alert and
+ * returns. A background thread delivers queued alerts in batches.
+ *
+ *   submit() ──▶ suppressed? ──▶ already queued? ──▶ bounded queue ──▶ token bucket ──▶ transport
+ *                 (same device+reason   (fold into it)  (full: drop)     (rate, burst)     (one call
+ *                  sent < window ago)                                                        per batch)
+ *
+ * **Deduplication**: alerts are keyed by (device_id, reason). A repeat of
+ * an alert that is still queued is folded into it; a repeat within
+ * suppression_window of the last delivery is suppressed. Either way the
+ * count is carried in Alert::duplicates of the next delivered alert, so
+ * an anomaly storm becomes one alert per device and reason per window.
+ * A suppressed count is kept after its window expires until the next
+ * alert for that device and reason is queued, however long that takes.
+ *
+ * **Rate limiting**: a token bucket (rate_per_sec, burst) caps deliveries;
+ * alerts over the rate stay queued (and keep absorbing repeats). When
+ * the queue is full, new keys are dropped and counted.
+ *
+ * **Batching**: every flush_interval (sooner when max_batch alerts are
+ * waiting) up to max_batch alerts go out in one transport call.
+ *
+ * **Failures**: the suppression window only starts once a batch was
+ * delivered. A failed batch goes back to the head of the queue (as far as
+ * queue_capacity allows; the rest count as failed) and sending pauses for
+ * retry_backoff, doubled per consecutive failure up to max_retry_backoff,
+ * so an endpoint outage delays alerts instead of losing them. flush() and
+ * shutdown make one last attempt and count what still fails as failed.
+ *
+ * Thread-safe. The destructor delivers what is still queued.
+ *
+ * Interview note: same shape as Alertmanager's grouping/inhibition
+ * (group_wait, repeat_interval) in front of a rate-limited receiver
+ */
+class AlertDispatcher {
+public:
+    struct Options {
+        size_t queue_capacity = 1024;                          ///< Distinct queued alerts
+        std::chrono::milliseconds suppression_window{60000};   ///< Per device and reason
+        double rate_per_sec = 10.0;                            ///< Sustained deliveries per second
+        size_t burst = 20;                                     ///< Bucket size
+        size_t max_batch = 50;                                 ///< Alerts per transport call
+        std::chrono::milliseconds flush_interval{100};
+        std::chrono::milliseconds retry_backoff{250};          ///< Pause after a failed send
+        std::chrono::milliseconds max_retry_backoff{30000};    ///< Cap of the doubling backoff
+    };
+
+    enum class SubmitStatus {
+        QUEUED,          ///< New alert queued
+        COALESCED,       ///< Folded into an identical queued (or in-flight) alert
+        SUPPRESSED,      ///< Same device+reason delivered within the window
+        DROPPED,         ///< Queue full
+        CLOSED           ///< Dispatcher shutting down
+    };
+
+    struct Stats {
+        size_t submitted = 0;
+        size_t sent = 0;                 ///< Delivered alerts
+        size_t coalesced = 0;
+        size_t suppressed = 0;
+        size_t dropped = 0;
+        size_t failed = 0;               ///< Alerts given up after a failed send
+        size_t requeued = 0;             ///< Alerts put back after a failed send
+        size_t batches = 0;              ///< Transport calls
+        size_t rate_limited = 0;         ///< Flushes that held alerts back for lack of tokens
+        size_t queued = 0;
+    };
+
+    /**
+     * @brief Start the dispatch thread with default options
+     */
+    explicit AlertDispatcher(std::shared_ptr<AlertTransport> transport);
+
+    /**
+     * @brief Start the dispatch thread
+     * @throws std::invalid_argument on a null transport or zero-sized limits
+     */
+    AlertDispatcher(std::shared_ptr<AlertTransport> transport, Options options);
+
+    /**
+     * @brief Deliver everything still queued (ignoring the rate limit), then stop
+     */
+    ~AlertDispatcher();
+
+    AlertDispatcher(const AlertDispatcher&) = delete;
+    AlertDispatcher& operator=(const AlertDispatcher&) = delete;
+
+    /**
+     * @brief File an alert for delivery; O(1), non-blocking
+     */
+    SubmitStatus submit(Alert alert);
+
+    /**
+     * @brief Deliver everything queued now, bypassing the rate limit, and
+     *        wait until done (shutdown, tests)
+     */
+    void flush();
+
+    const Options& options() const;
+
+    Stats stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace telemetry_processor
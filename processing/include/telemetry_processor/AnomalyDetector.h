@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace telemetry_processor {
+
+/**
+ * @brief Column-oriented (structure-of-arrays) batch of telemetry samples
+ *
+ * One contiguous array per metric, so a threshold test over a batch is a
+ * straight-line compare over packed doubles instead of a walk over
+ * payload structs. Absent values are NaN (never flagged).
+ */
+struct TelemetryColumns {
+    std::vector<double> temperature;
+    std::vector<double> humidity;
+    std::vector<double> pressure;
+    std::vector<double> voltage;
+    std::vector<double> current;
+
+    size_t size() const { return temperature.size(); }
+
+    void reserve(size_t n);
+    void clear();
+    void push_back(double t, double h, double p, double v, double c);
+};
+
+/**
+ * @brief Per-sample anomaly reasons (bitmask)
+ */
+enum AnomalyFlag : uint8_t {
+    ANOMALY_NONE = 0,
+    ANOMALY_TEMP_HIGH = 1 << 0,
+    ANOMALY_TEMP_LOW = 1 << 1,
+    ANOMALY_HUMIDITY_HIGH = 1 << 2,
+    ANOMALY_VOLTAGE_LOW = 1 << 3,
+    ANOMALY_CURRENT_HIGH = 1 << 4,
+    ANOMALY_ZSCORE = 1 << 5,         ///< Rolling z-score outlier (any metric)
+    ANOMALY_EWMA = 1 << 6            ///< Deviation from the EWMA band (any metric)
+};
+
+/**
+ * @brief Static limits checked by detect_thresholds()
+ */
+struct ThresholdLimits {
+    double temp_high = 80.0;
+    double temp_low = -20.0;
+    double humidity_high = 95.0;
+    double voltage_low = 2.8;
+    double current_high = 2.0;
+};
+
+/**
+ * @brief Evaluate all thresholds over a batch, branch-free
+ *
+ * flags[i] receives the ANOMALY_* bits of sample i (overwritten). Uses
+ * AVX2 (4 doubles per compare) when compiled with it, SSE2 (2 doubles,
+ * baseline on x86-64) otherwise, and a scalar loop for the tail and other
+ * targets. Ordered compares: NaN never trips a limit.
+ *
+ * @param flags Output, at least columns.size() bytes
+ * @return Number of samples with at least one flag
+ *
+ * Interview note: compare -> movemask -> OR into a bitmask is the standard
+ * SIMD filter kernel (same shape as simdjson's structural scan)
+ */
+size_t detect_thresholds(const TelemetryColumns& columns, const ThresholdLimits& limits, uint8_t* flags);
+
+/**
+ * @brief Per-device rolling z-score over the last `window` samples
+ *
+ * Each metric keeps a ring buffer with a sliding mean/M2 (O(1) per sample).
+ * A value is scored against the window *before* it is added, so an outlier
+ * cannot hide itself by inflating the variance it is measured against.
+ */
+class ZScoreDetector {
+public:
+    struct Options {
+        size_t window = 60;          ///< Samples per device and metric
+        double threshold = 3.0;      ///< Flag when |x - mean| > threshold * stddev
+        size_t min_samples = 10;     ///< Warm-up before scoring
+    };
+
+    /// @throws std::invalid_argument if window < 2 or metric_count is 0
+    ZScoreDetector(Options options, size_t metric_count);
+    ~ZScoreDetector();
+
+    /**
+     * @brief Score one sample, then fold it into the device's window
+     * @param values metric_count values; NaN = absent (skipped)
+     * @return Bitmask of metric indices that are outliers (bit m = metric m)
+     */
+    uint32_t update(std::string_view device_id, const double* values);
+
+    size_t devices() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Per-device EWMA band: flags values far from the smoothed mean
+ *
+ *   mean' = mean + alpha * (x - mean)
+ *   var'  = (1 - alpha) * (var + alpha * (x - mean)^2)
+ *
+ * Two doubles of state per device and metric, no history: cheaper than a
+ * rolling window and adapts to slow drift, at the cost of a softer memory.
+ */
+class EwmaDetector {
+public:
+    struct Options {
+        double alpha = 0.1;          ///< Smoothing factor in (0, 1]
+        double threshold = 4.0;      ///< Flag when |x - mean| > threshold * stddev
+        size_t min_samples = 10;     ///< Warm-up before scoring
+    };
+
+    /// @throws std::invalid_argument if alpha is outside (0, 1] or metric_count is 0
+    EwmaDetector(Options options, size_t metric_count);
+    ~EwmaDetector();
+
+    /// Same contract as ZScoreDetector::update()
+    uint32_t update(std::string_view device_id, const double* values);
+
+    size_t devices() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace telemetry_processor
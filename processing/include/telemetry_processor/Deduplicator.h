@@ -0,0 +1,140 @@
+#pragma once
+
+#include "telemetry_processor/RedisClient.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace telemetry_processor {
+
+/**
+ * @brief Blocked Bloom filter: all k bits of a key live in one 64-byte block
+ *
+ * A classic Bloom filter touches k random cache lines per lookup; here one
+ * hash picks a cache-line-sized block and the k bit positions inside it,
+ * so a lookup is a single cache miss. The price is a slightly higher
+ * false-positive rate at the same size (~1% at 10 bits per item).
+ *
+ * Not thread-safe; Deduplicator serializes access.
+ */
+class BloomFilter {
+public:
+    /**
+     * @param expected_items Items at which the false-positive rate is as designed
+     * @param bits_per_item Memory per expected item (10 ≈ 1%, 16 ≈ 0.1%)
+     */
+    BloomFilter(size_t expected_items, double bits_per_item);
+
+    void insert(const std::string& key);
+
+    /// false: definitely never inserted; true: probably inserted
+    bool maybe_contains(const std::string& key) const;
+
+    void clear();
+
+    size_t size_bytes() const { return blocks_.size() * sizeof(Block); }
+
+private:
+    struct alignas(64) Block {
+        uint64_t words[8];
+    };
+
+    size_t block_index(uint64_t hash) const;
+
+    std::vector<Block> blocks_;
+    unsigned hashes_;                // k: bit positions per key (1..7)
+};
+
+/**
+ * @brief Idempotency check for task IDs: local Bloom filter in front of Redis sets
+ *
+ * Task IDs are recorded once their task completed; seen() tells a worker
+ * which fetched tasks already ran (a producer resubmitted them after a
+ * timeout, a retry raced the original, a reaped task had finished).
+ *
+ *   seen(ids) ──▶ Bloom filter ──miss──▶ new (no Redis call)
+ *                      │hit
+ *                      ▼
+ *                SMISMEMBER on the live generation sets ──▶ duplicate / false positive
+ *
+ * Checking every ID remotely costs a Redis round trip per task. Here
+ * only Bloom hits (real duplicates plus ~1% false positives) are checked,
+ * as one SMISMEMBER per live generation for the whole batch; record() is
+ * one SADD per batch. The Redis sets are the shared record for all
+ * workers, but the filter only knows this process's completions: a
+ * duplicate whose original ran on another worker passes as new. Handlers
+ * therefore stay idempotent; this layer removes the common, cheap-to-catch
+ * repeats without a per-task round trip.
+ *
+ * **Ageing**: IDs are remembered for `generations` periods of
+ * generation_period. Each generation has its own filter and its own set,
+ * `<key_prefix>:<n>` with n = epoch seconds / period, so every process
+ * agrees on the current one. On rotation the oldest filter is cleared for
+ * reuse and the oldest set deleted (a real deployment would also EXPIRE
+ * it). Memory stays bounded however long the process runs.
+ *
+ * Thread-safe. Redis calls are made outside the lock.
+ *
+ * Interview note: same layering as Bigtable/Cassandra Bloom filters in
+ * front of SSTables - pay the remote lookup only when the local filter
+ * cannot rule the key out
+ */
+class Deduplicator {
+public:
+    struct Options {
+        std::string key_prefix = "distqueue:tasks:done";
+        size_t expected_items = 100000;                    ///< Per generation
+        double bits_per_item = 10.0;
+        std::chrono::seconds generation_period{600};
+        size_t generations = 2;                            ///< Live generations (>= 2)
+    };
+
+    struct Stats {
+        size_t checked = 0;              ///< IDs passed to seen()
+        size_t bloom_misses = 0;         ///< Ruled out locally, no Redis call
+        size_t remote_checks = 0;        ///< IDs checked in Redis
+        size_t duplicates = 0;
+        size_t false_positives = 0;      ///< Bloom hits Redis did not confirm
+        size_t recorded = 0;
+        size_t rotations = 0;
+    };
+
+    /**
+     * @brief Deduplicator with default options
+     */
+    explicit Deduplicator(std::shared_ptr<RedisClient> redis);
+
+    /**
+     * @throws std::invalid_argument on a null client or invalid sizing
+     */
+    Deduplicator(std::shared_ptr<RedisClient> redis, Options options);
+
+    ~Deduplicator();
+
+    Deduplicator(const Deduplicator&) = delete;
+    Deduplicator& operator=(const Deduplicator&) = delete;
+
+    /**
+     * @brief Which IDs belong to already-completed tasks
+     * @return One flag per ID, in order
+     */
+    std::vector<bool> seen(const std::vector<std::string>& ids);
+
+    /**
+     * @brief Remember completed task IDs (local filter + one SADD)
+     */
+    void record(const std::vector<std::string>& ids);
+
+    const Options& options() const;
+
+    Stats stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace telemetry_processor
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <nlohmann/json.hpp>
+
+namespace telemetry_processor {
+
+/**
+ * @brief Task payload that keeps the original bytes and parses lazily
+ *
+ * Most hops only route or requeue a task; building a JSON DOM at each one
+ * was the largest per-task cost in the processor. A Payload instead holds:
+ *
+ * - The raw JSON bytes in a refcounted, immutable buffer: copying a Task
+ *   (peek, requeue, retry) shares the bytes instead of duplicating them
+ * - A DOM that is built at most once, on first json() call, and shared by
+ *   every copy of the buffer (thread-safe, std::call_once)
+ * - Field lookup (operator[], value()) that scans the bytes with a SAX
+ *   parser for the first field asked for - no DOM, no allocation for
+ *   anything but that field. Every later lookup reads the cached DOM
+ * - fields(): a fixed set of top-level fields in one scan
+ *
+ * Mutation (mutable_json()) is copy-on-write, so a shared buffer is never
+ * changed under another Task's feet.
+ *
+ * Construction:
+ *   Payload p1 = R"({"device_id": "sensor-001"})";      // Raw bytes, unparsed
+ *   Payload p2 = nlohmann::json{{"temperature", 25.5}}; // From a DOM
+ *   Payload p3 = {{"device_id", "sensor-001"}};         // JSON initializer list
+ *
+ * Interview note: this is the same idea as simdjson's on-demand API and
+ * protobuf lazy fields - defer decoding until someone actually looks
+ */
+class Payload {
+public:
+    /// Empty payload (no bytes)
+    Payload() = default;
+
+    /// Adopt serialized JSON bytes without parsing them
+    Payload(std::string raw);
+    Payload(const char* raw);
+
+    /// Wrap an existing DOM; bytes are produced lazily by raw()
+    Payload(nlohmann::json doc);
+
+    /// Same semantics as nlohmann::json's initializer-list constructor
+    Payload(nlohmann::json::initializer_list_t init);
+
+    /**
+     * @brief Serialized bytes (original input, or the DOM dumped once)
+     * @note Never parses; a Payload built from bytes returns them verbatim
+     */
+    const std::string& raw() const;
+
+    /**
+     * @brief Parsed DOM, built on first call and cached
+     * @return Parsed value, or null if the bytes are not valid JSON
+     */
+    const nlohmann::json& json() const;
+
+    /**
+     * @brief DOM for modification (copy-on-write)
+     * @warning The reference is invalidated by the next raw(), copy or assignment
+     */
+    nlohmann::json& mutable_json();
+
+    /**
+     * @brief Top-level field by key, without building the DOM if possible
+     * @return Field value, or null if absent / payload not a JSON object
+     *
+     * The first lookup on unparsed bytes scans them without building a
+     * DOM (object/array fields fall back to the full parse). A scan has to
+     * read to the end to agree with json() - a duplicate key returns its
+     * last value, malformed bytes return null - so it costs about as much
+     * as a parse; the second lookup therefore builds the DOM once and every
+     * lookup after it is a hash-map find. One field: one scan, no DOM;
+     * k fields: one scan plus one parse instead of k scans.
+     * Returns by value (const, so `payload["k"] = v` does not compile -
+     * use mutable_json()).
+     */
+    const nlohmann::json operator[](std::string_view key) const;
+
+    /**
+     * @brief Typed top-level field with fallback (like nlohmann::json::value)
+     * @return Field converted to T, or fallback if absent, null or mistyped
+     */
+    template <typename T>
+    T value(std::string_view key, T fallback) const {
+        nlohmann::json field = (*this)[key];
+        if (field.is_null()) {
+            return fallback;
+        }
+        try {
+            return field.get<T>();
+        } catch (const nlohmann::json::exception&) {
+            return fallback;
+        }
+    }
+
+    /**
+     * @brief Several top-level fields in one pass
+     * @param keys Field names (distinct)
+     * @param out Each key's value, null if absent
+     * @return false (and every value null) if the payload is not a
+     *         well-formed JSON object
+     *
+     * For callers that always read the same set of fields: one scan for
+     * all of them, no DOM unless a wanted field is an object/array, and
+     * operator[]'s first-lookup scan is left untouched. Reads the DOM
+     * directly once one exists.
+     */
+    template <size_t N>
+    bool fields(const std::array<std::string_view, N>& keys, std::array<nlohmann::json, N>& out) const {
+        return read_fields(keys.data(), out.data(), N);
+    }
+
+    /// No content: default-constructed, empty bytes, or empty/null DOM (never parses)
+    bool empty() const;
+
+    /// true once a DOM exists (built from one, or parsed by json())
+    bool is_parsed() const;
+
+    /// true if the bytes are well-formed JSON (parses if needed); an empty payload is valid
+    bool is_valid() const;
+
+    /// Same bytes, or the same JSON value
+    friend bool operator==(const Payload& a, const Payload& b);
+    friend bool operator!=(const Payload& a, const Payload& b) { return !(a == b); }
+
+    friend std::ostream& operator<<(std::ostream& os, const Payload& payload) {
+        return os << payload.raw();
+    }
+
+private:
+    bool read_fields(const std::string_view* keys, nlohmann::json* out, size_t count) const;
+
+    struct Buffer;
+    std::shared_ptr<Buffer> buffer_;  ///< Shared between copies; null = empty
+};
+
+} // namespace telemetry_processor
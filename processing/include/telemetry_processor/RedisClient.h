@@ -4,6 +4,8 @@
 #include <optional>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <limits>
 
 namespace telemetry_processor {
 
@@ -12,6 +14,10 @@ namespace telemetry_processor {
  * 
  * Day 1: Simple interface, mock implementation
  * Day 2+: Real Redis integration with redis-plus-plus
+ * 
+ * The mock is a real in-process transport: a sharded hash-map store with a
+ * condition variable per list, so many producer/worker threads can share one
+ * client and blpop() genuinely blocks. Thread-safe.
  */
 class RedisClient {
 public:
@@ -33,6 +39,13 @@ public:
      */
     bool connect();
     
+    /**
+     * @brief Disconnect; wakes every thread blocked in blpop() (returns nullopt)
+     * 
+     * Use this to stop workers that block with timeout 0.
+     */
+    void disconnect();
+    
     /**
      * @brief Check if connected
      */
@@ -52,14 +65,132 @@ public:
      */
     bool rpush(const std::string& key, const std::string& value);
     
+    /**
+     * @brief Push several items in one call (RPUSH key value [value ...])
+     */
+    bool rpush(const std::string& key, const std::vector<std::string>& values);
+    
+    /**
+     * @brief Items between start and stop, inclusive (LRANGE; negative = from the tail)
+     */
+    std::vector<std::string> lrange(const std::string& key, long long start, long long stop);
+    
+    /**
+     * @brief Keep only the items between start and stop, inclusive (LTRIM)
+     */
+    void ltrim(const std::string& key, long long start, long long stop);
+    
     /**
      * @brief Blocking left pop from list (BLPOP)
+     * 
+     * Sleeps until another thread pushes to the key, the timeout expires
+     * or disconnect() is called. Waiters on one key are woken one per push.
+     * 
      * @param key List key
      * @param timeout_seconds Timeout in seconds (0 = wait forever)
      * @return Popped value, or nullopt if timeout
      */
     std::optional<std::string> blpop(const std::string& key, int timeout_seconds = 0);
     
+    /**
+     * @brief Pop up to count items from the left of a list (LPOP key count)
+     * 
+     * Non-blocking: one round trip for a whole batch, so a worker can
+     * prefetch many tasks per call instead of one BLPOP each.
+     * 
+     * @param key List key
+     * @param count Maximum number of items
+     * @return Popped values in list order (empty if the list is empty)
+     */
+    std::vector<std::string> lpop(const std::string& key, size_t count);
+    
+    /**
+     * @brief Atomically move up to count items from the head of source to
+     *        the tail of destination (LMOVE source destination LEFT RIGHT)
+     * 
+     * All items move in one atomic step - on a real server, count LMOVEs in
+     * one MULTI/EXEC - so an item is always in exactly one of the lists.
+     * 
+     * @param source Source list
+     * @param destination Destination list (may equal source: rotation)
+     * @param count Maximum number of items
+     * @return Moved values in list order (empty if source is empty)
+     */
+    std::vector<std::string> lmove(const std::string& source, const std::string& destination, size_t count);
+    
+    /**
+     * @brief Blocking variant of lmove() for a single item (BLMOVE ... LEFT RIGHT)
+     * 
+     * @param source Source list
+     * @param destination Destination list
+     * @param timeout_seconds Timeout in seconds (0 = wait forever)
+     * @return Moved value, or nullopt on timeout or disconnect()
+     */
+    std::optional<std::string> blmove(const std::string& source, const std::string& destination,
+                                      int timeout_seconds = 0);
+    
+    /**
+     * @brief Remove one occurrence of each value from a list (LREM key 1 value, pipelined)
+     * 
+     * @param key List key
+     * @param values Values to remove; a value listed twice removes two occurrences
+     * @return Number of items removed
+     */
+    size_t lrem(const std::string& key, const std::vector<std::string>& values);
+    
+    /**
+     * @brief Add or update a sorted-set member (ZADD)
+     * @return true if the member is new
+     */
+    bool zadd(const std::string& key, const std::string& member, double score);
+    
+    /**
+     * @brief Add or update several members in one call (ZADD key score member [score member ...])
+     * @return Number of members that were new
+     */
+    size_t zadd(const std::string& key, const std::vector<std::pair<std::string, double>>& members);
+    
+    /**
+     * @brief Number of members (ZCARD)
+     */
+    size_t zcard(const std::string& key);
+    
+    /**
+     * @brief Atomically move up to limit members with score <= max_score,
+     *        lowest first, to the tail of a list
+     * 
+     * On a real server this is one Lua script (ZRANGEBYSCORE, ZREM, RPUSH),
+     * so a member is never in both places or in neither.
+     * 
+     * @return Members moved
+     */
+    size_t zmove_to_list(const std::string& source, const std::string& destination,
+                         double max_score, size_t limit);
+    
+    /**
+     * @brief Members with min <= score <= max, lowest score first (ZRANGEBYSCORE ... LIMIT 0 limit)
+     */
+    std::vector<std::string> zrangebyscore(const std::string& key, double min, double max,
+                                           size_t limit = std::numeric_limits<size_t>::max());
+    
+    /**
+     * @brief Remove a sorted-set member (ZREM)
+     * @return true if the member existed
+     */
+    bool zrem(const std::string& key, const std::string& member);
+    
+    /**
+     * @brief Add members to a set (SADD key member [member ...])
+     * @return Number of members that were new
+     */
+    size_t sadd(const std::string& key, const std::vector<std::string>& members);
+    
+    /**
+     * @brief Membership of several members in one call (SMISMEMBER)
+     * @return One flag per member, in order
+     */
+    std::vector<bool> smismember(const std::string& key, const std::vector<std::string>& members);
+    
     /**
      * @brief Set key-value pair (SET)
      * @param key Key
@@ -92,7 +223,7 @@ public:
 private:
     std::string host_;
     int port_;
-    bool connected_;
+    std::atomic<bool> connected_;
     
     // Redis connection (will add real redis++ connection later)
     // For Day 1, we'll use an in-memory mock
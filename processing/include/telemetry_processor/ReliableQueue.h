@@ -0,0 +1,124 @@
+#pragma once
+
+#include "telemetry_processor/RedisClient.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace telemetry_processor {
+
+/**
+ * @brief Reliable-queue protocol over Redis lists: claim, ack, lease, reap
+ *
+ * A plain BLPOP deletes the task before it is processed: a worker that
+ * crashes mid-task loses it. Here a claimed task is *moved*, atomically,
+ * into a processing list owned by the worker, and is only deleted by the
+ * ack that follows a final outcome:
+ *
+ *   pending ──claim (LMOVE ×n)──▶ <pending>:processing:<worker> ──ack (LREM ×n)──▶ gone
+ *      ▲                                      │
+ *      └────────── reap / release (LMOVE all) ┘  lease expired / clean shutdown
+ *
+ * **Leases**: each worker holds one lease, a member of the
+ * `<pending>:leases` sorted set scored by its expiry (epoch ms), renewed
+ * by heartbeat(). Being in a worker's processing list *is* the persisted
+ * RUNNING state and the list name is the worker_id, so nothing is written
+ * per task to record ownership.
+ *
+ * **Reaping**: reap() finds leases that expired (the worker died or hung
+ * past lease_ttl) and moves their processing lists back to pending. Any
+ * worker may reap; ZREM decides which reaper wins.
+ *
+ * **Batching**: every step is one round trip per batch, not per task:
+ * claim() moves up to `max` tasks at once (BLMOVE only to wait on an empty
+ * queue), ack() removes a whole batch in one pass, and the lease is
+ * renewed at most every lease_ttl/3, whatever the task rate.
+ *
+ * Delivery is at-least-once: a worker that stalls past its lease has its
+ * tasks reaped and run elsewhere; its late ack() then removes nothing.
+ *
+ * Thread-safe: the prefetch thread claims while workers ack.
+ *
+ * Interview note: the RPOPLPUSH "reliable queue" pattern from the Redis
+ * docs, with SQS-style visibility timeouts held per worker instead of per
+ * message
+ */
+class ReliableQueue {
+public:
+    struct Options {
+        std::string pending_key = "distqueue:tasks:pending";
+        std::chrono::milliseconds lease_ttl{30000};     ///< Worker presumed dead after this
+    };
+
+    /**
+     * @brief Queue endpoint for one worker with default options
+     */
+    ReliableQueue(std::shared_ptr<RedisClient> redis, std::string worker_id);
+
+    /**
+     * @throws std::invalid_argument on a null client, empty worker_id or zero lease
+     */
+    ReliableQueue(std::shared_ptr<RedisClient> redis, std::string worker_id, Options options);
+
+    /**
+     * @brief Move up to max tasks from pending into this worker's processing list
+     *
+     * Renews the lease when due. If pending is empty, waits up to
+     * timeout_seconds for one task (0 = do not wait), then tops the batch up.
+     *
+     * @return Claimed frames, in queue order
+     */
+    std::vector<std::string> claim(size_t max, int timeout_seconds = 0);
+
+    /**
+     * @brief Delete finished tasks (completed or failed for good) from the processing list
+     * @return Frames actually removed (fewer if some were reaped meanwhile)
+     */
+    size_t ack(const std::vector<std::string>& frames);
+
+    /**
+     * @brief Extend the lease to now + lease_ttl
+     */
+    bool heartbeat();
+
+    /**
+     * @brief heartbeat() if the last one is older than lease_ttl/3; cheap to call in a loop
+     */
+    void renew_if_due();
+
+    /**
+     * @brief Hand everything still claimed back to pending and drop the lease
+     *        (clean shutdown, or recovery on restart with the same worker_id)
+     * @return Tasks requeued
+     */
+    size_t release();
+
+    /**
+     * @brief Requeue the processing lists of every worker whose lease expired
+     * @return Tasks requeued
+     */
+    size_t reap();
+
+    const std::string& worker_id() const { return worker_id_; }
+
+    const std::string& processing_key() const { return processing_key_; }
+
+    const std::string& lease_key() const { return lease_key_; }
+
+    /// `<pending_key>:processing:<worker_id>`
+    static std::string processing_key(const std::string& pending_key, const std::string& worker_id);
+
+private:
+    std::shared_ptr<RedisClient> redis_;
+    std::string worker_id_;
+    Options options_;
+    std::string processing_key_;
+    std::string lease_key_;
+    std::atomic<int64_t> lease_renewed_ms_{0};    // Epoch ms of the last heartbeat
+};
+
+} // namespace telemetry_processor
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "telemetry_processor/RedisClient.h"
+#include "telemetry_processor/Task.h"
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace telemetry_processor {
+
+/**
+ * @brief Parked poison tasks: a Redis list of JSON envelopes
+ *
+ * Each entry is {"task": {...}, "error": "...", "dead_at": "..."}, JSON
+ * rather than the binary frame so an operator can read it with LRANGE.
+ * Tasks stay until replayed or purged; nothing retries them on its own.
+ */
+class DeadLetterQueue {
+public:
+    struct Entry {
+        Task task;
+        std::string error;       ///< Last failure message
+        std::string dead_at;     ///< ISO-8601 UTC
+    };
+
+    /**
+     * @param redis Client
+     * @param key DLQ list key
+     * @param pending_key Where replay() sends tasks
+     */
+    DeadLetterQueue(std::shared_ptr<RedisClient> redis, std::string key, std::string pending_key);
+
+    /**
+     * @brief Park tasks with their last error (one RPUSH)
+     */
+    void park(const std::vector<Task>& tasks, const std::vector<std::string>& errors);
+
+    size_t size();
+
+    /**
+     * @brief Inspect entries without removing them, oldest first (LRANGE)
+     */
+    std::vector<Entry> peek(size_t offset, size_t count);
+
+    /**
+     * @brief Send up to count of the oldest entries back to pending with a
+     *        fresh retry budget (status PENDING, retry_count 0)
+     *
+     * LRANGE, RPUSH to pending, then LTRIM: a crash in between replays the
+     * same entries twice rather than losing them. Run one replay at a time
+     * per DLQ.
+     *
+     * @return Tasks replayed
+     */
+    size_t replay(size_t count);
+
+    /**
+     * @brief Delete every entry
+     * @return Entries deleted
+     */
+    size_t purge();
+
+    const std::string& key() const { return key_; }
+
+    /// Envelope encoding (exposed for tests and tooling)
+    static std::string encode(const Task& task, const std::string& error);
+    static Entry decode(const std::string& envelope);
+
+private:
+    std::shared_ptr<RedisClient> redis_;
+    std::string key_;
+    std::string pending_key_;
+};
+
+/**
+ * @brief Delayed retries through a Redis sorted set, poison tasks to a DLQ
+ *
+ * Retrying a failed task immediately in-process turns a poison message
+ * into a hot loop: it fails, is picked up again at once, and burns a
+ * worker until its budget is gone. Here failures leave the worker:
+ *
+ *   fail() ──retries left──▶ ZADD <pending>:retry (score = due time, epoch ms)
+ *      │                              │ promote_due(): due members, oldest first,
+ *      │                              ▼ moved in one atomic step per batch
+ *      │                          <pending> list ──▶ any worker
+ *      └──exhausted / permanent──▶ DeadLetterQueue (<pending>:dead)
+ *
+ * **Backoff**: attempt n waits min(max_delay, base_delay * 2^(n-1)),
+ * of which a `jitter` fraction is randomized ("equal jitter" at 0.5), so
+ * tasks that failed together (a database outage) do not return together.
+ *
+ * **Batching**: fail() is one ZADD and at most one RPUSH per call, and
+ * promote_due() moves up to promote_batch tasks per call. Whoever runs
+ * the mover (every Worker's prefetch thread does, every promote_interval)
+ * costs the same one round trip whether zero or hundreds are due.
+ *
+ * Thread-safe.
+ *
+ * Interview note: the Sidekiq/Resque "retry set + dead set" design; jitter
+ * as in the AWS "Exponential Backoff and Jitter" analysis
+ */
+class RetryScheduler {
+public:
+    struct Options {
+        std::string pending_key = "distqueue:tasks:pending";   ///< retry = <key>:retry, DLQ = <key>:dead
+        std::chrono::milliseconds base_delay{500};            ///< First retry
+        std::chrono::milliseconds max_delay{60000};           ///< Cap before jitter
+        double jitter = 0.5;                                  ///< Randomized fraction of each delay
+        size_t promote_batch = 256;                           ///< Tasks moved per promote_due()
+        std::chrono::milliseconds promote_interval{100};      ///< Worker: how often to promote
+    };
+
+    /// One failed task and why
+    struct Failure {
+        Task task;
+        std::string error;
+        bool permanent = false;      ///< Retrying cannot help (unknown type, invalid input)
+    };
+
+    struct Outcome {
+        size_t scheduled = 0;        ///< Sent to the retry set
+        size_t dead = 0;             ///< Sent to the DLQ
+    };
+
+    /**
+     * @brief Scheduler with default options
+     */
+    explicit RetryScheduler(std::shared_ptr<RedisClient> redis);
+
+    /**
+     * @throws std::invalid_argument on a null client or invalid delays/jitter
+     */
+    RetryScheduler(std::shared_ptr<RedisClient> redis, Options options);
+
+    /**
+     * @brief Schedule a retry for each failure with budget left, park the rest
+     *
+     * Increments retry_count of scheduled tasks and resets them to PENDING.
+     */
+    Outcome fail(std::vector<Failure> failures);
+
+    /**
+     * @brief Move due retries to the pending list
+     * @return Tasks promoted
+     */
+    size_t promote_due();
+
+    /// Retries waiting for their due time
+    size_t scheduled();
+
+    /**
+     * @brief Delay before attempt `retry_count` (1 = first retry), jitter included
+     */
+    std::chrono::milliseconds backoff(int retry_count) const;
+
+    DeadLetterQueue& dead_letters() { return dlq_; }
+
+    const std::string& retry_key() const { return retry_key_; }
+
+    const Options& options() const { return options_; }
+
+private:
+    std::shared_ptr<RedisClient> redis_;
+    Options options_;
+    std::string retry_key_;
+    DeadLetterQueue dlq_;
+};
+
+} // namespace telemetry_processor
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace telemetry_processor {
+
+/**
+ * @brief One row of the telemetry_data table
+ *
+ * Metrics use NaN for "absent" and are written as SQL NULL.
+ */
+struct TelemetryRow {
+    static constexpr double kNull = std::numeric_limits<double>::quiet_NaN();
+
+    std::string device_id;
+    std::string timestamp;       ///< ISO-8601; empty = time the row is encoded
+    double temperature = kNull;
+    double humidity = kNull;
+    double pressure = kNull;
+    double voltage = kNull;
+    double current = kNull;
+    std::string raw_data;        ///< Original JSON payload (JSONB column)
+};
+
+/**
+ * @brief Destination of bulk loads (database, file, test double)
+ *
+ * Receives whole batches in PostgreSQL COPY text format: one row per line,
+ * tab-separated columns, \N for NULL, backslash escapes. A libpq backend
+ * forwards the buffer verbatim (COPY table (columns) FROM STDIN); other
+ * backends can store or parse it.
+ *
+ * Only the StorageWriter flush thread calls a backend, so implementations
+ * need no locking of their own.
+ */
+class StorageBackend {
+public:
+    virtual ~StorageBackend() = default;
+
+    /**
+     * @brief (Re)establish the connection; called before the first load
+     *        and again after a failed one
+     */
+    virtual bool connect() = 0;
+
+    /**
+     * @brief Load one batch
+     * @param table Target table
+     * @param columns Column list, in the order of the COPY fields
+     * @param data COPY text, `rows` newline-terminated lines
+     * @return false if the batch was not stored (the writer retries)
+     */
+    virtual bool copy_rows(const std::string& table, const std::vector<std::string>& columns,
+                           const std::string& data, size_t rows) = 0;
+};
+
+/**
+ * @brief Appends every batch to a file (COPY text, loadable with \copy)
+ *
+ * Stand-in for the database in tests and local runs.
+ */
+class FileStorageBackend : public StorageBackend {
+public:
+    explicit FileStorageBackend(std::string path);
+
+    bool connect() override;
+    bool copy_rows(const std::string& table, const std::vector<std::string>& columns,
+                   const std::string& data, size_t rows) override;
+
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+/**
+ * @brief Accepts and discards every batch
+ *
+ * Mock: default backend while no database client is linked in this tree.
+ */
+class NullStorageBackend : public StorageBackend {
+public:
+    bool connect() override { return true; }
+    bool copy_rows(const std::string&, const std::vector<std::string>&,
+                   const std::string&, size_t) override { return true; }
+};
+
+/**
+ * @brief Buffers rows and bulk-loads them in batches on a background thread
+ *
+ * Row-at-a-time INSERTs cost one round trip and one statement per row; a
+ * COPY of a few thousand rows costs one. The writer turns a stream of
+ * small writes into few large loads:
+ *
+ *   write() ──encode──▶ open batch ──seal──▶ in-flight window ──▶ backend
+ *                        (by rows, bytes      (max_in_flight     (flush thread,
+ *                         or age)              sealed batches)    retries)
+ *
+ * **Flushing**: a batch is sealed when it reaches max_batch_rows or
+ * max_batch_bytes, or when it is older than flush_interval, so a quiet
+ * stream is still stored promptly.
+ *
+ * **Backpressure**: at most max_in_flight sealed batches wait for (or are
+ * in) the backend. When the window is full and the open batch is full
+ * too, write() waits up to its timeout and then returns BACKPRESSURE
+ * without taking the rows: memory stays bounded and the caller decides
+ * (retry later, leave the task in the queue, shed load).
+ *
+ * **Failures**: a failed load is retried with exponential backoff
+ * (reconnecting first); after max_retries the batch is dropped and counted
+ * in Stats::rows_failed. Rows accepted by write() are therefore stored
+ * within about flush_interval unless the backend stays down.
+ *
+ * Thread-safe: any number of threads may write concurrently. Rows are
+ * encoded outside the lock; the lock only covers appending the bytes.
+ *
+ * @code
+ * StorageWriter writer(std::make_shared<FileStorageBackend>("rows.copy"));
+ * if (writer.write(rows) == StorageWriter::WriteStatus::BACKPRESSURE) {
+ *     // Storage is behind: slow down / retry
+ * }
+ * writer.flush();   // Everything accepted so far is loaded
+ * @endcode
+ *
+ * Interview note: group commit / write coalescing - the same trade as
+ * Kafka producer linger.ms and batch.size: a little latency for a lot of
+ * throughput, with a bounded buffer as the backpressure signal
+ */
+class StorageWriter {
+public:
+    struct Options {
+        std::string table = "telemetry_data";
+        size_t max_batch_rows = 1000;                       ///< Seal at this many rows
+        size_t max_batch_bytes = 1 << 20;                   ///< ... or this much COPY text
+        std::chrono::milliseconds flush_interval{200};      ///< ... or this age
+        size_t max_in_flight = 4;                           ///< Sealed batches not yet stored
+        int max_retries = 3;                                ///< Per batch, after the first attempt
+        std::chrono::milliseconds retry_backoff{50};        ///< Doubled per retry
+    };
+
+    enum class WriteStatus {
+        ACCEPTED,        ///< Rows buffered; they will be flushed
+        BACKPRESSURE,    ///< Window full: rows NOT taken
+        CLOSED           ///< Writer is shutting down: rows NOT taken
+    };
+
+    struct Stats {
+        size_t rows_accepted = 0;
+        size_t rows_written = 0;
+        size_t rows_failed = 0;          ///< Dropped after exhausting retries
+        size_t rows_rejected = 0;        ///< Refused with BACKPRESSURE
+        size_t batches_written = 0;
+        size_t retries = 0;
+        size_t buffered_rows = 0;        ///< Accepted, not yet stored
+        size_t in_flight_batches = 0;
+    };
+
+    /**
+     * @brief Start the flush thread with default options
+     */
+    explicit StorageWriter(std::shared_ptr<StorageBackend> backend);
+
+    /**
+     * @brief Start the flush thread
+     * @throws std::invalid_argument on a null backend or zero-sized limits
+     */
+    StorageWriter(std::shared_ptr<StorageBackend> backend, Options options);
+
+    /**
+     * @brief Flush everything accepted, then stop the flush thread
+     */
+    ~StorageWriter();
+
+    StorageWriter(const StorageWriter&) = delete;
+    StorageWriter& operator=(const StorageWriter&) = delete;
+
+    /**
+     * @brief Buffer rows for the next batch(es); all-or-nothing
+     * @param wait How long to wait for room when the window is full
+     */
+    WriteStatus write(const std::vector<TelemetryRow>& rows,
+                      std::chrono::milliseconds wait = std::chrono::milliseconds(0));
+
+    WriteStatus write(const TelemetryRow& row,
+                      std::chrono::milliseconds wait = std::chrono::milliseconds(0));
+
+    /**
+     * @brief Seal the open batch and block until every accepted row has
+     *        been stored or dropped
+     */
+    void flush();
+
+    /// Column order of the COPY text (matches the telemetry_data schema)
+    static const std::vector<std::string>& columns();
+
+    /**
+     * @brief Append one row as a COPY text line (exposed for tests/backends)
+     */
+    static void encode_row(const TelemetryRow& row, std::string& out);
+
+    const Options& options() const;
+
+    Stats stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace telemetry_processor
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <nlohmann/json.hpp>
+#include "telemetry_processor/Payload.h"
+#include "telemetry_processor/Uuid.h"
 
 namespace telemetry_processor {
 
@@ -27,16 +31,51 @@ enum class TaskStatus {
     CANCELLED     // Explicitly cancelled
 };
 
+/**
+ * @brief Wire encodings of a Task
+ * 
+ * BINARY is the compact default for Redis; JSON stays available for
+ * debugging (redis-cli, logs). Task::deserialize() detects either.
+ */
+enum class WireFormat {
+    JSON,
+    BINARY
+};
+
 /**
  * @brief Core Task data structure
  * 
  * Represents a unit of work to be executed by workers.
- * Tasks are serialized to JSON for storage in Redis.
+ * Tasks are serialized for storage in Redis, either as JSON or as a
+ * fixed-layout binary frame:
+ * 
+ *   offset  size  field
+ *   0       2     magic 0xD7 0x51
+ *   2       1     format version: major (high 4 bits), minor (low 4 bits)
+ *   3       1     header size in bytes
+ *   4       1     priority
+ *   5       1     status
+ *   6       2     id length
+ *   8       4     retry_count
+ *   12      4     max_retries
+ *   16      8     created_at (ns since epoch)
+ *   24      8     updated_at (ns since epoch)
+ *   32      2     type length
+ *   34      2     worker_id length
+ *   36      4     payload length
+ *   40      ...   id, type, worker_id, payload bytes (verbatim, unparsed)
+ * 
+ * All integers little-endian. Compared to JSON: no key names, no string
+ * enums, no escaping, and full timestamp precision (JSON keeps seconds).
+ * 
+ * Versioning: a new minor version may only append header fields (and grow
+ * the header size); readers of an older minor skip them. Any other layout
+ * change is a new major version, which readers reject.
  */
 struct Task {
     std::string id;           // Unique identifier (UUID)
     std::string type;         // Task type: "compute", "io", "notify", etc.
-    std::string payload;      // JSON serialized task data
+    Payload payload;          // Task data: raw JSON bytes, parsed on first access
     Priority priority;        // Execution priority
     TaskStatus status;        // Current status
     int retry_count;          // Number of times this task has been retried
@@ -58,27 +97,56 @@ struct Task {
      */
     static Task from_json(const nlohmann::json& j);
     
+    /// Binary frame version written by to_binary(): major 0, minor 1
+    static constexpr uint8_t kBinaryVersion = 0x01;
+    
+    /**
+     * @brief Serialize task to the binary frame (see layout above)
+     * @return Encoded bytes; binary-safe in Redis values
+     */
+    std::string to_binary() const;
+    
+    /**
+     * @brief Deserialize task from a binary frame
+     * @param bytes Output of to_binary()
+     * @return Reconstructed Task
+     * @throws std::invalid_argument if truncated, not a frame, or another major version
+     */
+    static Task from_binary(std::string_view bytes);
+    
+    /**
+     * @brief Serialize in the requested wire format
+     * @param format BINARY (compact) or JSON (readable)
+     */
+    std::string serialize(WireFormat format = WireFormat::BINARY) const;
+    
+    /**
+     * @brief Deserialize either wire format (detected from the first bytes)
+     * @throws std::invalid_argument / nlohmann::json::exception on malformed input
+     */
+    static Task deserialize(std::string_view bytes);
+    
     /**
      * @brief Create a new task with generated UUID
      * @param type Task type
-     * @param payload Task data (JSON string)
+     * @param payload Task data (JSON bytes, adopted unparsed)
      * @param priority Task priority
      * @param max_retries Maximum retry attempts
      * @return New Task instance
      */
     static Task create(
         const std::string& type,
-        const std::string& payload,
+        Payload payload,
         Priority priority = Priority::NORMAL,
         int max_retries = 3
     );
 };
 
 /**
- * @brief Generate a UUID v4 string
- * @return UUID string in format: xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
+ * @brief Detect the wire format of serialized task bytes
+ * @return BINARY if the frame magic is present, JSON otherwise
  */
-std::string generate_uuid();
+WireFormat detect_wire_format(std::string_view bytes);
 
 /**
  * @brief Convert Priority to string
@@ -1,8 +1,18 @@
 #pragma once
 
+#include "telemetry_processor/AlertDispatcher.h"
+#include "telemetry_processor/AnomalyDetector.h"
+#include "telemetry_processor/StorageWriter.h"
 #include "telemetry_processor/Task.h"
-#include <memory>
+#include "telemetry_processor/WindowAggregator.h"
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 namespace telemetry_processor {
 
@@ -25,13 +35,55 @@ namespace telemetry_processor {
  *                            ↓
  *                      [Analysis/Storage/Alerts]
  * 
+ * Pipeline (per task or per batch):
+ * 
+ *   task.type ──intern──▶ TaskKind ──table──▶ batch handler
+ *   task.payload ──one SAX pass──▶ TelemetryPayload (no DOM)
+ * 
+ * - The payload is scanned exactly once, straight from its raw bytes, into
+ *   typed fields; every handler works on the parsed struct
+ * - The type string is looked up once (per task, or once per batch) and
+ *   dispatch is an array index, not a chain of string compares
+ * - process_batch() runs N same-type tasks through one handler call, so
+ *   locks, lookups and per-call overhead are paid once per batch
+ * 
+ * Thread-safe: one handler can be shared by all workers.
+ * 
  * Usage:
  *   auto handler = std::make_shared<TelemetryHandler>(db_config);
  *   worker_pool.register_handler("telemetry.analyze", handler);
  *   worker_pool.register_handler("telemetry.anomaly_detect", handler);
+ * 
+ * Interview note: "parse once, dispatch by integer, process in batches" is
+ * the same recipe as vectorized query engines and high-rate log pipelines
  */
 class TelemetryHandler {
 public:
+    /**
+     * @brief Interned task type: index into the dispatch table
+     */
+    enum class TaskKind : uint8_t {
+        ANALYZE,
+        ANOMALY_DETECT,
+        AGGREGATE,
+        STORE,
+        ALERT,
+        UNKNOWN
+    };
+    
+    static constexpr size_t kTaskKindCount = static_cast<size_t>(TaskKind::UNKNOWN);
+    
+    /**
+     * @brief Map a task type string to its TaskKind (one hash lookup)
+     * @return TaskKind, or UNKNOWN for types this handler does not serve
+     */
+    static TaskKind intern_task_type(std::string_view type);
+    
+    /**
+     * @brief Canonical type string of a TaskKind ("telemetry.analyze", ...)
+     */
+    static std::string_view task_type_name(TaskKind kind);
+    
     /**
      * @brief Processing result
      */
@@ -46,13 +98,19 @@ public:
      * @brief Configuration for telemetry processing
      */
     struct Config {
-        // Database connection
+        // Database connection (for a database StorageBackend)
         std::string db_host = "localhost";
         int db_port = 5432;
         std::string db_name = "telemetry";
         std::string db_user = "telemetry_user";
         std::string db_password = "";
         
+        // Storage batching (see StorageWriter)
+        std::string storage_file_path = "";    // Non-empty: COPY text to this file (no database)
+        size_t storage_batch_rows = 1000;      // Rows per bulk load
+        int storage_flush_ms = 200;            // Max age of a partial batch
+        size_t storage_max_in_flight = 4;      // Sealed batches before backpressure
+        
         // Anomaly detection thresholds
         double temp_high_threshold = 80.0;     // °C
         double temp_low_threshold = -20.0;     // °C
@@ -60,23 +118,52 @@ public:
         double voltage_low_threshold = 2.8;    // V
         double current_high_threshold = 2.0;   // A
         
+        // Statistical detectors, per device and metric (0 = disabled)
+        double zscore_threshold = 0.0;         // Rolling z-score limit, e.g. 3.0
+        int zscore_window = 60;                // Samples in the rolling window
+        double ewma_alpha = 0.0;               // EWMA smoothing, e.g. 0.1
+        double ewma_threshold = 4.0;           // Deviations from the EWMA mean
+        
         // Aggregation settings
         int aggregation_window_sec = 60;       // 1 minute windows
+        int aggregation_slide_sec = 0;         // 0 = tumbling, else sliding hop
+        int aggregation_lateness_sec = 5;      // Out-of-order tolerance (watermark lag)
+        std::string rollup_table = "telemetry_rollups";  // Closed windows go here ("" = take_closed_windows())
+        size_t rollup_pending_limit = 10000;   // Windows held back before the oldest are dropped
         
         // Alert settings
         std::string alert_webhook_url = "";
         bool enable_email_alerts = false;
         std::string alert_email = "";
+        int alert_suppression_sec = 60;        // Repeat window per device and reason
+        double alert_rate_per_sec = 10.0;      // Sustained deliveries (token bucket)
+        size_t alert_burst = 20;               // Token bucket size
+        size_t alert_queue_capacity = 1024;    // Distinct queued alerts before dropping
     };
     
+    /**
+     * @brief Constructor with default configuration
+     */
+    TelemetryHandler();
+    
     /**
      * @brief Constructor
      * @param config Handler configuration
      */
-    explicit TelemetryHandler(const Config& config = Config{});
+    explicit TelemetryHandler(const Config& config);
+    
+    /**
+     * @brief Constructor with explicit storage backend and alert transport
+     * @param config Handler configuration
+     * @param storage Destination of telemetry.store rows (null = from config)
+     * @param alerts Delivery of alerts (null = webhook from config)
+     */
+    TelemetryHandler(const Config& config, std::shared_ptr<StorageBackend> storage,
+                     std::shared_ptr<AlertTransport> alerts = nullptr);
     
     /**
-     * @brief Destructor
+     * @brief Destructor (stores open aggregation windows, flushes buffered
+     *        storage rows and queued alerts)
      */
     ~TelemetryHandler();
     
@@ -95,6 +182,20 @@ public:
      */
     ProcessResult process(const Task& task);
     
+    /**
+     * @brief Process many tasks, one handler call per run of equal types
+     * 
+     * Tasks need not share a type, but throughput is best when they do
+     * (the worker batches by type): each run of consecutive same-type
+     * tasks is interned once, parsed in one loop and handed to its
+     * handler as a single batch. processing_time_ms is the per-task share
+     * of the batch time.
+     * 
+     * @param tasks Tasks to process
+     * @return One ProcessResult per task, in input order
+     */
+    std::vector<ProcessResult> process_batch(const std::vector<Task>& tasks);
+    
     /**
      * @brief Statistical analysis on telemetry data
      * 
@@ -113,31 +214,48 @@ public:
      * @brief Anomaly detection using thresholds and statistical methods
      * 
      * Detects:
-     * - Out-of-range values (threshold-based)
-     * - Sudden spikes (gradient-based)
-     * - Flatlines (no variance)
-     * - Missing expected patterns
+     * - Out-of-range values: Config thresholds, evaluated for the whole
+     *   batch at once over columnar data (detect_thresholds(), SIMD)
+     * - Sudden spikes: rolling z-score per device (if zscore_threshold > 0)
+     * - Drift from recent behaviour: EWMA band per device (if ewma_alpha > 0)
      * 
      * @param task Task with telemetry payload
-     * @return Anomaly detection results (triggers alert if anomaly found)
+     * @return Anomaly detection results (triggers alert if anomaly found);
+     *         metrics "anomaly" (0/1) and "anomaly_flags" (AnomalyFlag bits)
      */
     ProcessResult handle_anomaly_detect(const Task& task);
     
     /**
      * @brief Time-based aggregation
      * 
-     * Aggregates telemetry over time windows:
-     * - 1-minute averages
-     * - 5-minute rolling windows
-     * - Hourly summaries
+     * Folds the sample into per-device event-time windows (see
+     * WindowAggregator; window, slide and lateness from Config). The sample
+     * "timestamp" (ISO-8601) is its event time; samples without one use
+     * arrival time. Windows closed by the advancing watermark are written
+     * in one batch per call to rollup_table, through the same storage
+     * backend as telemetry.store (timestamp = window start, metric columns
+     * = window mean, raw_data = count/min/max/mean/last per metric).
      * 
      * Reduces storage requirements while preserving trends.
      * 
      * @param task Task with telemetry payload
-     * @return Aggregated data
+     * @return "late" = 1 if the sample arrived after its windows closed
      */
     ProcessResult handle_aggregate(const Task& task);
     
+    /**
+     * @brief Closed aggregation windows not handed to storage (one batch)
+     * 
+     * Metrics are indexed temperature, humidity, pressure, voltage, current.
+     * With a rollup table these are only windows refused by storage
+     * backpressure (retried on the next aggregate batch unless taken here);
+     * without one, every closed window. At most rollup_pending_limit are
+     * kept, the oldest are dropped (Stats::windows_dropped).
+     * 
+     * @param flush_open Also close windows that are still open (shutdown)
+     */
+    std::vector<WindowResult> take_closed_windows(bool flush_open = false);
+    
     /**
      * @brief Store telemetry data to PostgreSQL
      * 
@@ -154,13 +272,27 @@ public:
      *     raw_data JSONB
      *   );
      * 
-     * Uses batch inserts for performance.
+     * Rows are not inserted one by one: they are handed to a StorageWriter
+     * that bulk-loads them (COPY) in batches of storage_batch_rows, or
+     * after storage_flush_ms. When storage falls behind, the task fails
+     * with "Storage backpressure" and nothing is buffered, so the task can
+     * be retried instead of growing memory.
+     * 
+     * The device's timestamp is stored normalized to UTC
+     * ("2025-12-26T10:30:00.000Z"); one that does not parse as ISO-8601 is
+     * replaced by the write time, so it cannot fail the whole COPY batch.
      * 
      * @param task Task with telemetry payload
-     * @return Storage result
+     * @return Storage result; "backpressure" = 1 if the rows were refused
      */
     ProcessResult handle_store(const Task& task);
     
+    /**
+     * @brief Block until every row accepted by handle_store() is stored
+     *        (or dropped after retries)
+     */
+    void flush_storage();
+    
     /**
      * @brief Trigger alerts based on conditions
      * 
@@ -176,11 +308,22 @@ public:
      * - Telemetry values
      * - Severity level
      * 
+     * Alerts (from here and from anomaly_detect) are filed with an
+     * AlertDispatcher and delivered asynchronously: no worker ever waits on
+     * a webhook. Repeats per device and reason are coalesced/suppressed
+     * for alert_suppression_sec and deliveries are rate limited.
+     * 
      * @param task Task with alert conditions
-     * @return Alert delivery result
+     * @return Queueing result ("Alert queued", "Alert suppressed", or a
+     *         failure when the alert queue is full)
      */
     ProcessResult handle_alert(const Task& task);
     
+    /**
+     * @brief Deliver every queued alert now and wait (shutdown, tests)
+     */
+    void flush_alerts();
+    
     /**
      * @brief Get handler statistics
      */
@@ -188,7 +331,13 @@ public:
         size_t tasks_processed = 0;
         size_t tasks_failed = 0;
         size_t anomalies_detected = 0;
-        size_t alerts_sent = 0;
+        size_t alerts_sent = 0;                // Delivered by the alert transport
+        size_t alerts_suppressed = 0;          // Repeats coalesced or suppressed
+        size_t alerts_dropped = 0;             // Alert queue full
+        size_t rows_stored = 0;                // Loaded by the storage backend
+        size_t rows_backpressured = 0;         // Refused while storage was behind
+        size_t rollups_stored = 0;             // Closed windows loaded into rollup_table
+        size_t windows_dropped = 0;            // Closed windows over rollup_pending_limit
         double avg_processing_time_ms = 0.0;
         std::map<std::string, size_t> task_type_counts;
     };
@@ -204,28 +353,43 @@ private:
     struct Impl;
     std::unique_ptr<Impl> pimpl_;
     
-    // Helper: Parse telemetry payload from JSON
+    // Helper: Parse telemetry payload from JSON (NaN = field absent)
     struct TelemetryPayload {
+        static constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+        
+        bool valid = false;                    // Well-formed JSON object
         std::string device_id;
         std::string timestamp;
-        double temperature = 0.0;
-        double humidity = 0.0;
-        double pressure = 0.0;
-        double voltage = 0.0;
-        double current = 0.0;
-        nlohmann::json raw_data;
+        double temperature = kMissing;
+        double humidity = kMissing;
+        double pressure = kMissing;
+        double voltage = kMissing;
+        double current = kMissing;
+        Payload raw_data;                      // Original bytes (shared, unparsed)
     };
     
-    TelemetryPayload parse_payload(const std::string& json_payload);
+    using Batch = std::vector<TelemetryPayload>;
+    using Results = std::vector<ProcessResult>;
+    using BatchHandler = void (TelemetryHandler::*)(const Batch&, Results&);
+    
+    // Dispatch table, indexed by TaskKind
+    static const std::array<BatchHandler, kTaskKindCount> kHandlers;
+    
+    // Batch implementations behind handle_*() and process*()
+    void analyze_batch(const Batch& batch, Results& results);
+    void anomaly_detect_batch(const Batch& batch, Results& results);
+    void aggregate_batch(const Batch& batch, Results& results);
+    void store_batch(const Batch& batch, Results& results);
+    void alert_batch(const Batch& batch, Results& results);
     
-    // Helper: Check if value exceeds thresholds
-    bool is_anomaly(const TelemetryPayload& payload);
+    // Parse + dispatch one run of same-kind tasks, append results, update stats
+    void run(TaskKind kind, const Task* tasks, size_t count, Results& results);
     
-    // Helper: Send webhook alert
-    bool send_webhook_alert(const std::string& message, const TelemetryPayload& payload);
+    TelemetryPayload parse_payload(const Payload& payload) const;
     
-    // Helper: Database connection management
-    bool ensure_db_connected();
+    // Helper: File an alert with the dispatcher (never blocks)
+    AlertDispatcher::SubmitStatus queue_alert(std::string reason, std::string message,
+                                              const char* severity, const TelemetryPayload& payload);
 };
 
 } // namespace telemetry_processor
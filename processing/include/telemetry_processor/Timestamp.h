@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace telemetry_processor {
+
+/**
+ * @brief ISO-8601 UTC timestamps <-> Unix milliseconds
+ *
+ * Calendar math is done by hand (H. Hinnant's civil date algorithms), not
+ * with gmtime_r/gmtime_s/timegm: no locale, no platform split, valid before
+ * 1970 too.
+ */
+
+/**
+ * @brief Parse e.g. "2025-12-26T10:30:00Z" or "2025-12-26T10:30:00.123+01:00"
+ * @return Unix milliseconds, or nullopt if text is not an ISO-8601 timestamp
+ */
+std::optional<int64_t> parse_iso8601_ms(std::string_view text);
+
+/**
+ * @brief Format as "2025-12-26T10:30:00.123Z"
+ */
+std::string format_iso8601_ms(int64_t unix_ms);
+
+/**
+ * @brief Current system time, formatted by format_iso8601_ms()
+ */
+std::string now_iso8601();
+
+} // namespace telemetry_processor
@@ -0,0 +1,13 @@
+#pragma once
+
+// UUIDs come from telemetry_common; processing compiles common's
+// uuid_generator.cpp (standard library only) rather than keeping its own copy.
+#include "telemetry_common/uuid_generator.h"
+
+namespace telemetry_processor {
+
+using telemetry_common::Uuid;
+using telemetry_common::generate_uuid;
+using telemetry_common::generate_uuid_v7;
+
+} // namespace telemetry_processor
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace telemetry_processor {
+
+/**
+ * @brief Running aggregate of one metric inside one window
+ */
+struct MetricAggregate {
+    size_t count = 0;
+    double sum = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double last = 0.0;           ///< Value with the latest event time
+    int64_t last_ts_ms = std::numeric_limits<int64_t>::min();
+
+    void add(double value, int64_t ts_ms) {
+        ++count;
+        sum += value;
+        min = value < min ? value : min;
+        max = value > max ? value : max;
+        if (ts_ms >= last_ts_ms) {  // Out-of-order samples don't overwrite "last"
+            last = value;
+            last_ts_ms = ts_ms;
+        }
+    }
+
+    double mean() const { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+};
+
+/**
+ * @brief One closed window of one device
+ */
+struct WindowResult {
+    static constexpr size_t kMaxMetrics = 8;
+
+    std::string device_id;
+    int64_t start_ms = 0;        ///< Inclusive
+    int64_t end_ms = 0;          ///< Exclusive
+    size_t sample_count = 0;
+    std::array<MetricAggregate, kMaxMetrics> metrics{};  ///< Indexed like Options::metric_names
+};
+
+/**
+ * @brief Per-device tumbling/sliding window aggregation on event time
+ *
+ * Samples are folded into their window(s) as they arrive (count, sum, min,
+ * max, mean, last per metric): O(1) state per open window, no raw samples
+ * kept. Windows close when the watermark passes their end and are handed
+ * out in batches by poll(), ready for one bulk write.
+ *
+ * **Event time & watermark**:
+ * - watermark = highest event time seen - max_lateness
+ * - A sample whose windows have all closed (end <= watermark) is late and
+ *   dropped (counted in Stats::late_samples); anything newer is accepted
+ *   in any order
+ *
+ * **State layout**:
+ * - Device IDs are interned once to a dense index
+ * - Open windows live in a flat open-addressing table keyed by
+ *   (device index, window start): one probe sequence in one array, no
+ *   node allocation per window
+ * - A min-heap of window ends finds closable windows without scanning
+ *
+ * Not thread-safe: callers serialize access (TelemetryHandler holds a lock
+ * per batch).
+ *
+ * @code
+ * WindowAggregator agg({60000, 0, 5000, {"temperature", "humidity"}});
+ * double values[] = {21.5, 40.0};
+ * agg.add("sensor-001", ts_ms, values);
+ * for (const auto& w : agg.poll()) store(w);   // Closed windows only
+ * @endcode
+ *
+ * Interview note: this is the Flink/Kafka Streams model (event time,
+ * watermarks, allowed lateness) reduced to a single process
+ */
+class WindowAggregator {
+public:
+    struct Options {
+        int64_t window_ms = 60000;          ///< Window length
+        int64_t slide_ms = 0;               ///< 0 = tumbling; else hop (window_ms % slide_ms == 0)
+        int64_t max_lateness_ms = 5000;     ///< Out-of-order tolerance behind the newest sample
+        std::vector<std::string> metric_names;  ///< At most WindowResult::kMaxMetrics
+    };
+
+    struct Stats {
+        size_t samples = 0;          ///< Accepted samples
+        size_t late_samples = 0;     ///< Dropped: all their windows already closed
+        size_t open_windows = 0;
+        size_t windows_emitted = 0;
+        size_t devices = 0;
+    };
+
+    /**
+     * @throws std::invalid_argument on a non-positive window, a slide that
+     *         does not divide the window, or too many metrics
+     */
+    explicit WindowAggregator(Options options);
+    ~WindowAggregator();
+
+    WindowAggregator(WindowAggregator&&) noexcept;
+    WindowAggregator& operator=(WindowAggregator&&) noexcept;
+
+    /**
+     * @brief Fold one sample into every window that contains ts_ms
+     * @param values metric_names.size() values; NaN = metric absent
+     * @return false if the sample was late and dropped
+     */
+    bool add(std::string_view device_id, int64_t ts_ms, const double* values);
+
+    /// Closed windows (end <= watermark) since the last call, in order of window end
+    std::vector<WindowResult> poll();
+
+    /// Close and return every open window (shutdown / end of stream)
+    std::vector<WindowResult> flush();
+
+    /// Current watermark (minimum int64 before the first sample)
+    int64_t watermark() const;
+
+    const Options& options() const;
+
+    Stats stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace telemetry_processor
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "telemetry_processor/Deduplicator.h"
+#include "telemetry_processor/RedisClient.h"
+#include "telemetry_processor/ReliableQueue.h"
+#include "telemetry_processor/RetryScheduler.h"
+#include "telemetry_processor/Task.h"
+#include "telemetry_processor/TelemetryHandler.h"
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace telemetry_processor {
+
+/**
+ * @brief Worker runtime: Redis → local queue → handler pool
+ *
+ * The engine between the Redis task list and the handlers:
+ *
+ *   Redis list ──LPOP n──▶ prefetch thread ──▶ in-flight table + local TaskQueue
+ *                                                        │ dequeue_bulk
+ *                                                        ▼
+ *                              pool (max_concurrency threads, `limit` active)
+ *                                                        │ one call per type run
+ *                                                        ▼
+ *                                       BatchHandler (e.g. TelemetryHandler)
+ *
+ * **Prefetching**: one thread keeps up to `prefetch` tasks local, pulling
+ * them with LPOP key count (one round trip per batch, BLPOP only when
+ * Redis is empty). Workers never touch Redis on the hot path.
+ *
+ * **In-flight tracking**: every task taken from Redis is in the in-flight
+ * table until it completes or fails for good. Failures are retried
+ * locally with exponential backoff (TaskQueue::enqueue_after) up to the
+ * task's max_retries; the table is the source of truth for what this
+ * process owes back to Redis.
+ *
+ * **Adaptive concurrency (AIMD)**: all threads exist up front, but only
+ * the first `limit` take work. Every adjust_every batches the mean
+ * per-task handler latency is compared with target_latency: above it,
+ * limit *= decrease_factor; at or below it with a backlog, limit += 1.
+ * Concurrency settles where latency stays on target instead of
+ * overloading downstream (database, webhooks).
+ *
+ * **Graceful drain**: stop() stops fetching, lets workers finish what is
+ * local (up to drain_timeout), then pushes anything unfinished back to
+ * Redis, so a restart loses no task (at-least-once).
+ *
+ * **Reliable mode** (Options::reliable): tasks are claimed with
+ * ReliableQueue instead of LPOP, so they stay in Redis, in this worker's
+ * processing list, until acked. Each processed batch is acked in one
+ * call once its tasks completed or failed for good; retries stay claimed.
+ * The prefetch thread keeps the worker's lease alive and, every
+ * reap_interval, requeues the tasks of workers whose lease expired, so a
+ * crash (not just stop()) loses nothing either.
+ *
+ * **Retry scheduling** (Options::retry_scheduler): failures leave the
+ * worker instead of being retried locally - delayed retries go to the
+ * Redis retry set, exhausted and permanent failures to the dead-letter
+ * queue - and the prefetch thread promotes due retries every
+ * promote_interval. Without it, retries back off in the local queue and
+ * exhausted tasks are dropped.
+ *
+ * **Deduplication** (Options::deduplicator): fetched tasks whose ID
+ * already completed are skipped (and acked) without running; completed
+ * IDs are recorded once per batch. See Deduplicator.
+ *
+ * @code
+ * auto redis = std::make_shared<RedisClient>();
+ * redis->connect();
+ * Worker worker(redis);
+ * worker.register_handler("telemetry.analyze", std::make_shared<TelemetryHandler>());
+ * worker.start();
+ * ...
+ * worker.stop();   // Drain
+ * @endcode
+ *
+ * Interview note: prefetch (AMQP basic.qos), AIMD (TCP congestion control,
+ * Netflix concurrency-limits) and visibility tracking (SQS in-flight
+ * messages) in one small runtime
+ */
+class Worker {
+public:
+    using Results = std::vector<TelemetryHandler::ProcessResult>;
+
+    /// Processes a run of same-type tasks; one result per task, in order
+    using BatchHandler = std::function<Results(const std::vector<Task>&)>;
+
+    struct Options {
+        std::string queue_key = "distqueue:tasks:pending";
+        std::string worker_id;                               ///< Empty = generated
+        size_t max_concurrency = 8;                          ///< Pool threads
+        size_t min_concurrency = 1;
+        size_t initial_concurrency = 2;
+        size_t batch_size = 32;                              ///< Tasks per dequeue/handler call
+        size_t prefetch = 256;                               ///< Tasks held locally (queued + running)
+        std::chrono::milliseconds target_latency{50};        ///< Per-task handler latency goal
+        double decrease_factor = 0.5;                        ///< Multiplicative decrease
+        size_t adjust_every = 8;                             ///< Batches per AIMD decision
+        std::chrono::milliseconds retry_backoff{100};        ///< Local retries: doubled per retry
+        std::chrono::milliseconds drain_timeout{5000};       ///< stop(): wait for local work
+        int poll_timeout_sec = 1;                            ///< BLPOP wait when Redis is empty
+        bool reliable = false;                               ///< Claim/ack through ReliableQueue
+        std::chrono::milliseconds lease_ttl{30000};          ///< Reliable: presumed dead after this
+        std::chrono::milliseconds reap_interval{5000};       ///< Reliable: dead-worker scan period
+        std::shared_ptr<Deduplicator> deduplicator;          ///< Null = run every task fetched
+        std::shared_ptr<RetryScheduler> retry_scheduler;     ///< Null = local retries, no DLQ
+    };
+
+    struct Stats {
+        size_t fetched = 0;              ///< Tasks taken from Redis
+        size_t completed = 0;
+        size_t retried = 0;              ///< Failed attempts scheduled again
+        size_t failed = 0;               ///< Out of retries, unknown type or malformed
+        size_t dead_lettered = 0;        ///< Failed tasks parked in the DLQ
+        size_t requeued = 0;             ///< Pushed back to Redis by stop()
+        size_t duplicates = 0;           ///< Skipped: ID already completed
+        size_t reaped = 0;               ///< Reliable: dead workers' tasks requeued (incl. own previous run)
+        size_t in_flight = 0;            ///< Taken from Redis, not finished
+        size_t concurrency_limit = 0;
+        double avg_latency_ms = 0.0;     ///< Mean per-task handler time
+    };
+
+    /**
+     * @brief Worker with default options
+     */
+    explicit Worker(std::shared_ptr<RedisClient> redis);
+
+    /**
+     * @throws std::invalid_argument on a null client, inconsistent limits,
+     *         or (reliable mode) a lease too short for the BLMOVE poll
+     */
+    Worker(std::shared_ptr<RedisClient> redis, Options options);
+
+    /**
+     * @brief Stops (and drains) if still running
+     */
+    ~Worker();
+
+    Worker(const Worker&) = delete;
+    Worker& operator=(const Worker&) = delete;
+
+    /**
+     * @brief Route a task type to a handler (before start())
+     */
+    void register_handler(const std::string& type, BatchHandler handler);
+
+    /// Route a task type to TelemetryHandler::process_batch()
+    void register_handler(const std::string& type, std::shared_ptr<TelemetryHandler> handler);
+
+    /**
+     * @brief Start the prefetch thread and the pool
+     */
+    void start();
+
+    /**
+     * @brief Graceful drain: stop fetching, finish local work (up to
+     *        drain_timeout), push the rest back to Redis, join threads
+     */
+    void stop();
+
+    bool running() const;
+
+    const std::string& worker_id() const;
+
+    Stats stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace telemetry_processor
@@ -0,0 +1,327 @@
+#include "telemetry_processor/AlertDispatcher.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace telemetry_processor {
+
+// ========== Webhook transport ==========
+
+WebhookAlertTransport::WebhookAlertTransport(std::string url)
+    : url_(std::move(url)) {
+}
+
+bool WebhookAlertTransport::send(const std::vector<Alert>& alerts) {
+    // Mock: no HTTP client in this tree yet. Log what would be POSTed.
+    if (!url_.empty()) {
+        std::clog << "[alert] POST " << url_ << " " << format_body(alerts) << "\n";
+    }
+    return true;
+}
+
+std::string WebhookAlertTransport::format_body(const std::vector<Alert>& alerts) {
+    nlohmann::json items = nlohmann::json::array();
+    for (const auto& alert : alerts) {
+        items.push_back({
+            {"device_id", alert.device_id},
+            {"reason", alert.reason},
+            {"message", alert.message},
+            {"severity", alert.severity},
+            {"timestamp", alert.timestamp},
+            {"duplicates", alert.duplicates},
+        });
+    }
+    return nlohmann::json{{"alerts", std::move(items)}}.dump();
+}
+
+// ========== Dispatcher ==========
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+class TokenBucket {
+public:
+    TokenBucket(double rate_per_sec, double capacity)
+        : rate_(rate_per_sec), capacity_(capacity), tokens_(capacity), last_(Clock::now()) {}
+
+    void refill(Clock::time_point now) {
+        const double elapsed = std::chrono::duration<double>(now - last_).count();
+        tokens_ = std::min(capacity_, tokens_ + rate_ * elapsed);
+        last_ = now;
+    }
+
+    size_t available() const { return static_cast<size_t>(tokens_); }
+
+    void take(size_t n) { tokens_ = std::max(0.0, tokens_ - static_cast<double>(n)); }
+
+private:
+    double rate_;
+    double capacity_;
+    double tokens_;
+    Clock::time_point last_;
+};
+
+// Last delivery of one (device, reason) and the repeats suppressed since
+struct Suppression {
+    Clock::time_point last_sent;
+    size_t suppressed = 0;
+};
+
+std::string alert_key(const Alert& alert) {
+    std::string key;
+    key.reserve(alert.device_id.size() + 1 + alert.reason.size());
+    key += alert.device_id;
+    key += '\x1f';  // Unit separator: cannot collide with "a" + "b:c" vs "a:b" + "c"
+    key += alert.reason;
+    return key;
+}
+
+} // namespace
+
+struct AlertDispatcher::Impl {
+    Impl(std::shared_ptr<AlertTransport> t, Options opts)
+        : transport(std::move(t)), options(opts),
+          bucket(opts.rate_per_sec, static_cast<double>(opts.burst)) {}
+
+    // Forget deliveries older than the window (their suppression has expired).
+    // Entries that swallowed repeats stay until the next submit for their key
+    // reports the count
+    void prune(Clock::time_point now) {
+        if (now - last_prune < options.suppression_window) {
+            return;
+        }
+        last_prune = now;
+        for (auto it = recent.begin(); it != recent.end();) {
+            const bool expired = now - it->second.last_sent >= options.suppression_window;
+            it = expired && it->second.suppressed == 0 ? recent.erase(it) : std::next(it);
+        }
+    }
+
+    // Caller holds mutex. Puts a failed batch back at the head of the queue,
+    // oldest first, as far as queue_capacity allows; the rest count as failed
+    void requeue(std::vector<Alert>& batch, const std::vector<std::string>& keys) {
+        const size_t room = options.queue_capacity > pending.size() ? options.queue_capacity - pending.size() : 0;
+        for (size_t i = batch.size(); i-- > 0;) {  // Reverse + push_front keeps the batch order
+            if (i >= room) {
+                ++stats.failed;
+                continue;
+            }
+            batch[i].duplicates += in_flight[keys[i]];
+            pending.push_front(std::move(batch[i]));
+            queued.emplace(keys[i], &pending.front());
+            ++stats.requeued;
+        }
+    }
+
+    void dispatch_loop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto next_flush = Clock::now() + options.flush_interval;
+        for (;;) {
+            work_cv.wait_until(lock, std::max(next_flush, retry_after), [this] {
+                if (stopping || (flush_waiters > 0 && !pending.empty())) {
+                    return true;
+                }
+                if (pending.size() < options.max_batch || Clock::now() < retry_after) {
+                    return false;
+                }
+                bucket.refill(Clock::now());
+                return bucket.available() > 0;  // Full batch and tokens to send it
+            });
+            const auto now = Clock::now();
+            if (now >= next_flush) {
+                next_flush = now + options.flush_interval;
+            }
+            prune(now);
+            if (pending.empty()) {
+                if (stopping) {
+                    return;
+                }
+                continue;
+            }
+
+            // Draining (flush/shutdown) ignores the rate limit and the retry backoff
+            const bool drain = stopping || flush_waiters > 0;
+            if (!drain && now < retry_after) {
+                continue;
+            }
+            bucket.refill(now);
+            const size_t wanted = std::min(pending.size(), options.max_batch);
+            const size_t count = drain ? wanted : std::min(wanted, bucket.available());
+            if (count < wanted) {
+                ++stats.rate_limited;
+            }
+            if (count == 0) {
+                continue;
+            }
+            bucket.take(count);
+
+            std::vector<Alert> batch;
+            std::vector<std::string> keys;
+            batch.reserve(count);
+            keys.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                keys.push_back(alert_key(pending.front()));
+                queued.erase(keys.back());
+                in_flight.emplace(keys.back(), 0);
+                batch.push_back(std::move(pending.front()));
+                pending.pop_front();
+            }
+            sending = true;
+            lock.unlock();
+
+            const bool ok = transport->send(batch);
+
+            lock.lock();
+            sending = false;
+            ++stats.batches;
+            const auto done = Clock::now();
+            if (ok) {
+                // Suppression window starts at a successful delivery; repeats that
+                // arrived during the send are reported by the next one
+                for (const auto& key : keys) {
+                    recent[key] = Suppression{done, in_flight[key]};
+                }
+                stats.sent += batch.size();
+                consecutive_failures = 0;
+                retry_after = Clock::time_point{};
+            } else if (drain) {
+                stats.failed += batch.size();  // Last attempt: flush() and shutdown must finish
+            } else {
+                const auto doubled = options.retry_backoff * (int64_t{1} << std::min(consecutive_failures, 20));
+                retry_after = done + std::min<std::chrono::milliseconds>(doubled, options.max_retry_backoff);
+                ++consecutive_failures;
+                requeue(batch, keys);
+            }
+            in_flight.clear();
+            done_cv.notify_all();
+        }
+    }
+
+    std::shared_ptr<AlertTransport> transport;
+    Options options;
+
+    mutable std::mutex mutex;
+    std::condition_variable work_cv;   // Wakes the dispatch thread
+    std::condition_variable done_cv;   // Wakes flush()
+    std::deque<Alert> pending;         // Arrival order; references stay valid on push_back/pop_front
+    std::unordered_map<std::string, Alert*> queued;         // Key -> pending alert
+    std::unordered_map<std::string, size_t> in_flight;      // Key -> repeats while being sent
+    std::unordered_map<std::string, Suppression> recent;    // Key -> last delivery
+    TokenBucket bucket;
+    Clock::time_point last_prune = Clock::now();
+    bool sending = false;
+    bool stopping = false;
+    int consecutive_failures = 0;
+    Clock::time_point retry_after;      // No sends before this after a failed one
+    size_t flush_waiters = 0;
+    Stats stats;
+
+    std::thread dispatcher;
+};
+
+AlertDispatcher::AlertDispatcher(std::shared_ptr<AlertTransport> transport)
+    : AlertDispatcher(std::move(transport), Options{}) {
+}
+
+AlertDispatcher::AlertDispatcher(std::shared_ptr<AlertTransport> transport, Options options) {
+    if (!transport) {
+        throw std::invalid_argument("AlertDispatcher: transport is null");
+    }
+    if (options.queue_capacity == 0 || options.burst == 0 || options.max_batch == 0 ||
+        !(options.rate_per_sec > 0.0)) {
+        throw std::invalid_argument("AlertDispatcher: capacity, burst, batch and rate must be > 0");
+    }
+    if (options.retry_backoff.count() < 0 || options.max_retry_backoff < options.retry_backoff) {
+        throw std::invalid_argument("AlertDispatcher: retry backoff must be >= 0 and <= max_retry_backoff");
+    }
+    impl_ = std::make_unique<Impl>(std::move(transport), options);
+    impl_->dispatcher = std::thread([impl = impl_.get()] { impl->dispatch_loop(); });
+}
+
+AlertDispatcher::~AlertDispatcher() {
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->stopping = true;
+    }
+    impl_->work_cv.notify_one();
+    impl_->dispatcher.join();
+}
+
+AlertDispatcher::SubmitStatus AlertDispatcher::submit(Alert alert) {
+    const std::string key = alert_key(alert);
+    const auto now = Clock::now();
+
+    Impl& s = *impl_;
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (s.stopping) {
+        return SubmitStatus::CLOSED;
+    }
+    ++s.stats.submitted;
+
+    auto queued = s.queued.find(key);
+    if (queued != s.queued.end()) {
+        ++queued->second->duplicates;
+        ++s.stats.coalesced;
+        return SubmitStatus::COALESCED;
+    }
+    auto in_flight = s.in_flight.find(key);
+    if (in_flight != s.in_flight.end()) {
+        ++in_flight->second;  // Carried by the requeued alert, or by the next delivery
+        ++s.stats.coalesced;
+        return SubmitStatus::COALESCED;
+    }
+
+    auto recent = s.recent.find(key);
+    if (recent != s.recent.end()) {
+        if (now - recent->second.last_sent < s.options.suppression_window) {
+            ++recent->second.suppressed;
+            ++s.stats.suppressed;
+            return SubmitStatus::SUPPRESSED;
+        }
+    }
+
+    if (s.pending.size() >= s.options.queue_capacity) {
+        ++s.stats.dropped;
+        return SubmitStatus::DROPPED;  // Any swallowed repeats wait for the next submit
+    }
+    if (recent != s.recent.end()) {
+        alert.duplicates += recent->second.suppressed;  // Report what the window swallowed
+        s.recent.erase(recent);
+    }
+    s.pending.push_back(std::move(alert));
+    s.queued.emplace(key, &s.pending.back());
+    if (s.pending.size() >= s.options.max_batch) {
+        s.work_cv.notify_one();
+    }
+    return SubmitStatus::QUEUED;
+}
+
+void AlertDispatcher::flush() {
+    Impl& s = *impl_;
+    std::unique_lock<std::mutex> lock(s.mutex);
+    ++s.flush_waiters;
+    s.work_cv.notify_one();
+    s.done_cv.wait(lock, [&s] { return (s.pending.empty() && !s.sending) || s.stopping; });
+    --s.flush_waiters;
+}
+
+const AlertDispatcher::Options& AlertDispatcher::options() const {
+    return impl_->options;
+}
+
+AlertDispatcher::Stats AlertDispatcher::stats() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    Stats stats = impl_->stats;
+    stats.queued = impl_->pending.size();
+    return stats;
+}
+
+} // namespace telemetry_processor
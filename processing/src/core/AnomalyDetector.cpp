@@ -0,0 +1,297 @@
+#include "telemetry_processor/AnomalyDetector.h"
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace telemetry_processor {
+
+// ========== Columns ==========
+
+void TelemetryColumns::reserve(size_t n) {
+    for (auto* column : {&temperature, &humidity, &pressure, &voltage, &current}) {
+        column->reserve(n);
+    }
+}
+
+void TelemetryColumns::clear() {
+    for (auto* column : {&temperature, &humidity, &pressure, &voltage, &current}) {
+        column->clear();
+    }
+}
+
+void TelemetryColumns::push_back(double t, double h, double p, double v, double c) {
+    temperature.push_back(t);
+    humidity.push_back(h);
+    pressure.push_back(p);
+    voltage.push_back(v);
+    current.push_back(c);
+}
+
+// ========== Threshold kernel ==========
+
+namespace {
+
+// Bit k of a movemask -> bit 0 of byte k (0x204081 = 1 + 1<<7 + 1<<14 + 1<<21)
+inline uint32_t spread4(uint32_t mask) {
+    return (mask * 0x00204081u) & 0x01010101u;
+}
+
+inline uint32_t spread2(uint32_t mask) {
+    return (mask * 0x81u) & 0x0101u;
+}
+
+inline uint8_t scalar_flags(const TelemetryColumns& c, const ThresholdLimits& l, size_t i) {
+    return static_cast<uint8_t>(
+        (c.temperature[i] > l.temp_high ? ANOMALY_TEMP_HIGH : 0) |
+        (c.temperature[i] < l.temp_low ? ANOMALY_TEMP_LOW : 0) |
+        (c.humidity[i] > l.humidity_high ? ANOMALY_HUMIDITY_HIGH : 0) |
+        (c.voltage[i] < l.voltage_low ? ANOMALY_VOLTAGE_LOW : 0) |
+        (c.current[i] > l.current_high ? ANOMALY_CURRENT_HIGH : 0));
+}
+
+} // namespace
+
+size_t detect_thresholds(const TelemetryColumns& columns, const ThresholdLimits& limits, uint8_t* flags) {
+    // Flag bit c is 1 << c, so each check's lane mask is spread to bytes and shifted by c
+    static_assert(ANOMALY_TEMP_HIGH == 1 && ANOMALY_TEMP_LOW == 2 && ANOMALY_HUMIDITY_HIGH == 4 &&
+                  ANOMALY_VOLTAGE_LOW == 8 && ANOMALY_CURRENT_HIGH == 16, "flag layout");
+    const double* temperature = columns.temperature.data();
+    const double* humidity = columns.humidity.data();
+    const double* voltage = columns.voltage.data();
+    const double* current = columns.current.data();
+    const size_t n = columns.size();
+    size_t flagged = 0;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256d temp_high = _mm256_set1_pd(limits.temp_high);
+    const __m256d temp_low = _mm256_set1_pd(limits.temp_low);
+    const __m256d humidity_high = _mm256_set1_pd(limits.humidity_high);
+    const __m256d voltage_low = _mm256_set1_pd(limits.voltage_low);
+    const __m256d current_high = _mm256_set1_pd(limits.current_high);
+    for (; i + 4 <= n; i += 4) {
+        const __m256d t = _mm256_loadu_pd(temperature + i);
+        const uint32_t m0 = _mm256_movemask_pd(_mm256_cmp_pd(t, temp_high, _CMP_GT_OQ));
+        const uint32_t m1 = _mm256_movemask_pd(_mm256_cmp_pd(t, temp_low, _CMP_LT_OQ));
+        const uint32_t m2 = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(humidity + i), humidity_high, _CMP_GT_OQ));
+        const uint32_t m3 = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(voltage + i), voltage_low, _CMP_LT_OQ));
+        const uint32_t m4 = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(current + i), current_high, _CMP_GT_OQ));
+        const uint32_t bytes = spread4(m0) | spread4(m1) << 1 | spread4(m2) << 2 |
+                               spread4(m3) << 3 | spread4(m4) << 4;
+        std::memcpy(flags + i, &bytes, 4);  // Little-endian: byte k = lane k
+        flagged += std::bitset<4>(m0 | m1 | m2 | m3 | m4).count();  // Portable popcount (MSVC too)
+    }
+#elif defined(__SSE2__)
+    const __m128d temp_high = _mm_set1_pd(limits.temp_high);
+    const __m128d temp_low = _mm_set1_pd(limits.temp_low);
+    const __m128d humidity_high = _mm_set1_pd(limits.humidity_high);
+    const __m128d voltage_low = _mm_set1_pd(limits.voltage_low);
+    const __m128d current_high = _mm_set1_pd(limits.current_high);
+    for (; i + 2 <= n; i += 2) {
+        const __m128d t = _mm_loadu_pd(temperature + i);
+        const uint32_t m0 = _mm_movemask_pd(_mm_cmpgt_pd(t, temp_high));
+        const uint32_t m1 = _mm_movemask_pd(_mm_cmplt_pd(t, temp_low));
+        const uint32_t m2 = _mm_movemask_pd(_mm_cmpgt_pd(_mm_loadu_pd(humidity + i), humidity_high));
+        const uint32_t m3 = _mm_movemask_pd(_mm_cmplt_pd(_mm_loadu_pd(voltage + i), voltage_low));
+        const uint32_t m4 = _mm_movemask_pd(_mm_cmpgt_pd(_mm_loadu_pd(current + i), current_high));
+        const uint32_t bytes = spread2(m0) | spread2(m1) << 1 | spread2(m2) << 2 |
+                               spread2(m3) << 3 | spread2(m4) << 4;
+        flags[i] = static_cast<uint8_t>(bytes);
+        flags[i + 1] = static_cast<uint8_t>(bytes >> 8);
+        const uint32_t any = m0 | m1 | m2 | m3 | m4;
+        flagged += (any & 1) + (any >> 1);
+    }
+#endif
+
+    for (; i < n; ++i) {
+        flags[i] = scalar_flags(columns, limits, i);
+        flagged += flags[i] != 0;
+    }
+    return flagged;
+}
+
+// ========== Stateful detectors ==========
+
+namespace {
+
+/**
+ * Device -> per-metric state, with a one-entry cache: batches usually
+ * carry runs of samples from the same device, which then skip the hash.
+ */
+template <typename State>
+class DeviceStates {
+public:
+    explicit DeviceStates(size_t metric_count, State prototype)
+        : metric_count_(metric_count), prototype_(std::move(prototype)) {}
+
+    State* lookup(std::string_view device_id) {
+        if (last_ != nullptr && last_id_ == device_id) {
+            return last_;
+        }
+        auto it = states_.find(std::string(device_id));
+        if (it == states_.end()) {
+            it = states_.emplace(std::string(device_id),
+                                 std::vector<State>(metric_count_, prototype_)).first;
+        }
+        last_id_ = it->first;  // Node-based map: key and values never move
+        last_ = it->second.data();
+        return last_;
+    }
+
+    size_t size() const { return states_.size(); }
+
+private:
+    size_t metric_count_;
+    State prototype_;
+    std::unordered_map<std::string, std::vector<State>> states_;
+    std::string_view last_id_;
+    State* last_ = nullptr;
+};
+
+struct RollingWindow {
+    std::vector<double> ring;  // Capacity = window
+    size_t head = 0;
+    size_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    double stddev() const {
+        return count > 1 ? std::sqrt(std::max(0.0, m2 / static_cast<double>(count - 1))) : 0.0;
+    }
+
+    void add(double x) {
+        const size_t capacity = ring.size();
+        if (count < capacity) {
+            // Growing phase: plain Welford
+            ring[(head + count) % capacity] = x;
+            ++count;
+            const double delta = x - mean;
+            mean += delta / static_cast<double>(count);
+            m2 += delta * (x - mean);
+            return;
+        }
+        // Full: replace the oldest value y with x in one step
+        const double y = ring[head];
+        ring[head] = x;
+        head = (head + 1) % capacity;
+        const double old_mean = mean;
+        mean += (x - y) / static_cast<double>(count);
+        m2 += (x - y) * (x - mean + y - old_mean);
+    }
+};
+
+struct EwmaState {
+    size_t count = 0;
+    double mean = 0.0;
+    double var = 0.0;
+};
+
+} // namespace
+
+struct ZScoreDetector::Impl {
+    Impl(Options opts, size_t metrics)
+        : options(opts), metric_count(metrics),
+          states(metrics, RollingWindow{std::vector<double>(opts.window, 0.0)}) {}
+
+    Options options;
+    size_t metric_count;
+    DeviceStates<RollingWindow> states;
+};
+
+ZScoreDetector::ZScoreDetector(Options options, size_t metric_count) {
+    if (options.window < 2 || metric_count == 0 || metric_count > 32) {
+        throw std::invalid_argument("ZScoreDetector: window must be >= 2 and 1..32 metrics");
+    }
+    impl_ = std::make_unique<Impl>(options, metric_count);
+}
+
+ZScoreDetector::~ZScoreDetector() = default;
+
+uint32_t ZScoreDetector::update(std::string_view device_id, const double* values) {
+    RollingWindow* windows = impl_->states.lookup(device_id);
+    const Options& options = impl_->options;
+    uint32_t outliers = 0;
+    for (size_t m = 0; m < impl_->metric_count; ++m) {
+        const double x = values[m];
+        if (std::isnan(x)) {
+            continue;
+        }
+        RollingWindow& window = windows[m];
+        if (window.count >= std::min(options.min_samples, window.ring.size())) {
+            const double sd = window.stddev();
+            // Flat history: any change is an outlier; identical values are not
+            const bool outlier = sd > 0.0 ? std::fabs(x - window.mean) > options.threshold * sd
+                                          : x != window.mean;
+            outliers |= outlier ? (1u << m) : 0u;
+        }
+        window.add(x);
+    }
+    return outliers;
+}
+
+size_t ZScoreDetector::devices() const {
+    return impl_->states.size();
+}
+
+struct EwmaDetector::Impl {
+    Impl(Options opts, size_t metrics)
+        : options(opts), metric_count(metrics), states(metrics, EwmaState{}) {}
+
+    Options options;
+    size_t metric_count;
+    DeviceStates<EwmaState> states;
+};
+
+EwmaDetector::EwmaDetector(Options options, size_t metric_count) {
+    if (!(options.alpha > 0.0 && options.alpha <= 1.0) || metric_count == 0 || metric_count > 32) {
+        throw std::invalid_argument("EwmaDetector: alpha must be in (0, 1] and 1..32 metrics");
+    }
+    impl_ = std::make_unique<Impl>(options, metric_count);
+}
+
+EwmaDetector::~EwmaDetector() = default;
+
+uint32_t EwmaDetector::update(std::string_view device_id, const double* values) {
+    EwmaState* states = impl_->states.lookup(device_id);
+    const Options& options = impl_->options;
+    const double alpha = options.alpha;
+    uint32_t outliers = 0;
+    for (size_t m = 0; m < impl_->metric_count; ++m) {
+        const double x = values[m];
+        if (std::isnan(x)) {
+            continue;
+        }
+        EwmaState& s = states[m];
+        if (s.count == 0) {
+            s.mean = x;  // Seed with the first observation
+            s.count = 1;
+            continue;
+        }
+        const double diff = x - s.mean;
+        if (s.count >= options.min_samples) {
+            const double sd = std::sqrt(s.var);
+            const bool outlier = sd > 0.0 ? std::fabs(diff) > options.threshold * sd : diff != 0.0;
+            outliers |= outlier ? (1u << m) : 0u;
+        }
+        s.mean += alpha * diff;
+        s.var = (1.0 - alpha) * (s.var + alpha * diff * diff);
+        ++s.count;
+    }
+    return outliers;
+}
+
+size_t EwmaDetector::devices() const {
+    return impl_->states.size();
+}
+
+} // namespace telemetry_processor
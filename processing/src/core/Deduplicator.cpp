@@ -0,0 +1,245 @@
+#include "telemetry_processor/Deduplicator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace telemetry_processor {
+
+// ========== Bloom filter ==========
+
+namespace {
+
+constexpr size_t kBlockBits = 512;
+
+// splitmix64 finalizer: std::hash<std::string> is not uniform in every bit
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t key_hash(const std::string& key) {
+    return mix(std::hash<std::string>{}(key));
+}
+
+} // namespace
+
+BloomFilter::BloomFilter(size_t expected_items, double bits_per_item) {
+    if (expected_items == 0 || !(bits_per_item >= 1.0)) {
+        throw std::invalid_argument("BloomFilter: expected_items and bits_per_item must be >= 1");
+    }
+    const double bits = static_cast<double>(expected_items) * bits_per_item;
+    blocks_.resize(std::max<size_t>(1, static_cast<size_t>(std::ceil(bits / kBlockBits))));
+    // Optimal k = bits/item * ln 2; 7 x 9-bit positions fit in the second hash
+    hashes_ = static_cast<unsigned>(std::clamp(std::lround(bits_per_item * 0.6931), 1L, 7L));
+    clear();
+}
+
+size_t BloomFilter::block_index(uint64_t hash) const {
+    // Multiply-shift range reduction: no modulo on the hot path
+    return static_cast<size_t>(((hash >> 32) * static_cast<uint64_t>(blocks_.size())) >> 32);
+}
+
+void BloomFilter::insert(const std::string& key) {
+    const uint64_t hash = key_hash(key);
+    Block& block = blocks_[block_index(hash)];
+    uint64_t bits = mix(hash);
+    for (unsigned i = 0; i < hashes_; ++i, bits >>= 9) {
+        const unsigned bit = static_cast<unsigned>(bits & (kBlockBits - 1));
+        block.words[bit >> 6] |= uint64_t{1} << (bit & 63);
+    }
+}
+
+bool BloomFilter::maybe_contains(const std::string& key) const {
+    const uint64_t hash = key_hash(key);
+    const Block& block = blocks_[block_index(hash)];
+    uint64_t bits = mix(hash);
+    for (unsigned i = 0; i < hashes_; ++i, bits >>= 9) {
+        const unsigned bit = static_cast<unsigned>(bits & (kBlockBits - 1));
+        if ((block.words[bit >> 6] & (uint64_t{1} << (bit & 63))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BloomFilter::clear() {
+    std::memset(blocks_.data(), 0, blocks_.size() * sizeof(Block));
+}
+
+// ========== Deduplicator ==========
+
+namespace {
+
+int64_t generation_now(std::chrono::seconds period) {
+    const auto epoch = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+    return epoch.count() / period.count();
+}
+
+} // namespace
+
+/**
+ * Filters form a ring: filters[g % generations] holds generation g while
+ * it is live. `mutex` covers the ring and the counters only.
+ */
+struct Deduplicator::Impl {
+    Impl(std::shared_ptr<RedisClient> client, Options opts)
+        : redis(std::move(client)), options(std::move(opts)) {
+        filters.reserve(options.generations);
+        for (size_t i = 0; i < options.generations; ++i) {
+            filters.emplace_back(options.expected_items, options.bits_per_item);
+        }
+        current = generation_now(options.generation_period);
+    }
+
+    std::string set_key(int64_t generation) const {
+        return options.key_prefix + ":" + std::to_string(generation);
+    }
+
+    BloomFilter& filter(int64_t generation) {
+        return filters[static_cast<size_t>(generation) % filters.size()];
+    }
+
+    // Advance the ring to now; caller holds mutex. Returns the set keys to delete.
+    std::vector<std::string> rotate() {
+        std::vector<std::string> expired;
+        const int64_t now = generation_now(options.generation_period);
+        if (now <= current) {
+            return expired;
+        }
+        const int64_t live = static_cast<int64_t>(filters.size());
+        // New generations take over (cleared) the slots of those that left the window
+        for (int64_t g = std::max(current + 1, now - live + 1); g <= now; ++g) {
+            filter(g).clear();
+        }
+        for (int64_t g = current - live + 1; g <= std::min(current, now - live); ++g) {
+            expired.push_back(set_key(g));
+        }
+        current = now;
+        ++stats.rotations;
+        return expired;
+    }
+
+    void drop(const std::vector<std::string>& keys) {
+        for (const auto& key : keys) {
+            redis->del(key);
+        }
+    }
+
+    std::shared_ptr<RedisClient> redis;
+    Options options;
+
+    mutable std::mutex mutex;
+    std::vector<BloomFilter> filters;
+    int64_t current = 0;                 // Newest live generation
+    Stats stats;
+};
+
+Deduplicator::Deduplicator(std::shared_ptr<RedisClient> redis)
+    : Deduplicator(std::move(redis), Options{}) {
+}
+
+Deduplicator::Deduplicator(std::shared_ptr<RedisClient> redis, Options options) {
+    if (!redis) {
+        throw std::invalid_argument("Deduplicator: redis client is null");
+    }
+    if (options.generations < 2 || options.generation_period.count() <= 0) {
+        throw std::invalid_argument("Deduplicator: need >= 2 generations and a positive period");
+    }
+    impl_ = std::make_unique<Impl>(std::move(redis), std::move(options));
+}
+
+Deduplicator::~Deduplicator() = default;
+
+std::vector<bool> Deduplicator::seen(const std::vector<std::string>& ids) {
+    Impl& s = *impl_;
+    std::vector<bool> duplicate(ids.size(), false);
+    std::vector<size_t> hits;
+    std::vector<std::string> expired;
+    int64_t newest = 0;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        expired = s.rotate();
+        newest = s.current;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            for (const auto& filter : s.filters) {
+                if (filter.maybe_contains(ids[i])) {
+                    hits.push_back(i);
+                    break;
+                }
+            }
+        }
+        s.stats.checked += ids.size();
+        s.stats.bloom_misses += ids.size() - hits.size();
+        s.stats.remote_checks += hits.size();
+    }
+    s.drop(expired);
+    if (hits.empty()) {
+        return duplicate;
+    }
+
+    // Only the probable duplicates go to Redis: one call per live generation
+    std::vector<std::string> candidates;
+    candidates.reserve(hits.size());
+    for (size_t i : hits) {
+        candidates.push_back(ids[i]);
+    }
+    const int64_t live = static_cast<int64_t>(s.options.generations);
+    for (int64_t g = newest; g > newest - live; --g) {
+        const auto found = s.redis->smismember(s.set_key(g), candidates);
+        for (size_t j = 0; j < hits.size(); ++j) {
+            if (found[j]) {
+                duplicate[hits[j]] = true;
+            }
+        }
+    }
+
+    size_t confirmed = 0;
+    for (size_t i : hits) {
+        confirmed += duplicate[i] ? 1 : 0;
+    }
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.stats.duplicates += confirmed;
+    s.stats.false_positives += hits.size() - confirmed;
+    return duplicate;
+}
+
+void Deduplicator::record(const std::vector<std::string>& ids) {
+    if (ids.empty()) {
+        return;
+    }
+    Impl& s = *impl_;
+    std::vector<std::string> expired;
+    int64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        expired = s.rotate();
+        generation = s.current;
+        BloomFilter& filter = s.filter(generation);
+        for (const auto& id : ids) {
+            filter.insert(id);
+        }
+        s.stats.recorded += ids.size();
+    }
+    s.drop(expired);
+    s.redis->sadd(s.set_key(generation), ids);
+}
+
+const Deduplicator::Options& Deduplicator::options() const {
+    return impl_->options;
+}
+
+Deduplicator::Stats Deduplicator::stats() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->stats;
+}
+
+} // namespace telemetry_processor
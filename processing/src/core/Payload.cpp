@@ -0,0 +1,292 @@
+#include "telemetry_processor/Payload.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace telemetry_processor {
+
+namespace {
+
+using json = nlohmann::json;
+
+/**
+ * SAX handler that picks a set of top-level keys out of the document in one
+ * pass. Scalars are written straight into their slot; an object/array value
+ * for a wanted key reports Compound so the caller can fall back to the DOM.
+ * Scanning continues to the end so a duplicate key later on wins and a
+ * malformed tail reports Invalid - both as json() would.
+ */
+class FieldScanner {
+public:
+    enum class Result { Object, Compound, Invalid, NotObject };
+
+    FieldScanner(const std::string_view* keys, json* values, size_t count)
+        : keys_(keys), values_(values), count_(count) {}
+
+    bool null() { return scalar(nullptr); }
+    bool boolean(bool value) { return scalar(value); }
+    bool number_integer(json::number_integer_t value) { return scalar(value); }
+    bool number_unsigned(json::number_unsigned_t value) { return scalar(value); }
+    bool number_float(json::number_float_t value, const json::string_t&) { return scalar(value); }
+    bool string(json::string_t& value) { return scalar(std::move(value)); }
+    bool binary(json::binary_t& value) { return scalar(json::binary(std::move(value))); }
+
+    bool start_object(std::size_t) { return open(); }
+    bool start_array(std::size_t) {
+        if (depth_ == 0) {
+            return stop(Result::NotObject);
+        }
+        return open();
+    }
+    bool end_object() { return close(); }
+    bool end_array() { return close(); }
+
+    bool key(json::string_t& key) {
+        matched_ = kNone;
+        if (depth_ == 1) {
+            for (size_t i = 0; i < count_; ++i) {
+                if (key == keys_[i]) {
+                    matched_ = i;
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) {
+        return stop(Result::Invalid);
+    }
+
+    Result result() const { return result_; }
+
+private:
+    static constexpr size_t kNone = static_cast<size_t>(-1);
+
+    template <typename T>
+    bool scalar(T&& value) {
+        if (depth_ == 0) {
+            return stop(Result::NotObject);  // Root is a scalar: no fields
+        }
+        if (matched_ != kNone) {
+            values_[matched_] = json(std::forward<T>(value));  // A later duplicate overwrites it
+            matched_ = kNone;
+        }
+        return true;
+    }
+
+    bool open() {
+        if (matched_ != kNone) {
+            return stop(Result::Compound);
+        }
+        ++depth_;
+        return true;
+    }
+
+    bool close() {
+        --depth_;
+        return true;
+    }
+
+    bool stop(Result result) {
+        result_ = result;
+        return false;
+    }
+
+    const std::string_view* keys_;
+    json* values_;
+    size_t count_;
+    int depth_ = 0;
+    size_t matched_ = kNone;
+    Result result_ = Result::Object;
+};
+
+const std::string kEmptyBytes;
+const json kNull;
+
+} // namespace
+
+/**
+ * Immutable once shared: whichever representation is missing (bytes or DOM)
+ * is derived at most once under a once_flag, so const access from several
+ * threads is safe.
+ */
+struct Payload::Buffer {
+    explicit Buffer(std::string raw)
+        : bytes(std::move(raw)), from_bytes(true) {}
+
+    explicit Buffer(nlohmann::json value)
+        : doc(std::move(value)), from_bytes(false), parsed(true) {}
+
+    const nlohmann::json& get_doc() {
+        std::call_once(parse_once, [this] {
+            if (!from_bytes || bytes.empty()) {
+                parsed.store(true, std::memory_order_release);
+                return;  // No bytes: null, like a default Payload
+            }
+            doc = nlohmann::json::parse(bytes, nullptr, /*allow_exceptions=*/false);
+            if (doc.is_discarded()) {
+                doc = nullptr;
+                valid = false;
+            }
+            parsed.store(true, std::memory_order_release);
+        });
+        return doc;
+    }
+
+    const std::string& get_bytes() {
+        std::call_once(dump_once, [this] {
+            if (!from_bytes) {
+                bytes = doc.dump();
+                dumped = true;
+            }
+        });
+        return bytes;
+    }
+
+    std::string bytes;
+    nlohmann::json doc;
+    const bool from_bytes;
+    bool valid = true;
+    bool dumped = false;
+    std::atomic<bool> parsed{false};
+    std::atomic<bool> scanned{false};  ///< operator[] already spent its one SAX scan
+    std::once_flag parse_once;
+    std::once_flag dump_once;
+};
+
+Payload::Payload(std::string raw)
+    : buffer_(std::make_shared<Buffer>(std::move(raw))) {
+}
+
+Payload::Payload(const char* raw)
+    : Payload(std::string(raw ? raw : "")) {
+}
+
+Payload::Payload(nlohmann::json doc)
+    : buffer_(std::make_shared<Buffer>(std::move(doc))) {
+}
+
+Payload::Payload(nlohmann::json::initializer_list_t init)
+    : Payload(nlohmann::json(init)) {
+}
+
+const std::string& Payload::raw() const {
+    return buffer_ ? buffer_->get_bytes() : kEmptyBytes;
+}
+
+const nlohmann::json& Payload::json() const {
+    return buffer_ ? buffer_->get_doc() : kNull;
+}
+
+nlohmann::json& Payload::mutable_json() {
+    // Reuse the buffer only if nobody else sees it and no bytes were derived
+    if (buffer_ && buffer_.use_count() == 1 && !buffer_->from_bytes && !buffer_->dumped) {
+        return buffer_->doc;
+    }
+    nlohmann::json doc;
+    if (buffer_) {
+        if (buffer_.use_count() == 1) {
+            buffer_->get_doc();
+            doc = std::move(buffer_->doc);  // Sole owner: steal the DOM
+        } else {
+            doc = buffer_->get_doc();
+        }
+    }
+    buffer_ = std::make_shared<Buffer>(std::move(doc));
+    return buffer_->doc;
+}
+
+const nlohmann::json Payload::operator[](std::string_view key) const {
+    if (!buffer_) {
+        return nullptr;
+    }
+
+    // Only the first lookup scans: a second one means more fields are wanted,
+    // and one parse is cheaper than a full scan per field
+    if (!buffer_->parsed.load(std::memory_order_acquire) &&
+        !buffer_->scanned.exchange(true, std::memory_order_relaxed)) {
+        nlohmann::json value;
+        FieldScanner scanner(&key, &value, 1);
+        const std::string& bytes = buffer_->bytes;
+        nlohmann::json::sax_parse(bytes.begin(), bytes.end(), &scanner);
+        switch (scanner.result()) {
+            case FieldScanner::Result::Object:
+                return value;
+            case FieldScanner::Result::NotObject:
+            case FieldScanner::Result::Invalid:
+                return nullptr;
+            case FieldScanner::Result::Compound:
+                break;  // Object/array field: parse once, then serve from the DOM
+        }
+    }
+
+    const nlohmann::json& doc = buffer_->get_doc();
+    if (!doc.is_object()) {
+        return nullptr;
+    }
+    auto it = doc.find(std::string(key));
+    return it != doc.end() ? *it : nlohmann::json();
+}
+
+bool Payload::read_fields(const std::string_view* keys, nlohmann::json* out, size_t count) const {
+    std::fill(out, out + count, nullptr);
+    if (!buffer_) {
+        return false;
+    }
+
+    if (!buffer_->parsed.load(std::memory_order_acquire)) {
+        FieldScanner scanner(keys, out, count);
+        const std::string& bytes = buffer_->bytes;
+        nlohmann::json::sax_parse(bytes.begin(), bytes.end(), &scanner);
+        switch (scanner.result()) {
+            case FieldScanner::Result::Object:
+                return true;
+            case FieldScanner::Result::NotObject:
+            case FieldScanner::Result::Invalid:
+                std::fill(out, out + count, nullptr);  // Drop what was read before the stop
+                return false;
+            case FieldScanner::Result::Compound:
+                break;
+        }
+    }
+
+    const nlohmann::json& doc = buffer_->get_doc();
+    if (!doc.is_object()) {
+        std::fill(out, out + count, nullptr);
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        auto it = doc.find(std::string(keys[i]));
+        out[i] = it != doc.end() ? *it : nlohmann::json();
+    }
+    return true;
+}
+
+bool Payload::empty() const {
+    if (!buffer_) {
+        return true;
+    }
+    return buffer_->from_bytes ? buffer_->bytes.empty() : buffer_->doc.empty();
+}
+
+bool Payload::is_parsed() const {
+    return buffer_ && buffer_->parsed.load(std::memory_order_acquire);
+}
+
+bool Payload::is_valid() const {
+    if (!buffer_) {
+        return true;
+    }
+    buffer_->get_doc();
+    return buffer_->valid;
+}
+
+bool operator==(const Payload& a, const Payload& b) {
+    if (a.buffer_ == b.buffer_ || a.raw() == b.raw()) {
+        return true;  // Shared buffer or identical bytes: no parse needed
+    }
+    return a.json() == b.json();
+}
+
+} // namespace telemetry_processor
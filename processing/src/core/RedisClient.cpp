@@ -1,68 +1,480 @@
 #include "telemetry_processor/RedisClient.h"
-#include <map>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <deque>
+#include <functional>
 #include <mutex>
+#include <set>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace telemetry_processor {
 
 /**
- * Day 1: Mock Redis implementation using in-memory data structures
- * This allows us to build and test without external Redis dependency
- * 
- * Day 2: Replace with real redis-plus-plus implementation
+ * In-process Redis stand-in: sharded hash maps with real blocking pops
+ *
+ * - Keys hash to one of kShardCount shards, each with its own mutex, so
+ *   workers touching different keys never contend on the same lock
+ * - Every list has its own condition variable: RPUSH wakes exactly one
+ *   BLPOP waiter on that key instead of every consumer in the process
+ * - BLPOP sleeps until data arrives or the timeout expires (no busy-spin)
+ *
+ * Interview note: lock striping is how ConcurrentHashMap (Java) and
+ * Redis Cluster slots scale - contention drops by ~1/shards
  */
 struct RedisClient::Impl {
-    std::map<std::string, std::string> kv_store;           // Key-value store
-    std::map<std::string, std::deque<std::string>> lists;  // Lists
-    std::mutex mutex;                                       // Thread safety
-    
+    static constexpr size_t kShardCount = 64;
+
+    struct List {
+        std::deque<std::string> items;
+        std::condition_variable not_empty;
+        size_t waiters = 0;  // Entry must outlive blocked BLPOPs
+    };
+
+    struct SortedSet {
+        std::unordered_map<std::string, double> scores;
+        std::set<std::pair<double, std::string>> by_score;
+    };
+
+    // One cache line per shard mutex to avoid false sharing between shards
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::string> kv_store;  // Key-value store
+        std::unordered_map<std::string, List> lists;            // Lists (node-based: stable addresses)
+        std::unordered_map<std::string, SortedSet> zsets;       // Sorted sets
+        std::unordered_map<std::string, std::unordered_set<std::string>> sets;
+    };
+
+    std::array<Shard, kShardCount> shards;
+    std::atomic<bool> closed{false};
+
+    Shard& shard_for(const std::string& key) {
+        return shards[std::hash<std::string>{}(key) % kShardCount];
+    }
+
+    // Redis drops empty lists; keep the entry while someone waits on its condition variable
+    static void drop_if_unused(Shard& shard, const std::string& key, const List& list) {
+        if (list.items.empty() && list.waiters == 0) {
+            shard.lists.erase(key);
+        }
+    }
+
     bool rpush(const std::string& key, const std::string& value) {
-        std::lock_guard<std::mutex> lock(mutex);
-        lists[key].push_back(value);
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        List& list = shard.lists[key];
+        list.items.push_back(value);
+        if (list.waiters > 0) {
+            list.not_empty.notify_one();
+        }
         return true;
     }
-    
-    std::optional<std::string> blpop(const std::string& key, int /*timeout_seconds*/) {
-        std::lock_guard<std::mutex> lock(mutex);
-        auto it = lists.find(key);
-        if (it == lists.end() || it->second.empty()) {
+
+    bool rpush(const std::string& key, const std::vector<std::string>& values) {
+        if (values.empty()) {
+            return true;
+        }
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        List& list = shard.lists[key];
+        list.items.insert(list.items.end(), values.begin(), values.end());
+        if (list.waiters > 0) {
+            list.not_empty.notify_all();
+        }
+        return true;
+    }
+
+    std::vector<std::string> lrange(const std::string& key, long long start, long long stop) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::vector<std::string> values;
+        auto it = shard.lists.find(key);
+        if (it == shard.lists.end()) {
+            return values;
+        }
+        const auto& items = it->second.items;
+        const long long size = static_cast<long long>(items.size());
+        // Negative indexes count from the tail, as in Redis
+        if (start < 0) {
+            start = std::max(0LL, size + start);
+        }
+        if (stop < 0) {
+            stop = size + stop;
+        }
+        stop = std::min(stop, size - 1);
+        for (long long i = start; i <= stop; ++i) {
+            values.push_back(items[static_cast<size_t>(i)]);
+        }
+        return values;
+    }
+
+    void ltrim(const std::string& key, long long start, long long stop) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.lists.find(key);
+        if (it == shard.lists.end()) {
+            return;
+        }
+        auto& items = it->second.items;
+        const long long size = static_cast<long long>(items.size());
+        if (start < 0) {
+            start = std::max(0LL, size + start);
+        }
+        if (stop < 0) {
+            stop = size + stop;
+        }
+        stop = std::min(stop, size - 1);
+        if (start > stop) {
+            items.clear();  // Empty range empties the list, as in Redis
+        } else {
+            items.erase(items.begin() + (stop + 1), items.end());
+            items.erase(items.begin(), items.begin() + start);
+        }
+        drop_if_unused(shard, key, it->second);
+    }
+
+    std::optional<std::string> blpop(const std::string& key, int timeout_seconds) {
+        Shard& shard = shard_for(key);
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        List& list = shard.lists[key];
+
+        if (list.items.empty() && !closed) {
+            ++list.waiters;
+            auto ready = [&] { return !list.items.empty() || closed; };
+            if (timeout_seconds > 0) {
+                list.not_empty.wait_for(lock, std::chrono::seconds(timeout_seconds), ready);
+            } else {
+                list.not_empty.wait(lock, ready);
+            }
+            --list.waiters;
+        }
+
+        if (list.items.empty()) {
+            drop_if_unused(shard, key, list);
             return std::nullopt;
         }
-        
-        std::string value = it->second.front();
-        it->second.pop_front();
+        std::string value = std::move(list.items.front());
+        list.items.pop_front();
+        drop_if_unused(shard, key, list);
         return value;
     }
-    
+
+    std::vector<std::string> lpop(const std::string& key, size_t count) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::vector<std::string> values;
+        auto it = shard.lists.find(key);
+        if (it == shard.lists.end()) {
+            return values;
+        }
+        List& list = it->second;
+        const size_t n = std::min(count, list.items.size());
+        values.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            values.push_back(std::move(list.items.front()));
+            list.items.pop_front();
+        }
+        drop_if_unused(shard, key, list);
+        return values;
+    }
+
+    // Both shards locked (std::lock: no ordering deadlock between opposite moves)
+    struct PairLock {
+        PairLock(Shard& a, Shard& b) : first(a.mutex, std::defer_lock), second(b.mutex, std::defer_lock) {
+            if (&a == &b) {
+                first.lock();
+            } else {
+                std::lock(first, second);
+            }
+        }
+        std::unique_lock<std::mutex> first;
+        std::unique_lock<std::mutex> second;
+    };
+
+    std::vector<std::string> lmove(const std::string& source, const std::string& destination, size_t count) {
+        Shard& from = shard_for(source);
+        Shard& to = shard_for(destination);
+        PairLock lock(from, to);
+
+        std::vector<std::string> moved;
+        auto it = from.lists.find(source);
+        if (it == from.lists.end() || it->second.items.empty() || count == 0) {
+            return moved;
+        }
+        List& src = it->second;
+        List& dst = to.lists[destination];
+        const size_t n = std::min(count, src.items.size());
+        moved.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            moved.push_back(src.items.front());
+            dst.items.push_back(std::move(src.items.front()));
+            src.items.pop_front();
+        }
+        if (dst.waiters > 0) {
+            dst.not_empty.notify_all();
+        }
+        drop_if_unused(from, source, src);
+        return moved;
+    }
+
+    // Wait for source to have items, then race for one with lmove()
+    std::optional<std::string> blmove(const std::string& source, const std::string& destination,
+                                      int timeout_seconds) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout_seconds);
+        for (;;) {
+            auto moved = lmove(source, destination, 1);
+            if (!moved.empty()) {
+                return std::move(moved.front());
+            }
+            Shard& shard = shard_for(source);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            List& list = shard.lists[source];
+            if (list.items.empty() && !closed) {
+                ++list.waiters;
+                auto ready = [&] { return !list.items.empty() || closed; };
+                if (timeout_seconds > 0) {
+                    list.not_empty.wait_until(lock, deadline, ready);
+                } else {
+                    list.not_empty.wait(lock, ready);
+                }
+                --list.waiters;
+            }
+            const bool has_items = !list.items.empty();
+            drop_if_unused(shard, source, list);
+            if (!has_items || closed) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    // One pass over the list, however many values
+    size_t lrem(const std::string& key, const std::vector<std::string>& values) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.lists.find(key);
+        if (it == shard.lists.end() || values.empty()) {
+            return 0;
+        }
+        std::unordered_map<std::string_view, size_t> wanted;
+        for (const auto& value : values) {
+            ++wanted[value];
+        }
+        auto& items = it->second.items;
+        size_t removed = 0;
+        auto out = items.begin();
+        for (auto in = items.begin(); in != items.end(); ++in) {
+            auto match = wanted.find(*in);
+            if (match != wanted.end() && match->second > 0) {
+                --match->second;
+                ++removed;
+                continue;
+            }
+            if (out != in) {
+                *out = std::move(*in);
+            }
+            ++out;
+        }
+        items.erase(out, items.end());
+        drop_if_unused(shard, key, it->second);
+        return removed;
+    }
+
+    static bool zadd_locked(SortedSet& zset, const std::string& member, double score) {
+        auto it = zset.scores.find(member);
+        if (it != zset.scores.end()) {
+            zset.by_score.erase({it->second, member});
+            it->second = score;
+            zset.by_score.emplace(score, member);
+            return false;
+        }
+        zset.scores.emplace(member, score);
+        zset.by_score.emplace(score, member);
+        return true;
+    }
+
+    bool zadd(const std::string& key, const std::string& member, double score) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return zadd_locked(shard.zsets[key], member, score);
+    }
+
+    size_t zadd(const std::string& key, const std::vector<std::pair<std::string, double>>& members) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        SortedSet& zset = shard.zsets[key];
+        size_t added = 0;
+        for (const auto& member : members) {
+            added += zadd_locked(zset, member.first, member.second) ? 1 : 0;
+        }
+        if (zset.scores.empty()) {
+            shard.zsets.erase(key);
+        }
+        return added;
+    }
+
+    size_t zcard(const std::string& key) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.zsets.find(key);
+        return it == shard.zsets.end() ? 0 : it->second.scores.size();
+    }
+
+    // Lowest scores first; pop and push under both shard locks
+    size_t zmove_to_list(const std::string& source, const std::string& destination,
+                         double max_score, size_t limit) {
+        Shard& from = shard_for(source);
+        Shard& to = shard_for(destination);
+        PairLock lock(from, to);
+
+        auto it = from.zsets.find(source);
+        if (it == from.zsets.end() || limit == 0) {
+            return 0;
+        }
+        SortedSet& zset = it->second;
+        List& list = to.lists[destination];
+        size_t moved = 0;
+        while (!zset.by_score.empty() && moved < limit && zset.by_score.begin()->first <= max_score) {
+            auto entry = zset.by_score.begin();
+            zset.scores.erase(entry->second);
+            list.items.push_back(entry->second);
+            zset.by_score.erase(entry);
+            ++moved;
+        }
+        if (moved > 0 && list.waiters > 0) {
+            list.not_empty.notify_all();
+        }
+        if (zset.scores.empty()) {
+            from.zsets.erase(it);
+        }
+        if (list.items.empty() && list.waiters == 0) {
+            to.lists.erase(destination);
+        }
+        return moved;
+    }
+
+    std::vector<std::string> zrangebyscore(const std::string& key, double min, double max, size_t limit) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::vector<std::string> members;
+        auto it = shard.zsets.find(key);
+        if (it == shard.zsets.end()) {
+            return members;
+        }
+        const auto& by_score = it->second.by_score;
+        for (auto entry = by_score.lower_bound({min, std::string()});
+             entry != by_score.end() && entry->first <= max && members.size() < limit; ++entry) {
+            members.push_back(entry->second);
+        }
+        return members;
+    }
+
+    bool zrem(const std::string& key, const std::string& member) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.zsets.find(key);
+        if (it == shard.zsets.end()) {
+            return false;
+        }
+        SortedSet& zset = it->second;
+        auto score = zset.scores.find(member);
+        if (score == zset.scores.end()) {
+            return false;
+        }
+        zset.by_score.erase({score->second, member});
+        zset.scores.erase(score);
+        if (zset.scores.empty()) {
+            shard.zsets.erase(it);
+        }
+        return true;
+    }
+
+    size_t sadd(const std::string& key, const std::vector<std::string>& members) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto& set = shard.sets[key];
+        size_t added = 0;
+        for (const auto& member : members) {
+            added += set.insert(member).second ? 1 : 0;
+        }
+        if (set.empty()) {
+            shard.sets.erase(key);
+        }
+        return added;
+    }
+
+    std::vector<bool> smismember(const std::string& key, const std::vector<std::string>& members) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::vector<bool> found(members.size(), false);
+        auto it = shard.sets.find(key);
+        if (it == shard.sets.end()) {
+            return found;
+        }
+        for (size_t i = 0; i < members.size(); ++i) {
+            found[i] = it->second.count(members[i]) > 0;
+        }
+        return found;
+    }
+
     bool set(const std::string& key, const std::string& value) {
-        std::lock_guard<std::mutex> lock(mutex);
-        kv_store[key] = value;
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.kv_store[key] = value;
         return true;
     }
-    
+
     std::optional<std::string> get(const std::string& key) {
-        std::lock_guard<std::mutex> lock(mutex);
-        auto it = kv_store.find(key);
-        if (it == kv_store.end()) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.kv_store.find(key);
+        if (it == shard.kv_store.end()) {
             return std::nullopt;
         }
         return it->second;
     }
-    
+
     bool del(const std::string& key) {
-        std::lock_guard<std::mutex> lock(mutex);
-        bool deleted = kv_store.erase(key) > 0;
-        deleted |= lists.erase(key) > 0;
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        bool deleted = shard.kv_store.erase(key) > 0;
+        deleted |= shard.zsets.erase(key) > 0;
+        deleted |= shard.sets.erase(key) > 0;
+        auto it = shard.lists.find(key);
+        if (it != shard.lists.end()) {
+            deleted |= !it->second.items.empty();
+            it->second.items.clear();
+            drop_if_unused(shard, key, it->second);
+        }
         return deleted;
     }
-    
+
     long long llen(const std::string& key) {
-        std::lock_guard<std::mutex> lock(mutex);
-        auto it = lists.find(key);
-        if (it == lists.end()) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.lists.find(key);
+        if (it == shard.lists.end()) {
             return 0;
         }
-        return static_cast<long long>(it->second.size());
+        return static_cast<long long>(it->second.items.size());
+    }
+
+    // Open/close the store; closing wakes every blocked BLPOP with nullopt
+    void set_closed(bool value) {
+        closed = value;
+        if (!value) {
+            return;
+        }
+        for (auto& shard : shards) {
+            // Taking the lock orders the flag before any waiter's predicate check
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto& entry : shard.lists) {
+                entry.second.not_empty.notify_all();
+            }
+        }
     }
 };
 
@@ -78,10 +490,16 @@ RedisClient::~RedisClient() = default;
 
 bool RedisClient::connect() {
     // Mock: always succeeds
+    impl_->set_closed(false);
     connected_ = true;
     return true;
 }
 
+void RedisClient::disconnect() {
+    connected_ = false;
+    impl_->set_closed(true);
+}
+
 bool RedisClient::is_connected() const {
     return connected_;
 }
@@ -107,6 +525,115 @@ std::optional<std::string> RedisClient::blpop(const std::string& key, int timeou
     return impl_->blpop(key, timeout_seconds);
 }
 
+std::vector<std::string> RedisClient::lpop(const std::string& key, size_t count) {
+    if (!connected_) {
+        return {};
+    }
+    return impl_->lpop(key, count);
+}
+
+bool RedisClient::rpush(const std::string& key, const std::vector<std::string>& values) {
+    if (!connected_) {
+        return false;
+    }
+    return impl_->rpush(key, values);
+}
+
+std::vector<std::string> RedisClient::lrange(const std::string& key, long long start, long long stop) {
+    if (!connected_) {
+        return {};
+    }
+    return impl_->lrange(key, start, stop);
+}
+
+void RedisClient::ltrim(const std::string& key, long long start, long long stop) {
+    if (!connected_) {
+        return;
+    }
+    impl_->ltrim(key, start, stop);
+}
+
+std::vector<std::string> RedisClient::lmove(const std::string& source, const std::string& destination,
+                                            size_t count) {
+    if (!connected_) {
+        return {};
+    }
+    return impl_->lmove(source, destination, count);
+}
+
+std::optional<std::string> RedisClient::blmove(const std::string& source, const std::string& destination,
+                                               int timeout_seconds) {
+    if (!connected_) {
+        return std::nullopt;
+    }
+    return impl_->blmove(source, destination, timeout_seconds);
+}
+
+size_t RedisClient::lrem(const std::string& key, const std::vector<std::string>& values) {
+    if (!connected_) {
+        return 0;
+    }
+    return impl_->lrem(key, values);
+}
+
+bool RedisClient::zadd(const std::string& key, const std::string& member, double score) {
+    if (!connected_) {
+        return false;
+    }
+    return impl_->zadd(key, member, score);
+}
+
+size_t RedisClient::zadd(const std::string& key, const std::vector<std::pair<std::string, double>>& members) {
+    if (!connected_) {
+        return 0;
+    }
+    return impl_->zadd(key, members);
+}
+
+size_t RedisClient::zcard(const std::string& key) {
+    if (!connected_) {
+        return 0;
+    }
+    return impl_->zcard(key);
+}
+
+size_t RedisClient::zmove_to_list(const std::string& source, const std::string& destination,
+                                  double max_score, size_t limit) {
+    if (!connected_) {
+        return 0;
+    }
+    return impl_->zmove_to_list(source, destination, max_score, limit);
+}
+
+std::vector<std::string> RedisClient::zrangebyscore(const std::string& key, double min, double max,
+                                                    size_t limit) {
+    if (!connected_) {
+        return {};
+    }
+    return impl_->zrangebyscore(key, min, max, limit);
+}
+
+bool RedisClient::zrem(const std::string& key, const std::string& member) {
+    if (!connected_) {
+        return false;
+    }
+    return impl_->zrem(key, member);
+}
+
+size_t RedisClient::sadd(const std::string& key, const std::vector<std::string>& members) {
+    if (!connected_) {
+        return 0;
+    }
+    return impl_->sadd(key, members);
+}
+
+std::vector<bool> RedisClient::smismember(const std::string& key, const std::vector<std::string>& members) {
+    if (!connected_) {
+        return std::vector<bool>(members.size(), false);
+    }
+    return impl_->smismember(key, members);
+}
+
 bool RedisClient::set(const std::string& key, const std::string& value) {
     if (!connected_) {
         return false;
@@ -0,0 +1,101 @@
+#include "telemetry_processor/ReliableQueue.h"
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace telemetry_processor {
+
+namespace {
+
+constexpr size_t kAll = std::numeric_limits<size_t>::max();
+
+// Lease scores are wall-clock: workers in other processes must agree on them
+int64_t epoch_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+ReliableQueue::ReliableQueue(std::shared_ptr<RedisClient> redis, std::string worker_id)
+    : ReliableQueue(std::move(redis), std::move(worker_id), Options{}) {
+}
+
+ReliableQueue::ReliableQueue(std::shared_ptr<RedisClient> redis, std::string worker_id, Options options)
+    : redis_(std::move(redis)), worker_id_(std::move(worker_id)), options_(std::move(options)) {
+    if (!redis_) {
+        throw std::invalid_argument("ReliableQueue: redis client is null");
+    }
+    if (worker_id_.empty() || options_.lease_ttl.count() <= 0) {
+        throw std::invalid_argument("ReliableQueue: worker_id and lease_ttl are required");
+    }
+    processing_key_ = processing_key(options_.pending_key, worker_id_);
+    lease_key_ = options_.pending_key + ":leases";
+}
+
+std::string ReliableQueue::processing_key(const std::string& pending_key, const std::string& worker_id) {
+    return pending_key + ":processing:" + worker_id;
+}
+
+std::vector<std::string> ReliableQueue::claim(size_t max, int timeout_seconds) {
+    renew_if_due();  // Before claiming: never hold tasks under a stale lease
+    if (max == 0) {
+        return {};
+    }
+    auto frames = redis_->lmove(options_.pending_key, processing_key_, max);
+    if (!frames.empty() || timeout_seconds <= 0) {
+        return frames;
+    }
+
+    auto first = redis_->blmove(options_.pending_key, processing_key_, timeout_seconds);
+    if (!first) {
+        return frames;
+    }
+    frames.push_back(std::move(*first));
+    for (auto& frame : redis_->lmove(options_.pending_key, processing_key_, max - 1)) {
+        frames.push_back(std::move(frame));
+    }
+    return frames;
+}
+
+size_t ReliableQueue::ack(const std::vector<std::string>& frames) {
+    return frames.empty() ? 0 : redis_->lrem(processing_key_, frames);
+}
+
+bool ReliableQueue::heartbeat() {
+    const int64_t now = epoch_ms();
+    lease_renewed_ms_.store(now, std::memory_order_relaxed);
+    redis_->zadd(lease_key_, worker_id_, static_cast<double>(now + options_.lease_ttl.count()));
+    return redis_->is_connected();
+}
+
+void ReliableQueue::renew_if_due() {
+    const int64_t last = lease_renewed_ms_.load(std::memory_order_relaxed);
+    if (epoch_ms() - last >= options_.lease_ttl.count() / 3) {
+        heartbeat();
+    }
+}
+
+size_t ReliableQueue::release() {
+    const size_t requeued = redis_->lmove(processing_key_, options_.pending_key, kAll).size();
+    redis_->zrem(lease_key_, worker_id_);
+    lease_renewed_ms_.store(0, std::memory_order_relaxed);
+    return requeued;
+}
+
+size_t ReliableQueue::reap() {
+    size_t requeued = 0;
+    const auto expired = redis_->zrangebyscore(lease_key_, -std::numeric_limits<double>::infinity(),
+                                               static_cast<double>(epoch_ms()));
+    for (const auto& worker : expired) {
+        // ZREM picks one reaper per dead worker; the LMOVE itself is atomic anyway
+        if (worker == worker_id_ || !redis_->zrem(lease_key_, worker)) {
+            continue;
+        }
+        requeued += redis_->lmove(processing_key(options_.pending_key, worker),
+                                  options_.pending_key, kAll).size();
+    }
+    return requeued;
+}
+
+} // namespace telemetry_processor
@@ -0,0 +1,181 @@
+#include "telemetry_processor/RetryScheduler.h"
+#include "telemetry_processor/Timestamp.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace telemetry_processor {
+
+namespace {
+
+int64_t epoch_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// One generator per thread: fail() runs on every worker thread
+double unit_random() {
+    thread_local std::mt19937_64 rng{std::random_device{}()};
+    return std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+}
+
+} // namespace
+
+// ========== Dead-letter queue ==========
+
+DeadLetterQueue::DeadLetterQueue(std::shared_ptr<RedisClient> redis, std::string key, std::string pending_key)
+    : redis_(std::move(redis)), key_(std::move(key)), pending_key_(std::move(pending_key)) {
+}
+
+std::string DeadLetterQueue::encode(const Task& task, const std::string& error) {
+    nlohmann::json envelope{
+        {"task", task.to_json()},
+        {"error", error},
+        {"dead_at", now_iso8601()},
+    };
+    return envelope.dump();
+}
+
+DeadLetterQueue::Entry DeadLetterQueue::decode(const std::string& envelope) {
+    const auto j = nlohmann::json::parse(envelope);
+    return Entry{Task::from_json(j.at("task")), j.value("error", ""), j.value("dead_at", "")};
+}
+
+void DeadLetterQueue::park(const std::vector<Task>& tasks, const std::vector<std::string>& errors) {
+    std::vector<std::string> envelopes;
+    envelopes.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        envelopes.push_back(encode(tasks[i], i < errors.size() ? errors[i] : std::string()));
+    }
+    redis_->rpush(key_, envelopes);
+}
+
+size_t DeadLetterQueue::size() {
+    return static_cast<size_t>(std::max(0LL, redis_->llen(key_)));
+}
+
+std::vector<DeadLetterQueue::Entry> DeadLetterQueue::peek(size_t offset, size_t count) {
+    std::vector<Entry> entries;
+    if (count == 0) {
+        return entries;
+    }
+    const auto start = static_cast<long long>(offset);
+    for (const auto& envelope : redis_->lrange(key_, start, start + static_cast<long long>(count) - 1)) {
+        try {
+            entries.push_back(decode(envelope));
+        } catch (const std::exception& e) {
+            std::clog << "[dlq] unreadable entry in " << key_ << ": " << e.what() << "\n";
+        }
+    }
+    return entries;
+}
+
+size_t DeadLetterQueue::replay(size_t count) {
+    if (count == 0) {
+        return 0;
+    }
+    // Read, push, then trim: a crash between the steps replays entries twice
+    // instead of losing them. The frame is rewritten (fresh budget), so this
+    // cannot be an LMOVE.
+    const auto envelopes = redis_->lrange(key_, 0, static_cast<long long>(count) - 1);
+    std::vector<std::string> frames;
+    for (const auto& envelope : envelopes) {
+        try {
+            Task task = decode(envelope).task;
+            task.status = TaskStatus::PENDING;
+            task.retry_count = 0;
+            task.worker_id.clear();
+            task.updated_at = std::chrono::system_clock::now();
+            frames.push_back(task.serialize());
+        } catch (const std::exception& e) {
+            std::clog << "[dlq] dropping unreadable entry from " << key_ << ": " << e.what() << "\n";
+        }
+    }
+    if (!frames.empty()) {
+        redis_->rpush(pending_key_, frames);
+    }
+    redis_->ltrim(key_, static_cast<long long>(envelopes.size()), -1);
+    return frames.size();
+}
+
+size_t DeadLetterQueue::purge() {
+    const size_t parked = size();
+    redis_->del(key_);
+    return parked;
+}
+
+// ========== Retry scheduler ==========
+
+RetryScheduler::RetryScheduler(std::shared_ptr<RedisClient> redis)
+    : RetryScheduler(std::move(redis), Options{}) {
+}
+
+RetryScheduler::RetryScheduler(std::shared_ptr<RedisClient> redis, Options options)
+    : redis_(std::move(redis)), options_(std::move(options)),
+      retry_key_(options_.pending_key + ":retry"),
+      dlq_(redis_, options_.pending_key + ":dead", options_.pending_key) {
+    if (!redis_) {
+        throw std::invalid_argument("RetryScheduler: redis client is null");
+    }
+    if (options_.base_delay.count() <= 0 || options_.max_delay < options_.base_delay ||
+        !(options_.jitter >= 0.0 && options_.jitter <= 1.0) || options_.promote_batch == 0) {
+        throw std::invalid_argument("RetryScheduler: invalid delays, jitter or batch size");
+    }
+}
+
+std::chrono::milliseconds RetryScheduler::backoff(int retry_count) const {
+    const int exponent = std::clamp(retry_count - 1, 0, 30);
+    const double ceiling = static_cast<double>(options_.max_delay.count());
+    const double delay = std::min(ceiling, static_cast<double>(options_.base_delay.count()) * (1LL << exponent));
+    const double fixed = delay * (1.0 - options_.jitter);
+    return std::chrono::milliseconds(static_cast<int64_t>(fixed + delay * options_.jitter * unit_random()));
+}
+
+RetryScheduler::Outcome RetryScheduler::fail(std::vector<Failure> failures) {
+    Outcome outcome;
+    std::vector<std::pair<std::string, double>> retries;
+    std::vector<Task> dead;
+    std::vector<std::string> errors;
+    const int64_t now = epoch_ms();
+    const auto stamp = std::chrono::system_clock::now();
+
+    for (auto& failure : failures) {
+        Task& task = failure.task;
+        task.worker_id.clear();
+        task.updated_at = stamp;
+        if (!failure.permanent && task.retry_count < task.max_retries) {
+            ++task.retry_count;
+            task.status = TaskStatus::PENDING;
+            const auto due = now + backoff(task.retry_count).count();
+            retries.emplace_back(task.serialize(), static_cast<double>(due));
+        } else {
+            task.status = TaskStatus::FAILED;
+            dead.push_back(std::move(task));
+            errors.push_back(std::move(failure.error));
+        }
+    }
+
+    if (!retries.empty()) {
+        redis_->zadd(retry_key_, retries);
+    }
+    if (!dead.empty()) {
+        dlq_.park(dead, errors);
+    }
+    outcome.scheduled = retries.size();
+    outcome.dead = dead.size();
+    return outcome;
+}
+
+size_t RetryScheduler::promote_due() {
+    return redis_->zmove_to_list(retry_key_, options_.pending_key,
+                                 static_cast<double>(epoch_ms()), options_.promote_batch);
+}
+
+size_t RetryScheduler::scheduled() {
+    return redis_->zcard(retry_key_);
+}
+
+} // namespace telemetry_processor
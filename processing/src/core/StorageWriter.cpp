@@ -0,0 +1,302 @@
+#include "telemetry_processor/StorageWriter.h"
+#include "telemetry_processor/Timestamp.h"
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace telemetry_processor {
+
+// ========== Backends ==========
+
+FileStorageBackend::FileStorageBackend(std::string path)
+    : path_(std::move(path)) {
+}
+
+bool FileStorageBackend::connect() {
+    std::ofstream file(path_, std::ios::app);
+    return file.is_open();
+}
+
+bool FileStorageBackend::copy_rows(const std::string&, const std::vector<std::string>&,
+                                   const std::string& data, size_t) {
+    std::ofstream file(path_, std::ios::app | std::ios::binary);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    file.flush();
+    return file.good();
+}
+
+// ========== COPY encoding ==========
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// COPY text escapes: the field separator, line breaks and the escape itself
+void append_text(std::string& out, const std::string& value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            default: out += c;
+        }
+    }
+}
+
+void append_number(std::string& out, double value) {
+    if (!std::isfinite(value)) {
+        out += "\\N";  // NaN = absent; +-inf is not a useful reading either
+        return;
+    }
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);  // Shortest round-trip form
+    out.append(buffer, result.ptr);
+}
+
+} // namespace
+
+const std::vector<std::string>& StorageWriter::columns() {
+    static const std::vector<std::string> kColumns{
+        "device_id", "timestamp", "temperature", "humidity", "pressure", "voltage", "current", "raw_data"
+    };
+    return kColumns;
+}
+
+void StorageWriter::encode_row(const TelemetryRow& row, std::string& out) {
+    append_text(out, row.device_id);
+    out += '\t';
+    if (row.timestamp.empty()) {
+        out += now_iso8601();
+    } else {
+        append_text(out, row.timestamp);
+    }
+    for (double value : {row.temperature, row.humidity, row.pressure, row.voltage, row.current}) {
+        out += '\t';
+        append_number(out, value);
+    }
+    out += '\t';
+    if (row.raw_data.empty()) {
+        out += "\\N";
+    } else {
+        append_text(out, row.raw_data);
+    }
+    out += '\n';
+}
+
+// ========== Writer ==========
+
+struct StorageWriter::Impl {
+    struct Batch {
+        std::string data;
+        size_t rows = 0;
+    };
+
+    Impl(std::shared_ptr<StorageBackend> b, Options opts)
+        : backend(std::move(b)), options(std::move(opts)) {}
+
+    bool open_full() const {
+        return open.rows >= options.max_batch_rows || open.data.size() >= options.max_batch_bytes;
+    }
+
+    bool window_full() const {
+        return sealed.size() + (writing ? 1 : 0) >= options.max_in_flight;
+    }
+
+    // Caller holds mutex
+    void seal() {
+        sealed.push_back(std::move(open));
+        open = Batch{};
+        work_cv.notify_one();
+    }
+
+    // Load one batch, retrying with backoff; runs without the lock
+    bool store(const Batch& batch, size_t& retries) {
+        auto backoff = options.retry_backoff;
+        for (int attempt = 0; attempt <= options.max_retries; ++attempt) {
+            if (attempt > 0) {
+                ++retries;
+                std::this_thread::sleep_for(backoff);
+                backoff *= 2;
+                connected = false;  // Reconnect after any failure
+            }
+            if (!connected) {
+                connected = backend->connect();
+                if (!connected) {
+                    continue;
+                }
+            }
+            if (backend->copy_rows(options.table, columns(), batch.data, batch.rows)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void flush_loop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            // Seal the open batch when it is due: full (left open while the window
+            // was full), aged, flush() waiting, or shutting down
+            const bool due = open.rows > 0 && (open_full() || stopping || flush_waiters > 0 ||
+                                               Clock::now() - open_since >= options.flush_interval);
+            if (sealed.empty() && due) {
+                seal();
+            }
+            if (sealed.empty()) {
+                if (stopping) {
+                    return;
+                }
+                if (open.rows > 0) {
+                    work_cv.wait_until(lock, open_since + options.flush_interval);
+                } else {
+                    work_cv.wait(lock);
+                }
+                continue;
+            }
+
+            Batch batch = std::move(sealed.front());
+            sealed.pop_front();
+            writing = true;
+            lock.unlock();
+
+            size_t retries = 0;
+            const bool ok = store(batch, retries);
+            if (!ok) {
+                std::clog << "[storage] dropped batch of " << batch.rows << " rows for "
+                          << options.table << " after " << options.max_retries << " retries\n";
+            }
+
+            lock.lock();
+            writing = false;
+            buffered -= batch.rows;
+            stats.retries += retries;
+            if (ok) {
+                stats.rows_written += batch.rows;
+                ++stats.batches_written;
+            } else {
+                stats.rows_failed += batch.rows;
+            }
+            space_cv.notify_all();  // Room in the window; flush() may be done
+        }
+    }
+
+    std::shared_ptr<StorageBackend> backend;
+    Options options;
+    bool connected = false;  // Flush thread only
+
+    mutable std::mutex mutex;
+    std::condition_variable work_cv;   // Wakes the flush thread
+    std::condition_variable space_cv;  // Wakes writers waiting for room, and flush()
+    Batch open;
+    Clock::time_point open_since;
+    std::deque<Batch> sealed;
+    bool writing = false;
+    bool stopping = false;
+    size_t flush_waiters = 0;
+    size_t buffered = 0;
+    Stats stats;
+
+    std::thread flusher;
+};
+
+StorageWriter::StorageWriter(std::shared_ptr<StorageBackend> backend)
+    : StorageWriter(std::move(backend), Options{}) {
+}
+
+StorageWriter::StorageWriter(std::shared_ptr<StorageBackend> backend, Options options) {
+    if (!backend) {
+        throw std::invalid_argument("StorageWriter: backend is null");
+    }
+    if (options.max_batch_rows == 0 || options.max_batch_bytes == 0 || options.max_in_flight == 0) {
+        throw std::invalid_argument("StorageWriter: batch limits and window must be > 0");
+    }
+    impl_ = std::make_unique<Impl>(std::move(backend), std::move(options));
+    impl_->flusher = std::thread([impl = impl_.get()] { impl->flush_loop(); });
+}
+
+StorageWriter::~StorageWriter() {
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->stopping = true;
+    }
+    impl_->work_cv.notify_one();
+    impl_->space_cv.notify_all();  // Writers waiting for room get CLOSED
+    impl_->flusher.join();
+}
+
+StorageWriter::WriteStatus StorageWriter::write(const std::vector<TelemetryRow>& rows,
+                                                std::chrono::milliseconds wait) {
+    if (rows.empty()) {
+        return WriteStatus::ACCEPTED;
+    }
+    std::string encoded;
+    encoded.reserve(rows.size() * 128);
+    for (const auto& row : rows) {
+        encode_row(row, encoded);  // Outside the lock: writers only contend on the append
+    }
+
+    Impl& s = *impl_;
+    std::unique_lock<std::mutex> lock(s.mutex);
+    // The open batch can only grow while it has room, or while it can be sealed
+    const bool room = s.space_cv.wait_for(lock, wait, [&s] {
+        return s.stopping || !s.open_full() || !s.window_full();
+    });
+    if (s.stopping) {
+        return WriteStatus::CLOSED;
+    }
+    if (!room) {
+        s.stats.rows_rejected += rows.size();
+        return WriteStatus::BACKPRESSURE;
+    }
+    if (s.open_full()) {
+        s.seal();
+    }
+
+    if (s.open.rows == 0) {
+        s.open_since = Clock::now();
+        s.work_cv.notify_one();  // Arm the age timer
+    }
+    s.open.data += encoded;
+    s.open.rows += rows.size();
+    s.buffered += rows.size();
+    s.stats.rows_accepted += rows.size();
+    if (s.open_full() && !s.window_full()) {
+        s.seal();
+    }
+    return WriteStatus::ACCEPTED;
+}
+
+StorageWriter::WriteStatus StorageWriter::write(const TelemetryRow& row, std::chrono::milliseconds wait) {
+    return write(std::vector<TelemetryRow>{row}, wait);
+}
+
+void StorageWriter::flush() {
+    Impl& s = *impl_;
+    std::unique_lock<std::mutex> lock(s.mutex);
+    ++s.flush_waiters;
+    s.work_cv.notify_one();
+    s.space_cv.wait(lock, [&s] { return s.buffered == 0 || s.stopping; });
+    --s.flush_waiters;
+}
+
+const StorageWriter::Options& StorageWriter::options() const {
+    return impl_->options;
+}
+
+StorageWriter::Stats StorageWriter::stats() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    Stats stats = impl_->stats;
+    stats.buffered_rows = impl_->buffered;
+    stats.in_flight_batches = impl_->sealed.size() + (impl_->writing ? 1 : 0);
+    return stats;
+}
+
+} // namespace telemetry_processor
@@ -1,47 +1,59 @@
 #include "telemetry_processor/Task.h"
-#include <random>
-#include <sstream>
-#include <iomanip>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 
 namespace telemetry_processor {
 
-std::string generate_uuid() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(0, 15);
-    static std::uniform_int_distribution<> dis2(8, 11);
-    
-    std::stringstream ss;
-    ss << std::hex;
-    
-    for (int i = 0; i < 8; i++) {
-        ss << dis(gen);
-    }
-    ss << "-";
-    
-    for (int i = 0; i < 4; i++) {
-        ss << dis(gen);
-    }
-    ss << "-4"; // Version 4
-    
-    for (int i = 0; i < 3; i++) {
-        ss << dis(gen);
+namespace {
+
+// ========== Binary frame helpers ==========
+
+constexpr unsigned char kMagic0 = 0xD7;  // Non-ASCII: never the first byte of JSON text
+constexpr unsigned char kMagic1 = 0x51;
+constexpr size_t kHeaderSize = 40;
+
+using Nanos = std::chrono::nanoseconds;
+
+// Explicit little-endian so frames are portable between hosts
+template <typename T>
+void put_le(std::string& out, size_t offset, T value) {
+    auto bits = static_cast<std::make_unsigned_t<T>>(value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out[offset + i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
     }
-    ss << "-";
-    
-    ss << dis2(gen); // Variant
-    for (int i = 0; i < 3; i++) {
-        ss << dis(gen);
+}
+
+template <typename T>
+T get_le(std::string_view in, size_t offset) {
+    std::make_unsigned_t<T> bits = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        bits |= static_cast<std::make_unsigned_t<T>>(
+            static_cast<unsigned char>(in[offset + i])) << (8 * i);
     }
-    ss << "-";
-    
-    for (int i = 0; i < 12; i++) {
-        ss << dis(gen);
+    return static_cast<T>(bits);
+}
+
+template <typename T>
+T checked_length(const std::string& field, const char* name) {
+    if (field.size() > std::numeric_limits<T>::max()) {
+        throw std::invalid_argument(std::string("Task field too long for binary frame: ") + name);
     }
-    
-    return ss.str();
+    return static_cast<T>(field.size());
+}
+
+int64_t to_nanos(std::chrono::system_clock::time_point tp) {
+    return std::chrono::duration_cast<Nanos>(tp.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point from_nanos(int64_t ns) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(Nanos(ns)));
 }
 
+} // namespace
+
 std::string priority_to_string(Priority p) {
     switch (p) {
         case Priority::HIGH: return "HIGH";
@@ -66,7 +78,7 @@ nlohmann::json Task::to_json() const {
     return nlohmann::json{
         {"id", id},
         {"type", type},
-        {"payload", payload},
+        {"payload", payload.raw()},  // Still a string on the wire: no re-parse
         {"priority", static_cast<int>(priority)},
         {"status", static_cast<int>(status)},
         {"retry_count", retry_count},
@@ -81,7 +93,7 @@ Task Task::from_json(const nlohmann::json& j) {
     Task task;
     task.id = j.value("id", "");
     task.type = j.value("type", "");
-    task.payload = j.value("payload", "");
+    task.payload = Payload(j.value("payload", std::string()));  // Adopted, parsed on demand
     task.priority = static_cast<Priority>(j.value("priority", 1));
     task.status = static_cast<TaskStatus>(j.value("status", 0));
     task.retry_count = j.value("retry_count", 0);
@@ -98,16 +110,114 @@ Task Task::from_json(const nlohmann::json& j) {
     return task;
 }
 
+std::string Task::to_binary() const {
+    const std::string& body = payload.raw();
+    const auto id_len = checked_length<uint16_t>(id, "id");
+    const auto type_len = checked_length<uint16_t>(type, "type");
+    const auto worker_len = checked_length<uint16_t>(worker_id, "worker_id");
+    const auto payload_len = checked_length<uint32_t>(body, "payload");
+
+    // One allocation: header + variable fields
+    std::string out(kHeaderSize + id_len + type_len + worker_len + payload_len, '\0');
+    out[0] = static_cast<char>(kMagic0);
+    out[1] = static_cast<char>(kMagic1);
+    out[2] = static_cast<char>(kBinaryVersion);
+    out[3] = static_cast<char>(kHeaderSize);
+    out[4] = static_cast<char>(priority);
+    out[5] = static_cast<char>(status);
+    put_le<uint16_t>(out, 6, id_len);
+    put_le<int32_t>(out, 8, retry_count);
+    put_le<int32_t>(out, 12, max_retries);
+    put_le<int64_t>(out, 16, to_nanos(created_at));
+    put_le<int64_t>(out, 24, to_nanos(updated_at));
+    put_le<uint16_t>(out, 32, type_len);
+    put_le<uint16_t>(out, 34, worker_len);
+    put_le<uint32_t>(out, 36, payload_len);
+
+    size_t offset = kHeaderSize;
+    for (const std::string* field : {&id, &type, &worker_id, &body}) {
+        if (!field->empty()) {
+            std::memcpy(&out[offset], field->data(), field->size());
+        }
+        offset += field->size();
+    }
+    return out;
+}
+
+Task Task::from_binary(std::string_view bytes) {
+    if (detect_wire_format(bytes) != WireFormat::BINARY || bytes.size() < 4) {
+        throw std::invalid_argument("Not a binary task frame");
+    }
+    const auto version = static_cast<uint8_t>(bytes[2]);
+    const auto header_size = static_cast<uint8_t>(bytes[3]);
+    if ((version >> 4) != (kBinaryVersion >> 4)) {
+        throw std::invalid_argument("Unsupported task frame major version " + std::to_string(version >> 4));
+    }
+    if (header_size < kHeaderSize || bytes.size() < header_size) {
+        throw std::invalid_argument("Truncated task frame header");
+    }
+
+    const size_t id_len = get_le<uint16_t>(bytes, 6);
+    const size_t type_len = get_le<uint16_t>(bytes, 32);
+    const size_t worker_len = get_le<uint16_t>(bytes, 34);
+    const size_t payload_len = get_le<uint32_t>(bytes, 36);
+    if (bytes.size() - header_size < id_len + type_len + worker_len + payload_len) {
+        throw std::invalid_argument("Truncated task frame body");
+    }
+
+    Task task;
+    task.priority = static_cast<Priority>(static_cast<uint8_t>(bytes[4]));
+    task.status = static_cast<TaskStatus>(static_cast<uint8_t>(bytes[5]));
+    task.retry_count = get_le<int32_t>(bytes, 8);
+    task.max_retries = get_le<int32_t>(bytes, 12);
+    task.created_at = from_nanos(get_le<int64_t>(bytes, 16));
+    task.updated_at = from_nanos(get_le<int64_t>(bytes, 24));
+
+    // Header fields appended by a newer minor version are skipped via header_size
+    size_t offset = header_size;
+    auto take = [&](size_t len) {
+        std::string_view field = bytes.substr(offset, len);
+        offset += len;
+        return std::string(field);
+    };
+    task.id = take(id_len);
+    task.type = take(type_len);
+    task.worker_id = take(worker_len);
+    task.payload = Payload(take(payload_len));  // Still unparsed
+    return task;
+}
+
+std::string Task::serialize(WireFormat format) const {
+    return format == WireFormat::BINARY ? to_binary() : to_json().dump();
+}
+
+Task Task::deserialize(std::string_view bytes) {
+    if (detect_wire_format(bytes) == WireFormat::BINARY) {
+        return from_binary(bytes);
+    }
+    return from_json(nlohmann::json::parse(bytes.begin(), bytes.end()));
+}
+
+WireFormat detect_wire_format(std::string_view bytes) {
+    // JSON text is ASCII at its first byte ('{', whitespace); 0xD7 never is
+    if (bytes.size() >= 2 &&
+        static_cast<unsigned char>(bytes[0]) == kMagic0 &&
+        static_cast<unsigned char>(bytes[1]) == kMagic1) {
+        return WireFormat::BINARY;
+    }
+    return WireFormat::JSON;
+}
+
 Task Task::create(
     const std::string& type,
-    const std::string& payload,
+    Payload payload,
     Priority priority,
     int max_retries
 ) {
     Task task;
     task.id = generate_uuid();
     task.type = type;
-    task.payload = payload;
+    task.payload = std::move(payload);
     task.priority = priority;
     task.status = TaskStatus::PENDING;
     task.retry_count = 0;
@@ -0,0 +1,701 @@
+#include "telemetry_processor/TelemetryHandler.h"
+#include "telemetry_processor/Timestamp.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <unordered_map>
+
+namespace telemetry_processor {
+
+namespace {
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::array<std::string_view, TelemetryHandler::kTaskKindCount> kTypeNames{{
+    "telemetry.analyze",
+    "telemetry.anomaly_detect",
+    "telemetry.aggregate",
+    "telemetry.store",
+    "telemetry.alert",
+}};
+
+constexpr size_t kMetricCount = 5;
+constexpr std::array<const char*, kMetricCount> kMetricNames{{
+    "temperature", "humidity", "pressure", "voltage", "current"
+}};
+
+// Top-level fields parse_payload() reads: IDs first, then kMetricNames order
+constexpr std::array<std::string_view, kMetricCount + 2> kPayloadFields{{
+    "device_id", "timestamp", "temperature", "humidity", "pressure", "voltage", "current"
+}};
+
+std::string describe_flags(uint8_t flags) {
+    static constexpr std::pair<uint8_t, const char*> kReasons[] = {
+        {ANOMALY_TEMP_HIGH, "temperature high"},
+        {ANOMALY_TEMP_LOW, "temperature low"},
+        {ANOMALY_HUMIDITY_HIGH, "humidity high"},
+        {ANOMALY_VOLTAGE_LOW, "voltage low"},
+        {ANOMALY_CURRENT_HIGH, "current high"},
+        {ANOMALY_ZSCORE, "z-score outlier"},
+        {ANOMALY_EWMA, "EWMA deviation"},
+    };
+    std::string text;
+    for (const auto& reason : kReasons) {
+        if (flags & reason.first) {
+            text += text.empty() ? "" : ", ";
+            text += reason.second;
+        }
+    }
+    return text;
+}
+
+int64_t now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::array<double, kMetricCount> metric_values(double t, double h, double p, double v, double c) {
+    return {{t, h, p, v, c}};
+}
+
+// One closed window as a telemetry row: metric columns hold the window
+// mean, raw_data the whole aggregate
+TelemetryRow rollup_row(const WindowResult& window) {
+    TelemetryRow row;
+    row.device_id = window.device_id;
+    row.timestamp = format_iso8601_ms(window.start_ms);
+    const std::array<double*, kMetricCount> columns{{
+        &row.temperature, &row.humidity, &row.pressure, &row.voltage, &row.current
+    }};
+    json metrics = json::object();
+    for (size_t m = 0; m < kMetricCount; ++m) {
+        const MetricAggregate& agg = window.metrics[m];
+        if (agg.count == 0) {
+            continue;  // Never reported in this window: NULL column
+        }
+        *columns[m] = agg.mean();
+        metrics[kMetricNames[m]] = {
+            {"count", agg.count}, {"min", agg.min}, {"max", agg.max}, {"mean", agg.mean()}, {"last", agg.last}
+        };
+    }
+    row.raw_data = json{
+        {"window_end", format_iso8601_ms(window.end_ms)},
+        {"samples", window.sample_count},
+        {"metrics", std::move(metrics)},
+    }.dump();
+    return row;
+}
+
+/**
+ * Serializes the two writers (rows, rollups) onto one backend, which is
+ * written for a single flush thread.
+ */
+class SerializedBackend : public StorageBackend {
+public:
+    explicit SerializedBackend(std::shared_ptr<StorageBackend> inner) : inner_(std::move(inner)) {}
+
+    bool connect() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return inner_->connect();
+    }
+
+    bool copy_rows(const std::string& table, const std::vector<std::string>& columns,
+                   const std::string& data, size_t rows) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return inner_->copy_rows(table, columns, data, rows);
+    }
+
+private:
+    std::shared_ptr<StorageBackend> inner_;
+    std::mutex mutex_;
+};
+
+// Welford running mean/variance: one pass, numerically stable
+struct RunningStat {
+    size_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double last = 0.0;
+
+    void add(double value) {
+        ++count;
+        const double delta = value - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (value - mean);
+        min = std::min(min, value);
+        max = std::max(max, value);
+        last = value;
+    }
+
+    double stddev() const {
+        return count > 1 ? std::sqrt(m2 / static_cast<double>(count - 1)) : 0.0;
+    }
+};
+
+} // namespace
+
+/**
+ * Mutable state shared by all workers using this handler:
+ * - device_stats: per-device running statistics (analyze)
+ * - aggregator / closed_windows: event-time windows (aggregate); closed
+ *   windows go to the rollups writer, or wait in closed_windows (bounded)
+ * - zscore / ewma: per-device detector state (anomaly_detect)
+ * - storage / rollups: batching writers (store, aggregate; thread-safe on
+ *   their own, one shared backend)
+ * - alerts: async dispatcher (anomaly_detect, alert; thread-safe on its own)
+ * - counters: handler statistics
+ * Each batch takes each lock once, not once per task.
+ */
+struct TelemetryHandler::Impl {
+    static WindowAggregator::Options window_options(const Config& cfg) {
+        WindowAggregator::Options options;
+        options.window_ms = std::max(1, cfg.aggregation_window_sec) * int64_t{1000};
+        options.slide_ms = std::max(0, cfg.aggregation_slide_sec) * int64_t{1000};
+        options.max_lateness_ms = std::max(0, cfg.aggregation_lateness_sec) * int64_t{1000};
+        options.metric_names.assign(kMetricNames.begin(), kMetricNames.end());
+        return options;
+    }
+
+    static StorageWriter::Options storage_options(const Config& cfg) {
+        StorageWriter::Options options;
+        options.max_batch_rows = std::max<size_t>(1, cfg.storage_batch_rows);
+        options.flush_interval = std::chrono::milliseconds(std::max(1, cfg.storage_flush_ms));
+        options.max_in_flight = std::max<size_t>(1, cfg.storage_max_in_flight);
+        return options;
+    }
+
+    static std::shared_ptr<StorageBackend> shared_backend(const Config& cfg, std::shared_ptr<StorageBackend> backend) {
+        if (!backend && !cfg.storage_file_path.empty()) {
+            backend = std::make_shared<FileStorageBackend>(cfg.storage_file_path);
+        } else if (!backend) {
+            backend = std::make_shared<NullStorageBackend>();  // No database client in this tree yet
+        }
+        return std::make_shared<SerializedBackend>(std::move(backend));
+    }
+
+    static AlertDispatcher::Options alert_options(const Config& cfg) {
+        AlertDispatcher::Options options;
+        options.suppression_window = std::chrono::seconds(std::max(0, cfg.alert_suppression_sec));
+        options.rate_per_sec = cfg.alert_rate_per_sec > 0.0 ? cfg.alert_rate_per_sec : options.rate_per_sec;
+        options.burst = std::max<size_t>(1, cfg.alert_burst);
+        options.queue_capacity = std::max<size_t>(1, cfg.alert_queue_capacity);
+        return options;
+    }
+
+    Impl(const Config& cfg, std::shared_ptr<StorageBackend> backend, std::shared_ptr<AlertTransport> transport)
+        : config(cfg), aggregator(window_options(cfg)),
+          backend(shared_backend(cfg, std::move(backend))),
+          storage(this->backend, storage_options(cfg)),
+          alerts(transport ? std::move(transport) : std::make_shared<WebhookAlertTransport>(cfg.alert_webhook_url),
+                 alert_options(cfg)) {
+        if (!cfg.rollup_table.empty()) {
+            auto options = storage_options(cfg);
+            options.table = cfg.rollup_table;
+            rollups = std::make_unique<StorageWriter>(this->backend, options);
+        }
+        limits.temp_high = cfg.temp_high_threshold;
+        limits.temp_low = cfg.temp_low_threshold;
+        limits.humidity_high = cfg.humidity_high_threshold;
+        limits.voltage_low = cfg.voltage_low_threshold;
+        limits.current_high = cfg.current_high_threshold;
+        if (cfg.zscore_threshold > 0.0) {
+            ZScoreDetector::Options options;
+            options.threshold = cfg.zscore_threshold;
+            options.window = static_cast<size_t>(std::max(2, cfg.zscore_window));
+            zscore = std::make_unique<ZScoreDetector>(options, kMetricCount);
+        }
+        if (cfg.ewma_alpha > 0.0) {
+            EwmaDetector::Options options;
+            options.alpha = std::min(1.0, cfg.ewma_alpha);
+            options.threshold = cfg.ewma_threshold;
+            ewma = std::make_unique<EwmaDetector>(options, kMetricCount);
+        }
+    }
+
+    // Caller holds state_mutex. Hands waiting windows to the rollups writer in
+    // one write; what it refuses (or everything, without a rollup table)
+    // stays in closed_windows, oldest dropped beyond rollup_pending_limit.
+    void store_rollups() {
+        if (rollups && !closed_windows.empty()) {
+            std::vector<TelemetryRow> rows;
+            rows.reserve(closed_windows.size());
+            for (const auto& window : closed_windows) {
+                rows.push_back(rollup_row(window));
+            }
+            if (rollups->write(rows) == StorageWriter::WriteStatus::ACCEPTED) {
+                closed_windows.clear();
+                return;
+            }
+        }
+        if (closed_windows.size() > config.rollup_pending_limit) {
+            const size_t excess = closed_windows.size() - config.rollup_pending_limit;
+            closed_windows.erase(closed_windows.begin(), closed_windows.begin() + static_cast<std::ptrdiff_t>(excess));
+            windows_dropped += excess;
+        }
+    }
+
+    Config config;
+    ThresholdLimits limits;
+
+    std::mutex state_mutex;
+    std::unordered_map<std::string, std::array<RunningStat, kMetricCount>> device_stats;
+    WindowAggregator aggregator;
+    std::vector<WindowResult> closed_windows;  // Not (yet) taken by the rollups writer
+    std::atomic<size_t> windows_dropped{0};
+    std::unique_ptr<ZScoreDetector> zscore;  // Null when disabled
+    std::unique_ptr<EwmaDetector> ewma;
+    std::shared_ptr<StorageBackend> backend;
+    StorageWriter storage;
+    std::unique_ptr<StorageWriter> rollups;  // Null without a rollup table
+    AlertDispatcher alerts;
+
+    mutable std::mutex stats_mutex;
+    size_t tasks_processed = 0;
+    size_t tasks_failed = 0;
+    size_t anomalies_detected = 0;
+    StorageWriter::Stats storage_baseline;  // Writer counters at the last reset_stats()
+    StorageWriter::Stats rollup_baseline;
+    size_t dropped_baseline = 0;
+    AlertDispatcher::Stats alert_baseline;  // Dispatcher counters at the last reset_stats()
+    double total_time_ms = 0.0;
+    std::array<size_t, kTaskKindCount> kind_counts{};
+    std::map<std::string, size_t> unknown_type_counts;
+};
+
+const std::array<TelemetryHandler::BatchHandler, TelemetryHandler::kTaskKindCount>
+TelemetryHandler::kHandlers{{
+    &TelemetryHandler::analyze_batch,
+    &TelemetryHandler::anomaly_detect_batch,
+    &TelemetryHandler::aggregate_batch,
+    &TelemetryHandler::store_batch,
+    &TelemetryHandler::alert_batch,
+}};
+
+TelemetryHandler::TelemetryHandler()
+    : TelemetryHandler(Config{}) {
+}
+
+TelemetryHandler::TelemetryHandler(const Config& config)
+    : TelemetryHandler(config, nullptr) {
+}
+
+TelemetryHandler::TelemetryHandler(const Config& config, std::shared_ptr<StorageBackend> storage,
+                                   std::shared_ptr<AlertTransport> alerts)
+    : pimpl_(std::make_unique<Impl>(config, std::move(storage), std::move(alerts))) {
+}
+
+TelemetryHandler::~TelemetryHandler() {
+    // Open windows are partial but still data: hand them over before the writers flush
+    std::lock_guard<std::mutex> lock(pimpl_->state_mutex);
+    if (pimpl_->rollups) {
+        auto rest = pimpl_->aggregator.flush();
+        pimpl_->closed_windows.insert(pimpl_->closed_windows.end(),
+                                      std::make_move_iterator(rest.begin()),
+                                      std::make_move_iterator(rest.end()));
+        pimpl_->store_rollups();
+    }
+}
+
+// ========== Interning & Dispatch ==========
+
+TelemetryHandler::TaskKind TelemetryHandler::intern_task_type(std::string_view type) {
+    static const std::unordered_map<std::string_view, TaskKind> kinds = [] {
+        std::unordered_map<std::string_view, TaskKind> map;
+        for (size_t i = 0; i < kTaskKindCount; ++i) {
+            map.emplace(kTypeNames[i], static_cast<TaskKind>(i));
+        }
+        return map;
+    }();
+    auto it = kinds.find(type);
+    return it != kinds.end() ? it->second : TaskKind::UNKNOWN;
+}
+
+std::string_view TelemetryHandler::task_type_name(TaskKind kind) {
+    const auto index = static_cast<size_t>(kind);
+    return index < kTaskKindCount ? kTypeNames[index] : std::string_view("unknown");
+}
+
+TelemetryHandler::ProcessResult TelemetryHandler::process(const Task& task) {
+    Results results;
+    run(intern_task_type(task.type), &task, 1, results);
+    return std::move(results.front());
+}
+
+std::vector<TelemetryHandler::ProcessResult> TelemetryHandler::process_batch(const std::vector<Task>& tasks) {
+    Results results;
+    results.reserve(tasks.size());
+    size_t begin = 0;
+    while (begin < tasks.size()) {
+        // Extend the run while neighbours share the type (string equality, no hashing)
+        size_t end = begin + 1;
+        while (end < tasks.size() && tasks[end].type == tasks[begin].type) {
+            ++end;
+        }
+        run(intern_task_type(tasks[begin].type), &tasks[begin], end - begin, results);
+        begin = end;
+    }
+    return results;
+}
+
+TelemetryHandler::ProcessResult TelemetryHandler::handle_analyze(const Task& task) {
+    Results results;
+    run(TaskKind::ANALYZE, &task, 1, results);
+    return std::move(results.front());
+}
+
+TelemetryHandler::ProcessResult TelemetryHandler::handle_anomaly_detect(const Task& task) {
+    Results results;
+    run(TaskKind::ANOMALY_DETECT, &task, 1, results);
+    return std::move(results.front());
+}
+
+TelemetryHandler::ProcessResult TelemetryHandler::handle_aggregate(const Task& task) {
+    Results results;
+    run(TaskKind::AGGREGATE, &task, 1, results);
+    return std::move(results.front());
+}
+
+TelemetryHandler::ProcessResult TelemetryHandler::handle_store(const Task& task) {
+    Results results;
+    run(TaskKind::STORE, &task, 1, results);
+    return std::move(results.front());
+}
+
+TelemetryHandler::ProcessResult TelemetryHandler::handle_alert(const Task& task) {
+    Results results;
+    run(TaskKind::ALERT, &task, 1, results);
+    return std::move(results.front());
+}
+
+void TelemetryHandler::run(TaskKind kind, const Task* tasks, size_t count, Results& results) {
+    const auto start = Clock::now();
+    const size_t first = results.size();
+    results.resize(first + count);
+    Results out(count);
+
+    if (kind == TaskKind::UNKNOWN) {
+        for (auto& result : out) {
+            result.message = "Unknown task type: " + tasks[0].type;
+        }
+    } else {
+        // Parse every payload exactly once; handlers only see typed fields
+        Batch batch;
+        batch.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            batch.push_back(parse_payload(tasks[i].payload));
+            if (!batch.back().valid) {
+                out[i].message = "Invalid telemetry payload";
+            }
+        }
+        (this->*kHandlers[static_cast<size_t>(kind)])(batch, out);
+    }
+
+    const double elapsed_ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    const double per_task_ms = elapsed_ms / static_cast<double>(count);
+    size_t failed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        out[i].processing_time_ms = per_task_ms;
+        failed += out[i].success ? 0 : 1;
+        results[first + i] = std::move(out[i]);
+    }
+
+    std::lock_guard<std::mutex> lock(pimpl_->stats_mutex);
+    pimpl_->tasks_processed += count;
+    pimpl_->tasks_failed += failed;
+    pimpl_->total_time_ms += elapsed_ms;
+    if (kind == TaskKind::UNKNOWN) {
+        pimpl_->unknown_type_counts[tasks[0].type] += count;
+    } else {
+        pimpl_->kind_counts[static_cast<size_t>(kind)] += count;
+    }
+}
+
+// ========== Handlers ==========
+
+void TelemetryHandler::analyze_batch(const Batch& batch, Results& results) {
+    std::lock_guard<std::mutex> lock(pimpl_->state_mutex);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const TelemetryPayload& payload = batch[i];
+        if (!payload.valid) {
+            continue;
+        }
+        auto& device = pimpl_->device_stats[payload.device_id];
+        const auto values = metric_values(payload.temperature, payload.humidity,
+                                          payload.pressure, payload.voltage, payload.current);
+        auto& metrics = results[i].metrics;
+        for (size_t m = 0; m < kMetricCount; ++m) {
+            if (std::isnan(values[m])) {
+                continue;
+            }
+            RunningStat& stat = device[m];
+            const std::string name = kMetricNames[m];
+            if (stat.count > 0) {
+                metrics[name + "_delta"] = values[m] - stat.last;  // Rate of change per sample
+            }
+            stat.add(values[m]);
+            metrics[name] = values[m];
+            metrics[name + "_mean"] = stat.mean;
+            metrics[name + "_stddev"] = stat.stddev();
+            metrics[name + "_min"] = stat.min;
+            metrics[name + "_max"] = stat.max;
+        }
+        results[i].success = true;
+        results[i].message = "Analyzed";
+    }
+}
+
+void TelemetryHandler::anomaly_detect_batch(const Batch& batch, Results& results) {
+    // Transpose to columns once, then test every threshold for every sample in one pass
+    TelemetryColumns columns;
+    columns.reserve(batch.size());
+    for (const TelemetryPayload& payload : batch) {
+        // Invalid payloads hold NaN everywhere, which never trips a limit
+        columns.push_back(payload.temperature, payload.humidity, payload.pressure,
+                          payload.voltage, payload.current);
+    }
+    std::vector<uint8_t> flags(batch.size());
+    detect_thresholds(columns, pimpl_->limits, flags.data());
+
+    if (pimpl_->zscore || pimpl_->ewma) {
+        std::lock_guard<std::mutex> lock(pimpl_->state_mutex);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (!batch[i].valid) {
+                continue;
+            }
+            const auto values = metric_values(columns.temperature[i], columns.humidity[i],
+                                              columns.pressure[i], columns.voltage[i], columns.current[i]);
+            if (pimpl_->zscore && pimpl_->zscore->update(batch[i].device_id, values.data()) != 0) {
+                flags[i] |= ANOMALY_ZSCORE;
+            }
+            if (pimpl_->ewma && pimpl_->ewma->update(batch[i].device_id, values.data()) != 0) {
+                flags[i] |= ANOMALY_EWMA;
+            }
+        }
+    }
+
+    size_t anomalies = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!batch[i].valid) {
+            continue;
+        }
+        const bool anomaly = flags[i] != ANOMALY_NONE;
+        results[i].success = true;
+        results[i].metrics["anomaly"] = anomaly ? 1.0 : 0.0;
+        results[i].metrics["anomaly_flags"] = static_cast<double>(flags[i]);
+        results[i].message = anomaly ? "Anomaly detected: " + describe_flags(flags[i]) : "Normal";
+        if (anomaly) {
+            ++anomalies;
+            // Limit breaches are critical; statistical outliers alone are warnings
+            const bool limit = (flags[i] & ~(ANOMALY_ZSCORE | ANOMALY_EWMA)) != 0;
+            queue_alert(describe_flags(flags[i]), results[i].message, limit ? "critical" : "warning", batch[i]);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(pimpl_->stats_mutex);
+    pimpl_->anomalies_detected += anomalies;
+}
+
+void TelemetryHandler::aggregate_batch(const Batch& batch, Results& results) {
+    const int64_t arrival_ms = now_ms();
+
+    std::lock_guard<std::mutex> lock(pimpl_->state_mutex);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const TelemetryPayload& payload = batch[i];
+        if (!payload.valid) {
+            continue;
+        }
+        const int64_t event_ms = parse_iso8601_ms(payload.timestamp).value_or(arrival_ms);
+        const auto values = metric_values(payload.temperature, payload.humidity,
+                                          payload.pressure, payload.voltage, payload.current);
+        const bool accepted = pimpl_->aggregator.add(payload.device_id, event_ms, values.data());
+        results[i].success = true;
+        results[i].message = accepted ? "Aggregated" : "Late sample dropped";
+        results[i].metrics["late"] = accepted ? 0.0 : 1.0;
+    }
+
+    // One watermark check per batch; closed windows leave as one batch too
+    auto closed = pimpl_->aggregator.poll();
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (batch[i].valid) {
+            results[i].metrics["windows_closed"] = static_cast<double>(closed.size());
+        }
+    }
+    pimpl_->closed_windows.insert(pimpl_->closed_windows.end(),
+                                  std::make_move_iterator(closed.begin()),
+                                  std::make_move_iterator(closed.end()));
+    pimpl_->store_rollups();
+}
+
+std::vector<WindowResult> TelemetryHandler::take_closed_windows(bool flush_open) {
+    std::lock_guard<std::mutex> lock(pimpl_->state_mutex);
+    if (flush_open) {
+        auto rest = pimpl_->aggregator.flush();
+        pimpl_->closed_windows.insert(pimpl_->closed_windows.end(),
+                                      std::make_move_iterator(rest.begin()),
+                                      std::make_move_iterator(rest.end()));
+        pimpl_->store_rollups();
+    }
+    return std::exchange(pimpl_->closed_windows, {});
+}
+
+void TelemetryHandler::store_batch(const Batch& batch, Results& results) {
+    std::vector<TelemetryRow> rows;
+    rows.reserve(batch.size());
+    for (const auto& payload : batch) {
+        if (!payload.valid) {
+            continue;
+        }
+        TelemetryRow row;
+        row.device_id = payload.device_id;
+        // Device clocks send anything; one unparseable value would fail the
+        // whole COPY. Empty -> encode_row() stamps the write time instead.
+        if (auto ms = parse_iso8601_ms(payload.timestamp)) {
+            row.timestamp = format_iso8601_ms(*ms);
+        }
+        row.temperature = payload.temperature;
+        row.humidity = payload.humidity;
+        row.pressure = payload.pressure;
+        row.voltage = payload.voltage;
+        row.current = payload.current;
+        row.raw_data = payload.raw_data.raw();
+        rows.push_back(std::move(row));
+    }
+
+    // One append for the whole batch; the writer coalesces batches into bulk loads
+    const auto status = pimpl_->storage.write(rows);
+    const bool accepted = status == StorageWriter::WriteStatus::ACCEPTED;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!batch[i].valid) {
+            continue;
+        }
+        results[i].success = accepted;
+        results[i].message = accepted ? "Queued for storage" : "Storage backpressure";
+        results[i].metrics["rows_in_batch"] = static_cast<double>(rows.size());
+        results[i].metrics["backpressure"] = accepted ? 0.0 : 1.0;
+    }
+}
+
+void TelemetryHandler::flush_storage() {
+    pimpl_->storage.flush();
+    if (pimpl_->rollups) {
+        pimpl_->rollups->flush();
+    }
+}
+
+void TelemetryHandler::alert_batch(const Batch& batch, Results& results) {
+    using Status = AlertDispatcher::SubmitStatus;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!batch[i].valid) {
+            continue;
+        }
+        const Status status = queue_alert("telemetry.alert", "Telemetry alert", "warning", batch[i]);
+        results[i].success = status != Status::DROPPED && status != Status::CLOSED;
+        results[i].message = status == Status::QUEUED ? "Alert queued"
+                            : results[i].success ? "Alert suppressed"   // Duplicate of a queued/recent alert
+                            : "Alert queue full";
+    }
+}
+
+void TelemetryHandler::flush_alerts() {
+    pimpl_->alerts.flush();
+}
+
+// ========== Helpers ==========
+
+TelemetryHandler::TelemetryPayload TelemetryHandler::parse_payload(const Payload& payload) const {
+    TelemetryPayload parsed;
+    parsed.raw_data = payload;  // Shares the buffer: no copy of the bytes
+
+    // One SAX pass over the bytes (or DOM lookups if the payload has one);
+    // non-string IDs/timestamps and non-numeric metrics read as absent
+    std::array<json, kPayloadFields.size()> values;
+    parsed.valid = payload.fields(kPayloadFields, values);
+    if (values[0].is_string()) {
+        parsed.device_id = std::move(values[0].get_ref<std::string&>());
+    }
+    if (values[1].is_string()) {
+        parsed.timestamp = std::move(values[1].get_ref<std::string&>());
+    }
+    const std::array<double*, kMetricCount> metrics{{
+        &parsed.temperature, &parsed.humidity, &parsed.pressure, &parsed.voltage, &parsed.current
+    }};
+    for (size_t m = 0; m < kMetricCount; ++m) {
+        if (values[m + 2].is_number()) {
+            *metrics[m] = values[m + 2].get<double>();
+        }
+    }
+    return parsed;
+}
+
+AlertDispatcher::SubmitStatus TelemetryHandler::queue_alert(std::string reason, std::string message,
+                                                           const char* severity,
+                                                           const TelemetryPayload& payload) {
+    Alert alert;
+    alert.device_id = payload.device_id;
+    alert.reason = std::move(reason);
+    alert.message = std::move(message);
+    alert.severity = severity;
+    alert.timestamp = payload.timestamp;
+    alert.payload = payload.raw_data.raw();
+    return pimpl_->alerts.submit(std::move(alert));
+}
+
+// ========== Statistics ==========
+
+TelemetryHandler::Stats TelemetryHandler::get_stats() const {
+    std::lock_guard<std::mutex> lock(pimpl_->stats_mutex);
+    Stats stats;
+    stats.tasks_processed = pimpl_->tasks_processed;
+    stats.tasks_failed = pimpl_->tasks_failed;
+    stats.anomalies_detected = pimpl_->anomalies_detected;
+    const auto alerts = pimpl_->alerts.stats();
+    const auto& base = pimpl_->alert_baseline;
+    stats.alerts_sent = alerts.sent - base.sent;
+    stats.alerts_suppressed = (alerts.coalesced + alerts.suppressed) - (base.coalesced + base.suppressed);
+    stats.alerts_dropped = alerts.dropped - base.dropped;
+    const auto storage = pimpl_->storage.stats();
+    stats.rows_stored = storage.rows_written - pimpl_->storage_baseline.rows_written;
+    stats.rows_backpressured = storage.rows_rejected - pimpl_->storage_baseline.rows_rejected;
+    if (pimpl_->rollups) {
+        stats.rollups_stored = pimpl_->rollups->stats().rows_written - pimpl_->rollup_baseline.rows_written;
+    }
+    stats.windows_dropped = pimpl_->windows_dropped - pimpl_->dropped_baseline;
+    stats.avg_processing_time_ms = pimpl_->tasks_processed > 0
+        ? pimpl_->total_time_ms / static_cast<double>(pimpl_->tasks_processed)
+        : 0.0;
+    for (size_t i = 0; i < kTaskKindCount; ++i) {
+        if (pimpl_->kind_counts[i] > 0) {
+            stats.task_type_counts[std::string(kTypeNames[i])] = pimpl_->kind_counts[i];
+        }
+    }
+    for (const auto& entry : pimpl_->unknown_type_counts) {
+        stats.task_type_counts[entry.first] = entry.second;
+    }
+    return stats;
+}
+
+void TelemetryHandler::reset_stats() {
+    std::lock_guard<std::mutex> lock(pimpl_->stats_mutex);
+    pimpl_->tasks_processed = 0;
+    pimpl_->tasks_failed = 0;
+    pimpl_->anomalies_detected = 0;
+    pimpl_->alert_baseline = pimpl_->alerts.stats();
+    pimpl_->storage_baseline = pimpl_->storage.stats();
+    if (pimpl_->rollups) {
+        pimpl_->rollup_baseline = pimpl_->rollups->stats();
+    }
+    pimpl_->dropped_baseline = pimpl_->windows_dropped;
+    pimpl_->total_time_ms = 0.0;
+    pimpl_->kind_counts.fill(0);
+    pimpl_->unknown_type_counts.clear();
+}
+
+} // namespace telemetry_processor
@@ -0,0 +1,130 @@
+#include "telemetry_processor/Timestamp.h"
+#include <chrono>
+#include <cstdio>
+
+namespace telemetry_processor {
+
+namespace {
+
+// Days since 1970-01-01 (H. Hinnant's days_from_civil)
+int64_t days_from_civil(int year, int month, int day) {
+    const int y = year - (month <= 2 ? 1 : 0);
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * static_cast<unsigned>(month + (month > 2 ? -3 : 9)) + 2) / 5 +
+                         static_cast<unsigned>(day) - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return static_cast<int64_t>(era) * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+// Inverse of days_from_civil (civil_from_days)
+void civil_from_days(int64_t days, int& year, int& month, int& day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    year = static_cast<int>(static_cast<int64_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0));
+}
+
+// Floor division that rounds toward -inf
+int64_t floor_div(int64_t value, int64_t divisor) {
+    const int64_t q = value / divisor;
+    return (value % divisor != 0 && value < 0) ? q - 1 : q;
+}
+
+} // namespace
+
+std::optional<int64_t> parse_iso8601_ms(std::string_view text) {
+    size_t pos = 0;
+    auto digits = [&](size_t count, int& out) {
+        if (pos + count > text.size()) {
+            return false;
+        }
+        out = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const char c = text[pos++];
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            out = out * 10 + (c - '0');
+        }
+        return true;
+    };
+    auto expect = [&](char c) {
+        const bool match = pos < text.size() &&
+                           (text[pos] == c || (c == 'T' && text[pos] == ' '));  // RFC 3339 allows ' '
+        pos += match ? 1 : 0;
+        return match;
+    };
+
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    if (!digits(4, year) || !expect('-') || !digits(2, month) || !expect('-') || !digits(2, day) ||
+        !expect('T') || !digits(2, hour) || !expect(':') || !digits(2, minute) ||
+        !expect(':') || !digits(2, second)) {
+        return std::nullopt;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+        return std::nullopt;
+    }
+
+    int64_t millis = 0;
+    if (pos < text.size() && text[pos] == '.') {
+        ++pos;
+        int64_t scale = 100;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+            millis += (text[pos++] - '0') * scale;
+            scale /= 10;
+        }
+    }
+
+    int64_t offset_min = 0;
+    if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+        const int sign = text[pos++] == '-' ? -1 : 1;
+        int off_h = 0, off_m = 0;
+        if (!digits(2, off_h)) {
+            return std::nullopt;
+        }
+        if (pos < text.size() && text[pos] == ':') {
+            ++pos;
+        }
+        if (!digits(2, off_m)) {
+            return std::nullopt;
+        }
+        offset_min = sign * (off_h * 60 + off_m);
+    } else if (pos < text.size() && (text[pos] == 'Z' || text[pos] == 'z')) {
+        ++pos;
+    }
+    if (pos != text.size()) {
+        return std::nullopt;
+    }
+
+    const int64_t seconds = days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second - offset_min * 60;
+    return seconds * 1000 + millis;
+}
+
+std::string format_iso8601_ms(int64_t unix_ms) {
+    const int64_t days = floor_div(unix_ms, 86400000);
+    const int64_t ms_of_day = unix_ms - days * 86400000;
+    int year = 0, month = 0, day = 0;
+    civil_from_days(days, year, month, day);
+
+    char buffer[40];
+    const int n = std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+                                year, month, day,
+                                static_cast<int>(ms_of_day / 3600000),
+                                static_cast<int>(ms_of_day / 60000 % 60),
+                                static_cast<int>(ms_of_day / 1000 % 60),
+                                static_cast<int>(ms_of_day % 1000));
+    return std::string(buffer, static_cast<size_t>(n));
+}
+
+std::string now_iso8601() {
+    return format_iso8601_ms(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace telemetry_processor
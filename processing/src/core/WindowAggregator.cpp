@@ -0,0 +1,343 @@
+#include "telemetry_processor/WindowAggregator.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace telemetry_processor {
+
+namespace {
+
+struct WindowKey {
+    uint32_t device = 0;
+    int64_t start = 0;
+
+    bool operator==(const WindowKey& other) const {
+        return device == other.device && start == other.start;
+    }
+};
+
+struct WindowState {
+    WindowKey key;
+    size_t samples = 0;
+    std::array<MetricAggregate, WindowResult::kMaxMetrics> metrics{};
+};
+
+/**
+ * Open-addressing (linear probing) index from WindowKey to a slot in a
+ * dense state vector. Slots are 4-byte indices, so a probe run stays in
+ * one cache line; states are removed by swap-with-last, and the index entry
+ * by backward-shift deletion (no tombstones to slow later probes).
+ */
+class FlatWindowTable {
+public:
+    FlatWindowTable() : slots_(kInitialCapacity) {}
+
+    /// Returns the state for key, creating it if absent (created = true)
+    WindowState& find_or_insert(const WindowKey& key, bool& created) {
+        if ((states_.size() + 1) * 10 > slots_.size() * 7) {
+            rehash(slots_.size() * 2);  // Keep load factor <= 0.7
+        }
+        size_t i = ideal(key);
+        for (; slots_[i].state != kEmpty; i = next(i)) {
+            if (states_[slots_[i].state].key == key) {
+                created = false;
+                return states_[slots_[i].state];
+            }
+        }
+        slots_[i].state = static_cast<uint32_t>(states_.size());
+        states_.push_back(WindowState{});
+        states_.back().key = key;
+        created = true;
+        return states_.back();
+    }
+
+    /// Move the state for key out of the table; false if absent
+    bool take(const WindowKey& key, WindowState& out) {
+        size_t i = ideal(key);
+        for (;; i = next(i)) {
+            if (slots_[i].state == kEmpty) {
+                return false;
+            }
+            if (states_[slots_[i].state].key == key) {
+                break;
+            }
+        }
+
+        const uint32_t index = slots_[i].state;
+        out = std::move(states_[index]);
+        erase_slot(i);  // No slot refers to index from here on
+
+        const auto last = static_cast<uint32_t>(states_.size() - 1);
+        if (index != last) {
+            // Swap-remove: repoint the last state's slot (found while its key is still in place)
+            slot_of(last).state = index;
+            states_[index] = std::move(states_[last]);
+        }
+        states_.pop_back();
+        return true;
+    }
+
+    size_t size() const { return states_.size(); }
+
+private:
+    static constexpr uint32_t kEmpty = 0xFFFFFFFFu;
+    static constexpr size_t kInitialCapacity = 64;  // Power of two
+
+    struct Slot {
+        uint32_t state = kEmpty;  // Index into states_
+    };
+
+    size_t ideal(const WindowKey& key) const {
+        uint64_t h = (static_cast<uint64_t>(key.start) * 0x9E3779B97F4A7C15ULL) ^ key.device;
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 32;
+        return static_cast<size_t>(h) & (slots_.size() - 1);
+    }
+
+    size_t next(size_t i) const { return (i + 1) & (slots_.size() - 1); }
+
+    // Slot holding state index (which must be in the table)
+    Slot& slot_of(uint32_t index) {
+        size_t i = ideal(states_[index].key);
+        while (slots_[i].state != index) {
+            i = next(i);
+        }
+        return slots_[i];
+    }
+
+    // Backward-shift deletion: pull later entries of the probe run into the hole
+    void erase_slot(size_t hole) {
+        slots_[hole].state = kEmpty;
+        for (size_t j = next(hole); slots_[j].state != kEmpty; j = next(j)) {
+            const size_t home = ideal(states_[slots_[j].state].key);
+            const bool movable = hole <= j ? (home <= hole || home > j)
+                                           : (home <= hole && home > j);
+            if (movable) {
+                slots_[hole] = slots_[j];
+                slots_[j].state = kEmpty;
+                hole = j;
+            }
+        }
+    }
+
+    void rehash(size_t capacity) {
+        slots_.assign(capacity, Slot{});
+        for (uint32_t index = 0; index < states_.size(); ++index) {
+            size_t i = ideal(states_[index].key);
+            while (slots_[i].state != kEmpty) {
+                i = next(i);
+            }
+            slots_[i].state = index;
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<WindowState> states_;
+};
+
+/**
+ * Device ID -> dense index, open addressing like FlatWindowTable. Slots keep
+ * the full hash, so a probe only compares strings on a hash match; lookups
+ * take a string_view, so interning a known device allocates nothing.
+ * Devices are never removed.
+ */
+class FlatDeviceIndex {
+public:
+    FlatDeviceIndex() : slots_(kInitialCapacity) {}
+
+    uint32_t intern(std::string_view name) {
+        const size_t hash = std::hash<std::string_view>{}(name);
+        size_t i = hash & (slots_.size() - 1);
+        for (; slots_[i].index != kEmpty; i = (i + 1) & (slots_.size() - 1)) {
+            if (slots_[i].hash == hash && names_[slots_[i].index] == name) {
+                return slots_[i].index;
+            }
+        }
+        const auto index = static_cast<uint32_t>(names_.size());
+        names_.emplace_back(name);
+        slots_[i] = Slot{hash, index};
+        if (names_.size() * 2 > slots_.size()) {
+            grow();  // Keep load factor <= 0.5
+        }
+        return index;
+    }
+
+    const std::string& name(uint32_t index) const { return names_[index]; }
+    size_t size() const { return names_.size(); }
+
+private:
+    static constexpr uint32_t kEmpty = 0xFFFFFFFFu;
+    static constexpr size_t kInitialCapacity = 64;  // Power of two
+
+    struct Slot {
+        size_t hash = 0;
+        uint32_t index = kEmpty;  // Into names_
+    };
+
+    void grow() {
+        std::vector<Slot> old(slots_.size() * 2);
+        old.swap(slots_);
+        for (const Slot& slot : old) {
+            if (slot.index == kEmpty) {
+                continue;
+            }
+            size_t i = slot.hash & (slots_.size() - 1);
+            while (slots_[i].index != kEmpty) {
+                i = (i + 1) & (slots_.size() - 1);
+            }
+            slots_[i] = slot;
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<std::string> names_;
+};
+
+// Floor division that rounds toward -inf (timestamps before 1970 stay correct)
+int64_t floor_div(int64_t value, int64_t divisor) {
+    int64_t q = value / divisor;
+    return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? q - 1 : q;
+}
+
+constexpr int64_t kNoWatermark = std::numeric_limits<int64_t>::min();
+
+} // namespace
+
+struct WindowAggregator::Impl {
+    struct Pending {
+        int64_t end;
+        WindowKey key;
+    };
+
+    // Min-heap order: earliest end first, then device index
+    struct LaterEnd {
+        bool operator()(const Pending& a, const Pending& b) const {
+            return a.end != b.end ? a.end > b.end : a.key.device > b.key.device;
+        }
+    };
+
+    explicit Impl(Options opts) : options(std::move(opts)) {}
+
+    WindowResult to_result(WindowState& state) const {
+        WindowResult result;
+        result.device_id = devices.name(state.key.device);
+        result.start_ms = state.key.start;
+        result.end_ms = state.key.start + options.window_ms;
+        result.sample_count = state.samples;
+        result.metrics = state.metrics;
+        return result;
+    }
+
+    // Emit every pending window whose end is <= limit
+    std::vector<WindowResult> close_until(int64_t limit) {
+        std::vector<WindowResult> closed;
+        while (!pending.empty() && pending.front().end <= limit) {
+            std::pop_heap(pending.begin(), pending.end(), LaterEnd{});
+            WindowState state;
+            if (windows.take(pending.back().key, state)) {
+                closed.push_back(to_result(state));
+            }
+            pending.pop_back();
+        }
+        emitted += closed.size();
+        return closed;
+    }
+
+    Options options;
+    FlatDeviceIndex devices;
+    FlatWindowTable windows;
+    std::vector<Pending> pending;  // Heap of open window ends
+    int64_t max_event_ms = kNoWatermark;
+    int64_t watermark = kNoWatermark;
+    size_t samples = 0;
+    size_t late = 0;
+    size_t emitted = 0;
+};
+
+WindowAggregator::WindowAggregator(Options options) {
+    if (options.window_ms <= 0 || options.slide_ms < 0 || options.max_lateness_ms < 0) {
+        throw std::invalid_argument("WindowAggregator: window must be > 0, slide and lateness >= 0");
+    }
+    if (options.slide_ms > 0 && options.window_ms % options.slide_ms != 0) {
+        throw std::invalid_argument("WindowAggregator: slide must divide the window length");
+    }
+    if (options.metric_names.size() > WindowResult::kMaxMetrics) {
+        throw std::invalid_argument("WindowAggregator: too many metrics");
+    }
+    impl_ = std::make_unique<Impl>(std::move(options));
+}
+
+WindowAggregator::~WindowAggregator() = default;
+WindowAggregator::WindowAggregator(WindowAggregator&&) noexcept = default;
+WindowAggregator& WindowAggregator::operator=(WindowAggregator&&) noexcept = default;
+
+bool WindowAggregator::add(std::string_view device_id, int64_t ts_ms, const double* values) {
+    Impl& s = *impl_;
+    if (ts_ms > s.max_event_ms) {
+        s.max_event_ms = ts_ms;
+        s.watermark = ts_ms - s.options.max_lateness_ms;
+    }
+
+    const int64_t window = s.options.window_ms;
+    const int64_t slide = s.options.slide_ms > 0 ? s.options.slide_ms : window;
+    const int64_t last_start = floor_div(ts_ms, slide) * slide;
+    const int64_t first_start = last_start - window + slide;
+    const size_t metric_count = s.options.metric_names.size();
+
+    uint32_t device = 0;
+    bool accepted = false;
+    for (int64_t start = first_start; start <= last_start; start += slide) {
+        if (start + window <= s.watermark) {
+            continue;  // Window already closed
+        }
+        if (!accepted) {
+            device = s.devices.intern(device_id);
+            accepted = true;
+        }
+        bool created = false;
+        WindowState& state = s.windows.find_or_insert({device, start}, created);
+        if (created) {
+            s.pending.push_back({start + window, state.key});
+            std::push_heap(s.pending.begin(), s.pending.end(), Impl::LaterEnd{});
+        }
+        ++state.samples;
+        for (size_t m = 0; m < metric_count; ++m) {
+            if (!std::isnan(values[m])) {
+                state.metrics[m].add(values[m], ts_ms);
+            }
+        }
+    }
+
+    ++(accepted ? s.samples : s.late);
+    return accepted;
+}
+
+std::vector<WindowResult> WindowAggregator::poll() {
+    return impl_->close_until(impl_->watermark);
+}
+
+std::vector<WindowResult> WindowAggregator::flush() {
+    return impl_->close_until(std::numeric_limits<int64_t>::max());
+}
+
+int64_t WindowAggregator::watermark() const {
+    return impl_->watermark;
+}
+
+const WindowAggregator::Options& WindowAggregator::options() const {
+    return impl_->options;
+}
+
+WindowAggregator::Stats WindowAggregator::stats() const {
+    Stats stats;
+    stats.samples = impl_->samples;
+    stats.late_samples = impl_->late;
+    stats.open_windows = impl_->windows.size();
+    stats.windows_emitted = impl_->emitted;
+    stats.devices = impl_->devices.size();
+    return stats;
+}
+
+} // namespace telemetry_processor
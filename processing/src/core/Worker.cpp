@@ -0,0 +1,547 @@
+#include "telemetry_processor/Worker.h"
+#include "task_queue.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace telemetry_processor {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using LocalTask = telemetry_processing::Task;
+
+constexpr auto kDequeueWait = std::chrono::milliseconds(20);
+
+LocalTask local_task(uint64_t seq, Priority priority) {
+    // Same numbering (0 = highest), so the local queue keeps Redis priorities
+    return LocalTask(std::to_string(seq), static_cast<telemetry_processing::TaskPriority>(priority));
+}
+
+} // namespace
+
+/**
+ * Threads: one prefetcher, max_concurrency workers. `mutex` guards the
+ * in-flight table, the AIMD window and the counters; workers take it once
+ * to claim a batch and once to settle it, never per task.
+ *
+ * In-flight entries are keyed by a local sequence number, not the task
+ * ID, so a task pushed to Redis twice is simply processed twice. In
+ * reliable mode they also keep the claimed frame: acks match it byte for
+ * byte.
+ */
+struct Worker::Impl {
+    struct InFlight {
+        Task task;
+        std::string frame;   // Reliable mode only
+    };
+
+    Impl(std::shared_ptr<RedisClient> client, Options opts)
+        : options(std::move(opts)), redis(std::move(client)),
+          local(options.prefetch), limit(options.initial_concurrency) {
+        if (options.reliable) {
+            ReliableQueue::Options queue_options;
+            queue_options.pending_key = options.queue_key;
+            queue_options.lease_ttl = options.lease_ttl;
+            reliable = std::make_unique<ReliableQueue>(redis, options.worker_id, queue_options);
+        }
+    }
+
+    // ===== Prefetch =====
+
+    void prefetch_loop() {
+        while (fetching) {
+            promote_retries();
+            size_t room = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                space_cv.wait_for(lock, std::chrono::milliseconds(50), [this] {
+                    return !fetching || in_flight.size() + options.batch_size <= options.prefetch;
+                });
+                if (!fetching) {
+                    break;
+                }
+                if (in_flight.size() + options.batch_size > options.prefetch) {
+                    lock.unlock();
+                    keep_lease();  // Busy workers are not dead workers
+                    continue;
+                }
+                room = options.prefetch - in_flight.size();
+            }
+
+            if (reliable) {
+                keep_lease();
+                auto frames = reliable->claim(room, options.poll_timeout_sec);
+                if (frames.empty() && !redis->is_connected()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+                admit(frames);
+                continue;
+            }
+
+            auto frames = redis->lpop(options.queue_key, room);
+            if (frames.empty()) {
+                if (!redis->is_connected()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    continue;
+                }
+                // Idle: block in Redis instead of polling, then top up the batch
+                auto first = redis->blpop(options.queue_key, options.poll_timeout_sec);
+                if (!first) {
+                    continue;
+                }
+                frames.push_back(std::move(*first));
+                for (auto& frame : redis->lpop(options.queue_key, room - 1)) {
+                    frames.push_back(std::move(frame));
+                }
+            }
+            admit(frames);
+        }
+    }
+
+    // Scheduler mode: move due retries to the pending list (one call per interval)
+    void promote_retries() {
+        if (!options.retry_scheduler) {
+            return;
+        }
+        const auto now = Clock::now();
+        if (now < next_promote) {
+            return;
+        }
+        next_promote = now + options.retry_scheduler->options().promote_interval;
+        options.retry_scheduler->promote_due();
+    }
+
+    // Reliable mode: renew the lease, and look for dead workers now and then
+    void keep_lease() {
+        reliable->renew_if_due();
+        const auto now = Clock::now();
+        if (now < next_reap) {
+            return;
+        }
+        next_reap = now + options.reap_interval;
+        const size_t reaped = reliable->reap();
+        if (reaped > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.reaped += reaped;
+        }
+    }
+
+    // Remove already-completed tasks; their frames join `done` for the ack
+    size_t drop_duplicates(std::vector<InFlight>& decoded, std::vector<std::string>& done) {
+        if (!options.deduplicator || decoded.empty()) {
+            return 0;
+        }
+        std::vector<std::string> ids;
+        ids.reserve(decoded.size());
+        for (const auto& entry : decoded) {
+            ids.push_back(entry.task.id);
+        }
+        const auto seen = options.deduplicator->seen(ids);
+        size_t kept = 0;
+        for (size_t i = 0; i < decoded.size(); ++i) {
+            if (seen[i]) {
+                done.push_back(std::move(decoded[i].frame));
+                continue;
+            }
+            if (kept != i) {
+                decoded[kept] = std::move(decoded[i]);
+            }
+            ++kept;
+        }
+        const size_t dropped = decoded.size() - kept;
+        decoded.resize(kept);
+        return dropped;
+    }
+
+    void admit(std::vector<std::string>& frames) {
+        std::vector<InFlight> decoded;
+        decoded.reserve(frames.size());
+        std::vector<std::string> skipped;  // Frames that will not run
+        for (auto& frame : frames) {
+            try {
+                Task task = Task::deserialize(frame);
+                task.worker_id = options.worker_id;
+                decoded.push_back({std::move(task), reliable ? std::move(frame) : std::string()});
+            } catch (const std::exception& e) {
+                skipped.push_back(std::move(frame));
+                std::clog << "[worker " << options.worker_id << "] dropping malformed task: " << e.what() << "\n";
+            }
+        }
+        const size_t malformed = skipped.size();
+        const size_t duplicates = drop_duplicates(decoded, skipped);
+        if (reliable && !skipped.empty()) {
+            reliable->ack(skipped);  // Unparseable or already done: do not let the reaper recycle them
+        }
+
+        std::vector<LocalTask> locals;
+        locals.reserve(decoded.size());
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& entry : decoded) {
+                const uint64_t seq = next_seq++;
+                locals.push_back(local_task(seq, entry.task.priority));
+                in_flight.emplace(seq, std::move(entry));
+            }
+            stats.fetched += frames.size();
+            stats.failed += malformed;
+            stats.duplicates += duplicates;
+        }
+        // Room was reserved against `prefetch`, which is also the queue capacity
+        local.enqueue_bulk(std::move(locals));
+    }
+
+    // ===== Workers =====
+
+    void worker_loop(size_t index) {
+        std::vector<LocalTask> batch;
+        batch.reserve(options.batch_size);
+        while (working) {
+            if (index >= limit.load(std::memory_order_relaxed)) {
+                std::unique_lock<std::mutex> lock(gate_mutex);
+                gate_cv.wait_for(lock, std::chrono::milliseconds(100), [&] {
+                    return !working || index < limit.load(std::memory_order_relaxed);
+                });
+                continue;
+            }
+            batch.clear();
+            if (local.dequeue_bulk(batch, options.batch_size, kDequeueWait) > 0) {
+                process(batch);
+            }
+        }
+    }
+
+    void process(const std::vector<LocalTask>& batch) {
+        // Claim: copy the tasks out of the table (payloads share their buffers)
+        std::vector<uint64_t> seqs;
+        std::vector<Task> tasks;
+        seqs.reserve(batch.size());
+        tasks.reserve(batch.size());
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& item : batch) {
+                const uint64_t seq = std::stoull(item.id);
+                auto it = in_flight.find(seq);
+                if (it == in_flight.end()) {
+                    continue;  // Stale entry from before a stop()
+                }
+                Task& task = it->second.task;
+                task.status = TaskStatus::RUNNING;
+                task.updated_at = std::chrono::system_clock::now();
+                seqs.push_back(seq);
+                tasks.push_back(task);
+            }
+        }
+
+        // Group by type (stable), one handler call per run
+        std::vector<size_t> order(tasks.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return tasks[a].type < tasks[b].type; });
+
+        std::vector<char> ok(tasks.size(), 0);
+        std::vector<char> permanent(tasks.size(), 0);  // Retrying cannot help
+        std::vector<std::string> errors(tasks.size());
+        double elapsed_ms = 0.0;
+        std::vector<Task> run;
+        for (size_t begin = 0; begin < order.size();) {
+            size_t end = begin + 1;
+            while (end < order.size() && tasks[order[end]].type == tasks[order[begin]].type) {
+                ++end;
+            }
+            auto handler = handlers.find(tasks[order[begin]].type);
+            if (handler == handlers.end()) {
+                for (size_t k = begin; k < end; ++k) {
+                    permanent[order[k]] = 1;
+                    errors[order[k]] = "no handler for task type " + tasks[order[k]].type;
+                }
+            } else {
+                run.clear();
+                for (size_t k = begin; k < end; ++k) {
+                    run.push_back(std::move(tasks[order[k]]));
+                }
+                const auto start = Clock::now();
+                Results results;
+                std::string thrown;
+                try {
+                    results = handler->second(run);
+                } catch (const std::exception& e) {
+                    thrown = std::string("handler threw: ") + e.what();
+                    std::clog << "[worker " << options.worker_id << "] " << thrown << "\n";
+                }
+                elapsed_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                for (size_t k = begin; k < end; ++k) {
+                    const size_t r = k - begin;
+                    ok[order[k]] = r < results.size() && results[r].success;
+                    if (!ok[order[k]]) {
+                        errors[order[k]] = r < results.size() ? results[r].message : thrown;
+                    }
+                }
+            }
+            begin = end;
+        }
+
+        settle(seqs, ok, permanent, errors, elapsed_ms);
+    }
+
+    void settle(const std::vector<uint64_t>& seqs, const std::vector<char>& ok,
+                const std::vector<char>& permanent, std::vector<std::string>& errors, double elapsed_ms) {
+        std::vector<std::pair<LocalTask, std::chrono::milliseconds>> retries;
+        std::vector<RetryScheduler::Failure> failures;  // Scheduler mode: leave the worker
+        std::vector<std::string> finished;  // Reliable mode: frames to ack
+        std::vector<std::string> completed_ids;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 0; i < seqs.size(); ++i) {
+                auto it = in_flight.find(seqs[i]);
+                Task& task = it->second.task;
+                if (ok[i]) {
+                    ++stats.completed;
+                    if (options.deduplicator) {
+                        completed_ids.push_back(task.id);
+                    }
+                } else if (options.retry_scheduler) {
+                    failures.push_back({std::move(task), std::move(errors[i]), permanent[i] != 0});
+                } else if (!permanent[i] && task.retry_count < task.max_retries) {
+                    ++task.retry_count;
+                    task.status = TaskStatus::PENDING;
+                    ++stats.retried;
+                    const auto backoff = options.retry_backoff * (1 << std::min(task.retry_count - 1, 16));
+                    retries.emplace_back(local_task(seqs[i], task.priority), backoff);
+                    continue;
+                } else {
+                    ++stats.failed;
+                }
+                if (reliable) {
+                    finished.push_back(std::move(it->second.frame));
+                }
+                in_flight.erase(it);
+            }
+            total_latency_ms += elapsed_ms;
+            window_latency_ms += elapsed_ms;
+            window_tasks += seqs.size();
+            total_tasks += seqs.size();
+            if (++window_batches >= options.adjust_every) {
+                adjust_limit();
+            }
+        }
+        // Redis calls outside the lock, all before the ack: a crash in between
+        // reruns a task (or the deduplicator recognizes it), never loses one
+        if (!failures.empty()) {
+            const auto outcome = options.retry_scheduler->fail(std::move(failures));
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.retried += outcome.scheduled;
+            stats.failed += outcome.dead;
+            stats.dead_lettered += outcome.dead;
+        }
+        if (options.deduplicator) {
+            options.deduplicator->record(completed_ids);
+        }
+        if (reliable) {
+            reliable->ack(finished);  // One LREM pass per batch (stop() joins workers before release())
+        }
+        space_cv.notify_all();  // Prefetcher room; stop() waits for an empty table
+
+        // Cannot fail for capacity: local occupancy <= in-flight entries <= prefetch
+        for (auto& retry : retries) {
+            local.enqueue_after(std::move(retry.first), retry.second);
+        }
+    }
+
+    // AIMD on mean per-task latency; caller holds mutex
+    void adjust_limit() {
+        const size_t current = limit.load(std::memory_order_relaxed);
+        size_t next = current;
+        if (window_tasks > 0) {
+            const double mean_ms = window_latency_ms / static_cast<double>(window_tasks);
+            if (mean_ms > static_cast<double>(options.target_latency.count())) {
+                next = std::max(options.min_concurrency,
+                                static_cast<size_t>(static_cast<double>(current) * options.decrease_factor));
+            } else if (!local.empty()) {
+                next = std::min(options.max_concurrency, current + 1);  // On target and work waiting
+            }
+        }
+        window_latency_ms = 0.0;
+        window_tasks = 0;
+        window_batches = 0;
+        if (next != current) {
+            limit.store(next, std::memory_order_relaxed);
+            if (next > current) {
+                std::lock_guard<std::mutex> gate(gate_mutex);
+                gate_cv.notify_all();
+            }
+        }
+    }
+
+    Options options;
+    std::shared_ptr<RedisClient> redis;
+    std::unique_ptr<ReliableQueue> reliable;                 // Null unless options.reliable
+    Clock::time_point next_reap{};                           // Prefetch thread only
+    Clock::time_point next_promote{};                        // Prefetch thread only
+    std::unordered_map<std::string, BatchHandler> handlers;  // Read-only once started
+    telemetry_processing::TaskQueue local;
+
+    mutable std::mutex mutex;
+    std::condition_variable space_cv;
+    std::unordered_map<uint64_t, InFlight> in_flight;
+    uint64_t next_seq = 0;
+    Stats stats;
+    double total_latency_ms = 0.0;
+    size_t total_tasks = 0;
+    double window_latency_ms = 0.0;
+    size_t window_tasks = 0;
+    size_t window_batches = 0;
+
+    std::atomic<size_t> limit;
+    std::mutex gate_mutex;
+    std::condition_variable gate_cv;
+
+    std::atomic<bool> fetching{false};
+    std::atomic<bool> working{false};
+    bool running = false;
+    std::thread prefetcher;
+    std::vector<std::thread> workers;
+};
+
+Worker::Worker(std::shared_ptr<RedisClient> redis)
+    : Worker(std::move(redis), Options{}) {
+}
+
+Worker::Worker(std::shared_ptr<RedisClient> redis, Options options) {
+    if (!redis) {
+        throw std::invalid_argument("Worker: redis client is null");
+    }
+    if (options.max_concurrency == 0 || options.min_concurrency == 0 ||
+        options.min_concurrency > options.max_concurrency || options.batch_size == 0 ||
+        options.prefetch < options.batch_size || options.adjust_every == 0 ||
+        !(options.decrease_factor > 0.0 && options.decrease_factor < 1.0)) {
+        throw std::invalid_argument("Worker: inconsistent concurrency, batch or prefetch limits");
+    }
+    // The lease is renewed between claims: a BLMOVE wait must fit well inside it
+    if (options.reliable && std::chrono::seconds(std::max(options.poll_timeout_sec, 1)) * 2 > options.lease_ttl) {
+        throw std::invalid_argument("Worker: lease_ttl must be at least twice poll_timeout_sec");
+    }
+    options.initial_concurrency = std::clamp(options.initial_concurrency,
+                                             options.min_concurrency, options.max_concurrency);
+    if (options.worker_id.empty()) {
+        options.worker_id = "worker-" + generate_uuid().substr(0, 8);
+    }
+    impl_ = std::make_unique<Impl>(std::move(redis), std::move(options));
+}
+
+Worker::~Worker() {
+    stop();
+}
+
+void Worker::register_handler(const std::string& type, BatchHandler handler) {
+    if (impl_->running) {
+        throw std::logic_error("Worker: register handlers before start()");
+    }
+    impl_->handlers[type] = std::move(handler);
+}
+
+void Worker::register_handler(const std::string& type, std::shared_ptr<TelemetryHandler> handler) {
+    register_handler(type, [handler = std::move(handler)](const std::vector<Task>& tasks) {
+        return handler->process_batch(tasks);
+    });
+}
+
+void Worker::start() {
+    Impl& s = *impl_;
+    if (s.running) {
+        return;
+    }
+    if (s.reliable) {
+        // A previous run under this worker_id may have died holding tasks
+        s.stats.reaped += s.reliable->release();
+        s.reliable->heartbeat();
+        s.next_reap = Clock::now();
+    }
+    s.running = true;
+    s.fetching = true;
+    s.working = true;
+    s.workers.reserve(s.options.max_concurrency);
+    for (size_t i = 0; i < s.options.max_concurrency; ++i) {
+        s.workers.emplace_back([&s, i] { s.worker_loop(i); });
+    }
+    s.prefetcher = std::thread([&s] { s.prefetch_loop(); });
+}
+
+void Worker::stop() {
+    Impl& s = *impl_;
+    if (!s.running) {
+        return;
+    }
+
+    // 1. Stop taking work from Redis (at most one BLPOP poll away)
+    s.fetching = false;
+    s.space_cv.notify_all();
+    s.prefetcher.join();
+
+    // 2. Let the pool finish what is local, retries included
+    {
+        std::unique_lock<std::mutex> lock(s.mutex);
+        s.space_cv.wait_for(lock, s.options.drain_timeout, [&s] { return s.in_flight.empty(); });
+    }
+    s.working = false;
+    {
+        std::lock_guard<std::mutex> gate(s.gate_mutex);
+        s.gate_cv.notify_all();
+    }
+    for (auto& thread : s.workers) {
+        thread.join();
+    }
+    s.workers.clear();
+
+    // 3. Hand unfinished tasks back to Redis
+    std::vector<Task> leftovers;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (s.reliable) {
+            // Still in the processing list, untouched: move them back as claimed
+            s.stats.requeued += s.reliable->release();
+        } else {
+            for (auto& entry : s.in_flight) {
+                leftovers.push_back(std::move(entry.second.task));
+            }
+            s.stats.requeued += leftovers.size();
+        }
+        s.in_flight.clear();
+    }
+    for (auto& task : leftovers) {
+        task.status = TaskStatus::PENDING;
+        task.worker_id.clear();
+        s.redis->rpush(s.options.queue_key, task.serialize());
+    }
+    s.local.clear();
+    s.running = false;
+}
+
+bool Worker::running() const {
+    return impl_->running;
+}
+
+const std::string& Worker::worker_id() const {
+    return impl_->options.worker_id;
+}
+
+Worker::Stats Worker::stats() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    Stats stats = impl_->stats;
+    stats.in_flight = impl_->in_flight.size();
+    stats.concurrency_limit = impl_->limit.load(std::memory_order_relaxed);
+    stats.avg_latency_ms = impl_->total_tasks > 0
+        ? impl_->total_latency_ms / static_cast<double>(impl_->total_tasks)
+        : 0.0;
+    return stats;
+}
+
+} // namespace telemetry_processor
@@ -31,6 +31,13 @@ int main() {
     std::cout << "  Deserialized ID: " << task2.id << "\n";
     std::cout << "  Match: " << (task.id == task2.id ? "✓" : "✗") << "\n";
     
+    // Test 3b: Binary frame (default wire format for Redis)
+    std::cout << "\nTest 3b: Binary Serialization\n";
+    auto frame = task.serialize();
+    std::cout << "  Binary: " << frame.size() << " bytes (JSON: " << json.dump().size() << " bytes)\n";
+    auto task_bin = telemetry_processor::Task::deserialize(frame);
+    std::cout << "  Match: " << (task.id == task_bin.id ? "✓" : "✗") << "\n";
+    
     // Test 4: Redis client
     std::cout << "\nTest 4: Redis Client (Mock)\n";
     telemetry_processor::RedisClient redis;
@@ -43,7 +50,7 @@ int main() {
         
         // Test RPUSH/BLPOP
         std::string queue_key = "distqueue:tasks:pending";
-        redis.rpush(queue_key, json.dump());
+        redis.rpush(queue_key, frame);
         std::cout << "  Pushed task to queue: ✓\n";
         
         auto queue_len = redis.llen(queue_key);
@@ -52,7 +59,7 @@ int main() {
         auto popped = redis.blpop(queue_key);
         if (popped) {
             std::cout << "  Popped task: ✓\n";
-            auto task3 = telemetry_processor::Task::from_json(nlohmann::json::parse(*popped));
+            auto task3 = telemetry_processor::Task::deserialize(*popped);  // Either format
             std::cout << "  Popped Task ID: " << task3.id << "\n";
         }
         
@@ -0,0 +1,125 @@
+// Telemetry worker process
+//
+// Runs one Worker against the task list until SIGINT/SIGTERM, then drains:
+// stops fetching, finishes what is local, pushes the rest back to Redis.
+//
+//   TELEMETRY_PROCESSOR_worker                          # 127.0.0.1:6379, 8 threads
+//   TELEMETRY_PROCESSOR_worker --concurrency 16 --batch 64
+//   TELEMETRY_PROCESSOR_worker --reliable --retries     # Claim/ack, Redis retry set + DLQ
+
+#include "telemetry_processor/Deduplicator.h"
+#include "telemetry_processor/RedisClient.h"
+#include "telemetry_processor/RetryScheduler.h"
+#include "telemetry_processor/TelemetryHandler.h"
+#include "telemetry_processor/Worker.h"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace telemetry_processor;
+
+namespace {
+std::atomic<bool> g_stop{false};
+
+void on_signal(int) { g_stop = true; }
+
+void usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [--host H] [--port N] [--queue KEY] [--id WORKER_ID]\n"
+              << "       [--concurrency N] [--batch N] [--prefetch N] [--drain-ms N]\n"
+              << "       [--reliable] [--retries] [--dedup]\n";
+}
+}
+
+int main(int argc, char** argv)
+{
+    std::string host = "127.0.0.1";
+    int port = 6379;
+    bool retries = false;
+    bool dedup = false;
+    Worker::Options options;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool has_value = i + 1 < argc;
+            if (arg == "--host" && has_value) {
+                host = argv[++i];
+            } else if (arg == "--port" && has_value) {
+                port = std::stoi(argv[++i]);
+            } else if (arg == "--queue" && has_value) {
+                options.queue_key = argv[++i];
+            } else if (arg == "--id" && has_value) {
+                options.worker_id = argv[++i];
+            } else if (arg == "--concurrency" && has_value) {
+                options.max_concurrency = std::stoul(argv[++i]);
+            } else if (arg == "--batch" && has_value) {
+                options.batch_size = std::stoul(argv[++i]);
+            } else if (arg == "--prefetch" && has_value) {
+                options.prefetch = std::stoul(argv[++i]);
+            } else if (arg == "--drain-ms" && has_value) {
+                options.drain_timeout = std::chrono::milliseconds(std::stol(argv[++i]));
+            } else if (arg == "--reliable") {
+                options.reliable = true;
+            } else if (arg == "--retries") {
+                retries = true;
+            } else if (arg == "--dedup") {
+                dedup = true;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {  // stoi/stoul on a non-number
+        usage(argv[0]);
+        return 1;
+    }
+
+    auto redis = std::make_shared<RedisClient>(host, port);
+    if (!redis->connect()) {
+        std::cerr << "Failed to connect to Redis at " << host << ":" << port << "\n";
+        return 1;
+    }
+    if (retries) {
+        options.retry_scheduler = std::make_shared<RetryScheduler>(redis);
+    }
+    if (dedup) {
+        options.deduplicator = std::make_shared<Deduplicator>(redis);
+    }
+
+    std::unique_ptr<Worker> worker;
+    try {
+        worker = std::make_unique<Worker>(redis, options);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Invalid worker options: " << e.what() << "\n";
+        return 1;
+    }
+    worker->register_handler("telemetry.analyze", std::make_shared<TelemetryHandler>());
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+    worker->start();
+    std::cout << "Worker " << worker->worker_id() << " consuming " << options.queue_key
+              << " (" << options.max_concurrency << " threads)\n";
+
+    while (!g_stop && worker->running()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    std::cout << "Draining...\n";
+    worker->stop();
+    auto stats = worker->stats();
+    std::cout << "fetched: " << stats.fetched
+              << ", completed: " << stats.completed
+              << ", failed: " << stats.failed
+              << ", dead-lettered: " << stats.dead_lettered
+              << ", requeued: " << stats.requeued << "\n";
+    return 0;
+}
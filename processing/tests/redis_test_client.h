@@ -0,0 +1,23 @@
+#pragma once
+
+#include "telemetry_processor/RedisClient.h"
+#include <memory>
+
+namespace telemetry_processor {
+namespace testing {
+
+/**
+ * Connected RedisClient, shared the way Worker, ReliableQueue,
+ * RetryScheduler and Deduplicator hold it.
+ *
+ * Every call is a separate in-process store, so tests never see each
+ * other's keys.
+ */
+inline std::shared_ptr<RedisClient> connected_client() {
+    auto redis = std::make_shared<RedisClient>();
+    redis->connect();
+    return redis;
+}
+
+} // namespace testing
+} // namespace telemetry_processor
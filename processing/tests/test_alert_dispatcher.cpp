@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include "telemetry_processor/AlertDispatcher.h"
+#include <nlohmann/json.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace telemetry_processor;
+using namespace std::chrono_literals;
+using Status = AlertDispatcher::SubmitStatus;
+
+namespace {
+
+// Local stand-in for the webhook endpoint; optionally blocks until opened
+class RecordingTransport : public AlertTransport {
+public:
+    explicit RecordingTransport(bool gated = false) : gate_open_(!gated) {}
+
+    bool send(const std::vector<Alert>& alerts) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++calls_;
+        cv_.notify_all();
+        cv_.wait(lock, [this] { return gate_open_; });
+        delivered_.insert(delivered_.end(), alerts.begin(), alerts.end());
+        return true;
+    }
+
+    void open_gate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        gate_open_ = true;
+        cv_.notify_all();
+    }
+
+    bool wait_for_call(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [this] { return calls_ > 0; });
+    }
+
+    std::vector<Alert> delivered() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return delivered_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool gate_open_;
+    size_t calls_ = 0;
+    std::vector<Alert> delivered_;
+};
+
+// Endpoint that is down for the first `failures` calls
+class FlakyTransport : public AlertTransport {
+public:
+    explicit FlakyTransport(size_t failures) : failures_(failures) {}
+
+    bool send(const std::vector<Alert>& alerts) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (failures_ > 0) {
+            --failures_;
+            return false;
+        }
+        delivered_.insert(delivered_.end(), alerts.begin(), alerts.end());
+        return true;
+    }
+
+    std::vector<Alert> delivered() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return delivered_;
+    }
+
+private:
+    std::mutex mutex_;
+    size_t failures_;
+    std::vector<Alert> delivered_;
+};
+
+Alert make_alert(const std::string& device, const std::string& reason) {
+    Alert alert;
+    alert.device_id = device;
+    alert.reason = reason;
+    alert.message = "Anomaly detected: " + reason;
+    return alert;
+}
+
+AlertDispatcher::Options manual_flush() {
+    AlertDispatcher::Options options;
+    options.flush_interval = 10s;  // Nothing leaves until flush() unless a test says otherwise
+    return options;
+}
+
+} // namespace
+
+TEST(AlertDispatcherTest, CoalescesQueuedRepeatsAndSuppressesAfterDelivery) {
+    auto transport = std::make_shared<RecordingTransport>();
+    AlertDispatcher dispatcher(transport, manual_flush());
+
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "temperature high")), Status::QUEUED);
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "temperature high")), Status::COALESCED);
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "temperature high")), Status::COALESCED);
+    EXPECT_EQ(dispatcher.submit(make_alert("d2", "temperature high")), Status::QUEUED);
+    dispatcher.flush();
+
+    auto delivered = transport->delivered();
+    ASSERT_EQ(delivered.size(), 2u);
+    EXPECT_EQ(delivered[0].device_id, "d1");
+    EXPECT_EQ(delivered[0].duplicates, 2u);
+
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "temperature high")), Status::SUPPRESSED);
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "voltage low")), Status::QUEUED);  // Other reason
+    auto stats = dispatcher.stats();
+    EXPECT_EQ(stats.sent, 2u);
+    EXPECT_EQ(stats.coalesced, 2u);
+    EXPECT_EQ(stats.suppressed, 1u);
+    EXPECT_EQ(stats.batches, 1u);
+}
+
+TEST(AlertDispatcherTest, ExpiredSuppressionReportsSwallowedRepeats) {
+    auto transport = std::make_shared<RecordingTransport>();
+    auto options = manual_flush();
+    options.suppression_window = 30ms;
+    AlertDispatcher dispatcher(transport, options);
+
+    dispatcher.submit(make_alert("d1", "current high"));
+    dispatcher.flush();
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "current high")), Status::SUPPRESSED);
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "current high")), Status::SUPPRESSED);
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "current high")), Status::QUEUED);
+    dispatcher.flush();
+
+    auto delivered = transport->delivered();
+    ASSERT_EQ(delivered.size(), 2u);
+    EXPECT_EQ(delivered[1].duplicates, 2u);
+}
+
+TEST(AlertDispatcherTest, SwallowedRepeatsSurvivePruning) {
+    auto transport = std::make_shared<RecordingTransport>();
+    auto options = manual_flush();
+    options.suppression_window = 30ms;
+    AlertDispatcher dispatcher(transport, options);
+
+    dispatcher.submit(make_alert("d1", "current high"));
+    dispatcher.flush();
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "current high")), Status::SUPPRESSED);
+    std::this_thread::sleep_for(50ms);
+
+    // Another delivery wakes the dispatcher, which prunes expired windows
+    dispatcher.submit(make_alert("d2", "current high"));
+    dispatcher.flush();
+    std::this_thread::sleep_for(50ms);
+    dispatcher.submit(make_alert("d2", "voltage low"));
+    dispatcher.flush();
+
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "current high")), Status::QUEUED);
+    dispatcher.flush();
+    auto delivered = transport->delivered();
+    ASSERT_EQ(delivered.size(), 4u);
+    EXPECT_EQ(delivered[3].device_id, "d1");
+    EXPECT_EQ(delivered[3].duplicates, 1u);
+}
+
+TEST(AlertDispatcherTest, TokenBucketLimitsDeliveries) {
+    auto transport = std::make_shared<RecordingTransport>();
+    AlertDispatcher::Options options;
+    options.rate_per_sec = 1.0;
+    options.burst = 3;
+    options.flush_interval = 5ms;
+    AlertDispatcher dispatcher(transport, options);
+
+    for (int i = 0; i < 10; ++i) {
+        dispatcher.submit(make_alert("d" + std::to_string(i), "temperature high"));
+    }
+    std::this_thread::sleep_for(100ms);  // Many flushes, but only the burst may go out
+
+    EXPECT_EQ(transport->delivered().size(), 3u);
+    auto stats = dispatcher.stats();
+    EXPECT_EQ(stats.queued, 7u);
+    EXPECT_GT(stats.rate_limited, 0u);
+
+    dispatcher.flush();  // Bypasses the limit
+    EXPECT_EQ(transport->delivered().size(), 10u);
+}
+
+TEST(AlertDispatcherTest, BoundedQueueDropsNewKeysWhenFull) {
+    auto transport = std::make_shared<RecordingTransport>();
+    auto options = manual_flush();
+    options.queue_capacity = 2;
+    AlertDispatcher dispatcher(transport, options);
+
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "r")), Status::QUEUED);
+    EXPECT_EQ(dispatcher.submit(make_alert("d2", "r")), Status::QUEUED);
+    EXPECT_EQ(dispatcher.submit(make_alert("d3", "r")), Status::DROPPED);
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "r")), Status::COALESCED);  // Repeats still fold in
+    EXPECT_EQ(dispatcher.stats().dropped, 1u);
+}
+
+TEST(AlertDispatcherTest, SubmitDoesNotWaitForSlowTransport) {
+    auto transport = std::make_shared<RecordingTransport>(true);  // Endpoint hangs until opened
+    AlertDispatcher::Options options;
+    options.flush_interval = 1ms;
+    options.rate_per_sec = 1000.0;
+    AlertDispatcher dispatcher(transport, options);
+
+    dispatcher.submit(make_alert("d0", "r"));
+    ASSERT_TRUE(transport->wait_for_call(2s));  // Dispatch thread now stuck in send()
+    for (int i = 1; i <= 100; ++i) {
+        EXPECT_NE(dispatcher.submit(make_alert("d" + std::to_string(i), "r")), Status::DROPPED);
+    }
+    transport->open_gate();
+    dispatcher.flush();
+    EXPECT_EQ(transport->delivered().size(), 101u);
+}
+
+TEST(AlertDispatcherTest, FailedSendIsRetriedNotSuppressed) {
+    auto transport = std::make_shared<FlakyTransport>(2);  // Webhook outage: two failed calls
+    AlertDispatcher::Options options;
+    options.flush_interval = 1ms;
+    options.retry_backoff = 20ms;
+    AlertDispatcher dispatcher(transport, options);
+
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "temperature high")), Status::QUEUED);
+    EXPECT_EQ(dispatcher.submit(make_alert("d2", "temperature high")), Status::QUEUED);
+    std::this_thread::sleep_for(10ms);  // First attempt failed, backing off
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "temperature high")), Status::COALESCED);
+
+    for (int i = 0; i < 200 && transport->delivered().size() < 2; ++i) {
+        std::this_thread::sleep_for(5ms);
+    }
+    auto delivered = transport->delivered();
+    ASSERT_EQ(delivered.size(), 2u);
+    EXPECT_EQ(delivered[0].device_id, "d1");   // Order kept across retries
+    EXPECT_EQ(delivered[0].duplicates, 1u);
+
+    auto stats = dispatcher.stats();
+    EXPECT_EQ(stats.sent, 2u);
+    EXPECT_EQ(stats.requeued, 4u);
+    EXPECT_EQ(stats.failed, 0u);
+    EXPECT_EQ(stats.suppressed, 0u);
+    // Only now does the suppression window run
+    EXPECT_EQ(dispatcher.submit(make_alert("d1", "temperature high")), Status::SUPPRESSED);
+}
+
+TEST(AlertDispatcherTest, RequeueAfterFailureRespectsCapacity) {
+    auto transport = std::make_shared<FlakyTransport>(1);
+    auto options = manual_flush();
+    options.queue_capacity = 3;
+    options.max_batch = 3;
+    options.retry_backoff = 10s;  // No retry inside this test
+    AlertDispatcher dispatcher(transport, options);
+
+    for (const char* device : {"d1", "d2", "d3"}) {
+        dispatcher.submit(make_alert(device, "r"));   // Full batch: sent at once, and fails
+    }
+    for (int i = 0; i < 200 && dispatcher.stats().requeued == 0; ++i) {
+        std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_EQ(dispatcher.stats().queued, 3u);
+    EXPECT_EQ(dispatcher.submit(make_alert("d4", "r")), Status::DROPPED);  // Still bounded
+
+    dispatcher.flush();  // Ignores the backoff
+    EXPECT_EQ(transport->delivered().size(), 3u);
+}
+
+TEST(AlertDispatcherTest, WebhookBodyIsJsonBatch) {
+    Alert alert = make_alert("d1", "voltage low");
+    alert.duplicates = 4;
+    auto body = nlohmann::json::parse(WebhookAlertTransport::format_body({alert, make_alert("d2", "x")}));
+
+    ASSERT_EQ(body["alerts"].size(), 2u);
+    EXPECT_EQ(body["alerts"][0]["device_id"], "d1");
+    EXPECT_EQ(body["alerts"][0]["duplicates"], 4);
+    EXPECT_TRUE(WebhookAlertTransport("").send({alert}));
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "telemetry_processor/AnomalyDetector.h"
+#include <cmath>
+#include <random>
+
+using namespace telemetry_processor;
+
+namespace {
+
+uint8_t reference_flags(const TelemetryColumns& c, const ThresholdLimits& l, size_t i) {
+    uint8_t flags = 0;
+    if (c.temperature[i] > l.temp_high) flags |= ANOMALY_TEMP_HIGH;
+    if (c.temperature[i] < l.temp_low) flags |= ANOMALY_TEMP_LOW;
+    if (c.humidity[i] > l.humidity_high) flags |= ANOMALY_HUMIDITY_HIGH;
+    if (c.voltage[i] < l.voltage_low) flags |= ANOMALY_VOLTAGE_LOW;
+    if (c.current[i] > l.current_high) flags |= ANOMALY_CURRENT_HIGH;
+    return flags;
+}
+
+} // namespace
+
+TEST(AnomalyDetectorTest, ThresholdKernelMatchesScalarReference) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> temp(-40.0, 120.0), hum(0.0, 100.0), volt(2.0, 4.0), cur(0.0, 3.0);
+    ThresholdLimits limits;
+
+    for (size_t n : {0u, 1u, 3u, 7u, 1000u}) {  // Odd sizes exercise the scalar tail
+        TelemetryColumns columns;
+        for (size_t i = 0; i < n; ++i) {
+            const double t = (i % 11 == 0) ? NAN : temp(gen);  // Absent values never flag
+            columns.push_back(t, hum(gen), 1013.0, volt(gen), cur(gen));
+        }
+        std::vector<uint8_t> flags(n, 0xFF);
+        size_t expected_flagged = 0;
+        const size_t flagged = detect_thresholds(columns, limits, flags.data());
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(flags[i], reference_flags(columns, limits, i)) << "n=" << n << " i=" << i;
+            expected_flagged += flags[i] != 0;
+        }
+        EXPECT_EQ(flagged, expected_flagged);
+    }
+}
+
+TEST(AnomalyDetectorTest, ZScoreFlagsSpikeAfterWarmup) {
+    ZScoreDetector detector({20, 3.0, 10}, 2);
+    for (int i = 0; i < 50; ++i) {
+        const double values[] = {20.0 + 0.5 * std::sin(i), NAN};  // Bounded wobble, never > 3 sigma
+        EXPECT_EQ(detector.update("d1", values), 0u) << i;
+    }
+    const double spike[] = {35.0, NAN};
+    EXPECT_EQ(detector.update("d1", spike), 1u);       // Metric 0 flagged, metric 1 absent
+    EXPECT_EQ(detector.update("d2", spike), 0u);       // New device: still warming up
+    EXPECT_EQ(detector.devices(), 2u);
+}
+
+TEST(AnomalyDetectorTest, EwmaFlagsDeviationAndAdaptsToDrift) {
+    EwmaDetector detector({0.2, 4.0, 10}, 1);
+    double value = 10.0;
+    for (int i = 0; i < 200; ++i) {
+        value += 0.01;  // Slow drift is followed, not flagged
+        const double sample[] = {value + ((i % 2) ? 0.1 : -0.1)};
+        EXPECT_EQ(detector.update("d1", sample), 0u) << i;
+    }
+    const double jump[] = {value + 5.0};
+    EXPECT_EQ(detector.update("d1", jump), 1u);
+}
+
+TEST(AnomalyDetectorTest, RejectsInvalidOptions) {
+    EXPECT_THROW(ZScoreDetector({1, 3.0, 10}, 1), std::invalid_argument);
+    EXPECT_THROW(EwmaDetector({0.0, 4.0, 10}, 1), std::invalid_argument);
+    EXPECT_THROW(EwmaDetector({0.1, 4.0, 10}, 0), std::invalid_argument);
+}
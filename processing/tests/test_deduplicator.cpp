@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "telemetry_processor/Deduplicator.h"
+#include "redis_test_client.h"
+#include <chrono>
+#include <thread>
+
+using namespace telemetry_processor;
+using telemetry_processor::testing::connected_client;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::vector<std::string> make_ids(const std::string& prefix, int count) {
+    std::vector<std::string> ids;
+    for (int i = 0; i < count; ++i) {
+        ids.push_back(prefix + std::to_string(i));
+    }
+    return ids;
+}
+
+} // namespace
+
+TEST(BloomFilterTest, NoFalseNegativesFewFalsePositives) {
+    BloomFilter filter(10000, 10.0);
+    for (const auto& id : make_ids("in-", 10000)) {
+        filter.insert(id);
+    }
+    for (const auto& id : make_ids("in-", 10000)) {
+        ASSERT_TRUE(filter.maybe_contains(id));
+    }
+
+    int false_positives = 0;
+    for (const auto& id : make_ids("out-", 10000)) {
+        false_positives += filter.maybe_contains(id) ? 1 : 0;
+    }
+    EXPECT_LT(false_positives, 300);   // ~1% designed, 3% bound
+
+    filter.clear();
+    EXPECT_FALSE(filter.maybe_contains("in-0"));
+}
+
+TEST(DeduplicatorTest, OnlyBloomHitsAreCheckedInRedis) {
+    auto redis = connected_client();
+    Deduplicator dedup(redis);
+
+    auto done = make_ids("done-", 100);
+    dedup.record(done);
+
+    auto ids = done;
+    auto fresh = make_ids("fresh-", 1000);
+    ids.insert(ids.end(), fresh.begin(), fresh.end());
+    auto seen = dedup.seen(ids);
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        EXPECT_EQ(seen[i], i < done.size()) << ids[i];
+    }
+    auto stats = dedup.stats();
+    EXPECT_EQ(stats.duplicates, 100u);
+    EXPECT_EQ(stats.remote_checks, 100u + stats.false_positives);
+    EXPECT_GT(stats.bloom_misses, 950u);           // Most new IDs never reach Redis
+}
+
+TEST(DeduplicatorTest, RedisRejectsFalsePositives) {
+    auto redis = connected_client();
+    Deduplicator::Options options;
+    options.expected_items = 1;                    // One 512-bit block: saturates quickly
+    options.bits_per_item = 1.0;
+    Deduplicator dedup(redis, options);
+
+    dedup.record(make_ids("done-", 2000));
+    auto seen = dedup.seen(make_ids("fresh-", 100));
+
+    for (bool duplicate : seen) {
+        EXPECT_FALSE(duplicate);
+    }
+    auto stats = dedup.stats();
+    EXPECT_GT(stats.remote_checks, 90u);
+    EXPECT_EQ(stats.false_positives, stats.remote_checks);
+    EXPECT_EQ(stats.duplicates, 0u);
+}
+
+TEST(DeduplicatorTest, EntriesAgeOutWithGenerations) {
+    auto redis = connected_client();
+    Deduplicator::Options options;
+    options.key_prefix = "test:done";
+    options.generation_period = 1s;
+    options.generations = 2;
+    Deduplicator dedup(redis, options);
+
+    dedup.record({"task-1"});
+    EXPECT_TRUE(dedup.seen({"task-1"})[0]);
+
+    std::this_thread::sleep_for(2100ms);           // Two rotations: out of the window
+    EXPECT_FALSE(dedup.seen({"task-1"})[0]);
+    EXPECT_GE(dedup.stats().rotations, 1u);
+}
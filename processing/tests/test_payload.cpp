@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "telemetry_processor/Payload.h"
+#include "telemetry_processor/Task.h"
+
+using namespace telemetry_processor;
+
+TEST(PayloadTest, ScalarFieldWithoutParsing) {
+    Payload payload = R"({"device_id": "sensor-001", "temperature": 25.5, "tags": ["a", "b"]})";
+
+    EXPECT_EQ(payload["device_id"], "sensor-001");
+    EXPECT_FALSE(payload.is_parsed());  // First scalar lookup never builds the DOM
+}
+
+TEST(PayloadTest, LaterLookupsReadTheCachedDom) {
+    Payload payload = R"({"device_id": "sensor-001", "temperature": 25.5, "state": "a", "state": "b"})";
+
+    EXPECT_EQ(payload["device_id"], "sensor-001");
+    EXPECT_FALSE(payload.is_parsed());
+
+    // Second lookup parses once instead of scanning the bytes again
+    EXPECT_DOUBLE_EQ(payload.value("temperature", 0.0), 25.5);
+    EXPECT_TRUE(payload.is_parsed());
+    EXPECT_EQ(payload.value("missing", 7), 7);
+    EXPECT_EQ(payload["state"], "b");  // Same answer as the scan would give
+
+    // Copies share the buffer, so they skip the scan too
+    Payload copy = payload;
+    EXPECT_EQ(copy["device_id"], "sensor-001");
+}
+
+TEST(PayloadTest, CompoundFieldFallsBackToDom) {
+    Payload payload = R"({"tags": ["a", "b"], "meta": {"site": "lab"}})";
+
+    EXPECT_EQ(payload["tags"], nlohmann::json({"a", "b"}));
+    EXPECT_TRUE(payload.is_parsed());
+    EXPECT_EQ(payload["meta"]["site"], "lab");
+}
+
+TEST(PayloadTest, InvalidJsonIsNullNotThrow) {
+    Payload payload = "{not json";
+
+    EXPECT_TRUE(payload["key"].is_null());
+    EXPECT_FALSE(payload.is_valid());
+    EXPECT_TRUE(payload.json().is_null());
+    EXPECT_EQ(payload.raw(), "{not json");  // Original bytes kept for DLQ/debugging
+}
+
+TEST(PayloadTest, FieldLookupAgreesWithDom) {
+    // Duplicate key: the last value wins, as in json()
+    Payload duplicate = R"({"state": "old", "state": "new"})";
+    EXPECT_EQ(duplicate["state"], "new");
+    EXPECT_FALSE(duplicate.is_parsed());
+    EXPECT_EQ(duplicate.json()["state"], "new");
+
+    // Well-formed up to the key, broken after it: null, like json()
+    Payload broken = R"({"device_id": "sensor-001", "temperature": )";
+    EXPECT_TRUE(broken["device_id"].is_null());
+    EXPECT_TRUE(broken.json().is_null());
+
+    Payload trailing = R"({"device_id": "sensor-001"} garbage)";
+    EXPECT_TRUE(trailing["device_id"].is_null());
+    EXPECT_FALSE(trailing.is_valid());
+}
+
+TEST(PayloadTest, FieldsReadsSeveralKeysInOnePass) {
+    constexpr std::array<std::string_view, 3> keys{{"device_id", "temperature", "missing"}};
+    std::array<nlohmann::json, 3> out;
+
+    Payload payload = R"({"device_id": "sensor-001", "tags": [1], "temperature": 25.5})";
+    ASSERT_TRUE(payload.fields(keys, out));
+    EXPECT_EQ(out[0], "sensor-001");
+    EXPECT_DOUBLE_EQ(out[1].get<double>(), 25.5);
+    EXPECT_TRUE(out[2].is_null());
+    EXPECT_FALSE(payload.is_parsed());  // Unwanted compound field skipped, no DOM
+    EXPECT_EQ(payload["device_id"], "sensor-001");
+    EXPECT_FALSE(payload.is_parsed());  // operator[] still had its scan
+
+    Payload compound = R"({"device_id": {"vendor": "acme"}, "temperature": 1})";
+    ASSERT_TRUE(compound.fields(keys, out));
+    EXPECT_EQ(out[0]["vendor"], "acme");  // Wanted compound field: read from the DOM
+    EXPECT_EQ(out[1], 1);
+
+    EXPECT_FALSE(Payload(R"({"device_id": "sensor-001", )").fields(keys, out));
+    EXPECT_TRUE(out[0].is_null());
+    EXPECT_FALSE(Payload("[1, 2]").fields(keys, out));
+    EXPECT_FALSE(Payload().fields(keys, out));
+}
+
+TEST(PayloadTest, CopiesShareBytesAndMutationIsCopyOnWrite) {
+    Payload original = R"({"attempt": 1})";
+    Payload copy = original;
+    EXPECT_EQ(&original.raw(), &copy.raw());  // Same buffer, not a duplicate
+
+    copy.mutable_json()["attempt"] = 2;
+    EXPECT_EQ(original.value("attempt", 0), 1);
+    EXPECT_EQ(copy.value("attempt", 0), 2);
+    EXPECT_NE(original, copy);
+}
+
+TEST(PayloadTest, EmptyAndEquality) {
+    EXPECT_TRUE(Payload().empty());
+    EXPECT_TRUE(Payload("").empty());
+    EXPECT_FALSE(Payload(R"({"a": 1})").empty());
+
+    // No bytes and empty bytes are the same payload
+    EXPECT_TRUE(Payload().is_valid());
+    EXPECT_TRUE(Payload("").is_valid());
+    EXPECT_TRUE(Payload("").json().is_null());
+    EXPECT_EQ(Payload(), Payload(""));
+
+    // Different bytes, same value
+    EXPECT_EQ(Payload(R"({"a": 1, "b": 2})"), Payload(R"({ "b": 2, "a": 1 })"));
+    EXPECT_EQ(Payload(R"({"a":1})"), Payload({{"a", 1}}));
+}
+
+TEST(PayloadTest, TaskRoundTripKeepsBytesUnparsed) {
+    auto task = Task::create("compute", R"({"data": 123})");
+    auto restored = Task::from_json(task.to_json());
+
+    EXPECT_EQ(restored.payload.raw(), R"({"data": 123})");
+    EXPECT_FALSE(restored.payload.is_parsed());
+    EXPECT_EQ(restored.payload.value("data", 0), 123);
+}
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 #include "telemetry_processor/RedisClient.h"
+#include "telemetry_processor/Task.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 using namespace telemetry_processor;
 
@@ -70,12 +75,202 @@ TEST(RedisClientTest, RPushAndBLPop) {
     EXPECT_EQ(client.llen(queue), 1);
 }
 
+TEST(RedisClientTest, LPopCountTakesBatch) {
+    RedisClient client;
+    client.connect();
+    
+    for (int i = 0; i < 5; ++i) {
+        client.rpush("batch_queue", "item" + std::to_string(i));
+    }
+    
+    auto first = client.lpop("batch_queue", 3);
+    ASSERT_EQ(first.size(), 3u);
+    EXPECT_EQ(first[0], "item0");
+    EXPECT_EQ(first[2], "item2");
+    EXPECT_EQ(client.lpop("batch_queue", 10).size(), 2u);  // Only what is there
+    EXPECT_TRUE(client.lpop("batch_queue", 10).empty());
+    EXPECT_EQ(client.llen("batch_queue"), 0);
+}
+
 TEST(RedisClientTest, BLPopEmptyQueue) {
     RedisClient client;
     client.connect();
     
-    auto item = client.blpop("empty_queue");
+    // Empty queue: blocks for the full timeout, then gives up
+    auto start = std::chrono::steady_clock::now();
+    auto item = client.blpop("empty_queue", 1);
+    auto waited = std::chrono::steady_clock::now() - start;
+    
     EXPECT_FALSE(item.has_value());
+    EXPECT_GE(waited, std::chrono::milliseconds(900));
+}
+
+TEST(RedisClientTest, BLPopWakesOnPush) {
+    RedisClient client;
+    client.connect();
+    
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        client.rpush("wake_queue", "late_item");
+    });
+    
+    auto item = client.blpop("wake_queue", 5);
+    producer.join();
+    
+    ASSERT_TRUE(item.has_value());
+    EXPECT_EQ(*item, "late_item");
+}
+
+TEST(RedisClientTest, LMoveAndLRemBatch) {
+    RedisClient client;
+    client.connect();
+    
+    for (int i = 0; i < 5; ++i) {
+        client.rpush("src_queue", "item" + std::to_string(i));
+    }
+    
+    auto moved = client.lmove("src_queue", "dst_queue", 3);
+    ASSERT_EQ(moved.size(), 3u);
+    EXPECT_EQ(moved[0], "item0");
+    EXPECT_EQ(client.llen("src_queue"), 2);
+    EXPECT_EQ(client.llen("dst_queue"), 3);
+    
+    // One pass removes each listed value once; unknown values are ignored
+    EXPECT_EQ(client.lrem("dst_queue", {"item2", "item0", "missing"}), 2u);
+    auto left = client.lpop("dst_queue", 10);
+    ASSERT_EQ(left.size(), 1u);
+    EXPECT_EQ(left[0], "item1");
+}
+
+TEST(RedisClientTest, BLMoveWakesOnPush) {
+    RedisClient client;
+    client.connect();
+    
+    EXPECT_FALSE(client.blmove("bl_src", "bl_dst", 1).has_value());
+    
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        client.rpush("bl_src", "late_item");
+    });
+    auto item = client.blmove("bl_src", "bl_dst", 5);
+    producer.join();
+    
+    ASSERT_TRUE(item.has_value());
+    EXPECT_EQ(*item, "late_item");
+    EXPECT_EQ(client.llen("bl_src"), 0);
+    EXPECT_EQ(client.llen("bl_dst"), 1);
+}
+
+TEST(RedisClientTest, SortedSetRangeByScore) {
+    RedisClient client;
+    client.connect();
+    
+    EXPECT_TRUE(client.zadd("leases", "a", 30));
+    EXPECT_TRUE(client.zadd("leases", "b", 10));
+    EXPECT_TRUE(client.zadd("leases", "c", 20));
+    EXPECT_FALSE(client.zadd("leases", "c", 5));  // Update moves it
+    
+    auto due = client.zrangebyscore("leases", 0, 15);
+    ASSERT_EQ(due.size(), 2u);
+    EXPECT_EQ(due[0], "c");
+    EXPECT_EQ(due[1], "b");
+    EXPECT_EQ(client.zrangebyscore("leases", 0, 100, 1).size(), 1u);
+    
+    EXPECT_TRUE(client.zrem("leases", "c"));
+    EXPECT_FALSE(client.zrem("leases", "c"));
+    EXPECT_EQ(client.zrangebyscore("leases", 0, 100).size(), 2u);
+}
+
+TEST(RedisClientTest, SortedSetMovesDueMembersToList) {
+    RedisClient client;
+    client.connect();
+    
+    EXPECT_EQ(client.zadd("retry", {{"late", 300.0}, {"early", 100.0}, {"mid", 200.0}}), 3u);
+    EXPECT_EQ(client.zcard("retry"), 3u);
+    
+    EXPECT_EQ(client.zmove_to_list("retry", "ready", 250.0, 10), 2u);
+    EXPECT_EQ(client.zcard("retry"), 1u);
+    auto ready = client.lrange("ready", 0, -1);
+    ASSERT_EQ(ready.size(), 2u);
+    EXPECT_EQ(ready[0], "early");                                  // Due order
+    EXPECT_EQ(ready[1], "mid");
+    EXPECT_EQ(client.zmove_to_list("retry", "ready", 250.0, 10), 0u);  // Not due yet
+    
+    client.rpush("ready", std::vector<std::string>{"x", "y"});
+    EXPECT_EQ(client.lrange("ready", -2, -1), (std::vector<std::string>{"x", "y"}));
+    EXPECT_EQ(client.lrange("ready", 1, 2), (std::vector<std::string>{"mid", "x"}));
+    
+    client.ltrim("ready", 1, -1);
+    EXPECT_EQ(client.lrange("ready", 0, -1), (std::vector<std::string>{"mid", "x", "y"}));
+    client.ltrim("ready", 5, -1);                                  // Empty range empties the list
+    EXPECT_EQ(client.llen("ready"), 0);
+}
+
+TEST(RedisClientTest, SetAddAndMultiMembership) {
+    RedisClient client;
+    client.connect();
+    
+    EXPECT_EQ(client.sadd("done", {"a", "b", "a"}), 2u);
+    EXPECT_EQ(client.sadd("done", {"b", "c"}), 1u);
+    
+    auto found = client.smismember("done", {"a", "x", "c"});
+    ASSERT_EQ(found.size(), 3u);
+    EXPECT_TRUE(found[0]);
+    EXPECT_FALSE(found[1]);
+    EXPECT_TRUE(found[2]);
+    
+    EXPECT_TRUE(client.del("done"));
+    EXPECT_FALSE(client.smismember("done", {"a"})[0]);
+}
+
+TEST(RedisClientTest, ManyWorkersDrainQueue) {
+    RedisClient client;
+    client.connect();
+    
+    constexpr int kWorkers = 8;
+    constexpr int kItems = 10000;
+    std::atomic<int> consumed{0};
+    
+    std::vector<std::thread> workers;
+    for (int w = 0; w < kWorkers; ++w) {
+        workers.emplace_back([&] {
+            while (client.blpop("shared_queue", 1)) {
+                ++consumed;
+            }
+        });
+    }
+    for (int i = 0; i < kItems; ++i) {
+        client.rpush("shared_queue", "item" + std::to_string(i));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    EXPECT_EQ(consumed.load(), kItems);
+    EXPECT_EQ(client.llen("shared_queue"), 0);
+}
+
+TEST(RedisClientTest, DisconnectWakesBlockedConsumers) {
+    RedisClient client;
+    client.connect();
+    
+    std::atomic<int> woken{0};
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; ++w) {
+        workers.emplace_back([&] {
+            if (!client.blpop("idle_queue")) {  // Timeout 0: wait forever
+                ++woken;
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    client.disconnect();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    EXPECT_EQ(woken.load(), 4);
+    EXPECT_FALSE(client.is_connected());
 }
 
 TEST(RedisClientTest, QueueLength) {
@@ -105,3 +300,19 @@ TEST(RedisClientTest, OperationsWithoutConnect) {
     EXPECT_FALSE(client.rpush("queue", "item"));
     EXPECT_FALSE(client.blpop("queue").has_value());
 }
+
+TEST(RedisClientTest, CarriesBinaryTaskFrames) {
+    RedisClient client;
+    client.connect();
+    
+    // Binary frames contain NUL bytes; values must round-trip byte-for-byte
+    auto task = Task::create("compute", R"({"n": 1})");
+    client.rpush("tasks", task.serialize(WireFormat::BINARY));
+    client.rpush("tasks", task.serialize(WireFormat::JSON));
+    
+    for (int i = 0; i < 2; ++i) {
+        auto popped = client.blpop("tasks", 1);
+        ASSERT_TRUE(popped.has_value());
+        EXPECT_EQ(Task::deserialize(*popped).id, task.id);
+    }
+}
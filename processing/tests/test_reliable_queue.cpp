@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "telemetry_processor/ReliableQueue.h"
+#include "redis_test_client.h"
+#include <chrono>
+#include <thread>
+
+using namespace telemetry_processor;
+using telemetry_processor::testing::connected_client;
+using namespace std::chrono_literals;
+
+namespace {
+
+const std::string kPending = "test:reliable:pending";
+
+ReliableQueue::Options queue_options(std::chrono::milliseconds lease_ttl = 30000ms) {
+    ReliableQueue::Options options;
+    options.pending_key = kPending;
+    options.lease_ttl = lease_ttl;
+    return options;
+}
+
+void push(RedisClient& redis, int count) {
+    for (int i = 0; i < count; ++i) {
+        redis.rpush(kPending, "task-" + std::to_string(i));
+    }
+}
+
+} // namespace
+
+TEST(ReliableQueueTest, ClaimMovesAndAckDeletes) {
+    auto redis = connected_client();
+    push(*redis, 5);
+    ReliableQueue queue(redis, "w1", queue_options());
+
+    auto frames = queue.claim(3);
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[0], "task-0");
+    EXPECT_EQ(redis->llen(kPending), 2);
+    EXPECT_EQ(redis->llen(queue.processing_key()), 3);   // Claimed, not deleted
+    EXPECT_EQ(queue.processing_key(), kPending + ":processing:w1");
+
+    EXPECT_EQ(queue.ack({frames[0], frames[2]}), 2u);
+    EXPECT_EQ(redis->llen(queue.processing_key()), 1);
+
+    // Claiming renewed the lease
+    EXPECT_EQ(redis->zrangebyscore(queue.lease_key(), 0, 1e18).size(), 1u);
+}
+
+TEST(ReliableQueueTest, ClaimWaitsForWork) {
+    auto redis = connected_client();
+    ReliableQueue queue(redis, "w1", queue_options());
+    EXPECT_TRUE(queue.claim(10).empty());   // No timeout: returns at once
+
+    std::thread producer([&] {
+        std::this_thread::sleep_for(50ms);
+        push(*redis, 3);
+    });
+    auto frames = queue.claim(10, 5);
+    producer.join();
+    EXPECT_GE(frames.size(), 1u);
+    EXPECT_EQ(static_cast<long long>(frames.size()), redis->llen(queue.processing_key()));
+}
+
+TEST(ReliableQueueTest, ReleaseRequeuesEverythingClaimed) {
+    auto redis = connected_client();
+    push(*redis, 4);
+    ReliableQueue queue(redis, "w1", queue_options());
+    queue.claim(4);
+
+    EXPECT_EQ(queue.release(), 4u);
+    EXPECT_EQ(redis->llen(kPending), 4);
+    EXPECT_EQ(redis->llen(queue.processing_key()), 0);
+    EXPECT_TRUE(redis->zrangebyscore(queue.lease_key(), 0, 1e18).empty());
+}
+
+TEST(ReliableQueueTest, ReapRequeuesOnlyExpiredLeases) {
+    auto redis = connected_client();
+    push(*redis, 3);
+    ReliableQueue dead(redis, "dead", queue_options(50ms));
+    ReliableQueue alive(redis, "alive", queue_options());
+    ReliableQueue reaper(redis, "reaper", queue_options());
+
+    auto lost = dead.claim(2);
+    alive.claim(1);
+    std::this_thread::sleep_for(80ms);   // dead never heartbeats again
+
+    EXPECT_EQ(reaper.reap(), 2u);
+    EXPECT_EQ(reaper.reap(), 0u);        // Lease already gone
+    EXPECT_EQ(redis->llen(kPending), 2);
+    EXPECT_EQ(redis->llen(alive.processing_key()), 1);
+
+    EXPECT_EQ(dead.ack(lost), 0u);       // Late ack of reaped tasks is a no-op
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "telemetry_processor/RetryScheduler.h"
+#include "redis_test_client.h"
+#include <chrono>
+#include <thread>
+
+using namespace telemetry_processor;
+using telemetry_processor::testing::connected_client;
+using namespace std::chrono_literals;
+
+namespace {
+
+const std::string kPending = "test:retry:pending";
+
+RetryScheduler::Options scheduler_options(std::chrono::milliseconds base_delay) {
+    RetryScheduler::Options options;
+    options.pending_key = kPending;
+    options.base_delay = base_delay;
+    options.max_delay = base_delay * 100;
+    options.jitter = 0.0;
+    return options;
+}
+
+Task task_with_retries(int retry_count, int max_retries = 3) {
+    Task task = Task::create("poison", R"({"device_id": "d1"})", Priority::NORMAL, max_retries);
+    task.retry_count = retry_count;
+    return task;
+}
+
+} // namespace
+
+TEST(RetrySchedulerTest, BackoffIsExponentialJitteredAndCapped) {
+    auto redis = connected_client();
+    RetryScheduler::Options options;
+    options.base_delay = 100ms;
+    options.max_delay = 1000ms;
+    options.jitter = 0.5;
+    RetryScheduler scheduler(redis, options);
+
+    for (int i = 0; i < 50; ++i) {
+        const auto first = scheduler.backoff(1);
+        EXPECT_GE(first, 50ms);
+        EXPECT_LE(first, 100ms);
+        const auto third = scheduler.backoff(3);
+        EXPECT_GE(third, 200ms);
+        EXPECT_LE(third, 400ms);
+        const auto capped = scheduler.backoff(20);
+        EXPECT_GE(capped, 500ms);
+        EXPECT_LE(capped, 1000ms);
+    }
+
+    options.jitter = 0.0;
+    RetryScheduler exact(redis, options);
+    EXPECT_EQ(exact.backoff(2), 200ms);
+}
+
+TEST(RetrySchedulerTest, FailSchedulesOrParks) {
+    auto redis = connected_client();
+    RetryScheduler scheduler(redis, scheduler_options(60000ms));
+
+    std::vector<RetryScheduler::Failure> failures;
+    failures.push_back({task_with_retries(0), "timeout", false});
+    failures.push_back({task_with_retries(3), "timeout again", false});   // Budget spent
+    failures.push_back({task_with_retries(0), "no handler", true});       // Permanent
+    auto outcome = scheduler.fail(std::move(failures));
+
+    EXPECT_EQ(outcome.scheduled, 1u);
+    EXPECT_EQ(outcome.dead, 2u);
+    EXPECT_EQ(scheduler.scheduled(), 1u);
+    EXPECT_EQ(scheduler.promote_due(), 0u);                               // Not due for a minute
+
+    auto retry = Task::deserialize(redis->zrangebyscore(scheduler.retry_key(), 0, 1e18).at(0));
+    EXPECT_EQ(retry.retry_count, 1);
+    EXPECT_EQ(retry.status, TaskStatus::PENDING);
+
+    auto dead = scheduler.dead_letters().peek(0, 10);
+    ASSERT_EQ(dead.size(), 2u);
+    EXPECT_EQ(dead[0].error, "timeout again");
+    EXPECT_EQ(dead[1].error, "no handler");
+    EXPECT_EQ(dead[0].task.status, TaskStatus::FAILED);
+    EXPECT_FALSE(dead[0].dead_at.empty());
+}
+
+TEST(RetrySchedulerTest, PromoteMovesDueRetriesInBatches) {
+    auto redis = connected_client();
+    auto options = scheduler_options(1ms);
+    options.promote_batch = 4;
+    RetryScheduler scheduler(redis, options);
+
+    std::vector<RetryScheduler::Failure> failures;
+    for (int i = 0; i < 10; ++i) {
+        failures.push_back({task_with_retries(0), "flaky", false});
+    }
+    scheduler.fail(std::move(failures));
+    std::this_thread::sleep_for(20ms);
+
+    EXPECT_EQ(scheduler.promote_due(), 4u);
+    EXPECT_EQ(scheduler.promote_due(), 4u);
+    EXPECT_EQ(scheduler.promote_due(), 2u);
+    EXPECT_EQ(scheduler.scheduled(), 0u);
+    EXPECT_EQ(redis->llen(kPending), 10);
+}
+
+TEST(RetrySchedulerTest, DeadLettersReplayWithFreshBudget) {
+    auto redis = connected_client();
+    DeadLetterQueue dlq(redis, kPending + ":dead", kPending);
+    dlq.park({task_with_retries(3), task_with_retries(3), task_with_retries(3)}, {"a", "b", "c"});
+    EXPECT_EQ(dlq.size(), 3u);
+
+    EXPECT_EQ(dlq.replay(2), 2u);
+    EXPECT_EQ(dlq.size(), 1u);
+    auto replayed = Task::deserialize(*redis->blpop(kPending, 1));
+    EXPECT_EQ(replayed.retry_count, 0);
+    EXPECT_EQ(replayed.status, TaskStatus::PENDING);
+    EXPECT_EQ(dlq.peek(0, 10).at(0).error, "c");   // Oldest first: c is what is left
+
+    redis->rpush(kPending + ":dead", "not an envelope");
+    EXPECT_EQ(dlq.replay(10), 1u);                  // Unreadable entry dropped, not replayed
+    EXPECT_EQ(dlq.size(), 0u);                      // ... but trimmed with the rest
+
+    dlq.park({task_with_retries(3)}, {"d"});
+    EXPECT_EQ(dlq.purge(), 1u);
+    EXPECT_EQ(dlq.size(), 0u);
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "telemetry_processor/StorageWriter.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace telemetry_processor;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Records every batch; optionally fails the first N loads or blocks until opened
+class RecordingBackend : public StorageBackend {
+public:
+    explicit RecordingBackend(int failures = 0, bool gated = false)
+        : failures_(failures), gate_open_(!gated) {}
+
+    bool connect() override { return true; }
+
+    bool copy_rows(const std::string&, const std::vector<std::string>&,
+                   const std::string& data, size_t rows) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return gate_open_; });
+        if (failures_ != 0) {
+            --failures_;
+            return false;
+        }
+        batches_.push_back(data);
+        batch_rows_.push_back(rows);
+        cv_.notify_all();
+        return true;
+    }
+
+    void open_gate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        gate_open_ = true;
+        cv_.notify_all();
+    }
+
+    bool wait_for_batches(size_t count, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&] { return batches_.size() >= count; });
+    }
+
+    std::vector<size_t> batch_rows() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batch_rows_;
+    }
+
+    std::vector<std::string> batches() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batches_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int failures_;
+    bool gate_open_;
+    std::vector<std::string> batches_;
+    std::vector<size_t> batch_rows_;
+};
+
+TelemetryRow make_row(const std::string& device, double temperature) {
+    TelemetryRow row;
+    row.device_id = device;
+    row.timestamp = "2025-12-26T10:00:00Z";
+    row.temperature = temperature;
+    return row;
+}
+
+StorageWriter::Options small_batches(size_t rows) {
+    StorageWriter::Options options;
+    options.max_batch_rows = rows;
+    options.flush_interval = 10s;  // Size-driven unless a test says otherwise
+    options.retry_backoff = 1ms;
+    return options;
+}
+
+} // namespace
+
+TEST(StorageWriterTest, EncodesCopyTextWithNullsAndEscapes) {
+    TelemetryRow row = make_row("dev\t1", 21.5);
+    row.voltage = 3.3;
+    row.raw_data = "{\"note\": \"a\\\\b\"}";
+
+    std::string line;
+    StorageWriter::encode_row(row, line);
+    EXPECT_EQ(line, "dev\\t1\t2025-12-26T10:00:00Z\t21.5\t\\N\t\\N\t3.3\t\\N\t{\"note\": \"a\\\\\\\\b\"}\n");
+    EXPECT_EQ(StorageWriter::columns().size(), 8u);
+
+    TelemetryRow untimed;
+    std::string now;
+    StorageWriter::encode_row(untimed, now);
+    EXPECT_EQ(now.find('\t', 1) - 1, 24u);  // "YYYY-MM-DDTHH:MM:SS.mmmZ" filled in
+}
+
+TEST(StorageWriterTest, SealsBatchesBySizeAndFlushesRemainder) {
+    auto backend = std::make_shared<RecordingBackend>();
+    StorageWriter writer(backend, small_batches(3));
+
+    for (int i = 0; i < 7; ++i) {
+        ASSERT_EQ(writer.write(make_row("d1", i)), StorageWriter::WriteStatus::ACCEPTED);
+    }
+    ASSERT_TRUE(backend->wait_for_batches(2, 2s));
+    writer.flush();
+
+    EXPECT_EQ(backend->batch_rows(), (std::vector<size_t>{3, 3, 1}));
+    auto stats = writer.stats();
+    EXPECT_EQ(stats.rows_written, 7u);
+    EXPECT_EQ(stats.batches_written, 3u);
+    EXPECT_EQ(stats.buffered_rows, 0u);
+}
+
+TEST(StorageWriterTest, FlushesPartialBatchByAge) {
+    auto backend = std::make_shared<RecordingBackend>();
+    auto options = small_batches(1000);
+    options.flush_interval = 20ms;
+    StorageWriter writer(backend, options);
+
+    writer.write(make_row("d1", 1.0));
+    EXPECT_TRUE(backend->wait_for_batches(1, 2s));  // No flush() call
+}
+
+TEST(StorageWriterTest, ReportsBackpressureWhenWindowIsFull) {
+    auto backend = std::make_shared<RecordingBackend>(0, true);  // Loads block until opened
+    auto options = small_batches(1);
+    options.max_in_flight = 2;
+    StorageWriter writer(backend, options);
+
+    using Status = StorageWriter::WriteStatus;
+    EXPECT_EQ(writer.write(make_row("d1", 1)), Status::ACCEPTED);  // Sealed, loading (blocked)
+    EXPECT_EQ(writer.write(make_row("d1", 2)), Status::ACCEPTED);  // Sealed, queued
+    EXPECT_EQ(writer.write(make_row("d1", 3)), Status::ACCEPTED);  // Open batch, full
+    EXPECT_EQ(writer.write(make_row("d1", 4)), Status::BACKPRESSURE);
+    EXPECT_EQ(writer.stats().rows_rejected, 1u);
+    EXPECT_EQ(writer.stats().buffered_rows, 3u);
+
+    std::thread release([&] {
+        std::this_thread::sleep_for(20ms);
+        backend->open_gate();
+    });
+    EXPECT_EQ(writer.write(make_row("d1", 4), 5s), Status::ACCEPTED);  // Waits for room
+    release.join();
+    writer.flush();
+    EXPECT_EQ(writer.stats().rows_written, 4u);
+}
+
+TEST(StorageWriterTest, RetriesFailedLoadsThenDrops) {
+    auto flaky = std::make_shared<RecordingBackend>(2);
+    {
+        StorageWriter writer(flaky, small_batches(10));
+        writer.write({make_row("d1", 1), make_row("d2", 2)});
+        writer.flush();
+        EXPECT_EQ(writer.stats().rows_written, 2u);
+        EXPECT_EQ(writer.stats().retries, 2u);
+    }
+
+    auto broken = std::make_shared<RecordingBackend>(-1);  // Never succeeds
+    auto options = small_batches(10);
+    options.max_retries = 1;
+    StorageWriter writer(broken, options);
+    writer.write(make_row("d1", 1));
+    writer.flush();  // Returns once the batch is given up
+    EXPECT_EQ(writer.stats().rows_failed, 1u);
+    EXPECT_EQ(writer.stats().rows_written, 0u);
+}
+
+TEST(StorageWriterTest, FileBackendAppendsCopyText) {
+    const std::string path = ::testing::TempDir() + "storage_writer_test.copy";
+    std::remove(path.c_str());
+    {
+        StorageWriter writer(std::make_shared<FileStorageBackend>(path), small_batches(2));
+        writer.write({make_row("d1", 1), make_row("d2", 2), make_row("d3", 3)});
+    }  // Destructor flushes
+
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const std::string text = contents.str();
+    EXPECT_EQ(std::count(text.begin(), text.end(), '\n'), 3);
+    EXPECT_NE(text.find("d3\t2025-12-26T10:00:00Z\t3\t"), std::string::npos);
+    std::remove(path.c_str());
+}
@@ -87,3 +87,67 @@ TEST(TaskTest, RoundTripSerialization) {
     EXPECT_EQ(original.max_retries, restored.max_retries);
     EXPECT_EQ(original.worker_id, restored.worker_id);
 }
+
+TEST(TaskTest, BinaryRoundTrip) {
+    auto original = Task::create("io", R"({"file": "data.txt"})", Priority::LOW, 2);
+    original.status = TaskStatus::RUNNING;
+    original.retry_count = 1;
+    original.worker_id = "worker-001";
+    
+    auto bytes = original.to_binary();
+    EXPECT_EQ(detect_wire_format(bytes), WireFormat::BINARY);
+    EXPECT_LT(bytes.size(), original.to_json().dump().size());
+    
+    auto restored = Task::from_binary(bytes);
+    EXPECT_EQ(original.id, restored.id);
+    EXPECT_EQ(original.type, restored.type);
+    EXPECT_EQ(original.payload.raw(), restored.payload.raw());
+    EXPECT_FALSE(restored.payload.is_parsed());
+    EXPECT_EQ(original.priority, restored.priority);
+    EXPECT_EQ(original.status, restored.status);
+    EXPECT_EQ(original.retry_count, restored.retry_count);
+    EXPECT_EQ(original.max_retries, restored.max_retries);
+    EXPECT_EQ(original.worker_id, restored.worker_id);
+    // Sub-second precision survives (JSON keeps whole seconds only)
+    EXPECT_EQ(original.created_at, restored.created_at);
+    EXPECT_EQ(original.updated_at, restored.updated_at);
+}
+
+TEST(TaskTest, DeserializeDetectsFormat) {
+    auto task = Task::create("compute", R"({"n": 1})", Priority::HIGH);
+    
+    auto json_bytes = task.serialize(WireFormat::JSON);
+    EXPECT_EQ(detect_wire_format(json_bytes), WireFormat::JSON);
+    EXPECT_EQ(Task::deserialize(json_bytes).id, task.id);
+    EXPECT_EQ(Task::deserialize(task.serialize()).id, task.id);
+}
+
+TEST(TaskTest, MalformedBinaryFrameThrows) {
+    auto bytes = Task::create("compute", R"({"n": 1})").to_binary();
+    
+    EXPECT_THROW(Task::from_binary(bytes.substr(0, bytes.size() - 1)), std::invalid_argument);
+    EXPECT_THROW(Task::from_binary(bytes.substr(0, 10)), std::invalid_argument);
+    EXPECT_THROW(Task::from_binary(R"({"id": "x"})"), std::invalid_argument);
+    
+    bytes[2] = static_cast<char>(Task::kBinaryVersion + 0x10);  // Next major version
+    EXPECT_THROW(Task::from_binary(bytes), std::invalid_argument);
+}
+
+TEST(TaskTest, NewerMinorVersionHeaderFieldsAreSkipped) {
+    auto original = Task::create("io", R"({"file": "data.txt"})", Priority::HIGH, 4);
+    original.worker_id = "worker-002";
+    auto bytes = original.to_binary();
+
+    // A newer minor writer appends 8 header bytes before the variable fields
+    const auto header_size = static_cast<uint8_t>(bytes[3]);
+    bytes.insert(header_size, std::string(8, '\x7f'));
+    bytes[3] = static_cast<char>(header_size + 8);
+    bytes[2] = static_cast<char>(Task::kBinaryVersion + 1);
+
+    auto restored = Task::from_binary(bytes);
+    EXPECT_EQ(restored.id, original.id);
+    EXPECT_EQ(restored.type, original.type);
+    EXPECT_EQ(restored.worker_id, original.worker_id);
+    EXPECT_EQ(restored.payload.raw(), original.payload.raw());
+    EXPECT_EQ(restored.max_retries, 4);
+}
@@ -0,0 +1,338 @@
+#include <gtest/gtest.h>
+#include "telemetry_processor/TelemetryHandler.h"
+
+using namespace telemetry_processor;
+
+namespace {
+
+Task telemetry_task(const std::string& type, const std::string& payload) {
+    return Task::create(type, payload);
+}
+
+// Collects the COPY batches the handler's storage writer loads
+class CollectingBackend : public StorageBackend {
+public:
+    bool connect() override { return true; }
+    bool copy_rows(const std::string& table, const std::vector<std::string>&,
+                   const std::string& data, size_t rows) override {
+        batches.push_back(rows);
+        tables.push_back(table);
+        text += data;
+        return true;
+    }
+
+    std::vector<size_t> batches;  // Written by the flush threads; read after flush_storage()
+    std::vector<std::string> tables;
+    std::string text;
+};
+
+class CollectingTransport : public AlertTransport {
+public:
+    bool send(const std::vector<Alert>& batch) override {
+        alerts.insert(alerts.end(), batch.begin(), batch.end());
+        return true;
+    }
+
+    std::vector<Alert> alerts;  // Written by the dispatch thread; read after flush_alerts()
+};
+
+} // namespace
+
+TEST(TelemetryHandlerTest, InternTaskType) {
+    using Kind = TelemetryHandler::TaskKind;
+    EXPECT_EQ(TelemetryHandler::intern_task_type("telemetry.analyze"), Kind::ANALYZE);
+    EXPECT_EQ(TelemetryHandler::intern_task_type("telemetry.store"), Kind::STORE);
+    EXPECT_EQ(TelemetryHandler::intern_task_type("compute"), Kind::UNKNOWN);
+    EXPECT_EQ(TelemetryHandler::task_type_name(Kind::ALERT), "telemetry.alert");
+}
+
+TEST(TelemetryHandlerTest, AnalyzeTracksPerDeviceStatistics) {
+    TelemetryHandler handler;
+    handler.process(telemetry_task("telemetry.analyze", R"({"device_id": "d1", "temperature": 20})"));
+    auto result = handler.process(telemetry_task("telemetry.analyze",
+        R"({"device_id": "d1", "temperature": 30, "nested": {"temperature": 999}})"));
+
+    ASSERT_TRUE(result.success);
+    EXPECT_DOUBLE_EQ(result.metrics["temperature"], 30.0);  // Nested field ignored
+    EXPECT_DOUBLE_EQ(result.metrics["temperature_mean"], 25.0);
+    EXPECT_DOUBLE_EQ(result.metrics["temperature_delta"], 10.0);
+    EXPECT_EQ(result.metrics.count("humidity"), 0u);  // Absent, not zero
+}
+
+TEST(TelemetryHandlerTest, AnomalyDetectUsesThresholds) {
+    TelemetryHandler::Config config;
+    config.temp_high_threshold = 50.0;
+    TelemetryHandler handler(config);
+
+    auto hot = handler.process(telemetry_task("telemetry.anomaly_detect", R"({"device_id": "d1", "temperature": 75.0})"));
+    auto ok = handler.process(telemetry_task("telemetry.anomaly_detect", R"({"device_id": "d1", "temperature": 21.0})"));
+    auto sparse = handler.process(telemetry_task("telemetry.anomaly_detect", R"({"device_id": "d1"})"));
+
+    EXPECT_DOUBLE_EQ(hot.metrics["anomaly"], 1.0);
+    EXPECT_DOUBLE_EQ(ok.metrics["anomaly"], 0.0);
+    EXPECT_DOUBLE_EQ(sparse.metrics["anomaly"], 0.0);  // Missing voltage is not "below 2.8 V"
+    EXPECT_EQ(handler.get_stats().anomalies_detected, 1u);
+    handler.flush_alerts();  // Alerts are delivered asynchronously
+    EXPECT_EQ(handler.get_stats().alerts_sent, 1u);
+}
+
+TEST(TelemetryHandlerTest, InvalidPayloadAndUnknownTypeFail) {
+    TelemetryHandler handler;
+    EXPECT_FALSE(handler.process(telemetry_task("telemetry.analyze", "{broken")).success);
+    EXPECT_FALSE(handler.process(telemetry_task("telemetry.analyze", "[1, 2]")).success);
+    EXPECT_FALSE(handler.process(telemetry_task("compute", R"({"device_id": "d1"})")).success);
+
+    auto stats = handler.get_stats();
+    EXPECT_EQ(stats.tasks_processed, 3u);
+    EXPECT_EQ(stats.tasks_failed, 3u);
+    EXPECT_EQ(stats.task_type_counts["compute"], 1u);
+}
+
+TEST(TelemetryHandlerTest, BatchMatchesSingleTaskResults) {
+    std::vector<Task> tasks;
+    for (int i = 0; i < 6; ++i) {
+        const char* type = i < 4 ? "telemetry.aggregate" : "telemetry.store";
+        tasks.push_back(telemetry_task(type,
+            R"({"device_id": "d1", "temperature": )" + std::to_string(10 * (i + 1)) + "}"));
+    }
+    tasks.push_back(telemetry_task("telemetry.store", "not json"));
+
+    TelemetryHandler batched;
+    auto results = batched.process_batch(tasks);
+    TelemetryHandler single;
+
+    ASSERT_EQ(results.size(), tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        auto expected = single.process(tasks[i]);
+        EXPECT_EQ(results[i].success, expected.success) << i;
+        EXPECT_EQ(results[i].message, expected.message) << i;
+    }
+    EXPECT_DOUBLE_EQ(results[3].metrics["late"], 0.0);
+
+    auto stats = batched.get_stats();
+    EXPECT_EQ(stats.task_type_counts["telemetry.aggregate"], 4u);
+    EXPECT_EQ(stats.task_type_counts["telemetry.store"], 3u);
+    EXPECT_EQ(stats.tasks_failed, 1u);
+
+    batched.reset_stats();
+    EXPECT_EQ(batched.get_stats().tasks_processed, 0u);
+}
+
+TEST(TelemetryHandlerTest, DomPayloadReadWithoutReparse) {
+    TelemetryHandler handler;
+    auto task = Task::create("telemetry.analyze", nlohmann::json{{"device_id", "d2"}, {"humidity", 40.5}});
+
+    auto result = handler.process(task);
+    ASSERT_TRUE(result.success);
+    EXPECT_DOUBLE_EQ(result.metrics["humidity"], 40.5);
+}
+
+TEST(TelemetryHandlerTest, DomAndRawPayloadsAgreeOnNonStringFields) {
+    const nlohmann::json doc{{"device_id", 42}, {"timestamp", 1700000000}, {"temperature", 21.5}};
+    TelemetryHandler dom_handler;
+    TelemetryHandler raw_handler;
+
+    for (const char* type : {"telemetry.analyze", "telemetry.aggregate", "telemetry.store"}) {
+        TelemetryHandler::ProcessResult dom, raw;
+        ASSERT_NO_THROW(dom = dom_handler.process(Task::create(type, doc))) << type;
+        raw = raw_handler.process(Task::create(type, doc.dump()));
+        EXPECT_EQ(dom.success, raw.success) << type;
+        EXPECT_EQ(dom.message, raw.message) << type;
+        EXPECT_EQ(dom.metrics, raw.metrics) << type;
+    }
+}
+
+TEST(TelemetryHandlerTest, AggregateEmitsClosedEventTimeWindows) {
+    TelemetryHandler::Config config;
+    config.aggregation_window_sec = 60;
+    config.aggregation_lateness_sec = 5;
+    config.rollup_table.clear();  // Keep closed windows for take_closed_windows()
+    TelemetryHandler handler(config);
+
+    auto sample = [](const char* ts, double temp) {
+        return telemetry_task("telemetry.aggregate",
+            std::string(R"({"device_id": "d1", "timestamp": ")") + ts +
+            R"(", "temperature": )" + std::to_string(temp) + "}");
+    };
+    handler.process_batch({
+        sample("2025-12-26T10:00:10Z", 20.0),
+        sample("2025-12-26T10:00:50Z", 30.0),
+        sample("2025-12-26T10:00:30Z", 25.0),   // Out of order, same window
+        sample("2025-12-26T10:01:04Z", 40.0),   // Watermark 10:00:59 - window still open
+    });
+    EXPECT_TRUE(handler.take_closed_windows().empty());
+
+    auto result = handler.process(sample("2025-12-26T10:01:06Z", 41.0));  // Watermark passes 10:01:00
+    EXPECT_DOUBLE_EQ(result.metrics["windows_closed"], 1.0);
+    auto late = handler.process(sample("2025-12-26T10:00:59.500Z", 99.0));
+    EXPECT_DOUBLE_EQ(late.metrics["late"], 1.0);
+
+    auto closed = handler.take_closed_windows();
+    ASSERT_EQ(closed.size(), 1u);
+    EXPECT_EQ(closed[0].device_id, "d1");
+    EXPECT_EQ(closed[0].end_ms - closed[0].start_ms, 60000);
+    EXPECT_EQ(closed[0].sample_count, 3u);
+    EXPECT_DOUBLE_EQ(closed[0].metrics[0].mean(), 25.0);  // temperature
+    EXPECT_DOUBLE_EQ(closed[0].metrics[0].last, 30.0);    // Latest event time, not arrival
+    EXPECT_EQ(closed[0].metrics[1].count, 0u);            // humidity never reported
+
+    EXPECT_EQ(handler.take_closed_windows(true).size(), 1u);  // Flush the open 10:01 window
+}
+
+TEST(TelemetryHandlerTest, AggregateStoresClosedWindowsAsRollups) {
+    TelemetryHandler::Config config;
+    config.aggregation_window_sec = 60;
+    config.aggregation_lateness_sec = 0;
+    auto backend = std::make_shared<CollectingBackend>();
+    {
+        TelemetryHandler handler(config, backend);
+        auto sample = [](const char* device, const char* ts, double temp) {
+            return telemetry_task("telemetry.aggregate",
+                std::string(R"({"device_id": ")") + device + R"(", "timestamp": ")" + ts +
+                R"(", "temperature": )" + std::to_string(temp) + "}");
+        };
+        handler.process_batch({
+            sample("d1", "2025-12-26T10:00:10Z", 20.0),
+            sample("d1", "2025-12-26T10:00:50Z", 30.0),
+            sample("d2", "2025-12-26T10:00:20Z", 5.0),
+            sample("d1", "2025-12-26T10:01:00Z", 40.0),   // Closes 10:00 for both devices
+        });
+        handler.flush_storage();
+
+        ASSERT_EQ(backend->tables, std::vector<std::string>{"telemetry_rollups"});
+        EXPECT_EQ(backend->batches, std::vector<size_t>{2});   // Both windows in one load
+        EXPECT_NE(backend->text.find("d1\t2025-12-26T10:00:00.000Z\t25\t\\N"), std::string::npos);
+        EXPECT_NE(backend->text.find(R"("samples":2)"), std::string::npos);
+        EXPECT_TRUE(handler.take_closed_windows().empty());   // Nothing left behind
+        EXPECT_EQ(handler.get_stats().rollups_stored, 2u);
+    }
+    // Destruction stores the still-open 10:01 window too
+    EXPECT_EQ(backend->batches.size(), 2u);
+    EXPECT_NE(backend->text.find("d1\t2025-12-26T10:01:00.000Z\t40"), std::string::npos);
+}
+
+TEST(TelemetryHandlerTest, ClosedWindowsWithoutRollupTableAreBounded) {
+    TelemetryHandler::Config config;
+    config.aggregation_window_sec = 1;
+    config.aggregation_lateness_sec = 0;
+    config.rollup_table.clear();
+    config.rollup_pending_limit = 3;
+    TelemetryHandler handler(config);
+
+    std::vector<Task> tasks;
+    for (int second = 0; second < 6; ++second) {
+        tasks.push_back(telemetry_task("telemetry.aggregate",
+            R"({"device_id": "d1", "timestamp": "2025-12-26T10:00:0)" + std::to_string(second) +
+            R"(Z", "temperature": 1})"));
+    }
+    handler.process_batch(tasks);   // Closes 5 windows, keeps the newest 3
+
+    auto kept = handler.take_closed_windows();
+    ASSERT_EQ(kept.size(), 3u);
+    EXPECT_EQ(kept.back().end_ms - kept.front().end_ms, 2000);
+    EXPECT_EQ(handler.get_stats().windows_dropped, 2u);
+}
+
+TEST(TelemetryHandlerTest, BatchAnomalyFlagsAndStatisticalDetectors) {
+    TelemetryHandler::Config config;
+    config.zscore_threshold = 3.0;
+    config.zscore_window = 20;
+    TelemetryHandler handler(config);
+
+    std::vector<Task> tasks;
+    for (int i = 0; i < 30; ++i) {
+        const double temp = 20.0 + (i % 3) * 0.1;
+        tasks.push_back(telemetry_task("telemetry.anomaly_detect",
+            R"({"device_id": "d1", "voltage": 3.3, "temperature": )" + std::to_string(temp) + "}"));
+    }
+    tasks.push_back(telemetry_task("telemetry.anomaly_detect", R"({"device_id": "d1", "temperature": 45.0})"));
+    tasks.push_back(telemetry_task("telemetry.anomaly_detect", R"({"device_id": "d2", "voltage": 2.5, "current": 2.5})"));
+
+    auto results = handler.process_batch(tasks);
+    for (size_t i = 0; i < 30; ++i) {
+        EXPECT_DOUBLE_EQ(results[i].metrics["anomaly"], 0.0) << i;
+    }
+    EXPECT_EQ(static_cast<int>(results[30].metrics["anomaly_flags"]), ANOMALY_ZSCORE);  // Below the 80 C limit
+    EXPECT_EQ(static_cast<int>(results[31].metrics["anomaly_flags"]), ANOMALY_VOLTAGE_LOW | ANOMALY_CURRENT_HIGH);
+    EXPECT_EQ(results[31].message, "Anomaly detected: voltage low, current high");
+    EXPECT_EQ(handler.get_stats().anomalies_detected, 2u);
+}
+
+TEST(TelemetryHandlerTest, StoreCoalescesBatchesIntoBulkLoads) {
+    TelemetryHandler::Config config;
+    config.storage_batch_rows = 4;
+    config.storage_flush_ms = 10000;  // Size-driven in this test
+    auto backend = std::make_shared<CollectingBackend>();
+    TelemetryHandler handler(config, backend);
+
+    std::vector<Task> tasks;
+    for (int i = 0; i < 3; ++i) {
+        tasks.push_back(telemetry_task("telemetry.store",
+            R"({"device_id": "d1", "timestamp": "2025-12-26T10:00:0)" + std::to_string(i) +
+            R"(Z", "temperature": 20.5})"));
+    }
+    tasks.push_back(telemetry_task("telemetry.store", "not json"));
+    auto results = handler.process_batch(tasks);
+    auto single = handler.process(telemetry_task("telemetry.store", R"({"device_id": "d2"})"));
+
+    ASSERT_TRUE(results[0].success);
+    EXPECT_EQ(results[0].message, "Queued for storage");
+    EXPECT_DOUBLE_EQ(results[0].metrics["rows_in_batch"], 3.0);
+    EXPECT_FALSE(results[3].success);
+    EXPECT_TRUE(single.success);
+
+    handler.flush_storage();
+    EXPECT_EQ(backend->batches, (std::vector<size_t>{4}));  // 3 + 1 rows, one load
+    EXPECT_NE(backend->text.find("d1\t2025-12-26T10:00:02.000Z\t20.5\t\\N"), std::string::npos);
+    EXPECT_EQ(handler.get_stats().rows_stored, 4u);
+}
+
+TEST(TelemetryHandlerTest, StoreNormalizesDeviceTimestamps) {
+    auto backend = std::make_shared<CollectingBackend>();
+    TelemetryHandler handler(TelemetryHandler::Config{}, backend);
+
+    auto results = handler.process_batch({
+        telemetry_task("telemetry.store", R"({"device_id": "ok", "timestamp": "2025-12-26T11:30:00+01:00"})"),
+        telemetry_task("telemetry.store", R"({"device_id": "bad", "timestamp": "yesterday'; DROP"})"),
+        telemetry_task("telemetry.store", R"({"device_id": "num", "timestamp": 1735209000})"),
+    });
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.success);  // A bad clock never fails the row
+    }
+
+    handler.flush_storage();
+    EXPECT_EQ(backend->batches, (std::vector<size_t>{3}));
+    EXPECT_NE(backend->text.find("ok\t2025-12-26T10:30:00.000Z\t"), std::string::npos);  // UTC, one format
+    EXPECT_EQ(backend->text.find("bad\tyesterday"), std::string::npos);  // Only in raw_data
+    EXPECT_NE(backend->text.find("bad\t20"), std::string::npos);        // Write time instead
+    EXPECT_NE(backend->text.find("num\t20"), std::string::npos);
+}
+
+TEST(TelemetryHandlerTest, AnomalyStormBecomesOneAlertPerDeviceAndReason) {
+    auto transport = std::make_shared<CollectingTransport>();
+    TelemetryHandler handler(TelemetryHandler::Config{}, nullptr, transport);
+
+    std::vector<Task> storm;
+    for (int i = 0; i < 50; ++i) {
+        storm.push_back(telemetry_task("telemetry.anomaly_detect", R"({"device_id": "d1", "temperature": 95.0})"));
+    }
+    storm.push_back(telemetry_task("telemetry.anomaly_detect", R"({"device_id": "d2", "voltage": 2.0})"));
+    handler.process_batch(storm);
+    auto explicit_alert = handler.process(telemetry_task("telemetry.alert", R"({"device_id": "d3"})"));
+    EXPECT_EQ(explicit_alert.message, "Alert queued");
+    handler.flush_alerts();
+
+    ASSERT_EQ(transport->alerts.size(), 3u);
+    EXPECT_EQ(transport->alerts[0].device_id, "d1");
+    EXPECT_EQ(transport->alerts[0].reason, "temperature high");
+    EXPECT_EQ(transport->alerts[0].severity, "critical");
+    EXPECT_EQ(transport->alerts[0].duplicates, 49u);
+    EXPECT_EQ(transport->alerts[1].reason, "voltage low");
+
+    auto stats = handler.get_stats();
+    EXPECT_EQ(stats.anomalies_detected, 51u);
+    EXPECT_EQ(stats.alerts_sent, 3u);
+    EXPECT_EQ(stats.alerts_suppressed, 49u);
+    EXPECT_EQ(handler.process(telemetry_task("telemetry.alert", R"({"device_id": "d3"})")).message,
+              "Alert suppressed");
+}
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include "telemetry_processor/Timestamp.h"
+
+using namespace telemetry_processor;
+
+TEST(TimestampTest, ParsesUtcAndOffsets) {
+    EXPECT_EQ(parse_iso8601_ms("1970-01-01T00:00:00Z"), 0);
+    EXPECT_EQ(parse_iso8601_ms("2025-12-26T10:30:00Z"), 1766745000000);
+    EXPECT_EQ(parse_iso8601_ms("2025-12-26T11:30:00.123+01:00"), 1766745000123);
+    EXPECT_EQ(parse_iso8601_ms("2025-12-26 10:30:00"), 1766745000000);   // RFC 3339 space
+    EXPECT_FALSE(parse_iso8601_ms("2025-13-01T00:00:00Z").has_value());
+    EXPECT_FALSE(parse_iso8601_ms("yesterday").has_value());
+}
+
+TEST(TimestampTest, FormatsWithMilliseconds) {
+    EXPECT_EQ(format_iso8601_ms(0), "1970-01-01T00:00:00.000Z");
+    EXPECT_EQ(format_iso8601_ms(1766745000123), "2025-12-26T10:30:00.123Z");
+    EXPECT_EQ(format_iso8601_ms(951782400000), "2000-02-29T00:00:00.000Z");  // Leap day
+    EXPECT_EQ(format_iso8601_ms(-1), "1969-12-31T23:59:59.999Z");           // Before the epoch
+}
+
+TEST(TimestampTest, FormatAndParseRoundTrip) {
+    for (int64_t ms = -86400000LL * 800; ms < 86400000LL * 40000; ms += 86400000LL * 7 + 3600123) {
+        EXPECT_EQ(parse_iso8601_ms(format_iso8601_ms(ms)), ms) << ms;
+    }
+    const auto now = parse_iso8601_ms(now_iso8601());
+    ASSERT_TRUE(now.has_value());
+    EXPECT_GT(*now, 1700000000000);
+}
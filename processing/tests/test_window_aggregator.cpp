@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "telemetry_processor/WindowAggregator.h"
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace telemetry_processor;
+
+namespace {
+
+WindowAggregator::Options options(int64_t window_ms, int64_t slide_ms, int64_t lateness_ms) {
+    WindowAggregator::Options opts;
+    opts.window_ms = window_ms;
+    opts.slide_ms = slide_ms;
+    opts.max_lateness_ms = lateness_ms;
+    opts.metric_names = {"temperature", "humidity"};
+    return opts;
+}
+
+} // namespace
+
+TEST(WindowAggregatorTest, TumblingWindowsCloseOnWatermark) {
+    WindowAggregator agg(options(1000, 0, 0));
+    const double a[] = {10.0, 50.0};
+    const double b[] = {30.0, NAN};
+    const double c[] = {20.0, 70.0};
+
+    agg.add("d1", 100, a);
+    agg.add("d1", 900, b);
+    agg.add("d2", 500, c);
+    EXPECT_TRUE(agg.poll().empty());
+
+    agg.add("d1", 1000, c);  // Watermark reaches 1000: [0, 1000) closes for both devices
+    auto closed = agg.poll();
+    ASSERT_EQ(closed.size(), 2u);
+    const auto& d1 = closed[0].device_id == "d1" ? closed[0] : closed[1];
+    EXPECT_EQ(d1.start_ms, 0);
+    EXPECT_EQ(d1.end_ms, 1000);
+    EXPECT_EQ(d1.sample_count, 2u);
+    EXPECT_EQ(d1.metrics[0].count, 2u);
+    EXPECT_DOUBLE_EQ(d1.metrics[0].sum, 40.0);
+    EXPECT_DOUBLE_EQ(d1.metrics[0].min, 10.0);
+    EXPECT_DOUBLE_EQ(d1.metrics[0].max, 30.0);
+    EXPECT_DOUBLE_EQ(d1.metrics[0].mean(), 20.0);
+    EXPECT_DOUBLE_EQ(d1.metrics[0].last, 30.0);
+    EXPECT_EQ(d1.metrics[1].count, 1u);  // NaN = absent
+
+    EXPECT_EQ(agg.stats().open_windows, 1u);
+    EXPECT_EQ(agg.flush().size(), 1u);
+    EXPECT_EQ(agg.stats().windows_emitted, 3u);
+}
+
+TEST(WindowAggregatorTest, OutOfOrderWithinLatenessIsAccepted) {
+    WindowAggregator agg(options(1000, 0, 500));
+    const double v[] = {1.0, 1.0};
+
+    EXPECT_TRUE(agg.add("d1", 1200, v));   // Watermark 700
+    EXPECT_TRUE(agg.add("d1", 800, v));    // Older, but window [0,1000) still open
+    EXPECT_TRUE(agg.poll().empty());
+
+    EXPECT_TRUE(agg.add("d1", 1600, v));   // Watermark 1100 closes [0,1000)
+    EXPECT_FALSE(agg.add("d1", 900, v));   // Too late: dropped
+    auto closed = agg.poll();
+    ASSERT_EQ(closed.size(), 1u);
+    EXPECT_EQ(closed[0].sample_count, 1u);
+    EXPECT_EQ(agg.stats().late_samples, 1u);
+}
+
+TEST(WindowAggregatorTest, SlidingWindowsOverlap) {
+    WindowAggregator agg(options(1000, 250, 0));
+    const double v[] = {4.0, NAN};
+
+    agg.add("d1", 600, v);  // Member of windows starting at -250, 0, 250, 500
+    auto all = agg.flush();
+    ASSERT_EQ(all.size(), 4u);
+    for (size_t i = 0; i < all.size(); ++i) {
+        EXPECT_EQ(all[i].start_ms, -250 + 250 * static_cast<int64_t>(i));  // Ordered by end
+        EXPECT_EQ(all[i].metrics[0].count, 1u);
+    }
+}
+
+TEST(WindowAggregatorTest, ManyDevicesSurviveRehashAndRemoval) {
+    WindowAggregator agg(options(1000, 0, 0));
+    const double v[] = {1.0, 2.0};
+    for (int round = 0; round < 3; ++round) {
+        for (int d = 0; d < 500; ++d) {
+            agg.add("device-" + std::to_string(d), round * 1000 + d, v);
+        }
+    }
+    auto closed = agg.poll();  // Rounds 0 and 1 closed by round 2's samples
+    EXPECT_EQ(closed.size(), 1000u);
+    for (const auto& window : closed) {
+        EXPECT_EQ(window.sample_count, 1u);
+    }
+    EXPECT_EQ(agg.stats().open_windows, 500u);
+    EXPECT_EQ(agg.stats().devices, 500u);
+}
+
+TEST(WindowAggregatorTest, RandomAddPollKeepsEverySample) {
+    // Interleaved polls remove windows from the middle of probe runs while
+    // others are still being filled; no sample may be lost or double-counted
+    for (unsigned seed = 1; seed <= 20; ++seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> device(0, 299);
+        std::uniform_int_distribution<int> jitter(-1500, 400);
+        WindowAggregator agg(options(1000, 0, 1000));
+        const double v[] = {1.0, NAN};
+
+        size_t emitted = 0;
+        int64_t clock = 0;
+        for (int i = 0; i < 20000; ++i) {
+            clock += 3;
+            agg.add("device-" + std::to_string(device(rng)), clock + jitter(rng), v);
+            if (rng() % 10 == 0) {
+                for (const auto& window : agg.poll()) {
+                    emitted += window.sample_count;
+                }
+            }
+        }
+        for (const auto& window : agg.flush()) {
+            emitted += window.sample_count;
+        }
+
+        const auto stats = agg.stats();
+        EXPECT_EQ(emitted, stats.samples) << "seed " << seed;
+        EXPECT_EQ(stats.samples + stats.late_samples, 20000u) << "seed " << seed;
+        EXPECT_EQ(stats.open_windows, 0u);
+        EXPECT_EQ(stats.devices, 300u);
+    }
+}
+
+TEST(WindowAggregatorTest, RejectsInvalidOptions) {
+    EXPECT_THROW(WindowAggregator(options(0, 0, 0)), std::invalid_argument);
+    EXPECT_THROW(WindowAggregator(options(1000, 300, 0)), std::invalid_argument);
+}
@@ -0,0 +1,325 @@
+#include <gtest/gtest.h>
+#include "telemetry_processor/Worker.h"
+#include "redis_test_client.h"
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace telemetry_processor;
+using telemetry_processor::testing::connected_client;
+using namespace std::chrono_literals;
+
+namespace {
+
+const std::string kQueue = "test:worker:pending";
+
+void push_tasks(RedisClient& redis, const std::string& type, int count, int max_retries = 3) {
+    for (int i = 0; i < count; ++i) {
+        redis.rpush(kQueue, Task::create(type, R"({"device_id": "d1", "temperature": 20})",
+                                         Priority::NORMAL, max_retries).serialize());
+    }
+}
+
+Worker::Options test_options() {
+    Worker::Options options;
+    options.queue_key = kQueue;
+    options.batch_size = 16;
+    options.prefetch = 64;
+    options.retry_backoff = 1ms;
+    return options;
+}
+
+Worker::Results all_succeed(const std::vector<Task>& tasks) {
+    Worker::Results results(tasks.size());
+    for (auto& result : results) {
+        result.success = true;
+    }
+    return results;
+}
+
+// Poll until pred() or timeout
+template <typename Pred>
+bool eventually(Pred pred, std::chrono::milliseconds timeout = 5000ms) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(2ms);
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(WorkerTest, DrainsRedisInPrefetchedBatches) {
+    auto redis = connected_client();
+    push_tasks(*redis, "count", 200);
+
+    std::atomic<size_t> processed{0};
+    std::atomic<size_t> largest_batch{0};
+    Worker worker(redis, test_options());
+    worker.register_handler("count", [&](const std::vector<Task>& tasks) {
+        processed += tasks.size();
+        size_t seen = largest_batch.load();
+        while (tasks.size() > seen && !largest_batch.compare_exchange_weak(seen, tasks.size())) {}
+        return all_succeed(tasks);
+    });
+    worker.start();
+
+    ASSERT_TRUE(eventually([&] { return worker.stats().completed == 200; }));
+    worker.stop();
+
+    EXPECT_EQ(processed.load(), 200u);
+    EXPECT_GT(largest_batch.load(), 1u);
+    auto stats = worker.stats();
+    EXPECT_EQ(stats.fetched, 200u);
+    EXPECT_EQ(stats.in_flight, 0u);
+    EXPECT_EQ(redis->llen(kQueue), 0);
+}
+
+TEST(WorkerTest, RetriesFailuresThenGivesUp) {
+    auto redis = connected_client();
+    push_tasks(*redis, "flaky", 10);
+    push_tasks(*redis, "broken", 5, 2);
+    push_tasks(*redis, "unregistered", 3);
+
+    std::mutex mutex;
+    std::set<std::string> attempted;
+    Worker worker(redis, test_options());
+    worker.register_handler("flaky", [&](const std::vector<Task>& tasks) {
+        Worker::Results results(tasks.size());
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            results[i].success = !attempted.insert(tasks[i].id).second;  // Fails the first time
+        }
+        return results;
+    });
+    worker.register_handler("broken", [](const std::vector<Task>& tasks) {
+        return Worker::Results(tasks.size());  // Never succeeds
+    });
+    worker.start();
+
+    ASSERT_TRUE(eventually([&] {
+        auto stats = worker.stats();
+        return stats.fetched == 18 && stats.in_flight == 0;
+    }));
+    worker.stop();
+
+    auto stats = worker.stats();
+    EXPECT_EQ(stats.completed, 10u);
+    EXPECT_EQ(stats.failed, 5u + 3u);          // Out of retries + no handler
+    EXPECT_EQ(stats.retried, 10u + 5u * 2u);   // Unknown types are not retried
+}
+
+TEST(WorkerTest, AimdFollowsHandlerLatency) {
+    auto redis = connected_client();
+    auto options = test_options();
+    options.batch_size = 1;
+    options.initial_concurrency = 4;
+    options.max_concurrency = 4;
+    options.adjust_every = 2;
+    options.target_latency = 2ms;
+
+    std::atomic<bool> slow{true};
+    Worker worker(redis, options);
+    worker.register_handler("work", [&](const std::vector<Task>& tasks) {
+        if (slow) {
+            std::this_thread::sleep_for(10ms);
+        }
+        return all_succeed(tasks);
+    });
+    push_tasks(*redis, "work", 40);
+    worker.start();
+
+    ASSERT_TRUE(eventually([&] { return worker.stats().completed == 40; }));
+    EXPECT_EQ(worker.stats().concurrency_limit, 1u);  // Halved down to the floor
+
+    slow = false;
+    push_tasks(*redis, "work", 2000);
+    ASSERT_TRUE(eventually([&] { return worker.stats().completed == 2040; }));
+    EXPECT_GT(worker.stats().concurrency_limit, 1u);  // Fast again, backlog: additive increase
+    worker.stop();
+}
+
+TEST(WorkerTest, StopRequeuesUnfinishedTasks) {
+    auto redis = connected_client();
+    push_tasks(*redis, "slow", 200);
+
+    auto options = test_options();
+    options.batch_size = 1;
+    options.prefetch = 16;
+    options.max_concurrency = 1;
+    options.initial_concurrency = 1;
+    options.drain_timeout = 20ms;
+    Worker worker(redis, options);
+    worker.register_handler("slow", [](const std::vector<Task>& tasks) {
+        std::this_thread::sleep_for(5ms);
+        return all_succeed(tasks);
+    });
+    worker.start();
+    ASSERT_TRUE(eventually([&] { return worker.stats().completed > 0; }));
+    worker.stop();
+
+    auto stats = worker.stats();
+    EXPECT_GT(stats.requeued, 0u);
+    EXPECT_EQ(stats.in_flight, 0u);
+    EXPECT_EQ(stats.completed + static_cast<size_t>(redis->llen(kQueue)), 200u);  // Nothing lost
+
+    auto frames = redis->lpop(kQueue, 200);
+    auto requeued = Task::deserialize(frames.back());  // Pushed back at the tail
+    EXPECT_EQ(requeued.status, TaskStatus::PENDING);
+    EXPECT_TRUE(requeued.worker_id.empty());
+}
+
+TEST(WorkerTest, RunsTelemetryHandler) {
+    auto redis = connected_client();
+    push_tasks(*redis, "telemetry.analyze", 20);
+
+    auto handler = std::make_shared<TelemetryHandler>();
+    Worker worker(redis, test_options());
+    worker.register_handler("telemetry.analyze", handler);
+    worker.start();
+    ASSERT_TRUE(eventually([&] { return worker.stats().completed == 20; }));
+    worker.stop();
+
+    EXPECT_EQ(handler->get_stats().task_type_counts["telemetry.analyze"], 20u);
+    EXPECT_FALSE(worker.worker_id().empty());
+}
+
+TEST(WorkerTest, ReliableModeReapsDeadWorkersAndAcks) {
+    auto redis = connected_client();
+    push_tasks(*redis, "count", 25);
+
+    // A worker that claimed 5 tasks and died without acking them
+    ReliableQueue::Options dead_options;
+    dead_options.pending_key = kQueue;
+    dead_options.lease_ttl = 50ms;
+    ReliableQueue dead(redis, "dead-worker", dead_options);
+    ASSERT_EQ(dead.claim(5).size(), 5u);
+    std::this_thread::sleep_for(80ms);
+
+    auto options = test_options();
+    options.reliable = true;
+    options.lease_ttl = 5000ms;
+    options.reap_interval = 10ms;
+    Worker worker(redis, options);
+    worker.register_handler("count", all_succeed);
+    worker.start();
+
+    ASSERT_TRUE(eventually([&] { return worker.stats().completed == 25; }));
+    worker.stop();
+
+    auto stats = worker.stats();
+    EXPECT_EQ(stats.reaped, 5u);
+    EXPECT_EQ(stats.requeued, 0u);
+    EXPECT_EQ(redis->llen(kQueue), 0);
+    EXPECT_EQ(redis->llen(dead.processing_key()), 0);
+    EXPECT_EQ(redis->llen(ReliableQueue::processing_key(kQueue, worker.worker_id())), 0);  // All acked
+}
+
+TEST(WorkerTest, ReliableModeKeepsUnfinishedTasksInRedis) {
+    auto redis = connected_client();
+    push_tasks(*redis, "slow", 100);
+
+    auto options = test_options();
+    options.reliable = true;
+    options.lease_ttl = 5000ms;
+    options.batch_size = 1;
+    options.prefetch = 16;
+    options.max_concurrency = 1;
+    options.initial_concurrency = 1;
+    options.drain_timeout = 20ms;
+    Worker worker(redis, options);
+    worker.register_handler("slow", [](const std::vector<Task>& tasks) {
+        std::this_thread::sleep_for(5ms);
+        return all_succeed(tasks);
+    });
+    worker.start();
+    ASSERT_TRUE(eventually([&] { return worker.stats().completed > 0; }));
+
+    // Mid-run: claimed tasks are in the processing list, not gone
+    const auto processing = ReliableQueue::processing_key(kQueue, worker.worker_id());
+    EXPECT_GT(redis->llen(processing), 0);
+    EXPECT_EQ(redis->llen(kQueue) + redis->llen(processing) +
+              static_cast<long long>(worker.stats().completed), 100);
+
+    worker.stop();
+    auto stats = worker.stats();
+    EXPECT_GT(stats.requeued, 0u);
+    EXPECT_EQ(redis->llen(processing), 0);
+    EXPECT_EQ(stats.completed + static_cast<size_t>(redis->llen(kQueue)), 100u);
+}
+
+TEST(WorkerTest, DeduplicatorSkipsResubmittedTasks) {
+    auto redis = connected_client();
+    std::vector<Task> tasks;
+    for (int i = 0; i < 20; ++i) {
+        tasks.push_back(Task::create("count", R"({"device_id": "d1"})"));
+        redis->rpush(kQueue, tasks.back().serialize());
+    }
+
+    std::atomic<size_t> runs{0};
+    auto options = test_options();
+    options.deduplicator = std::make_shared<Deduplicator>(redis);
+    Worker worker(redis, options);
+    worker.register_handler("count", [&](const std::vector<Task>& batch) {
+        runs += batch.size();
+        return all_succeed(batch);
+    });
+    worker.start();
+    ASSERT_TRUE(eventually([&] { return worker.stats().completed == 20; }));
+
+    // Producer resubmits half of them (e.g. after a timeout)
+    for (int i = 0; i < 10; ++i) {
+        redis->rpush(kQueue, tasks[i].serialize());
+    }
+    ASSERT_TRUE(eventually([&] { return worker.stats().duplicates == 10; }));
+    worker.stop();
+
+    EXPECT_EQ(runs.load(), 20u);
+    EXPECT_EQ(worker.stats().completed, 20u);
+    EXPECT_EQ(worker.stats().fetched, 30u);
+}
+
+TEST(WorkerTest, PoisonTasksEndInDeadLetterQueue) {
+    auto redis = connected_client();
+    push_tasks(*redis, "poison", 5, 2);
+    push_tasks(*redis, "count", 10);
+
+    RetryScheduler::Options retry_options;
+    retry_options.pending_key = kQueue;
+    retry_options.base_delay = 1ms;
+    retry_options.promote_interval = 5ms;
+    auto scheduler = std::make_shared<RetryScheduler>(redis, retry_options);
+
+    std::atomic<size_t> poison_attempts{0};
+    auto options = test_options();
+    options.retry_scheduler = scheduler;
+    Worker worker(redis, options);
+    worker.register_handler("count", all_succeed);
+    worker.register_handler("poison", [&](const std::vector<Task>& tasks) {
+        poison_attempts += tasks.size();
+        Worker::Results results(tasks.size());
+        for (auto& result : results) {
+            result.message = "bad payload";
+        }
+        return results;
+    });
+    worker.start();
+
+    ASSERT_TRUE(eventually([&] { return worker.stats().dead_lettered == 5; }));
+    worker.stop();
+
+    auto stats = worker.stats();
+    EXPECT_EQ(stats.completed, 10u);
+    EXPECT_EQ(stats.retried, 10u);                  // Two delayed retries each, via Redis
+    EXPECT_EQ(poison_attempts.load(), 15u);         // Then parked: no hot loop
+    EXPECT_EQ(scheduler->scheduled(), 0u);
+
+    auto dead = scheduler->dead_letters().peek(0, 10);
+    ASSERT_EQ(dead.size(), 5u);
+    EXPECT_EQ(dead[0].error, "bad payload");
+    EXPECT_EQ(dead[0].task.retry_count, 2);
+}
@@ -20,6 +20,9 @@ using namespace std::chrono_literals;
  * - Bounded capacity (backpressure)
  * - Timeout behavior (blocking operations)
  * - Edge cases (empty, full, shutdown)
+ * - Concurrent mode (lock-free lanes, weighted fairness)
+ * - Bulk enqueue/dequeue
+ * - Delayed tasks (enqueue_at / enqueue_after)
  */
 
 // ========== Basic Operations Tests ==========
@@ -155,6 +158,21 @@ TEST(TaskQueueTest, FIFOWithinPriority) {
     EXPECT_EQ(task3->id, "high-3");
 }
 
+TEST(TaskQueueTest, FIFOWithinPriorityWithoutDelays) {
+    TaskQueue queue;
+    
+    // Back-to-back enqueues may share a timestamp: order must still be exact
+    for (int i = 0; i < 100; ++i) {
+        queue.enqueue(Task("medium-" + std::to_string(i), TaskPriority::MEDIUM));
+    }
+    
+    for (int i = 0; i < 100; ++i) {
+        auto task = queue.dequeue();
+        ASSERT_TRUE(task.has_value());
+        EXPECT_EQ(task->id, "medium-" + std::to_string(i));
+    }
+}
+
 // ========== Bounded Capacity Tests ==========
 
 TEST(TaskQueueTest, EnqueueFullQueue) {
@@ -376,6 +394,340 @@ TEST(TaskQueueTest, GetStats) {
     EXPECT_DOUBLE_EQ(stats["utilization"], 3.0);  // 3% full
 }
 
+TEST(TaskQueueTest, PriorityBreakdownStats) {
+    TaskQueue queue(100);
+    
+    queue.enqueue(Task("high-1", TaskPriority::HIGH));
+    queue.enqueue(Task("high-2", TaskPriority::HIGH));
+    queue.enqueue(Task("low-1", TaskPriority::LOW));
+    queue.dequeue();  // high-1
+    
+    auto stats = queue.get_stats();
+    
+    EXPECT_EQ(stats["priority_breakdown"]["HIGH"], 1);
+    EXPECT_EQ(stats["priority_breakdown"]["MEDIUM"], 0);
+    EXPECT_EQ(stats["priority_breakdown"]["LOW"], 1);
+    EXPECT_EQ(stats["enqueued_total"]["HIGH"], 2);
+    EXPECT_EQ(stats["dequeued_total"]["HIGH"], 1);
+    EXPECT_EQ(stats["dequeued_total"]["LOW"], 0);
+}
+
+// ========== Concurrent Mode Tests ==========
+
+static TaskQueueOptions concurrent_options(size_t capacity) {
+    TaskQueueOptions options;
+    options.max_capacity = capacity;
+    options.mode = QueueMode::CONCURRENT;
+    return options;
+}
+
+TEST(TaskQueueTest, ConcurrentModeBasics) {
+    TaskQueue queue(concurrent_options(3));
+    EXPECT_EQ(queue.mode(), QueueMode::CONCURRENT);
+    EXPECT_EQ(queue.capacity(), 3);
+    
+    EXPECT_TRUE(queue.enqueue(Task("a", TaskPriority::MEDIUM)));
+    EXPECT_TRUE(queue.enqueue(Task("b", TaskPriority::MEDIUM)));
+    EXPECT_TRUE(queue.enqueue(Task("c", TaskPriority::MEDIUM)));
+    EXPECT_TRUE(queue.full());
+    EXPECT_FALSE(queue.enqueue(Task("d", TaskPriority::MEDIUM)));
+    EXPECT_FALSE(queue.peek().has_value());  // Unsupported in concurrent mode
+    
+    EXPECT_EQ(queue.dequeue()->id, "a");
+    EXPECT_EQ(queue.dequeue()->id, "b");
+    EXPECT_EQ(queue.get_stats()["mode"], "concurrent");
+    EXPECT_EQ(queue.get_stats()["dequeued_total"]["MEDIUM"], 2);
+    
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.dequeue().has_value());
+}
+
+TEST(TaskQueueTest, ConcurrentModeLowPriorityNotStarved) {
+    TaskQueue queue(concurrent_options(1000));  // Default weights 8/4/1
+    for (int i = 0; i < 100; ++i) {
+        queue.enqueue(Task("high-" + std::to_string(i), TaskPriority::HIGH));
+        queue.enqueue(Task("low-" + std::to_string(i), TaskPriority::LOW));
+    }
+    
+    // Two full rounds of 13: LOW gets its one slot per round, MEDIUM's
+    // (empty) slots go to HIGH
+    int low = 0;
+    for (int i = 0; i < 26; ++i) {
+        auto task = queue.dequeue();
+        ASSERT_TRUE(task.has_value());
+        low += task->priority == TaskPriority::LOW;
+    }
+    EXPECT_EQ(low, 2);
+    EXPECT_EQ(queue.get_stats()["dequeued_total"]["HIGH"], 24);
+}
+
+TEST(TaskQueueTest, ConcurrentModeWeightsHoldPerQueue) {
+    // Schedule H, H, L, H: a rotation shared between queues would hand
+    // one queue every LOW slot and the other none
+    auto options = concurrent_options(100);
+    options.lane_weights = {{3, 0, 1}};
+    TaskQueue first(options);
+    TaskQueue second(options);
+    for (auto* queue : {&first, &second}) {
+        for (int i = 0; i < 20; ++i) {
+            queue->enqueue(Task("high-" + std::to_string(i), TaskPriority::HIGH));
+            queue->enqueue(Task("low-" + std::to_string(i), TaskPriority::LOW));
+        }
+    }
+    
+    int low_first = 0;
+    int low_second = 0;
+    for (int i = 0; i < 8; ++i) {  // Same thread, alternating
+        low_first += first.dequeue()->priority == TaskPriority::LOW;
+        low_second += second.dequeue()->priority == TaskPriority::LOW;
+    }
+    EXPECT_EQ(low_first, 2);
+    EXPECT_EQ(low_second, 2);
+}
+
+TEST(TaskQueueTest, ConcurrentModeBlockingWaits) {
+    TaskQueue queue(concurrent_options(1));
+    
+    // Consumer parks on the eventcount until the producer arrives
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(50ms);
+        queue.enqueue(Task("late", TaskPriority::LOW));
+    });
+    auto task = queue.dequeue(5000ms);
+    producer.join();
+    ASSERT_TRUE(task.has_value());
+    EXPECT_EQ(task->id, "late");
+    
+    // Full queue: enqueue times out instead of spinning
+    ASSERT_TRUE(queue.enqueue(Task("fill", TaskPriority::HIGH)));
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.enqueue(Task("overflow", TaskPriority::HIGH), 50ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 45ms);
+}
+
+TEST(TaskQueueTest, ConcurrentModeManyProducersConsumers) {
+    TaskQueue queue(concurrent_options(256));  // Small: exercises backpressure
+    const int num_producers = 8;
+    const int num_consumers = 8;
+    const int tasks_per_producer = 5000;
+    const int total = num_producers * tasks_per_producer;
+    
+    std::vector<std::atomic<int>> seen(total);
+    std::atomic<int> consumed{0};
+    
+    std::vector<std::thread> threads;
+    for (int p = 0; p < num_producers; ++p) {
+        threads.emplace_back([&queue, p, tasks_per_producer]() {
+            for (int j = 0; j < tasks_per_producer; ++j) {
+                int n = p * tasks_per_producer + j;
+                Task task(std::to_string(n), static_cast<TaskPriority>(n % 3));
+                ASSERT_TRUE(queue.enqueue(std::move(task), 5000ms));
+            }
+        });
+    }
+    for (int c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&queue, &seen, &consumed, total]() {
+            while (consumed.load() < total) {
+                auto task = queue.dequeue(10ms);
+                if (task) {
+                    seen[std::stoi(task->id)]++;
+                    consumed++;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    
+    EXPECT_EQ(consumed, total);
+    EXPECT_TRUE(queue.empty());
+    // Every task delivered exactly once
+    EXPECT_EQ(std::count_if(seen.begin(), seen.end(), [](const std::atomic<int>& n) {
+        return n.load() != 1;
+    }), 0);
+}
+
+// ========== Bulk Operations Tests ==========
+
+static std::vector<Task> make_batch(const std::string& prefix, int count, TaskPriority priority) {
+    std::vector<Task> batch;
+    for (int i = 0; i < count; ++i) {
+        batch.emplace_back(prefix + std::to_string(i), priority);
+    }
+    return batch;
+}
+
+TEST(TaskQueueTest, BulkEnqueueDequeuePriorityOrder) {
+    TaskQueue queue(100);
+    auto batch = make_batch("low-", 3, TaskPriority::LOW);
+    batch.emplace_back("high-0", TaskPriority::HIGH);
+    batch.emplace_back("high-1", TaskPriority::HIGH);
+    
+    EXPECT_EQ(queue.enqueue_bulk(std::move(batch)), 5u);
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(queue.size(), 5u);
+    
+    std::vector<Task> out;
+    EXPECT_EQ(queue.dequeue_bulk(out, 4), 4u);
+    ASSERT_EQ(out.size(), 4u);
+    EXPECT_EQ(out[0].id, "high-0");
+    EXPECT_EQ(out[1].id, "high-1");
+    EXPECT_EQ(out[2].id, "low-0");
+    EXPECT_EQ(out[3].id, "low-1");
+    
+    // Appends to out; takes only what is there
+    EXPECT_EQ(queue.dequeue_bulk(out, 10), 1u);
+    EXPECT_EQ(out.back().id, "low-2");
+    EXPECT_EQ(queue.dequeue_bulk(out, 10), 0u);
+}
+
+TEST(TaskQueueTest, BulkEnqueueRespectsCapacity) {
+    TaskQueue queue(5);
+    auto batch = make_batch("task-", 8, TaskPriority::MEDIUM);
+    
+    EXPECT_EQ(queue.enqueue_bulk(std::move(batch)), 5u);
+    EXPECT_TRUE(queue.full());
+    
+    // Leftovers handed back in order
+    ASSERT_EQ(batch.size(), 3u);
+    EXPECT_EQ(batch[0].id, "task-5");
+    EXPECT_EQ(batch[2].id, "task-7");
+}
+
+TEST(TaskQueueTest, BulkEnqueueWaitsForSpace) {
+    for (auto mode : {QueueMode::LOCKED, QueueMode::CONCURRENT}) {
+        TaskQueueOptions options;
+        options.max_capacity = 2;
+        options.mode = mode;
+        TaskQueue queue(options);
+        
+        std::atomic<size_t> consumed{0};
+        std::thread consumer([&queue, &consumed]() {
+            std::vector<Task> out;
+            while (consumed < 6) {
+                consumed += queue.dequeue_bulk(out, 4, 1000ms);
+            }
+        });
+        
+        auto batch = make_batch("task-", 6, TaskPriority::HIGH);
+        EXPECT_EQ(queue.enqueue_bulk(std::move(batch), 5000ms), 6u);
+        consumer.join();
+        EXPECT_EQ(consumed, 6u);
+    }
+}
+
+TEST(TaskQueueTest, DequeueBulkWaitsForFirstTask) {
+    TaskQueue queue(concurrent_options(100));
+    
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(50ms);
+        queue.enqueue_bulk(make_batch("task-", 3, TaskPriority::MEDIUM));
+    });
+    
+    std::vector<Task> out;
+    size_t taken = queue.dequeue_bulk(out, 10, 5000ms);
+    producer.join();
+    
+    // Wakes on the first publish; may see 1-3 tasks of the batch
+    EXPECT_GE(taken, 1u);
+    taken += queue.dequeue_bulk(out, 10);
+    EXPECT_EQ(taken, 3u);
+    EXPECT_EQ(out[0].id, "task-0");
+}
+
+// ========== Delayed Task Tests ==========
+
+TEST(TaskQueueTest, DelayedTaskInvisibleUntilDue) {
+    for (auto mode : {QueueMode::LOCKED, QueueMode::CONCURRENT}) {
+        TaskQueueOptions options;
+        options.mode = mode;
+        TaskQueue queue(options);
+        
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_TRUE(queue.enqueue_after(Task("retry", TaskPriority::HIGH), 80ms));
+        EXPECT_FALSE(queue.dequeue().has_value());
+        EXPECT_EQ(queue.size(), 0);
+        EXPECT_EQ(queue.get_stats()["delayed"], 1);
+        
+        auto task = queue.dequeue(5000ms);
+        ASSERT_TRUE(task.has_value());
+        EXPECT_EQ(task->id, "retry");
+        EXPECT_GE(std::chrono::steady_clock::now() - start, 75ms);
+        EXPECT_EQ(queue.get_stats()["delayed"], 0);
+    }
+}
+
+TEST(TaskQueueTest, DelayedTasksOrderedByDueTime) {
+    for (auto mode : {QueueMode::LOCKED, QueueMode::CONCURRENT}) {
+        TaskQueueOptions options;
+        options.mode = mode;
+        TaskQueue queue(options);
+        auto now = std::chrono::steady_clock::now();
+        
+        queue.enqueue_at(Task("late", TaskPriority::HIGH), now + 60ms);
+        queue.enqueue_at(Task("early", TaskPriority::LOW), now + 30ms);
+        queue.enqueue_at(Task("past", TaskPriority::LOW), now - 1ms);
+        
+        EXPECT_EQ(queue.dequeue()->id, "past");  // Already due
+        EXPECT_EQ(queue.dequeue(5000ms)->id, "early");
+        EXPECT_EQ(queue.dequeue(5000ms)->id, "late");
+    }
+}
+
+TEST(TaskQueueTest, DelayedTasksHoldCapacity) {
+    for (auto mode : {QueueMode::LOCKED, QueueMode::CONCURRENT}) {
+        TaskQueueOptions options;
+        options.max_capacity = 2;
+        options.mode = mode;
+        TaskQueue queue(options);
+        
+        EXPECT_TRUE(queue.enqueue_after(Task("a", TaskPriority::LOW), 10s));
+        EXPECT_TRUE(queue.enqueue_after(Task("b", TaskPriority::LOW), 10s));
+        EXPECT_TRUE(queue.full());
+        EXPECT_EQ(queue.size(), 0);
+        EXPECT_FALSE(queue.enqueue(Task("c", TaskPriority::HIGH)));
+        EXPECT_FALSE(queue.enqueue_after(Task("d", TaskPriority::LOW), 1ms));
+        
+        queue.clear();  // Drops scheduled tasks too
+        EXPECT_FALSE(queue.full());
+        EXPECT_TRUE(queue.enqueue(Task("c", TaskPriority::HIGH)));
+    }
+}
+
+TEST(TaskQueueTest, BlockedConsumerWakesForDelayedTask) {
+    for (auto mode : {QueueMode::LOCKED, QueueMode::CONCURRENT}) {
+        TaskQueueOptions options;
+        options.mode = mode;
+        TaskQueue queue(options);
+        
+        // Consumers already asleep (no timer yet) must pick up a timer
+        // scheduled later, without waiting out their own timeout
+        std::atomic<int> received{0};
+        std::vector<std::thread> consumers;
+        for (int i = 0; i < 3; ++i) {
+            consumers.emplace_back([&queue, &received]() {
+                if (queue.dequeue(5000ms)) {
+                    received++;
+                }
+            });
+        }
+        std::this_thread::sleep_for(30ms);
+        
+        auto start = std::chrono::steady_clock::now();
+        queue.enqueue_after(Task("t1", TaskPriority::MEDIUM), 100ms);
+        queue.enqueue_after(Task("t2", TaskPriority::MEDIUM), 50ms);   // New head: re-arm
+        queue.enqueue_after(Task("t3", TaskPriority::MEDIUM), 150ms);
+        for (auto& t : consumers) {
+            t.join();
+        }
+        
+        EXPECT_EQ(received, 3);
+        EXPECT_LT(std::chrono::steady_clock::now() - start, 2000ms);
+    }
+}
+
 // ========== Utility Tests ==========
 
 TEST(TaskQueueTest, TaskPriorityToString) {